@@ -44,8 +44,18 @@
 
 #include "mne_rt_server.h"
 
+#include <fiff/fiff_constants.h>
+#include <fiff/fiff_stream.h>
+
 #include <stdlib.h>
 
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QFile>
+#include <QTextStream>
+
 //=============================================================================================================
 // USED NAMESPACES
 //=============================================================================================================
@@ -61,6 +71,8 @@ using namespace COMMUNICATIONLIB;
 FiffStreamServer::FiffStreamServer(QObject *parent)
 : QTcpServer(parent)
 , m_iNextClientId(0)
+, m_iMaxQueuedBuffers(100)
+, m_queuePolicy(FiffStreamThread::DropOldest)
 {
 }
 
@@ -77,11 +89,11 @@ void FiffStreamServer::comClist(Command p_command)
 {
     //ToDo JSON
     QString t_sOutput("");
-    t_sOutput.append("\tID\tAlias\r\n");
+    t_sOutput.append("\tID\tAlias\tDropped\r\n");
     QMap<qint32, FiffStreamThread*>::iterator i;
     for (i = this->m_qClientList.begin(); i != this->m_qClientList.end(); ++i)
     {
-        QString str = QString("\t%1\t%2\r\n").arg(i.key()).arg(i.value()->getAlias());
+        QString str = QString("\t%1\t%2\t%3\r\n").arg(i.key()).arg(i.value()->getAlias()).arg(i.value()->getDroppedBuffers());
         t_sOutput.append(str);
     }
     t_sOutput.append("\n");
@@ -179,6 +191,67 @@ void FiffStreamServer::connectCommands()
 
 ////=============================================================================================================
 
+void FiffStreamServer::setClientQueuePolicy(int iMaxQueuedBuffers,
+                                            FiffStreamThread::QueuePolicy policy)
+{
+    m_iMaxQueuedBuffers = iMaxQueuedBuffers;
+    m_queuePolicy = policy;
+
+    QMap<qint32, FiffStreamThread*>::iterator i;
+    for (i = this->m_qClientList.begin(); i != this->m_qClientList.end(); ++i)
+    {
+        i.value()->setQueuePolicy(m_iMaxQueuedBuffers, m_queuePolicy);
+    }
+}
+
+//=============================================================================================================
+
+void FiffStreamServer::readConfig(const QString& sFileName)
+{
+    QFile t_configFile(sFileName);
+    if(!t_configFile.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    int t_iMaxQueuedBuffers = m_iMaxQueuedBuffers;
+    FiffStreamThread::QueuePolicy t_queuePolicy = m_queuePolicy;
+
+    QTextStream in(&t_configFile);
+    QString line = in.readLine();
+    while (!line.isNull()) {
+        QStringList list = line.split(":");
+
+        if(list.size() == 2) {
+            QString t_sKey = list[0].simplified();
+            QString t_sValue = list[1].simplified();
+
+            if(t_sKey.compare("clientQueueSize") == 0) {
+                bool t_bOk = false;
+                int t_iValue = t_sValue.toInt(&t_bOk);
+                if(t_bOk && t_iValue > 0) {
+                    t_iMaxQueuedBuffers = t_iValue;
+                } else {
+                    printf("Invalid clientQueueSize '%s' in %s\n", t_sValue.toUtf8().constData(), sFileName.toUtf8().constData());
+                }
+            } else if(t_sKey.compare("clientQueuePolicy") == 0) {
+                if(t_sValue.compare("dropOldest", Qt::CaseInsensitive) == 0) {
+                    t_queuePolicy = FiffStreamThread::DropOldest;
+                } else if(t_sValue.compare("dropNewest", Qt::CaseInsensitive) == 0) {
+                    t_queuePolicy = FiffStreamThread::DropNewest;
+                } else {
+                    printf("Invalid clientQueuePolicy '%s' in %s\n", t_sValue.toUtf8().constData(), sFileName.toUtf8().constData());
+                }
+            }
+        }
+
+        line = in.readLine();
+    }
+
+    setClientQueuePolicy(t_iMaxQueuedBuffers, t_queuePolicy);
+}
+
+////=============================================================================================================
+
 //bool FiffStreamServer::parseCommand(QStringList& p_sListCommand, QByteArray& p_blockOutputInfo)
 //{
 //    bool success = false;
@@ -352,10 +425,19 @@ void FiffStreamServer::forwardMeasInfo(qint32 ID, const FiffInfo& p_fiffInfo)
 }
 
 //=============================================================================================================
-//ToDo increase preformance --> try inline
+
 void FiffStreamServer::forwardRawBuffer(QSharedPointer<Eigen::MatrixXf> m_pMatRawData)
 {
-    emit remitRawBuffer(m_pMatRawData);
+    if(m_qClientList.isEmpty()) {
+        return;
+    }
+
+    //Serialize the buffer once, all clients queue the same implicitly shared block
+    QByteArray t_blockRawData;
+    FiffStream t_FiffStreamOut(&t_blockRawData, QIODevice::WriteOnly);
+    t_FiffStreamOut.write_float(FIFF_DATA_BUFFER,m_pMatRawData->data(),m_pMatRawData->rows()*m_pMatRawData->cols());
+
+    emit remitRawBlock(t_blockRawData);
 }
 
 //=============================================================================================================
@@ -363,6 +445,7 @@ void FiffStreamServer::forwardRawBuffer(QSharedPointer<Eigen::MatrixXf> m_pMatRa
 void FiffStreamServer::incomingConnection(qintptr socketDescriptor)
 {
     FiffStreamThread* t_pStreamThread = new FiffStreamThread(m_iNextClientId, socketDescriptor, this);
+    t_pStreamThread->setQueuePolicy(m_iMaxQueuedBuffers, m_queuePolicy);
 
     m_qClientList.insert(m_iNextClientId, t_pStreamThread);
     ++m_iNextClientId;
@@ -41,6 +41,8 @@
 // INCLUDES
 //=============================================================================================================
 
+#include "fiffstreamthread.h"
+
 #include <fiff/fiff_info.h>
 #include <communication/rtCommand/commandmanager.h>
 
@@ -50,6 +52,7 @@
 
 #include <QStringList>
 #include <QTcpServer>
+#include <QByteArray>
 
 //=============================================================================================================
 // DEFINE NAMESPACE RTSERVER
@@ -98,6 +101,27 @@ public:
      */
     void connectCommands();
 
+    //=========================================================================================================
+    /**
+     * Sets the bound of the per client raw buffer send queue and the policy applied when a client does not keep
+     * up. Applies to all connected and future clients.
+     *
+     * @param[in] iMaxQueuedBuffers  Maximal number of raw buffers queued per client.
+     * @param[in] policy             The policy applied when a client queue is full.
+     */
+    void setClientQueuePolicy(int iMaxQueuedBuffers,
+                              FiffStreamThread::QueuePolicy policy);
+
+    //=========================================================================================================
+    /**
+     * Reads the client queue settings from the mne_rt_server config file, see setClientQueuePolicy. The keys are
+     * clientQueueSize (number of raw buffers) and clientQueuePolicy (dropOldest or dropNewest). Missing or invalid
+     * entries keep their current values.
+     *
+     * @param[in] sFileName  The config file.
+     */
+    void readConfig(const QString& sFileName);
+
 //    virtual bool parseCommand(QStringList& p_sListCommand, QByteArray& p_blockOutputInfo);
 
 //    //=========================================================================================================
@@ -117,7 +141,7 @@ signals:
     void stopMeasFiffStreamClient(qint32 ID);
 
     void remitMeasInfo(qint32 ID, const FIFFLIB::FiffInfo& p_fiffInfo);
-    void remitRawBuffer(QSharedPointer<Eigen::MatrixXf>);
+    void remitRawBlock(const QByteArray& p_blockRawData);
 
     void closeFiffStreamServer();
 
@@ -170,6 +194,9 @@ private:
 
     QMap<qint32, FiffStreamThread*> m_qClientList;
     qint32                          m_iNextClientId;
+
+    int                             m_iMaxQueuedBuffers;    /**< Maximal number of raw buffers queued per client. */
+    FiffStreamThread::QueuePolicy   m_queuePolicy;          /**< Policy applied when a client queue is full. */
 };
 
 //=============================================================================================================
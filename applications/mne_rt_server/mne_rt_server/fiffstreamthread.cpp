@@ -58,6 +58,7 @@
 //=============================================================================================================
 
 #include <QtNetwork>
+#include <QtEndian>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -76,8 +77,12 @@ FiffStreamThread::FiffStreamThread(qint32 id, int socketDescriptor, QObject *par
 , m_iDataClientId(id)
 , m_sDataClientAlias(QString(""))
 , m_iSocketDescriptor(socketDescriptor)
+, m_iQueuedRawBuffers(0)
+, m_iMaxQueuedRawBuffers(100)
+, m_queuePolicy(DropOldest)
+, m_iDroppedRawBuffers(0)
 , m_bIsSendingRawBuffer(false)
-, m_bIsRunning(false)
+, m_bStopRequested(false)
 {
 }
 
@@ -90,22 +95,88 @@ FiffStreamThread::~FiffStreamThread()
     if(t_pFiffStreamServer)
         t_pFiffStreamServer->m_qClientList.remove(m_iDataClientId);
 
-    m_bIsRunning = false;
+    //A plain quit() is lost if it arrives before run() entered its event loop. The flag covers a stop request
+    //before run() checks it, the queued stopRequested signal is processed by the event loop once it runs.
+    m_qMutex.lock();
+    m_bStopRequested = true;
+    m_qMutex.unlock();
+
+    emit stopRequested();
+
     QThread::wait();
 }
 
 //=============================================================================================================
 
+void FiffStreamThread::setQueuePolicy(int iMaxQueuedBuffers,
+                                      QueuePolicy policy)
+{
+    QMutexLocker locker(&m_qMutex);
+    m_iMaxQueuedRawBuffers = qMax(1, iMaxQueuedBuffers);
+    m_queuePolicy = policy;
+}
+
+//=============================================================================================================
+
+qint64 FiffStreamThread::getDroppedBuffers()
+{
+    QMutexLocker locker(&m_qMutex);
+    return m_iDroppedRawBuffers;
+}
+
+//=============================================================================================================
+
+void FiffStreamThread::enqueueControlBlock(const QByteArray& p_block)
+{
+    SendBlock t_sendBlock;
+    t_sendBlock.data = p_block;
+    t_sendBlock.bIsRawBuffer = false;
+
+    //Control blocks are small and are never dropped
+    m_qMutex.lock();
+    bool t_bWasEmpty = m_qSendQueue.isEmpty();
+    m_qSendQueue.enqueue(t_sendBlock);
+    m_qMutex.unlock();
+
+    if(t_bWasEmpty) {
+        emit blocksQueued();
+    }
+}
+
+//=============================================================================================================
+
+bool FiffStreamThread::dequeueBlock(QByteArray& p_block)
+{
+    QMutexLocker locker(&m_qMutex);
+
+    if(m_qSendQueue.isEmpty()) {
+        return false;
+    }
+
+    SendBlock t_sendBlock = m_qSendQueue.dequeue();
+    if(t_sendBlock.bIsRawBuffer) {
+        --m_iQueuedRawBuffers;
+    }
+
+    p_block = t_sendBlock.data;
+
+    return true;
+}
+
+//=============================================================================================================
+
 void FiffStreamThread::startMeas(qint32 ID)
 {
     if(ID == m_iDataClientId)
     {
         qDebug() << "Activate raw buffer sending.";
 
-        m_qMutex.lock();
-        // ToDo send start meas
-        FiffStream t_FiffStreamOut(&m_qSendBlock, QIODevice::WriteOnly);
+        QByteArray t_block;
+        FiffStream t_FiffStreamOut(&t_block, QIODevice::WriteOnly);
         t_FiffStreamOut.start_block(FIFFB_RAW_DATA);
+        enqueueControlBlock(t_block);
+
+        m_qMutex.lock();
         m_bIsSendingRawBuffer = true;
         m_qMutex.unlock();
     }
@@ -121,10 +192,13 @@ void FiffStreamThread::stopMeas(qint32 ID)
         qDebug() << "stop raw buffer sending.";
 
         m_qMutex.lock();
-        FiffStream t_FiffStreamOut(&m_qSendBlock, QIODevice::WriteOnly);
-        t_FiffStreamOut.end_block(FIFFB_RAW_DATA);
         m_bIsSendingRawBuffer = false;
         m_qMutex.unlock();
+
+        QByteArray t_block;
+        FiffStream t_FiffStreamOut(&t_block, QIODevice::WriteOnly);
+        t_FiffStreamOut.end_block(FIFFB_RAW_DATA);
+        enqueueControlBlock(t_block);
     }
 }
 
@@ -167,24 +241,95 @@ void FiffStreamThread::parseCommand(FiffTag::SPtr p_pTag)
 
 //=============================================================================================================
 
-void FiffStreamThread::sendRawBuffer(QSharedPointer<Eigen::MatrixXf> m_pMatRawData)
+void FiffStreamThread::sendRawBlock(const QByteArray& p_blockRawData)
 {
-    if(m_bIsSendingRawBuffer)
-    {
-//        qDebug() << "Send RawBuffer to client";
+    QMutexLocker locker(&m_qMutex);
 
-        m_qMutex.lock();
+    bool t_bWasEmpty = m_qSendQueue.isEmpty();
 
-        FiffStream t_FiffStreamOut(&m_qSendBlock, QIODevice::WriteOnly);
-        t_FiffStreamOut.write_float(FIFF_DATA_BUFFER,m_pMatRawData->data(),m_pMatRawData->rows()*m_pMatRawData->cols());
+    if(!m_bIsSendingRawBuffer) {
+        return;
+    }
 
-        m_qMutex.unlock();
+    if(m_iQueuedRawBuffers >= m_iMaxQueuedRawBuffers) {
+        if(m_queuePolicy == DropNewest) {
+            ++m_iDroppedRawBuffers;
+            return;
+        } else {
+            //DropOldest: remove the first raw buffer, control blocks keep their position
+            for(QQueue<SendBlock>::iterator it = m_qSendQueue.begin(); it != m_qSendQueue.end(); ++it) {
+                if(it->bIsRawBuffer) {
+                    m_qSendQueue.erase(it);
+                    --m_iQueuedRawBuffers;
+                    ++m_iDroppedRawBuffers;
+                    break;
+                }
+            }
+        }
+    }
+
+    //The block is shared with all other clients, enqueueing only increments its reference count
+    SendBlock t_sendBlock;
+    t_sendBlock.data = p_blockRawData;
+    t_sendBlock.bIsRawBuffer = true;
+    m_qSendQueue.enqueue(t_sendBlock);
+    ++m_iQueuedRawBuffers;
+
+    locker.unlock();
 
+    //Wake the client's event loop only if it is not already about to drain the queue
+    if(t_bWasEmpty) {
+        emit blocksQueued();
+    }
+}
+
+//=============================================================================================================
+
+void FiffStreamThread::writeQueuedBlocks(QTcpSocket& p_qTcpSocket)
+{
+    //Blocks are only handed to the socket once its own buffer is drained, so a slow client backs up in the bounded
+    //send queue where the queue policy applies. The next bytesWritten signal continues the transfer.
+    if(p_qTcpSocket.bytesToWrite() > 0) {
+        return;
+    }
+
+    QByteArray t_block;
+    while(dequeueBlock(t_block)) {
+        p_qTcpSocket.write(t_block);
+    }
+}
+
+//=============================================================================================================
+
+void FiffStreamThread::readCommands(QTcpSocket& p_qTcpSocket,
+                                    FiffStream& p_FiffStreamIn)
+{
+    const qint64 t_iTagHeaderSize = 4 * sizeof(qint32);
+
+    while(p_qTcpSocket.bytesAvailable() >= t_iTagHeaderSize)
+    {
+        //
+        // Peek at the tag header and only consume the tag once it arrived completely
+        //
+        QByteArray t_tagHeader = p_qTcpSocket.peek(t_iTagHeaderSize);
+        qint32 t_iTagSize = qFromBigEndian<qint32>(reinterpret_cast<const uchar*>(t_tagHeader.constData()) + 2 * sizeof(qint32));
+
+        if(p_qTcpSocket.bytesAvailable() < t_iTagHeaderSize + qMax(0, t_iTagSize)) {
+            return;
+        }
+
+        FiffTag::SPtr t_pTag;
+        p_FiffStreamIn.read_tag_info(t_pTag, false);
+        p_FiffStreamIn.read_tag_data(t_pTag);
+
+        //
+        // Parse the tag
+        //
+        if(t_pTag->kind == FIFF_MNE_RT_COMMAND)
+        {
+            parseCommand(t_pTag);
+        }
     }
-//    else
-//    {
-//        qDebug() << "Send RawBuffer is not activated";
-//    }
 }
 
 //=============================================================================================================
@@ -212,9 +357,8 @@ void FiffStreamThread::sendMeasurementInfo(qint32 ID, const FiffInfo& p_fiffInfo
 {
     if(ID == m_iDataClientId)
     {
-        m_qMutex.lock();
-
-        FiffStream t_FiffStreamOut(&m_qSendBlock, QIODevice::WriteOnly);
+        QByteArray t_block;
+        FiffStream t_FiffStreamOut(&t_block, QIODevice::WriteOnly);
 
 //        qint32 init_info[2];
 //        init_info[0] = FIFF_MNE_RT_CLIENT_ID;
@@ -225,9 +369,9 @@ void FiffStreamThread::sendMeasurementInfo(qint32 ID, const FiffInfo& p_fiffInfo
 //FiffStream::start_writing_raw
 
         p_fiffInfo.writeToStream(&t_FiffStreamOut);
-        m_qMutex.unlock();
+        enqueueControlBlock(t_block);
 
-//        qDebug() << "MeasInfo Blocksize: " << m_qSendBlock.size();
+//        qDebug() << "MeasInfo Blocksize: " << t_block.size();
     }
 }
 
@@ -235,9 +379,12 @@ void FiffStreamThread::sendMeasurementInfo(qint32 ID, const FiffInfo& p_fiffInfo
 
 void FiffStreamThread::writeClientId()
 {
-    FiffStream t_FiffStreamOut(&m_qSendBlock, QIODevice::WriteOnly);
+    QByteArray t_block;
+    FiffStream t_FiffStreamOut(&t_block, QIODevice::WriteOnly);
 
     t_FiffStreamOut.write_int(FIFF_MNE_RT_CLIENT_ID, &m_iDataClientId);
+
+    enqueueControlBlock(t_block);
 }
 
 //=============================================================================================================
@@ -280,14 +427,12 @@ void FiffStreamThread::writeClientId()
 
 void FiffStreamThread::run()
 {
-    m_bIsRunning = true;
-
     FiffStreamServer* t_pParentServer = qobject_cast<FiffStreamServer*>(this->parent());
 
     connect(t_pParentServer, &FiffStreamServer::remitMeasInfo,
             this, &FiffStreamThread::sendMeasurementInfo);
-    connect(t_pParentServer, &FiffStreamServer::remitRawBuffer,
-            this, &FiffStreamThread::sendRawBuffer);
+    connect(t_pParentServer, &FiffStreamServer::remitRawBlock,
+            this, &FiffStreamThread::sendRawBlock);
     connect(t_pParentServer, &FiffStreamServer::startMeasFiffStreamClient,
             this, &FiffStreamThread::startMeas);
     connect(t_pParentServer, &FiffStreamServer::stopMeasFiffStreamClient,
@@ -308,61 +453,30 @@ void FiffStreamThread::run()
 
     FiffStream t_FiffStreamIn(&t_qTcpSocket);
 
-//    int i = 0;
-    while(t_qTcpSocket.state() != QAbstractSocket::UnconnectedState && m_bIsRunning)
-    {
-        //
-        // Write available data
-        //
-        m_qMutex.lock();
-        qint32 t_iBlockSize = m_qSendBlock.size();
-//        qDebug() << "data available" << t_iBlockSize;
-        if(t_iBlockSize > 0)
-        {
-            qint32 t_iBytesWritten = t_qTcpSocket.write(m_qSendBlock);
-//            qDebug() << ++i<< "[wrote bytes] " << t_iBytesWritten;
-            t_qTcpSocket.waitForBytesWritten();
-            if(t_iBytesWritten == t_iBlockSize)
-            {
-                m_qSendBlock.clear();
-            }
-            else
-            {
-                //we have to store bytes which were not written to the socket, due to writing limit
-                //m_qSendBlock = m_qSendBlock.mid(t_iBytesWritten, t_iBlockSize-t_iBytesWritten);
-                m_qSendBlock.remove(0,t_iBytesWritten); //higher performance then mid
-            }
-        }
-        m_qMutex.unlock();
-
-        //
-        // Read: Wait 10ms for incomming tag header, read and continue
-        //
-        t_qTcpSocket.waitForReadyRead(10);
-
-        if (t_qTcpSocket.bytesAvailable() >= (int)sizeof(qint32)*4)
-        {
-//            qDebug() << "goes to read bytes " ;
-            FiffTag::SPtr t_pTag;
-            t_FiffStreamIn.read_tag_info(t_pTag, false);
-
-            //
-            // wait until tag size data are available and read the data
-            //
-            while (t_qTcpSocket.bytesAvailable() < t_pTag->size())
-            {
-                t_qTcpSocket.waitForReadyRead(10);
-            }
-            t_FiffStreamIn.read_tag_data(t_pTag);
-
-            //
-            // Parse the tag
-            //
-            if(t_pTag->kind == FIFF_MNE_RT_COMMAND)
-            {
-                parseCommand(t_pTag);
-            }
-        }
+    //
+    // Event driven I/O: queued blocks are written as soon as they arrive, commands are parsed when they arrive and
+    // the thread sleeps in its event loop in between.
+    //
+    connect(this, &FiffStreamThread::blocksQueued,
+            &t_qTcpSocket, [this, &t_qTcpSocket]() { writeQueuedBlocks(t_qTcpSocket); });
+    connect(&t_qTcpSocket, &QTcpSocket::bytesWritten,
+            &t_qTcpSocket, [this, &t_qTcpSocket]() { writeQueuedBlocks(t_qTcpSocket); });
+    connect(&t_qTcpSocket, &QTcpSocket::readyRead,
+            &t_qTcpSocket, [this, &t_qTcpSocket, &t_FiffStreamIn]() { readCommands(t_qTcpSocket, t_FiffStreamIn); });
+    connect(&t_qTcpSocket, &QTcpSocket::disconnected,
+            &t_qTcpSocket, [this]() { QThread::quit(); });
+    connect(this, &FiffStreamThread::stopRequested,
+            &t_qTcpSocket, [this]() { QThread::quit(); });
+
+    writeQueuedBlocks(t_qTcpSocket);
+    readCommands(t_qTcpSocket, t_FiffStreamIn);
+
+    m_qMutex.lock();
+    bool t_bStopRequested = m_bStopRequested;
+    m_qMutex.unlock();
+
+    if(!t_bStopRequested && t_qTcpSocket.state() != QAbstractSocket::UnconnectedState) {
+        QThread::exec();
     }
 
     t_qTcpSocket.disconnectFromHost();
@@ -52,6 +52,7 @@
 #include <QThread>
 #include <QTcpSocket>
 #include <QMutex>
+#include <QQueue>
 #include <QSharedPointer>
 
 //=============================================================================================================
@@ -70,6 +71,17 @@ class FiffStreamThread : public QThread
     Q_OBJECT
 
 public:
+    //=========================================================================================================
+    /**
+     * Policy which is applied when a new raw buffer arrives while the client send queue is full. The raw buffers
+     * are handed to all clients from the same thread, hence a slow client never holds up the producer and only
+     * loses its own buffers.
+     */
+    enum QueuePolicy {
+        DropOldest,     /**< Discard the oldest queued raw buffer, keeps the client close to real time. */
+        DropNewest      /**< Discard the incoming raw buffer, keeps the already queued data contiguous. */
+    };
+
     FiffStreamThread(qint32 id, int socketDescriptor, QObject *parent);
 
     ~FiffStreamThread();
@@ -86,23 +98,68 @@ public:
 
     void writeClientId();
 
+    //=========================================================================================================
+    /**
+     * Sets the bound of the raw buffer send queue and the policy applied when it is full.
+     *
+     * @param[in] iMaxQueuedBuffers  Maximal number of raw buffers waiting to be written to the socket.
+     * @param[in] policy             The policy applied when the queue is full.
+     */
+    void setQueuePolicy(int iMaxQueuedBuffers,
+                        QueuePolicy policy);
+
+    //=========================================================================================================
+    /**
+     * Returns the number of raw buffers which were dropped because the client did not keep up.
+     *
+     * @return The number of dropped raw buffers.
+     */
+    qint64 getDroppedBuffers();
+
 //    void sendData(QTcpSocket& p_qTcpSocket);
 
 signals:
     void error(QTcpSocket::SocketError socketError);
 
+    //=========================================================================================================
+    /**
+     * Emitted when blocks were added to an empty send queue. Wakes the client's event loop to write them.
+     */
+    void blocksQueued();
+
+    //=========================================================================================================
+    /**
+     * Emitted by the destructor. Quits the client's event loop through a queued connection.
+     */
+    void stopRequested();
+
 private:
     qint32 m_iDataClientId;
     QString m_sDataClientAlias;
 
     int m_iSocketDescriptor;
 
+    //=========================================================================================================
+    /**
+     * One entry of the send queue. Raw buffers are serialized once by the server and shared (implicitly,
+     * reference counted) between all clients, control tags are serialized per client.
+     */
+    struct SendBlock {
+        QByteArray  data;           /**< The serialized tags. */
+        bool        bIsRawBuffer;   /**< Whether this is a raw buffer, only raw buffers are subject to dropping. */
+    };
+
     QMutex m_qMutex;
-    QByteArray m_qSendBlock;
+    QQueue<SendBlock> m_qSendQueue;
+
+    int m_iQueuedRawBuffers;
+    int m_iMaxQueuedRawBuffers;
+    QueuePolicy m_queuePolicy;
+    qint64 m_iDroppedRawBuffers;
 
     bool m_bIsSendingRawBuffer;
 
-    bool m_bIsRunning;
+    bool m_bStopRequested;
 
     void startMeas(qint32 ID);
 
@@ -110,7 +167,16 @@ private:
 
     void sendMeasurementInfo(qint32 ID, const FIFFLIB::FiffInfo& p_fiffInfo);
 
-    void sendRawBuffer(QSharedPointer<Eigen::MatrixXf> m_pMatRawData);
+    void sendRawBlock(const QByteArray& p_blockRawData);
+
+    void enqueueControlBlock(const QByteArray& p_block);
+
+    bool dequeueBlock(QByteArray& p_block);
+
+    void writeQueuedBlocks(QTcpSocket& p_qTcpSocket);
+
+    void readCommands(QTcpSocket& p_qTcpSocket,
+                      FIFFLIB::FiffStream& p_FiffStreamIn);
     //void readToBuffer1();
 //    void readProc(QTcpSocket& p_qTcpSocket);
 };
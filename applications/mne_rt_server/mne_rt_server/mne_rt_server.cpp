@@ -83,6 +83,7 @@ MNERTServer::MNERTServer()
 
     // fiff stream server
     m_fiffStreamServer.connectCommands();
+    m_fiffStreamServer.readConfig(qApp->applicationDirPath()+"/resources/mne_rt_server_plugins/plugin.cfg");
 
     // command manager
     m_commandServer.registerCommandManager(this->getCommandManager());
@@ -42,6 +42,7 @@
 #include "fiffsimulator.h"
 
 #include <utils/generics/circularmatrixbuffer.h>
+#include <fiff/fiff_raw_segment_reader.h>
 
 //=============================================================================================================
 // QT INCLUDES
@@ -98,6 +99,11 @@ void FiffProducer::run()
     FiffStream::SPtr p_pStream(new FiffStream(&t_File));
     m_pFiffSimulator->m_RawInfo.file = p_pStream;
 
+    //
+    //   Read the samples in single precision straight away, the buffers are streamed once so there is no use in caching them
+    //
+    FiffRawSegmentReader t_reader(m_pFiffSimulator->m_RawInfo, 0);
+
     //
     //   Set up the reading parameters
     //
@@ -118,7 +124,7 @@ void FiffProducer::run()
     //
 
     fiff_int_t first, last;
-    MatrixXd data;
+    MatrixXf data;
     MatrixXd times;
 
     first = from;
@@ -130,9 +136,10 @@ void FiffProducer::run()
 //    for(qint32 i = 0; i < nchan; ++i)
 //        inv_calsMat.insert(i, i) = 1.0f/m_pFiffSimulator->m_RawInfo.info.chs[i].cal;
 
-    //Not good cause production time is not accurate
-    //loading and thread sleep is longer than thread sleep time - better to have a extra loading thread
-    // ToDo restructure this producer as laoding buffer --> and thread sleep to simulator buffer
+    //
+    //   This thread only loads: it decodes ahead until the ring buffer holds m_uiPrefetchBufferCount buffers and then
+    //   blocks on push. The FiffSimulator thread releases the buffers at the sampling rate.
+    //
     fiff_int_t t_iDiff;
     bool t_bRestart = false;
 
@@ -147,15 +154,15 @@ void FiffProducer::run()
             last = to;
         }
 
-        if (!m_pFiffSimulator->m_RawInfo.read_raw_segment(data,times,first,last))
+        if (!t_reader.read_raw_segment(data,times,first,last))
         {
             printf("error during read_raw_segment\n");
         }
 
-        MatrixXf tmp = data.cast<float>();//(inv_calsMat*data).cast<float>();
-
         if(t_bRestart)
         {
+            MatrixXf tmp = data;
+
             //
             // Case end of Simulation: restart file from the beginning and read remaining bytes
             //
@@ -164,19 +171,17 @@ void FiffProducer::run()
             first = from;
             last = first+t_iDiff-1;
 
-            if (!m_pFiffSimulator->m_RawInfo.read_raw_segment(data,times,first,last))
+            if (!t_reader.read_raw_segment(data,times,first,last))
             {
                 printf("error during read_raw_segment\n");
             }
 
-            MatrixXf tmp2 = data.cast<float>();//(inv_calsMat*data).cast<float>();
-
-            MatrixXf tmp3(tmp.rows(), tmp.cols()+tmp2.cols());
+            MatrixXf tmp3(tmp.rows(), tmp.cols()+data.cols());
 
             tmp3.block(0,0,tmp.rows(),tmp.cols()) = tmp;
-            tmp3.block(0,tmp.cols(),tmp.rows(),tmp2.cols()) = tmp2;
+            tmp3.block(0,tmp.cols(),tmp.rows(),data.cols()) = data;
 
-            tmp = tmp3;
+            data = tmp3;
 
             t_bRestart = false;
             first += t_iDiff;
@@ -187,7 +192,7 @@ void FiffProducer::run()
         }
 
         // call blocks until there is free space in the buffer
-        m_pFiffSimulator->m_pRawMatrixBuffer->push(&tmp);
+        m_pFiffSimulator->m_pRawMatrixBuffer->push(&data);
     }
 
     // close datastream in this thread
@@ -54,6 +54,7 @@
 #include <QFile>
 #include <QCoreApplication>
 #include <QDebug>
+#include <QElapsedTimer>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -83,6 +84,7 @@ FiffSimulator::FiffSimulator()
 : m_pFiffProducer(new FiffProducer(this))
 , m_sResourceDataPath(QString("%1/MNE-sample-data/MEG/sample/sample_audvis_raw.fif").arg(QCoreApplication::applicationDirPath()))
 , m_uiBufferSampleSize(100)//(4)
+, m_uiPrefetchBufferCount(RAW_BUFFFER_SIZE)
 , m_AccelerationFactor(1.0)
 , m_TrueSamplingRate(0.0)
 , m_pRawMatrixBuffer(NULL)
@@ -291,9 +293,17 @@ void FiffSimulator::init()
     {
         QTextStream in(&t_qFile);
         QString key = "simFile = ";
+        QString keyPrefetch = "prefetchBuffers = ";
         while (!in.atEnd()) {
             QString line = in.readLine();
-            if(line.contains(key, Qt::CaseInsensitive))
+            if(line.contains(keyPrefetch, Qt::CaseInsensitive))
+            {
+                qint32 idx = line.indexOf(keyPrefetch, 0, Qt::CaseInsensitive) + keyPrefetch.size();
+                quint32 uiPrefetch = line.mid(idx).trimmed().toUInt();
+                if(uiPrefetch > 0)
+                    m_uiPrefetchBufferCount = uiPrefetch;
+            }
+            else if(line.contains(key, Qt::CaseInsensitive))
             {
                 qint32 idx = line.indexOf(key);
                 idx += key.size();
@@ -318,7 +328,7 @@ void FiffSimulator::init()
     m_pRawMatrixBuffer = NULL;
 
     if(!m_RawInfo.isEmpty())
-        m_pRawMatrixBuffer = new RawMatrixBuffer(RAW_BUFFFER_SIZE, m_RawInfo.info.nchan, this->m_uiBufferSampleSize);
+        m_pRawMatrixBuffer = new RawMatrixBuffer(m_uiPrefetchBufferCount, m_RawInfo.info.nchan, this->m_uiBufferSampleSize);
 }
 
 //=============================================================================================================
@@ -464,7 +474,7 @@ bool FiffSimulator::readRawInfo()
         //
         if(m_pRawMatrixBuffer)
             delete m_pRawMatrixBuffer;
-        m_pRawMatrixBuffer = new RawMatrixBuffer(10, m_RawInfo.info.nchan, m_uiBufferSampleSize);
+        m_pRawMatrixBuffer = new RawMatrixBuffer(m_uiPrefetchBufferCount, m_RawInfo.info.nchan, m_uiBufferSampleSize);
 
         mutex.unlock();
     }
@@ -478,20 +488,34 @@ void FiffSimulator::run()
 {
     m_bIsRunning = true;
 
-    float t_fSamplingFrequency = m_RawInfo.info.sfreq;
-    float t_fBuffSampleSize = (float)m_uiBufferSampleSize;
+    //
+    // The FiffProducer keeps m_uiPrefetchBufferCount decoded buffers ready in the ring buffer, this thread only releases
+    // them. Buffers are released on an absolute schedule, so neither the emit nor sleep inaccuracies accumulate drift.
+    // The acceleration factor is already part of the sampling frequency.
+    //
+    double t_dSamplePeriodNs = ((double)m_uiBufferSampleSize / (double)m_RawInfo.info.sfreq) * 1.0e9;
 
-    quint32 uiSamplePeriod = (unsigned int) ((t_fBuffSampleSize/t_fSamplingFrequency)*1000000.0f);
+    QElapsedTimer t_timer;
+    t_timer.start();
 
-//    quint32 count = 0;
+    qint64 t_iBufferCount = 0;
 
     while(m_bIsRunning)
     {
         QSharedPointer<Eigen::MatrixXf> t_pRawBuffer(new Eigen::MatrixXf(m_pRawMatrixBuffer->pop()));
-//        ++count;
-//        printf("%d raw buffer (%d x %d) generated\r\n", count, t_pRawBuffer->rows(), t_pRawBuffer->cols());
+
+        qint64 t_iWaitNs = (qint64)(t_iBufferCount * t_dSamplePeriodNs) - t_timer.nsecsElapsed();
+
+        if(t_iWaitNs > 0) {
+            usleep((unsigned long)(t_iWaitNs / 1000));
+        } else if(-t_iWaitNs > m_uiPrefetchBufferCount * t_dSamplePeriodNs) {
+            //The loader could not keep up for longer than the prefetch depth, restart the schedule instead of bursting
+            printf("FiffSimulator: loader fell behind by %.1f ms, resynchronizing\r\n", -t_iWaitNs / 1.0e6);
+            t_timer.restart();
+            t_iBufferCount = 0;
+        }
 
         emit remitRawBuffer(t_pRawBuffer);
-        usleep(uiSamplePeriod);
+        ++t_iBufferCount;
     }
 }
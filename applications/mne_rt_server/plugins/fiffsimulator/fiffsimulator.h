@@ -183,6 +183,7 @@ private:
     FIFFLIB::FiffRawData        m_RawInfo;              /**< Holds the fiff raw measurement information. */
     QString                     m_sResourceDataPath;    /**< Holds the path to the Fiff resource simulation file directory.*/
     quint32                     m_uiBufferSampleSize;   /**< Sample size of the buffer */
+    quint32                     m_uiPrefetchBufferCount;/**< Number of decoded buffers the producer keeps ready ahead of the emitter. */
     float                       m_AccelerationFactor;   /**< Acceleration factor to simulate different sampling rates. */
     float                       m_TrueSamplingRate;     /**< The true sampling rate of the fif file. */
     bool                        m_bIsRunning;           /**< Flag whether the producer is running.*/
@@ -64,3 +64,10 @@ Measurement::Measurement(int type, QObject *parent)
 Measurement::~Measurement()
 {
 }
+
+//=============================================================================================================
+
+Measurement::SPtr Measurement::snapshot() const
+{
+    return Measurement::SPtr();
+}
@@ -138,6 +138,16 @@ public:
      */
     inline QList<QSharedPointer<QWidget> > getControlWidgets();
 
+    //=========================================================================================================
+    /**
+     * Returns a detached copy of the current state, which stays valid while this measurement is updated further.
+     * Non-blocking plugin connections deliver snapshots instead of the measurement itself. The default
+     * implementation returns a null pointer, such measurements are handed over synchronously.
+     *
+     * @return the snapshot, or a null pointer if the measurement type does not support snapshots.
+     */
+    virtual QSharedPointer<Measurement> snapshot() const;
+
 signals:
     void notify();
 
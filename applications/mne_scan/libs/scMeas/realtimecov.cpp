@@ -105,3 +105,18 @@ void RealTimeCov::setValue(const FiffCov& v)
     emit notify();
 }
 
+//=============================================================================================================
+
+Measurement::SPtr RealTimeCov::snapshot() const
+{
+    RealTimeCov::SPtr pSnapshot(new RealTimeCov);
+    pSnapshot->setName(getName());
+    pSnapshot->setVisibility(isVisible());
+
+    QMutexLocker locker(&m_qMutex);
+    pSnapshot->m_pFiffCov = FiffCov::SPtr(new FiffCov(*m_pFiffCov));
+    pSnapshot->m_pFiffInfo = m_pFiffInfo;
+    pSnapshot->m_bInitialized = m_bInitialized;
+
+    return pSnapshot;
+}
@@ -123,6 +123,14 @@ public:
      */
     virtual FIFFLIB::FiffCov::SPtr& getValue();
 
+    //=========================================================================================================
+    /**
+     * Returns a copy with its own covariance, so the next setValue does not overwrite it.
+     *
+     * @return the snapshot.
+     */
+    virtual QSharedPointer<Measurement> snapshot() const;
+
     //=========================================================================================================
     /**
      * Returns whether RealTimeCov contains values
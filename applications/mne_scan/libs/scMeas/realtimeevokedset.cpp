@@ -164,3 +164,23 @@ void RealTimeEvokedSet::setValue(const FiffEvokedSet &v,
 }
 
 //=============================================================================================================
+
+Measurement::SPtr RealTimeEvokedSet::snapshot() const
+{
+    RealTimeEvokedSet::SPtr pSnapshot(new RealTimeEvokedSet);
+    pSnapshot->setName(getName());
+    pSnapshot->setVisibility(isVisible());
+
+    QMutexLocker locker(&m_qMutex);
+    pSnapshot->m_pFiffEvokedSet = FiffEvokedSet::SPtr(new FiffEvokedSet(*m_pFiffEvokedSet));
+    pSnapshot->m_lResponsibleTriggerTypes = m_lResponsibleTriggerTypes;
+    pSnapshot->m_pFiffInfo = m_pFiffInfo;
+    pSnapshot->m_sXMLLayoutFile = m_sXMLLayoutFile;
+    pSnapshot->m_iPreStimSamples = m_iPreStimSamples;
+    pSnapshot->m_qListChColors = m_qListChColors;
+    pSnapshot->m_qListChInfo = m_qListChInfo;
+    pSnapshot->m_bInitialized = m_bInitialized;
+    pSnapshot->m_pairBaseline = m_pairBaseline;
+
+    return pSnapshot;
+}
@@ -186,6 +186,14 @@ public:
      */
     virtual FIFFLIB::FiffEvokedSet::SPtr& getValue();
 
+    //=========================================================================================================
+    /**
+     * Returns a copy with its own evoked set, so the next setValue does not overwrite it.
+     *
+     * @return the snapshot.
+     */
+    virtual QSharedPointer<Measurement> snapshot() const;
+
     //=========================================================================================================
     /**
      * Returns the trigger types which lead to the emit of this evoked set.
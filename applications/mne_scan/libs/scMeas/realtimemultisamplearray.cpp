@@ -64,6 +64,7 @@ RealTimeMultiSampleArray::RealTimeMultiSampleArray(QObject *parent)
 , m_dSamplingRate(0)
 , m_iMultiArraySize(10)
 , m_bChInfoIsInit(false)
+, m_pSampleBlockPool(SampleBlockPool::SPtr(new SampleBlockPool))
 {
     m_slDisplayFlag << "compensators" << "projections" << "filter" << "view" << "triggerdetection" << "scaling" << "sphara" << "colors";
 }
@@ -229,13 +230,26 @@ void RealTimeMultiSampleArray::initFromFiffInfo(FiffInfo::SPtr &p_pFiffInfo)
 //=============================================================================================================
 
 void RealTimeMultiSampleArray::setValue(const MatrixXd& mat)
+{
+    if(!m_bChInfoIsInit)
+        return;
+
+    SampleBlockPool::Block pBlock = m_pSampleBlockPool->acquire(mat.rows(), mat.cols());
+    *pBlock = mat;
+
+    setValue(pBlock);
+}
+
+//=============================================================================================================
+
+void RealTimeMultiSampleArray::setValue(const SampleBlockPool::ConstBlock& pBlock)
 {
     if(!m_bChInfoIsInit)
         return;
 
     m_qMutex.lock();
     //check vector size
-    if(mat.rows() != m_qListChInfo.size())
+    if(pBlock->rows() != m_qListChInfo.size())
         qCritical() << "Error Occured in RealTimeMultiSampleArrayNew::setVector: Vector size does not match the number of channels! ";
 
     //ToDo
@@ -247,15 +261,53 @@ void RealTimeMultiSampleArray::setValue(const MatrixXd& mat)
 //    }
 
     //Store
-    m_matSamples.push_back(mat);
+    m_lSampleBlocks.push_back(pBlock);
+    m_matSamples.clear();
 
+    bool bNotify = m_lSampleBlocks.size() >= m_iMultiArraySize;
     m_qMutex.unlock();
-    if(m_matSamples.size() >= m_iMultiArraySize)
+
+    if(bNotify)
     {
         emit notify();
-        m_qMutex.lock();
+        clear();
+    }
+}
+
+//=============================================================================================================
+
+const QList<MatrixXd>& RealTimeMultiSampleArray::getMultiSampleArray()
+{
+    QMutexLocker locker(&m_qMutex);
+
+    if(m_matSamples.size() != m_lSampleBlocks.size()) {
         m_matSamples.clear();
-        m_qMutex.unlock();
+        for(int i = 0; i < m_lSampleBlocks.size(); ++i) {
+            m_matSamples.append(*m_lSampleBlocks.at(i));
+        }
     }
+
+    return m_matSamples;
 }
 
+//=============================================================================================================
+
+Measurement::SPtr RealTimeMultiSampleArray::snapshot() const
+{
+    RealTimeMultiSampleArray::SPtr pSnapshot(new RealTimeMultiSampleArray);
+    pSnapshot->setName(getName());
+    pSnapshot->setVisibility(isVisible());
+
+    QMutexLocker locker(&m_qMutex);
+    pSnapshot->m_pFiffInfo_orig = m_pFiffInfo_orig;
+    pSnapshot->m_slDisplayFlag = m_slDisplayFlag;
+    pSnapshot->m_sXMLLayoutFile = m_sXMLLayoutFile;
+    pSnapshot->m_dSamplingRate = m_dSamplingRate;
+    pSnapshot->m_iMultiArraySize = m_iMultiArraySize;
+    pSnapshot->m_lSampleBlocks = m_lSampleBlocks;
+    pSnapshot->m_pSampleBlockPool = m_pSampleBlockPool;
+    pSnapshot->m_bChInfoIsInit = m_bChInfoIsInit;
+    pSnapshot->m_qListChInfo = m_qListChInfo;
+
+    return pSnapshot;
+}
@@ -43,6 +43,7 @@
 #include "scmeas_global.h"
 #include "measurement.h"
 #include "realtimesamplearraychinfo.h"
+#include "sampleblockpool.h"
 
 #include <fiff/fiff_info.h>
 
@@ -209,20 +210,60 @@ public:
 
     //=========================================================================================================
     /**
-     * Returns the gathered multi sample array.
+     * Returns the gathered multi sample array. The matrices are copied out of the sample blocks on the first call
+     * after a notification, consumers which only read the data should use getMultiSampleBlocks() instead.
      *
      * @return the current multi sample array.
      */
-    inline const QList<Eigen::MatrixXd>& getMultiSampleArray();
+    const QList<Eigen::MatrixXd>& getMultiSampleArray();
 
     //=========================================================================================================
     /**
-     * Attaches a value to the sample array list.
+     * Returns the gathered sample blocks. The blocks are immutable and reference counted, holding on to them after
+     * the notification does not copy any sample data.
+     *
+     * @return the current sample blocks.
+     */
+    inline QList<SampleBlockPool::ConstBlock> getMultiSampleBlocks() const;
+
+    //=========================================================================================================
+    /**
+     * Returns a writable block from the sample block pool of this measurement. Producers can fill the block in place
+     * and attach it with setValue(const SampleBlockPool::ConstBlock&).
+     *
+     * @param [in] iRows     the number of rows (channels).
+     * @param [in] iCols     the number of columns (samples).
+     *
+     * @return the block.
+     */
+    inline SampleBlockPool::Block acquireBlock(int iRows,
+                                               int iCols);
+
+    //=========================================================================================================
+    /**
+     * Attaches a value to the sample array list. The value is copied into a pooled sample block.
      *
      * @param [in] mat   the value which is attached to the sample array list.
      */
     virtual void setValue(const Eigen::MatrixXd& mat);
 
+    //=========================================================================================================
+    /**
+     * Attaches a sample block to the sample array list without copying it. The block must not be modified afterwards.
+     *
+     * @param [in] pBlock    the block which is attached to the sample array list.
+     */
+    void setValue(const SampleBlockPool::ConstBlock& pBlock);
+
+    //=========================================================================================================
+    /**
+     * Returns a copy which holds the sample blocks of the current notification. The blocks are shared with this
+     * measurement, so taking the snapshot does not copy sample data.
+     *
+     * @return the snapshot.
+     */
+    virtual QSharedPointer<Measurement> snapshot() const;
+
 private:
     mutable QMutex              m_qMutex;           /**< Mutex to ensure thread safety */
 
@@ -232,7 +273,9 @@ private:
     QString                     m_sXMLLayoutFile;   /**< Layout file name. */
     double                      m_dSamplingRate;    /**< Sampling rate of the RealTimeSampleArray.*/
     qint32                      m_iMultiArraySize;  /**< Sample size of the multi sample array.*/
-    QList<Eigen::MatrixXd>      m_matSamples;       /**< The multi sample array.*/
+    QList<SampleBlockPool::ConstBlock> m_lSampleBlocks; /**< The multi sample array as shared sample blocks.*/
+    QList<Eigen::MatrixXd>      m_matSamples;       /**< The multi sample array copied out of the sample blocks on request.*/
+    SampleBlockPool::SPtr       m_pSampleBlockPool; /**< The pool the sample blocks are taken from.*/
     bool                        m_bChInfoIsInit;    /**< If channel info is initialized.*/
 
     QList<RealTimeSampleArrayChInfo> m_qListChInfo; /**< Channel info list.*/
@@ -245,6 +288,7 @@ private:
 inline void RealTimeMultiSampleArray::clear()
 {
     QMutexLocker locker(&m_qMutex);
+    m_lSampleBlocks.clear();
     m_matSamples.clear();
 }
 
@@ -350,9 +394,18 @@ qint32 RealTimeMultiSampleArray::getMultiArraySize() const
 
 //=============================================================================================================
 
-inline const QList<Eigen::MatrixXd>& RealTimeMultiSampleArray::getMultiSampleArray()
+inline QList<SampleBlockPool::ConstBlock> RealTimeMultiSampleArray::getMultiSampleBlocks() const
+{
+    QMutexLocker locker(&m_qMutex);
+    return m_lSampleBlocks;
+}
+
+//=============================================================================================================
+
+inline SampleBlockPool::Block RealTimeMultiSampleArray::acquireBlock(int iRows,
+                                                                     int iCols)
 {
-    return m_matSamples;
+    return m_pSampleBlockPool->acquire(iRows, iCols);
 }
 } // NAMESPACE
 
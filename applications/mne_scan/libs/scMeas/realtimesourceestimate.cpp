@@ -102,3 +102,22 @@ void RealTimeSourceEstimate::setValue(MNESourceEstimate& v)
     }
 }
 
+//=============================================================================================================
+
+Measurement::SPtr RealTimeSourceEstimate::snapshot() const
+{
+    RealTimeSourceEstimate::SPtr pSnapshot(new RealTimeSourceEstimate);
+    pSnapshot->setName(getName());
+    pSnapshot->setVisibility(isVisible());
+
+    QMutexLocker locker(&m_qMutex);
+    pSnapshot->m_pFiffInfo = m_pFiffInfo;
+    pSnapshot->m_pAnnotSet = m_pAnnotSet;
+    pSnapshot->m_pSurfSet = m_pSurfSet;
+    pSnapshot->m_pFwdSolution = m_pFwdSolution;
+    pSnapshot->m_iSourceEstimateSize = m_iSourceEstimateSize;
+    pSnapshot->m_pMNEStc = m_pMNEStc;
+    pSnapshot->m_bInitialized = m_bInitialized;
+
+    return pSnapshot;
+}
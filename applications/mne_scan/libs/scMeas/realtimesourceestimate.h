@@ -160,6 +160,14 @@ public:
      */
     virtual QList<MNELIB::MNESourceEstimate::SPtr>& getValue();
 
+    //=========================================================================================================
+    /**
+     * Returns a copy which holds the source estimates of the current notification.
+     *
+     * @return the snapshot.
+     */
+    virtual QSharedPointer<Measurement> snapshot() const;
+
     //=========================================================================================================
     /**
      * Returns whether RealTimeSourceEstimate contains values
@@ -0,0 +1,127 @@
+//=============================================================================================================
+/**
+ * @file     sampleblockpool.cpp
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the SampleBlockPool class.
+ *
+ */
+
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "sampleblockpool.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QWeakPointer>
+#include <QMutexLocker>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace SCMEASLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+SampleBlockPool::SampleBlockPool(int iMaxFreeBlocks)
+: m_iRows(0)
+, m_iCols(0)
+, m_iMaxFreeBlocks(iMaxFreeBlocks)
+{
+}
+
+//=============================================================================================================
+
+SampleBlockPool::~SampleBlockPool()
+{
+    qDeleteAll(m_vecFreeBlocks);
+}
+
+//=============================================================================================================
+
+SampleBlockPool::Block SampleBlockPool::acquire(int iRows,
+                                                int iCols)
+{
+    MatrixXd* pBlock = Q_NULLPTR;
+
+    m_qMutex.lock();
+    if(iRows != m_iRows || iCols != m_iCols) {
+        qDeleteAll(m_vecFreeBlocks);
+        m_vecFreeBlocks.clear();
+        m_iRows = iRows;
+        m_iCols = iCols;
+    } else if(!m_vecFreeBlocks.isEmpty()) {
+        pBlock = m_vecFreeBlocks.takeLast();
+    }
+    m_qMutex.unlock();
+
+    if(!pBlock) {
+        pBlock = new MatrixXd(iRows, iCols);
+    }
+
+    //Blocks can outlive the pool, hand them back only while it exists
+    QWeakPointer<SampleBlockPool> wpPool = sharedFromThis();
+
+    return Block(pBlock, [wpPool](MatrixXd* pReleased) {
+        if(SampleBlockPool::SPtr pPool = wpPool.toStrongRef()) {
+            pPool->recycle(pReleased);
+        } else {
+            delete pReleased;
+        }
+    });
+}
+
+//=============================================================================================================
+
+int SampleBlockPool::freeBlocks() const
+{
+    QMutexLocker locker(&m_qMutex);
+    return m_vecFreeBlocks.size();
+}
+
+//=============================================================================================================
+
+void SampleBlockPool::recycle(MatrixXd* pBlock)
+{
+    QMutexLocker locker(&m_qMutex);
+
+    if(pBlock->rows() == m_iRows && pBlock->cols() == m_iCols && m_vecFreeBlocks.size() < m_iMaxFreeBlocks) {
+        m_vecFreeBlocks.append(pBlock);
+    } else {
+        delete pBlock;
+    }
+}
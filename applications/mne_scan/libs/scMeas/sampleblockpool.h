@@ -0,0 +1,135 @@
+//=============================================================================================================
+/**
+ * @file     sampleblockpool.h
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Contains the declaration of the SampleBlockPool class.
+ *
+ */
+
+#ifndef SAMPLEBLOCKPOOL_H
+#define SAMPLEBLOCKPOOL_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "scmeas_global.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QSharedPointer>
+#include <QEnableSharedFromThis>
+#include <QVector>
+#include <QMutex>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// DEFINE NAMESPACE SCMEASLIB
+//=============================================================================================================
+
+namespace SCMEASLIB
+{
+
+//=========================================================================================================
+/**
+ * The SampleBlockPool hands out reference counted sample matrices of one block shape. Blocks which are no longer
+ * referenced by any measurement or consumer return to the pool instead of being freed, so a stream with a constant
+ * block shape stops allocating after the first few blocks. The pool has to be owned by a SPtr.
+ *
+ * @brief The SampleBlockPool class recycles sample matrices of a fixed shape.
+ */
+class SCMEASSHARED_EXPORT SampleBlockPool : public QEnableSharedFromThis<SampleBlockPool>
+{
+public:
+    typedef QSharedPointer<SampleBlockPool> SPtr;                   /**< Shared pointer type for SampleBlockPool. */
+    typedef QSharedPointer<const SampleBlockPool> ConstSPtr;        /**< Const shared pointer type for SampleBlockPool. */
+
+    typedef QSharedPointer<Eigen::MatrixXd> Block;                  /**< A writable sample block. */
+    typedef QSharedPointer<const Eigen::MatrixXd> ConstBlock;       /**< An immutable sample block. */
+
+    //=========================================================================================================
+    /**
+     * Constructs a SampleBlockPool.
+     *
+     * @param [in] iMaxFreeBlocks    the maximal number of unused blocks kept for reuse.
+     */
+    explicit SampleBlockPool(int iMaxFreeBlocks = 32);
+
+    //=========================================================================================================
+    /**
+     * Destroys the SampleBlockPool. Blocks which are still referenced stay valid and are freed on release.
+     */
+    ~SampleBlockPool();
+
+    //=========================================================================================================
+    /**
+     * Returns a block of the given shape. The content of the block is undefined. A change of the shape discards
+     * all unused blocks of the previous shape.
+     *
+     * @param [in] iRows     the number of rows (channels).
+     * @param [in] iCols     the number of columns (samples).
+     *
+     * @return the block.
+     */
+    Block acquire(int iRows,
+                  int iCols);
+
+    //=========================================================================================================
+    /**
+     * Returns the number of unused blocks which are ready for reuse.
+     *
+     * @return the number of unused blocks.
+     */
+    int freeBlocks() const;
+
+private:
+    //=========================================================================================================
+    /**
+     * Takes a released block back or frees it if it does not fit the current shape or the pool is full.
+     *
+     * @param [in] pBlock    the released block.
+     */
+    void recycle(Eigen::MatrixXd* pBlock);
+
+    mutable QMutex                  m_qMutex;           /**< Guards the free list. */
+    QVector<Eigen::MatrixXd*>       m_vecFreeBlocks;    /**< The unused blocks. */
+    int                             m_iRows;            /**< The rows of the current block shape. */
+    int                             m_iCols;            /**< The columns of the current block shape. */
+    int                             m_iMaxFreeBlocks;   /**< The maximal number of unused blocks. */
+};
+} // NAMESPACE
+
+#endif // SAMPLEBLOCKPOOL_H
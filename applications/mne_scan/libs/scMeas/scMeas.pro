@@ -75,6 +75,7 @@ SOURCES += \
     realtimeconnectivityestimate.cpp \
     realtimesamplearray.cpp \
     realtimemultisamplearray.cpp \
+    sampleblockpool.cpp \
     realtimesamplearraychinfo.cpp \
     numeric.cpp \
     measurement.cpp \
@@ -89,6 +90,7 @@ HEADERS += \
     realtimeconnectivityestimate.h \
     realtimesamplearray.h \
     realtimemultisamplearray.h \
+    sampleblockpool.h \
     realtimesamplearraychinfo.h \
     numeric.h \
     measurement.h \
@@ -62,6 +62,8 @@ PluginConnectorConnection::PluginConnectorConnection(IPlugin::SPtr sender, IPlug
 : QObject(parent)
 , m_pSender(sender)
 , m_pReceiver(receiver)
+, m_policy(DropOldest)
+, m_iMaxQueueSize(32)
 {
     createConnection();
 }
@@ -82,6 +84,38 @@ void PluginConnectorConnection::clearConnection()
         disconnect(it.value());
 
     m_qHashConnections.clear();
+
+    QHash<QPair<QString, QString>, PluginConnectorEdge::SPtr>::iterator itEdge;
+    for (itEdge = m_qHashEdges.begin(); itEdge != m_qHashEdges.end(); ++itEdge)
+        itEdge.value()->release();
+
+    m_qHashEdges.clear();
+}
+
+//=============================================================================================================
+
+void PluginConnectorConnection::setPolicy(ConnectionPolicy policy,
+                                          int iMaxQueueSize)
+{
+    m_policy = policy;
+    m_iMaxQueueSize = iMaxQueueSize;
+
+    QHash<QPair<QString, QString>, PluginConnectorEdge::SPtr>::iterator it;
+    for (it = m_qHashEdges.begin(); it != m_qHashEdges.end(); ++it)
+        it.value()->setPolicy(m_policy, m_iMaxQueueSize);
+}
+
+//=============================================================================================================
+
+QHash<QPair<QString, QString>, EdgeStatistics> PluginConnectorConnection::getStatistics() const
+{
+    QHash<QPair<QString, QString>, EdgeStatistics> qHashStatistics;
+
+    QHash<QPair<QString, QString>, PluginConnectorEdge::SPtr>::const_iterator it;
+    for (it = m_qHashEdges.constBegin(); it != m_qHashEdges.constEnd(); ++it)
+        qHashStatistics.insert(it.key(), it.value()->getStatistics());
+
+    return qHashStatistics;
 }
 
 //=============================================================================================================
@@ -107,8 +141,7 @@ bool PluginConnectorConnection::createConnection()
             QSharedPointer< PluginInputData<RealTimeSampleArray> > receiverRTSA = m_pReceiver->getInputConnectors()[j].dynamicCast< PluginInputData<RealTimeSampleArray> >();
             if(senderRTSA && receiverRTSA)
             {
-                m_qHashConnections.insert(QPair<QString,QString>(m_pSender->getOutputConnectors()[i]->getName(), m_pReceiver->getInputConnectors()[j]->getName()), connect(m_pSender->getOutputConnectors()[i].data(), &PluginOutputConnector::notify,
-                        m_pReceiver->getInputConnectors()[j].data(), &PluginInputConnector::update, Qt::BlockingQueuedConnection));
+                connectEdge(m_pSender->getOutputConnectors()[i], m_pReceiver->getInputConnectors()[j]);
                 bConnected = true;
                 break;
             }
@@ -118,8 +151,7 @@ bool PluginConnectorConnection::createConnection()
             QSharedPointer< PluginInputData<RealTimeMultiSampleArray> > receiverRTMSA = m_pReceiver->getInputConnectors()[j].dynamicCast< PluginInputData<RealTimeMultiSampleArray> >();
             if(senderRTMSA && receiverRTMSA)
             {
-                m_qHashConnections.insert(QPair<QString,QString>(m_pSender->getOutputConnectors()[i]->getName(), m_pReceiver->getInputConnectors()[j]->getName()), connect(m_pSender->getOutputConnectors()[i].data(), &PluginOutputConnector::notify,
-                        m_pReceiver->getInputConnectors()[j].data(), &PluginInputConnector::update, Qt::BlockingQueuedConnection));
+                connectEdge(m_pSender->getOutputConnectors()[i], m_pReceiver->getInputConnectors()[j]);
                 bConnected = true;
                 break;
             }
@@ -129,8 +161,7 @@ bool PluginConnectorConnection::createConnection()
             QSharedPointer< PluginInputData<RealTimeEvokedSet> > receiverRTESet = m_pReceiver->getInputConnectors()[j].dynamicCast< PluginInputData<RealTimeEvokedSet> >();
             if(senderRTESet && receiverRTESet)
             {
-                m_qHashConnections.insert(QPair<QString,QString>(m_pSender->getOutputConnectors()[i]->getName(), m_pReceiver->getInputConnectors()[j]->getName()), connect(m_pSender->getOutputConnectors()[i].data(), &PluginOutputConnector::notify,
-                        m_pReceiver->getInputConnectors()[j].data(), &PluginInputConnector::update, Qt::BlockingQueuedConnection));
+                connectEdge(m_pSender->getOutputConnectors()[i], m_pReceiver->getInputConnectors()[j]);
                 bConnected = true;
                 break;
             }
@@ -140,8 +171,7 @@ bool PluginConnectorConnection::createConnection()
             QSharedPointer< PluginInputData<RealTimeCov> > receiverRTC = m_pReceiver->getInputConnectors()[j].dynamicCast< PluginInputData<RealTimeCov> >();
             if(senderRTC && receiverRTC)
             {
-                m_qHashConnections.insert(QPair<QString,QString>(m_pSender->getOutputConnectors()[i]->getName(), m_pReceiver->getInputConnectors()[j]->getName()), connect(m_pSender->getOutputConnectors()[i].data(), &PluginOutputConnector::notify,
-                        m_pReceiver->getInputConnectors()[j].data(), &PluginInputConnector::update, Qt::BlockingQueuedConnection));
+                connectEdge(m_pSender->getOutputConnectors()[i], m_pReceiver->getInputConnectors()[j]);
                 bConnected = true;
                 break;
             }
@@ -151,8 +181,7 @@ bool PluginConnectorConnection::createConnection()
             QSharedPointer< PluginInputData<RealTimeSourceEstimate> > receiverRTSE = m_pReceiver->getInputConnectors()[j].dynamicCast< PluginInputData<RealTimeSourceEstimate> >();
             if(senderRTSE && receiverRTSE)
             {
-                m_qHashConnections.insert(QPair<QString,QString>(m_pSender->getOutputConnectors()[i]->getName(), m_pReceiver->getInputConnectors()[j]->getName()), connect(m_pSender->getOutputConnectors()[i].data(), &PluginOutputConnector::notify,
-                        m_pReceiver->getInputConnectors()[j].data(), &PluginInputConnector::update, Qt::BlockingQueuedConnection));
+                connectEdge(m_pSender->getOutputConnectors()[i], m_pReceiver->getInputConnectors()[j]);
                 bConnected = true;
                 break;
             }
@@ -173,6 +202,47 @@ bool PluginConnectorConnection::createConnection()
 
 //=============================================================================================================
 
+void PluginConnectorConnection::connectEdge(QSharedPointer<PluginOutputConnector> pOutputConnector,
+                                            QSharedPointer<PluginInputConnector> pInputConnector)
+{
+    QPair<QString,QString> pairConnectors(pOutputConnector->getName(), pInputConnector->getName());
+
+    disconnectEdge(pairConnectors);
+
+    //The edge lives in the receiver thread, delete it there once pending deliveries were processed
+    PluginConnectorEdge::SPtr pEdge(new PluginConnectorEdge(pInputConnector.data(), m_policy, m_iMaxQueueSize), &QObject::deleteLater);
+
+    //The sender thread calls push() directly and may still be inside it when the edge is disconnected here. Hand it
+    //a strong reference for the duration of the call, so the edge outlives a push which is in flight.
+    QWeakPointer<PluginConnectorEdge> wpEdge = pEdge.toWeakRef();
+
+    m_qHashEdges.insert(pairConnectors, pEdge);
+    m_qHashConnections.insert(pairConnectors, connect(pOutputConnector.data(), &PluginOutputConnector::notify,
+                                                      pEdge.data(), [wpEdge](SCMEASLIB::Measurement::SPtr pMeasurement) {
+                                                          if(PluginConnectorEdge::SPtr pEdge = wpEdge.toStrongRef()) {
+                                                              pEdge->push(pMeasurement);
+                                                          }
+                                                      }, Qt::DirectConnection));
+}
+
+//=============================================================================================================
+
+void PluginConnectorConnection::disconnectEdge(const QPair<QString, QString>& pairConnectors)
+{
+    if(m_qHashConnections.contains(pairConnectors)) {
+        disconnect(m_qHashConnections[pairConnectors]);
+        m_qHashConnections.remove(pairConnectors);
+    }
+
+    //Waits for a push which is still running in the sender thread
+    if(m_qHashEdges.contains(pairConnectors)) {
+        m_qHashEdges[pairConnectors]->release();
+        m_qHashEdges.remove(pairConnectors);
+    }
+}
+
+//=============================================================================================================
+
 ConnectorDataType PluginConnectorConnection::getDataType(QSharedPointer<PluginConnector> pPluginConnector)
 {
     QSharedPointer< PluginOutputData<SCMEASLIB::RealTimeSampleArray> > RTSA_Out = pPluginConnector.dynamicCast< PluginOutputData<SCMEASLIB::RealTimeSampleArray> >();
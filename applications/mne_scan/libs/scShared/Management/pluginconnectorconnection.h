@@ -44,6 +44,7 @@
 
 #include "plugininputconnector.h"
 #include "pluginoutputconnector.h"
+#include "pluginconnectoredge.h"
 
 //=============================================================================================================
 // QT INCLUDES
@@ -52,6 +53,8 @@
 #include <QObject>
 #include <QMetaObject>
 #include <QSharedPointer>
+#include <QHash>
+#include <QPair>
 
 //=============================================================================================================
 // DEFINE NAMESPACE SCSHAREDLIB
@@ -127,6 +130,25 @@ public:
      */
     QWidget* setupWidget();
 
+    //=========================================================================================================
+    /**
+     * Sets the queue policy of all current and future connector connections. Measurement types which do not
+     * support snapshots are always delivered blocking.
+     *
+     * @param[in] policy         The queue policy.
+     * @param[in] iMaxQueueSize  The maximal number of measurements queued per connector connection.
+     */
+    void setPolicy(ConnectionPolicy policy,
+                   int iMaxQueueSize);
+
+    //=========================================================================================================
+    /**
+     * Returns the queue depth, drop and latency counters of the connector connections.
+     *
+     * @return the counters per QPair<Sender,Receiver> connector name.
+     */
+    QHash<QPair<QString, QString>, EdgeStatistics> getStatistics() const;
+
 signals:
     
 private:
@@ -136,10 +158,32 @@ private:
      */
     bool createConnection();
 
+    //=========================================================================================================
+    /**
+     * Connects an output connector to an input connector through a queued edge.
+     *
+     * @param[in] pOutputConnector   The sending output connector.
+     * @param[in] pInputConnector    The receiving input connector.
+     */
+    void connectEdge(QSharedPointer<PluginOutputConnector> pOutputConnector,
+                     QSharedPointer<PluginInputConnector> pInputConnector);
+
+    //=========================================================================================================
+    /**
+     * Disconnects and removes the edge between the named connectors.
+     *
+     * @param[in] pairConnectors     The QPair<Sender,Receiver> connector name.
+     */
+    void disconnectEdge(const QPair<QString, QString>& pairConnectors);
+
     IPlugin::SPtr m_pSender;
     IPlugin::SPtr m_pReceiver;
 
     QHash<QPair<QString, QString>, QMetaObject::Connection> m_qHashConnections; /**< QHash which holds the connections between sender and receiver QHash<QPair<Sender,Receiver>, Connection>. */
+    QHash<QPair<QString, QString>, PluginConnectorEdge::SPtr> m_qHashEdges;       /**< QHash which holds the queues of the connections QHash<QPair<Sender,Receiver>, Edge>. */
+
+    ConnectionPolicy    m_policy;           /**< The queue policy of the connections. */
+    int                 m_iMaxQueueSize;    /**< The maximal number of queued measurements per connection. */
 };
 
 //=============================================================================================================
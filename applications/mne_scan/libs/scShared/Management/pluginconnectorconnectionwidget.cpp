@@ -163,10 +163,8 @@ void PluginConnectorConnectionWidget::updateReceiver(const QString &p_sCurrentRe
                 if(m_pPluginConnectorConnection->m_pReceiver->getInputConnectors()[j]->getName() == p_sCurrentReceiver)
                     break;
 
-            m_pPluginConnectorConnection->m_qHashConnections.insert(QPair<QString,QString>(m_pPluginConnectorConnection->m_pSender->getOutputConnectors()[i]->getName(),
-                                                                                           m_pPluginConnectorConnection->m_pReceiver->getInputConnectors()[j]->getName()),
-                                                                    connect(m_pPluginConnectorConnection->m_pSender->getOutputConnectors()[i].data(), &PluginOutputConnector::notify,
-                                                                            m_pPluginConnectorConnection->m_pReceiver->getInputConnectors()[j].data(), &PluginInputConnector::update, Qt::BlockingQueuedConnection));
+            m_pPluginConnectorConnection->connectEdge(m_pPluginConnectorConnection->m_pSender->getOutputConnectors()[i],
+                                                      m_pPluginConnectorConnection->m_pReceiver->getInputConnectors()[j]);
         }
     }
 
@@ -176,8 +174,7 @@ void PluginConnectorConnectionWidget::updateReceiver(const QString &p_sCurrentRe
         if(it.value() != t_qComboBox && it.value()->currentText() == p_sCurrentReceiver)
         {
             QPair<QString, QString> t_qPair(it.key(),it.value()->currentText());
-            disconnect(m_pPluginConnectorConnection->m_qHashConnections[t_qPair]);
-            m_pPluginConnectorConnection->m_qHashConnections.remove(t_qPair);
+            m_pPluginConnectorConnection->disconnectEdge(t_qPair);
             it.value()->setCurrentIndex(0);
         }
     }
@@ -0,0 +1,252 @@
+//=============================================================================================================
+/**
+ * @file     pluginconnectoredge.cpp
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the PluginConnectorEdge class.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "pluginconnectoredge.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QMetaObject>
+#include <QThread>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace SCSHAREDLIB;
+using namespace SCMEASLIB;
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+PluginConnectorEdge::PluginConnectorEdge(PluginInputConnector* pInputConnector,
+                                         ConnectionPolicy policy,
+                                         int iMaxQueueSize)
+: QObject()
+, m_pInputConnector(pInputConnector)
+, m_policy(policy)
+, m_iMaxQueueSize(qMax(1, iMaxQueueSize))
+, m_iTimeoutMs(100)
+, m_bDeliveryPending(false)
+, m_bReleased(false)
+, m_iDelivered(0)
+, m_iDropped(0)
+, m_iMaxQueueDepth(0)
+, m_dSumLatencyMs(0.0)
+, m_dMaxLatencyMs(0.0)
+{
+    m_clock.start();
+
+    if(pInputConnector) {
+        moveToThread(pInputConnector->thread());
+    }
+}
+
+//=============================================================================================================
+
+PluginConnectorEdge::~PluginConnectorEdge()
+{
+    release();
+}
+
+//=============================================================================================================
+
+void PluginConnectorEdge::setPolicy(ConnectionPolicy policy,
+                                    int iMaxQueueSize,
+                                    int iTimeoutMs)
+{
+    QMutexLocker locker(&m_qMutex);
+    m_policy = policy;
+    m_iMaxQueueSize = qMax(1, iMaxQueueSize);
+    m_iTimeoutMs = qMax(0, iTimeoutMs);
+
+    while(m_qQueue.size() > m_iMaxQueueSize) {
+        dropOldest();
+    }
+
+    m_qQueueNotFull.wakeAll();
+}
+
+//=============================================================================================================
+
+EdgeStatistics PluginConnectorEdge::getStatistics() const
+{
+    QMutexLocker locker(&m_qMutex);
+
+    EdgeStatistics statistics;
+    statistics.iDelivered = m_iDelivered;
+    statistics.iDropped = m_iDropped;
+    statistics.iQueueDepth = m_qQueue.size();
+    statistics.iMaxQueueDepth = m_iMaxQueueDepth;
+    statistics.dMeanLatencyMs = m_iDelivered > 0 ? m_dSumLatencyMs / m_iDelivered : 0.0;
+    statistics.dMaxLatencyMs = m_dMaxLatencyMs;
+
+    return statistics;
+}
+
+//=============================================================================================================
+
+void PluginConnectorEdge::push(Measurement::SPtr pMeasurement)
+{
+    //The sender thread may still be inside this call while the edge is disconnected, release() waits for it
+    QMutexLocker pushLocker(&m_qPushMutex);
+
+    //setPolicy may run concurrently. A policy change between here and the enqueue below only affects this
+    //measurement's way of delivery, which is fine either way.
+    m_qMutex.lock();
+    bool bReleased = m_bReleased;
+    ConnectionPolicy policy = m_policy;
+    m_qMutex.unlock();
+
+    if(bReleased || !m_pInputConnector) {
+        return;
+    }
+
+    Measurement::SPtr pSnapshot;
+    if(policy != Blocking) {
+        pSnapshot = pMeasurement->snapshot();
+    }
+
+    if(!pSnapshot) {
+        QPointer<PluginInputConnector> pInputConnector = m_pInputConnector;
+        Qt::ConnectionType type = pInputConnector->thread() == QThread::currentThread() ? Qt::DirectConnection : Qt::BlockingQueuedConnection;
+
+        //The edge is not used below. Let go of it, so that release() called from the receiver thread does not wait
+        //for the blocking delivery.
+        pushLocker.unlock();
+
+        //The measurement is overwritten as soon as this call returns, hand it over before that
+        if(pInputConnector) {
+            QMetaObject::invokeMethod(pInputConnector.data(),
+                                      "update",
+                                      type,
+                                      Q_ARG(SCMEASLIB::Measurement::SPtr, pMeasurement));
+        }
+        return;
+    }
+
+    m_qMutex.lock();
+
+    if(m_policy == Coalesce) {
+        while(!m_qQueue.isEmpty()) {
+            dropOldest();
+        }
+    } else if(m_qQueue.size() >= m_iMaxQueueSize) {
+        if(m_policy == Backpressure && m_iTimeoutMs > 0) {
+            QElapsedTimer timer;
+            timer.start();
+            while(m_qQueue.size() >= m_iMaxQueueSize && !m_bReleased && timer.elapsed() < m_iTimeoutMs) {
+                m_qQueueNotFull.wait(&m_qMutex, m_iTimeoutMs - timer.elapsed());
+            }
+        }
+
+        //Never stall the sender for longer than the timeout, lose the oldest data of this edge instead
+        while(m_qQueue.size() >= m_iMaxQueueSize) {
+            dropOldest();
+        }
+    }
+
+    //The edge may have been released while the sender waited for free space
+    if(m_bReleased) {
+        m_qMutex.unlock();
+        return;
+    }
+
+    m_qQueue.enqueue(qMakePair(pSnapshot, m_clock.nsecsElapsed()));
+    m_iMaxQueueDepth = qMax(m_iMaxQueueDepth, m_qQueue.size());
+
+    bool bSchedule = !m_bDeliveryPending;
+    m_bDeliveryPending = true;
+
+    m_qMutex.unlock();
+
+    if(bSchedule) {
+        QMetaObject::invokeMethod(this, "deliver", Qt::QueuedConnection);
+    }
+}
+
+//=============================================================================================================
+
+void PluginConnectorEdge::release()
+{
+    m_qMutex.lock();
+    m_bReleased = true;
+    m_qQueue.clear();
+    m_qQueueNotFull.wakeAll();
+    m_qMutex.unlock();
+
+    //A sender waiting for free queue space was woken up above, wait until it left push()
+    QMutexLocker pushLocker(&m_qPushMutex);
+}
+
+//=============================================================================================================
+
+void PluginConnectorEdge::deliver()
+{
+    while(true) {
+        m_qMutex.lock();
+
+        if(m_qQueue.isEmpty() || m_bReleased || !m_pInputConnector) {
+            m_bDeliveryPending = false;
+            m_qMutex.unlock();
+            return;
+        }
+
+        QPair<Measurement::SPtr, qint64> item = m_qQueue.dequeue();
+
+        double dLatencyMs = (m_clock.nsecsElapsed() - item.second) / 1.0e6;
+        ++m_iDelivered;
+        m_dSumLatencyMs += dLatencyMs;
+        m_dMaxLatencyMs = qMax(m_dMaxLatencyMs, dLatencyMs);
+
+        m_qQueueNotFull.wakeAll();
+        m_qMutex.unlock();
+
+        m_pInputConnector->update(item.first);
+    }
+}
+
+//=============================================================================================================
+
+void PluginConnectorEdge::dropOldest()
+{
+    m_qQueue.dequeue();
+    ++m_iDropped;
+}
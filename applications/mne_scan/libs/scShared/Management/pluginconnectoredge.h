@@ -0,0 +1,200 @@
+//=============================================================================================================
+/**
+ * @file     pluginconnectoredge.h
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Contains the declaration of the PluginConnectorEdge class.
+ *
+ */
+#ifndef PLUGINCONNECTOREDGE_H
+#define PLUGINCONNECTOREDGE_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "../scshared_global.h"
+
+#include "plugininputconnector.h"
+
+#include <scMeas/measurement.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QObject>
+#include <QSharedPointer>
+#include <QPointer>
+#include <QQueue>
+#include <QPair>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+
+//=============================================================================================================
+// DEFINE NAMESPACE SCSHAREDLIB
+//=============================================================================================================
+
+namespace SCSHAREDLIB
+{
+
+//=============================================================================================================
+/**
+ * Queue policy of a plug-in connection.
+ */
+enum ConnectionPolicy
+{
+    Blocking,       /**< The sender waits until the receiver processed the measurement (legacy behavior). */
+    DropOldest,     /**< Measurements are queued, a full queue discards its oldest entry. */
+    Coalesce,       /**< Only the most recent measurement is kept, for receivers which only need the latest state. */
+    Backpressure    /**< The sender waits for free queue space up to a timeout, then the oldest entry is discarded. */
+};
+
+//=============================================================================================================
+/**
+ * Counters of one plug-in connection edge.
+ */
+struct EdgeStatistics
+{
+    qint64  iDelivered;         /**< Number of measurements delivered to the receiver. */
+    qint64  iDropped;           /**< Number of measurements discarded by the queue policy. */
+    int     iQueueDepth;        /**< Current number of queued measurements. */
+    int     iMaxQueueDepth;     /**< Maximal number of queued measurements seen so far. */
+    double  dMeanLatencyMs;     /**< Mean time between sending and delivery in milliseconds. */
+    double  dMaxLatencyMs;      /**< Maximal time between sending and delivery in milliseconds. */
+};
+
+//=============================================================================================================
+/**
+ * A PluginConnectorEdge decouples an output connector from an input connector. The sender thread only takes a
+ * snapshot of the measurement and queues it, the receiver thread delivers the queued snapshots from its event loop.
+ * A slow receiver therefore fills its own bounded queue instead of stalling the sender.
+ *
+ * @brief The PluginConnectorEdge class holds the queue of one output to input connection
+ */
+class SCSHAREDSHARED_EXPORT PluginConnectorEdge : public QObject
+{
+    Q_OBJECT
+
+public:
+    typedef QSharedPointer<PluginConnectorEdge> SPtr;             /**< Shared pointer type for PluginConnectorEdge. */
+    typedef QSharedPointer<const PluginConnectorEdge> ConstSPtr;  /**< Const shared pointer type for PluginConnectorEdge. */
+
+    //=========================================================================================================
+    /**
+     * Constructs a PluginConnectorEdge which delivers to the given input connector. The edge lives in the thread of
+     * the input connector.
+     *
+     * @param[in] pInputConnector    The receiving input connector.
+     * @param[in] policy             The queue policy.
+     * @param[in] iMaxQueueSize      The maximal number of queued measurements.
+     */
+    PluginConnectorEdge(PluginInputConnector* pInputConnector,
+                        ConnectionPolicy policy,
+                        int iMaxQueueSize);
+
+    //=========================================================================================================
+    /**
+     * Destructor
+     */
+    virtual ~PluginConnectorEdge();
+
+    //=========================================================================================================
+    /**
+     * Sets the queue policy.
+     *
+     * @param[in] policy             The queue policy.
+     * @param[in] iMaxQueueSize      The maximal number of queued measurements.
+     * @param[in] iTimeoutMs         The maximal time the sender waits for free space with the Backpressure policy.
+     */
+    void setPolicy(ConnectionPolicy policy,
+                   int iMaxQueueSize,
+                   int iTimeoutMs = 100);
+
+    //=========================================================================================================
+    /**
+     * Returns the counters of this edge.
+     *
+     * @return the counters.
+     */
+    EdgeStatistics getStatistics() const;
+
+    //=========================================================================================================
+    /**
+     * Queues a measurement for delivery. Called directly in the sender thread on
+     * PluginOutputConnector::notify. Measurements which do not support snapshots are delivered synchronously.
+     *
+     * @param[in] pMeasurement       The measurement which was updated by the sender.
+     */
+    void push(SCMEASLIB::Measurement::SPtr pMeasurement);
+
+    //=========================================================================================================
+    /**
+     * Wakes a sender waiting for free queue space and discards all queued measurements. Waits for a push() which
+     * is still running in the sender thread, afterwards push() returns right away. Disconnect the edge from
+     * PluginOutputConnector::notify before releasing it, the edge may be deleted once this returns.
+     */
+    void release();
+
+private:
+    //=========================================================================================================
+    /**
+     * Delivers all queued measurements to the input connector. Runs in the receiver thread.
+     */
+    Q_INVOKABLE void deliver();
+
+    //=========================================================================================================
+    /**
+     * Removes the oldest queued measurement and counts it as dropped. m_qMutex has to be locked.
+     */
+    void dropOldest();
+
+    QPointer<PluginInputConnector>  m_pInputConnector;  /**< The receiving input connector. */
+
+    QMutex                          m_qPushMutex;       /**< Held while push() uses the edge, release() waits for it. */
+    mutable QMutex                  m_qMutex;           /**< Guards the queue and the counters. */
+    QWaitCondition                  m_qQueueNotFull;    /**< Signaled when a queued measurement was delivered. */
+    QQueue<QPair<SCMEASLIB::Measurement::SPtr, qint64> > m_qQueue;  /**< The queued snapshots with their send time in ns. */
+    QElapsedTimer                   m_clock;            /**< The clock for the latency counters. */
+
+    ConnectionPolicy                m_policy;           /**< The queue policy. */
+    int                             m_iMaxQueueSize;    /**< The maximal number of queued measurements. */
+    int                             m_iTimeoutMs;       /**< The maximal backpressure waiting time. */
+    bool                            m_bDeliveryPending; /**< Whether a deliver() call is scheduled. */
+    bool                            m_bReleased;        /**< Whether the edge was released. */
+
+    qint64                          m_iDelivered;       /**< Number of delivered measurements. */
+    qint64                          m_iDropped;         /**< Number of dropped measurements. */
+    int                             m_iMaxQueueDepth;   /**< Maximal queue depth. */
+    double                          m_dSumLatencyMs;    /**< Sum of all delivery latencies. */
+    double                          m_dMaxLatencyMs;    /**< Maximal delivery latency. */
+};
+} // NAMESPACE
+
+#endif // PLUGINCONNECTOREDGE_H
@@ -163,9 +163,11 @@ void Averaging::update(SCMEASLIB::Measurement::SPtr pMeasurement)
     QSharedPointer<RealTimeMultiSampleArray> pRTMSA = pMeasurement.dynamicCast<RealTimeMultiSampleArray>();
 
     if(pRTMSA) {
+        QList<SampleBlockPool::ConstBlock> lSampleBlocks = pRTMSA->getMultiSampleBlocks();
+
         //Check if buffer initialized
         if(!m_pAveragingBuffer) {
-            m_pAveragingBuffer = CircularMatrixBuffer<double>::SPtr(new CircularMatrixBuffer<double>(64, pRTMSA->getNumChannels(), pRTMSA->getMultiSampleArray()[0].cols()));
+            m_pAveragingBuffer = CircularMatrixBuffer<double>::SPtr(new CircularMatrixBuffer<double>(64, pRTMSA->getNumChannels(), lSampleBlocks.first()->cols()));
         }
 
          //Fiff information
@@ -190,9 +192,9 @@ void Averaging::update(SCMEASLIB::Measurement::SPtr pMeasurement)
 
         // Append new data
         if(m_bProcessData) {
-            for(qint32 i = 0; i < pRTMSA->getMultiSampleArray().size(); ++i) {
+            for(qint32 i = 0; i < lSampleBlocks.size(); ++i) {
                 if(m_pRtAve) {
-                    m_pAveragingBuffer->push(&pRTMSA->getMultiSampleArray()[i]);
+                    m_pAveragingBuffer->push(lSampleBlocks.at(i).data());
                 }
             }
         }
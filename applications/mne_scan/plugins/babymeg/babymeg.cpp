@@ -355,7 +355,7 @@ void BabyMEG::run()
                 }
 
                 m_mutex.lock();
-                m_pOutfid->write_raw_buffer(matValue.cast<double>());
+                m_pOutfid->write_raw_buffer(matValue);
                 m_mutex.unlock();
             } else {
                 size = 0;
@@ -215,11 +215,10 @@ void Covariance::update(SCMEASLIB::Measurement::SPtr pMeasurement)
         }
 
         if(m_bProcessData) {
-            MatrixXd t_mat;
+            QList<SampleBlockPool::ConstBlock> lSampleBlocks = pRTMSA->getMultiSampleBlocks();
 
-            for(qint32 i = 0; i < pRTMSA->getMultiArraySize(); ++i) {
-                t_mat = pRTMSA->getMultiSampleArray()[i];
-                m_pRtCov->append(t_mat);
+            for(qint32 i = 0; i < lSampleBlocks.size(); ++i) {
+                m_pRtCov->append(*lSampleBlocks.at(i));
             }
         }
     }
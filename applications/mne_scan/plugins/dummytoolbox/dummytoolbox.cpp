@@ -169,9 +169,11 @@ void DummyToolbox::update(SCMEASLIB::Measurement::SPtr pMeasurement)
     QSharedPointer<RealTimeMultiSampleArray> pRTMSA = pMeasurement.dynamicCast<RealTimeMultiSampleArray>();
 
     if(pRTMSA) {
+        QList<SampleBlockPool::ConstBlock> lSampleBlocks = pRTMSA->getMultiSampleBlocks();
+
         //Check if buffer initialized
         if(!m_pDummyBuffer) {
-            m_pDummyBuffer = CircularMatrixBuffer<double>::SPtr(new CircularMatrixBuffer<double>(64, pRTMSA->getNumChannels(), pRTMSA->getMultiSampleArray()[0].cols()));
+            m_pDummyBuffer = CircularMatrixBuffer<double>::SPtr(new CircularMatrixBuffer<double>(64, pRTMSA->getNumChannels(), lSampleBlocks.first()->cols()));
         }
 
         //Fiff information
@@ -184,11 +186,8 @@ void DummyToolbox::update(SCMEASLIB::Measurement::SPtr pMeasurement)
             m_pDummyOutput->data()->setVisibility(true);
         }
 
-        MatrixXd t_mat;
-
-        for(unsigned char i = 0; i < pRTMSA->getMultiArraySize(); ++i) {
-            t_mat = pRTMSA->getMultiSampleArray()[i];
-            m_pDummyBuffer->push(&t_mat);
+        for(int i = 0; i < lSampleBlocks.size(); ++i) {
+            m_pDummyBuffer->push(lSampleBlocks.at(i).data());
         }
     }
 }
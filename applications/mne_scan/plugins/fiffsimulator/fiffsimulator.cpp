@@ -262,8 +262,10 @@ void FiffSimulator::run()
             doContinousHPI(matValue);
         }
 
-        //emit values
-        m_pRTMSA_FiffSimulator->data()->setValue(matValue.cast<double>());
+        //emit values, convert straight into a pooled sample block
+        SampleBlockPool::Block pBlock = m_pRTMSA_FiffSimulator->data()->acquireBlock(matValue.rows(), matValue.cols());
+        *pBlock = matValue.cast<double>();
+        m_pRTMSA_FiffSimulator->data()->setValue(pBlock);
     }
 }
 
@@ -319,9 +319,11 @@ void NeuronalConnectivity::updateRTMSA(SCMEASLIB::Measurement::SPtr pMeasurement
 
             MatrixXd data;
 
-            for(qint32 i = 0; i < pRTMSA->getMultiSampleArray().size(); ++i) {
-                const MatrixXd& t_mat = pRTMSA->getMultiSampleArray()[i];
-                m_iBlockSize = pRTMSA->getMultiSampleArray()[i].cols();
+            QList<SampleBlockPool::ConstBlock> lSampleBlocks = pRTMSA->getMultiSampleBlocks();
+
+            for(qint32 i = 0; i < lSampleBlocks.size(); ++i) {
+                const MatrixXd& t_mat = *lSampleBlocks.at(i);
+                m_iBlockSize = t_mat.cols();
 
                 // Check row and colum integrity and restart if necessary
                 if(m_connectivitySettings.size() != 0) {
@@ -255,9 +255,11 @@ void NoiseReduction::update(SCMEASLIB::Measurement::SPtr pMeasurement)
     m_pRTMSA = pMeasurement.dynamicCast<RealTimeMultiSampleArray>();
 
     if(m_pRTMSA) {
+        QList<SampleBlockPool::ConstBlock> lSampleBlocks = m_pRTMSA->getMultiSampleBlocks();
+
         //Check if buffer initialized
         if(!m_pNoiseReductionBuffer) {
-            m_pNoiseReductionBuffer = CircularMatrixBuffer<double>::SPtr(new CircularMatrixBuffer<double>(64, m_pRTMSA->getNumChannels(), m_pRTMSA->getMultiSampleArray()[0].cols()));
+            m_pNoiseReductionBuffer = CircularMatrixBuffer<double>::SPtr(new CircularMatrixBuffer<double>(64, m_pRTMSA->getNumChannels(), lSampleBlocks.first()->cols()));
         }
 
         //Fiff information
@@ -283,7 +285,7 @@ void NoiseReduction::update(SCMEASLIB::Measurement::SPtr pMeasurement)
             m_pNoiseReductionOutput->data()->setVisibility(true);            
 
             //Init the filter
-            m_iMaxFilterTapSize = m_pRTMSA->getMultiSampleArray().first().cols();
+            m_iMaxFilterTapSize = lSampleBlocks.first()->cols();
 
             m_pFilterSettingsView->getFilterView()->init(m_pFiffInfo->sfreq);
             m_pFilterSettingsView->getFilterView()->setWindowSize(m_iMaxFilterTapSize);
@@ -295,11 +297,8 @@ void NoiseReduction::update(SCMEASLIB::Measurement::SPtr pMeasurement)
             m_pCompensatorView->setCompensators(m_pFiffInfo->comps);
         }
 
-        MatrixXd t_mat;
-
-        for(unsigned char i = 0; i < m_pRTMSA->getMultiArraySize(); ++i) {
-            t_mat = m_pRTMSA->getMultiSampleArray()[i];
-            m_pNoiseReductionBuffer->push(&t_mat);
+        for(int i = 0; i < lSampleBlocks.size(); ++i) {
+            m_pNoiseReductionBuffer->push(lSampleBlocks.at(i).data());
         }
     }
 }
@@ -385,9 +385,11 @@ void RtcMne::updateRTMSA(SCMEASLIB::Measurement::SPtr pMeasurement)
             return;
         }
 
+        QList<SampleBlockPool::ConstBlock> lSampleBlocks = pRTMSA->getMultiSampleBlocks();
+
         //Check if buffer initialized
         if(!m_pMatrixDataBuffer) {
-            m_pMatrixDataBuffer = CircularMatrixBuffer<double>::SPtr(new CircularMatrixBuffer<double>(64, pRTMSA->getNumChannels(), pRTMSA->getMultiSampleArray()[0].cols()));
+            m_pMatrixDataBuffer = CircularMatrixBuffer<double>::SPtr(new CircularMatrixBuffer<double>(64, pRTMSA->getNumChannels(), lSampleBlocks.first()->cols()));
         }
 
         //Fiff Information of the RTMSA
@@ -397,17 +399,17 @@ void RtcMne::updateRTMSA(SCMEASLIB::Measurement::SPtr pMeasurement)
         }
 
         if(m_bProcessData) {
-            for(qint32 i = 0; i < pRTMSA->getMultiSampleArray().size(); ++i) {
+            for(qint32 i = 0; i < lSampleBlocks.size(); ++i) {
                 // Check for artifacts
                 QMap<QString,double> mapReject;
                 mapReject.insert("eog", 150e-06);
 
-                bool bArtifactDetected = MNEEpochDataList::checkForArtifact(pRTMSA->getMultiSampleArray()[i],
+                bool bArtifactDetected = MNEEpochDataList::checkForArtifact(*lSampleBlocks.at(i),
                                                                             *m_pFiffInfoInput,
                                                                             mapReject);
 
                 if(!bArtifactDetected) {
-                    m_pMatrixDataBuffer->push(&pRTMSA->getMultiSampleArray()[i]);
+                    m_pMatrixDataBuffer->push(lSampleBlocks.at(i).data());
                 } else {
                     qDebug() << "RtcMne::updateRTMSA - Reject data block";
                 }
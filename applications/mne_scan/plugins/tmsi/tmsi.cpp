@@ -661,7 +661,7 @@ void TMSI::run()
 
             //Write raw data to fif file
             if(m_bWriteToFile) {
-                m_pOutfid->write_raw_buffer(matValue.cast<double>(), m_cals);
+                m_pOutfid->write_raw_buffer(matValue, m_cals);
                 size += matValue.cols();
 
 //                qDebug()<<"size"<<size;
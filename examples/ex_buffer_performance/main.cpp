@@ -0,0 +1,163 @@
+//=============================================================================================================
+/**
+ * @file     main.cpp
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Benchmarks the throughput of the circular matrix buffers between a producer and a consumer thread.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/circularmatrixbuffer.h>
+#include "circularmatrixbuffer_old.h"
+#include <utils/generics/applicationlogger.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QtConcurrent>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace IOBUFFER;
+using namespace UTILSLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+/**
+ * Streams iNumMatrices matrices from a producer thread through the buffer to the calling thread and checks their order.
+ *
+ * @param [in] buffer        The buffer to benchmark.
+ * @param [in] iNumMatrices  The number of matrices to stream.
+ * @param [out] bOrderOk     Whether all matrices arrived in order.
+ *
+ * @return the elapsed time in milliseconds.
+ */
+template<typename BufferType>
+qint64 streamMatrices(BufferType& buffer,
+                      int iNumMatrices,
+                      bool& bOrderOk)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QFuture<void> producer = QtConcurrent::run([&buffer, iNumMatrices]() {
+        MatrixXf matData(buffer.rows(), buffer.cols());
+        for(int i = 0; i < iNumMatrices; ++i) {
+            matData.setConstant(float(i));
+            buffer.push(&matData);
+        }
+    });
+
+    bOrderOk = true;
+    for(int i = 0; i < iNumMatrices; ++i) {
+        MatrixXf matData = buffer.pop();
+        if(matData(0,0) != float(i) || matData(matData.rows()-1, matData.cols()-1) != float(i)) {
+            bOrderOk = false;
+        }
+    }
+
+    producer.waitForFinished();
+
+    return timer.elapsed();
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+/**
+ * The function main marks the entry point of the program.
+ * By default, main has the storage class extern.
+ *
+ * @param [in] argc (argument count) is an integer that indicates how many arguments were entered on the command line when the program was started.
+ * @param [in] argv (argument vector) is an array of pointers to arrays of character objects. The array objects are null-terminated strings, representing the arguments that were entered on the command line when the program was started.
+ * @return the value that was set to exit() (which is 0 if exit() is called via quit()).
+ */
+int main(int argc, char *argv[])
+{
+    qInstallMessageHandler(ApplicationLogger::customLogWriter);
+    QCoreApplication app(argc, argv);
+
+    // Command Line Parser
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Buffer Performance Example");
+    parser.addHelpOption();
+
+    QCommandLineOption rowsOption("rows", "Number of <rows> (channels) per matrix.", "rows", "306");
+    QCommandLineOption colsOption("cols", "Number of <cols> (samples) per matrix.", "cols", "200");
+    QCommandLineOption matricesOption("matrices", "Number of <matrices> to stream.", "matrices", "5000");
+    QCommandLineOption slotsOption("slots", "Number of matrix <slots> in the buffer.", "slots", "10");
+
+    parser.addOption(rowsOption);
+    parser.addOption(colsOption);
+    parser.addOption(matricesOption);
+    parser.addOption(slotsOption);
+
+    parser.process(app);
+
+    int iRows = qMax(1, parser.value(rowsOption).toInt());
+    int iCols = qMax(1, parser.value(colsOption).toInt());
+    int iNumMatrices = qMax(1, parser.value(matricesOption).toInt());
+    int iSlots = qMax(1, parser.value(slotsOption).toInt());
+
+    double dMegaBytes = double(iNumMatrices) * iRows * iCols * sizeof(float) / (1024.0 * 1024.0);
+
+    printf("Streaming %d matrices of %d x %d floats (%.1f MB) through %d slots\n", iNumMatrices, iRows, iCols, dMegaBytes, iSlots);
+
+    bool bOrderOk;
+    qint64 iTime;
+
+    //
+    //   Old element-wise buffer
+    //
+    CircularMatrixBuffer_old<float> bufferOld(iSlots, iRows, iCols);
+    iTime = qMax(qint64(1), streamMatrices(bufferOld, iNumMatrices, bOrderOk));
+    printf("CircularMatrixBuffer_old: %lld ms, %.1f MB/s, order %s\n", iTime, dMegaBytes * 1000.0 / iTime, bOrderOk ? "ok" : "broken");
+
+    //
+    //   Slot ring buffer
+    //
+    CircularMatrixBuffer<float> buffer(iSlots, iRows, iCols);
+    iTime = qMax(qint64(1), streamMatrices(buffer, iNumMatrices, bOrderOk));
+    printf("CircularMatrixBuffer: %lld ms, %.1f MB/s, order %s\n", iTime, dMegaBytes * 1000.0 / iTime, bOrderOk ? "ok" : "broken");
+
+    return 0;
+}
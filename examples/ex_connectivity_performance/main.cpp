@@ -144,6 +144,10 @@ int main(int argc, char *argv[])
 
     //Parameters for performance test
     QStringList sConnectivityMethodList = QStringList() << "COR" << "XCOR" << "COH" << "IMAGCOH" << "PLI" << "WPLI" << "USPLI" << "DSWPLI" << "PLV";
+
+    // Compare computing all spectral methods in one fused pass against computing them one after another
+    QStringList sSpectralMethodList = QStringList() << "COH" << "IMAGCOH" << "PLI" << "WPLI" << "USPLI" << "DSWPLI" << "PLV";
+    sConnectivityMethodList << "SPECTRAL_FUSED" << "SPECTRAL_SEQUENTIAL";
     QList<int> lNumberTrials = QList<int>() << 1 << 5 << 10 << 20 << 50 << 100 << 200;
     QList<int> lNumberChannels = QList<int>() << 32 << 64 << 128 << 256;
     QList<int> lNumberSamples = QList<int>() << 100 << 200 << 300 << 400 << 500 << 600 << 700 << 800 << 900 << 1000 << 2000 << 3000 << 4000 << 5000 << 6000 << 7000 << 8000 << 9000 << 10000 << 20000 << 30000 << 40000 << 50000 << 60000 << 70000 << 80000 << 90000 << 100000;
@@ -253,7 +257,17 @@ int main(int argc, char *argv[])
                     int iNFreqs = int(floor(iNfft / 2.0)) + 1;
                     qWarning() << "iNFreqs" << iNFreqs;
 
-                    connectivitySettings.setConnectivityMethods(QStringList() << sConnectivityMethodList.at(i));
+                    QStringList lMethods = QStringList() << sConnectivityMethodList.at(i);
+                    bool bFuseSpectralMethods = true;
+
+                    if(sConnectivityMethodList.at(i) == "SPECTRAL_FUSED") {
+                        lMethods = sSpectralMethodList;
+                    } else if(sConnectivityMethodList.at(i) == "SPECTRAL_SEQUENTIAL") {
+                        lMethods = sSpectralMethodList;
+                        bFuseSpectralMethods = false;
+                    }
+
+                    connectivitySettings.setConnectivityMethods(lMethods);
 
                     m_iCurrentIteration = 0;
                     for(int u = 0; u < iNumberRepeats; ++u) {
@@ -262,7 +276,8 @@ int main(int argc, char *argv[])
                         qWarning() << "iteration" << m_iCurrentIteration;
 
                         //Do connectivity estimation
-                        connectivityObj.calculate(connectivitySettings);
+                        connectivityObj.calculate(connectivitySettings,
+                                                  bFuseSpectralMethods);
 
                         printf("Iteration %d: Calculating %s for %d trials, %d channels, %d samples\n", m_iCurrentIteration, sConnectivityMethodList.at(i).toLatin1().data(), connectivitySettings.size(), lNumberChannels.at(k), lNumberSamples.at(j));
 
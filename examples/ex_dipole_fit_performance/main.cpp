@@ -0,0 +1,159 @@
+//=============================================================================================================
+/**
+ * @file     main.cpp
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Benchmarks the scaling of the time point parallel dipole fit on the sample evoked data.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <inverse/dipoleFit/dipole_fit_settings.h>
+#include <inverse/dipoleFit/dipole_fit.h>
+#include <inverse/dipoleFit/ecd_set.h>
+
+#include <utils/generics/applicationlogger.h>
+#include <utils/parallelexecutor.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QDebug>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace INVERSELIB;
+using namespace UTILSLIB;
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+/**
+ * The function main marks the entry point of the program.
+ * By default, main has the storage class extern.
+ *
+ * @param [in] argc (argument count) is an integer that indicates how many arguments were entered on the command line when the program was started.
+ * @param [in] argv (argument vector) is an array of pointers to arrays of character objects. The array objects are null-terminated strings, representing the arguments that were entered on the command line when the program was started.
+ * @return the value that was set to exit() (which is 0 if exit() is called via quit()).
+ */
+int main(int argc, char *argv[])
+{
+    qInstallMessageHandler(ApplicationLogger::customLogWriter);
+    QCoreApplication app(argc, argv);
+
+    // Command Line Parser
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Dipole Fit Performance Example");
+    parser.addHelpOption();
+
+    QCommandLineOption measFileOption("meas", "Path to evoked <file>.", "file", QCoreApplication::applicationDirPath() + "/MNE-sample-data/MEG/sample/sample_audvis-ave.fif");
+    QCommandLineOption bemFileOption("bem", "Path to BEM <file>, the sphere model is used if empty.", "file", "");
+    QCommandLineOption mriFileOption("mri", "Path to head <-> MRI transform <file>, needed with a BEM.", "file", "");
+    QCommandLineOption tminOption("tmin", "Start of the fitted interval in <s>.", "s", "0.0");
+    QCommandLineOption tmaxOption("tmax", "End of the fitted interval in <s>.", "s", "0.2");
+    QCommandLineOption threadsOption("threads", "Maximal number of <threads>.", "threads", QString::number(ParallelExecutor::maxThreads()));
+
+    parser.addOption(measFileOption);
+    parser.addOption(bemFileOption);
+    parser.addOption(mriFileOption);
+    parser.addOption(tminOption);
+    parser.addOption(tmaxOption);
+    parser.addOption(threadsOption);
+
+    parser.process(app);
+
+    if(!QFile::exists(parser.value(measFileOption))) {
+        qWarning() << "Could not find" << parser.value(measFileOption);
+        return 1;
+    }
+
+    DipoleFitSettings settings;
+    settings.measname = parser.value(measFileOption);
+    settings.is_raw = false;
+    settings.setno = 1;
+    settings.include_meg = true;
+    settings.include_eeg = true;
+    settings.tmin = parser.value(tminOption).toFloat();
+    settings.tmax = parser.value(tmaxOption).toFloat();
+    settings.bmin = -0.1f;
+    settings.bmax = 0.0f;
+    settings.bemname = parser.value(bemFileOption);
+    settings.mriname = parser.value(mriFileOption);
+    settings.checkIntegrity();
+
+    int iMaxThreads = qMax(1, parser.value(threadsOption).toInt());
+
+    QElapsedTimer timer;
+    ECDSet refSet;
+    qint64 iSerialMs = 0;
+
+    //Double the thread count each round and compare against the serial fit
+    for(int nthread = 1; ; nthread = qMin(2 * nthread, iMaxThreads)) {
+        settings.nthread = nthread;
+
+        timer.start();
+        ECDSet set = DipoleFit(&settings).calculateFit();
+        qint64 iElapsedMs = timer.elapsed();
+
+        if(nthread == 1) {
+            refSet = set;
+            iSerialMs = iElapsedMs;
+        }
+
+        bool bIdentical = set.size() == refSet.size();
+        for(int k = 0; bIdentical && k < set.size(); ++k) {
+            bIdentical = set[k].time == refSet[k].time
+                         && set[k].rd == refSet[k].rd
+                         && set[k].Q == refSet[k].Q
+                         && set[k].good == refSet[k].good;
+        }
+
+        qInfo() << "Threads:" << nthread
+                << "Dipoles:" << set.size()
+                << "Time:" << iElapsedMs << "ms"
+                << "Speedup:" << (iElapsedMs > 0 ? double(iSerialMs) / iElapsedMs : 0.0)
+                << "Identical to serial fit:" << bIdentical;
+
+        if(nthread == iMaxThreads) {
+            break;
+        }
+    }
+
+    return 0;
+}
@@ -191,7 +191,9 @@ int main(int argc, char *argv[])
     qInfo() << "findOrder() took" << timer.elapsed() << "milliseconds";
     qInfo() << "[done]";
 
-    // read and fit
+    // read and fit, keeping the fitting context alive between the blocks
+    HPIFit hpiFit;
+
     for(int i = 0; i < vTime.size(); i++) {
         from = first + vTime(i)*pFiffInfo->sfreq;
         to = from + iQuantum;
@@ -208,16 +210,16 @@ int main(int argc, char *argv[])
 
         qInfo() << "HPI-Fit...";
         timer.start();
-        HPIFit::fitHPI(mData,
-                       mProjectors,
-                       pFiffInfo->dev_head_t,
-                       vFreqs,
-                       vError,
-                       vGoF,
-                       fittedPointSet,
-                       pFiffInfo,
-                       bDoDebug,
-                       sHPIResourceDir);
+        hpiFit.fit(mData,
+                   mProjectors,
+                   pFiffInfo->dev_head_t,
+                   vFreqs,
+                   vError,
+                   vGoF,
+                   fittedPointSet,
+                   pFiffInfo,
+                   bDoDebug,
+                   sHPIResourceDir);
         qInfo() << "The HPI-Fit took" << timer.elapsed() << "milliseconds";
         qInfo() << "[done]";
 
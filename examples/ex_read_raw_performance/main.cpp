@@ -0,0 +1,176 @@
+//=============================================================================================================
+/**
+ * @file     main.cpp
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Benchmarks the serial and the parallel raw data readers on the whole file.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <fiff/fiff.h>
+#include <fiff/fiff_raw_segment_reader.h>
+#include <utils/generics/applicationlogger.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QThread>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace UTILSLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+/**
+ * The function main marks the entry point of the program.
+ * By default, main has the storage class extern.
+ *
+ * @param [in] argc (argument count) is an integer that indicates how many arguments were entered on the command line when the program was started.
+ * @param [in] argv (argument vector) is an array of pointers to arrays of character objects. The array objects are null-terminated strings, representing the arguments that were entered on the command line when the program was started.
+ * @return the value that was set to exit() (which is 0 if exit() is called via quit()).
+ */
+int main(int argc, char *argv[])
+{
+    qInstallMessageHandler(ApplicationLogger::customLogWriter);
+    QCoreApplication app(argc, argv);
+
+    // Command Line Parser
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Read Raw Performance Example");
+    parser.addHelpOption();
+
+    QCommandLineOption inputOption("fileIn", "The input file <in>.", "in", QCoreApplication::applicationDirPath() + "/MNE-sample-data/MEG/sample/sample_audvis_raw.fif");
+    QCommandLineOption repetitionsOption("repetitions", "Number of <repetitions> per measurement.", "repetitions", "3");
+    QCommandLineOption mapOption("map", "Map the file into memory.", "map", "false");
+
+    parser.addOption(inputOption);
+    parser.addOption(repetitionsOption);
+    parser.addOption(mapOption);
+
+    parser.process(app);
+
+    QFile t_fileRaw(parser.value(inputOption));
+    int iRepetitions = qMax(1, parser.value(repetitionsOption).toInt());
+    bool bMap = parser.value(mapOption) == "true" || parser.value(mapOption) == "1";
+
+    //
+    //   Setup for reading the raw data
+    //
+    FiffRawData raw(t_fileRaw);
+
+    if(raw.isEmpty()) {
+        qWarning("Could not read %s", t_fileRaw.fileName().toUtf8().constData());
+        return -1;
+    }
+
+    //
+    //   Activate the projection items, so that the timing includes the SSP
+    //
+    for(int k = 0; k < raw.info.projs.size(); ++k) {
+        raw.info.projs[k].active = true;
+    }
+    raw.info.make_projector(raw.proj);
+
+    RowVectorXi picks = raw.info.pick_types(true, true, true, defaultQStringList, raw.info.bads);
+
+    if(bMap && !raw.file->map()) {
+        qWarning("Could not map %s, falling back to buffered reads", t_fileRaw.fileName().toUtf8().constData());
+    }
+
+    MatrixXd matRef, matData, times;
+    QElapsedTimer timer;
+    qint64 iTime;
+
+    printf("Reading %d samples of %d channels, %d repetitions per measurement\n", raw.last_samp - raw.first_samp + 1, (int)picks.cols(), iRepetitions);
+
+    //
+    //   Reference: FiffRawData::read_raw_segment
+    //
+    timer.start();
+    for(int i = 0; i < iRepetitions; ++i) {
+        raw.read_raw_segment(matRef, times, raw.first_samp, raw.last_samp, picks);
+    }
+    iTime = timer.elapsed() / iRepetitions;
+    printf("FiffRawData::read_raw_segment: %lld ms\n", iTime);
+
+    //
+    //   Serial segment reader, the cache is disabled to measure decoding
+    //
+    FiffRawSegmentReader reader(raw, 0);
+
+    timer.restart();
+    for(int i = 0; i < iRepetitions; ++i) {
+        reader.read_raw_segment(matData, times, raw.first_samp, raw.last_samp, picks);
+    }
+    iTime = timer.elapsed() / iRepetitions;
+    printf("FiffRawSegmentReader::read_raw_segment: %lld ms, max deviation %g\n", iTime, (matRef - matData).cwiseAbs().maxCoeff());
+
+    //
+    //   Pipelined parallel reader with increasing number of threads
+    //
+    qint64 iTimeSingle = 0;
+
+    for(int iNumThreads = 1; iNumThreads <= QThread::idealThreadCount(); iNumThreads *= 2) {
+        timer.restart();
+        for(int i = 0; i < iRepetitions; ++i) {
+            reader.read_raw_segment_parallel(matData, times, raw.first_samp, raw.last_samp, picks, iNumThreads);
+        }
+        iTime = timer.elapsed() / iRepetitions;
+
+        if(iNumThreads == 1) {
+            iTimeSingle = iTime;
+        }
+
+        printf("FiffRawSegmentReader::read_raw_segment_parallel, %d thread(s): %lld ms, speedup %.2f, max deviation %g\n",
+               iNumThreads,
+               iTime,
+               iTime > 0 ? double(iTimeSingle) / double(iTime) : 0.0,
+               (matRef - matData).cwiseAbs().maxCoeff());
+
+        if(iNumThreads < QThread::idealThreadCount() && iNumThreads * 2 > QThread::idealThreadCount()) {
+            iNumThreads = QThread::idealThreadCount() / 2;
+        }
+    }
+
+    return 0;
+}
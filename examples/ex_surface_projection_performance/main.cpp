@@ -0,0 +1,170 @@
+//=============================================================================================================
+/**
+ * @file     main.cpp
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Benchmarks the closest point search on a BEM surface, exhaustive versus bounding volume hierarchy.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <mne/mne_bem.h>
+#include <mne/mne_bem_surface.h>
+#include <mne/mne_triangle_bvh.h>
+#include <mne/mne_project_to_surface.h>
+
+#include <utils/generics/applicationlogger.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QDebug>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace MNELIB;
+using namespace UTILSLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+/**
+ * The function main marks the entry point of the program.
+ * By default, main has the storage class extern.
+ *
+ * @param [in] argc (argument count) is an integer that indicates how many arguments were entered on the command line when the program was started.
+ * @param [in] argv (argument vector) is an array of pointers to arrays of character objects. The array objects are null-terminated strings, representing the arguments that were entered on the command line when the program was started.
+ * @return the value that was set to exit() (which is 0 if exit() is called via quit()).
+ */
+int main(int argc, char *argv[])
+{
+    qInstallMessageHandler(ApplicationLogger::customLogWriter);
+    QCoreApplication app(argc, argv);
+
+    // Command Line Parser
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Surface Projection Performance Example");
+    parser.addHelpOption();
+
+    QCommandLineOption bemFileOption("bem", "Path to BEM <file>.", "file", QCoreApplication::applicationDirPath() + "/MNE-sample-data/subjects/sample/bem/sample-5120-5120-5120-bem.fif");
+    QCommandLineOption pointsOption("points", "Number of <points> to project.", "points", "10000");
+    QCommandLineOption offsetOption("offset", "Maximal <offset> of the points from the surface in m.", "offset", "0.02");
+
+    parser.addOption(bemFileOption);
+    parser.addOption(pointsOption);
+    parser.addOption(offsetOption);
+
+    parser.process(app);
+
+    int iNumPoints = qMax(1, parser.value(pointsOption).toInt());
+    float fOffset = parser.value(offsetOption).toFloat();
+
+    QFile t_fileBem(parser.value(bemFileOption));
+    MNEBem t_Bem(t_fileBem);
+
+    if(t_Bem.size() == 0) {
+        qWarning() << "Could not read BEM from" << t_fileBem.fileName();
+        return 1;
+    }
+
+    //Use the outermost surface, which is the one digitizer points and electrodes are projected to
+    const MNEBemSurface& surf = t_Bem[0];
+
+    //Scatter points around the vertices, the way digitizer points lie around the scalp
+    MatrixX3f matPoints(iNumPoints, 3);
+    for(int k = 0; k < iNumPoints; ++k) {
+        matPoints.row(k) = surf.rr.row(k % surf.np) + fOffset * RowVector3f::Random();
+    }
+
+    qInfo() << "Surface with" << surf.ntri << "triangles," << iNumPoints << "points";
+
+    QElapsedTimer timer;
+    VectorXi vecNearestRef, vecNearest;
+    MatrixX3f matClosestRef, matClosest;
+    VectorXf vecDistRef, vecDist;
+
+    //A single leaf makes the tree an exhaustive search over all triangles
+    MNETriangleBVH exhaustive(surf.rr, surf.tris, surf.ntri);
+
+    timer.start();
+    for(int k = 0; k < iNumPoints; ++k) {
+        Vector3f rClosest;
+        float dist;
+        exhaustive.nearestTriangle(matPoints.row(k).transpose(), rClosest, dist);
+    }
+    qint64 iExhaustiveMs = timer.elapsed();
+
+    timer.restart();
+    MNETriangleBVH bvh(surf);
+    qint64 iBuildMs = timer.elapsed();
+
+    timer.restart();
+    for(int k = 0; k < iNumPoints; ++k) {
+        Vector3f rClosest;
+        float dist;
+        bvh.nearestTriangle(matPoints.row(k).transpose(), rClosest, dist);
+    }
+    qint64 iSerialMs = timer.elapsed();
+
+    timer.restart();
+    bvh.nearestTriangles(matPoints, vecNearest, matClosest, vecDist);
+    qint64 iParallelMs = timer.elapsed();
+
+    timer.restart();
+    MNEProjectToSurface projector(surf);
+    MatrixXf matProjected(iNumPoints, 3);
+    VectorXi vecProjNearest;
+    VectorXf vecProjDist;
+    projector.mne_find_closest_on_surface(matPoints, iNumPoints, matProjected, vecProjNearest, vecProjDist);
+    qint64 iProjectorMs = timer.elapsed();
+
+    //Verify against the exhaustive search
+    exhaustive.nearestTriangles(matPoints, vecNearestRef, matClosestRef, vecDistRef);
+    float fMaxDistError = (vecDist - vecDistRef).cwiseAbs().maxCoeff();
+
+    qInfo() << "Exhaustive search:" << iExhaustiveMs << "ms";
+    qInfo() << "BVH build:" << iBuildMs << "ms";
+    qInfo() << "BVH search, serial:" << iSerialMs << "ms";
+    qInfo() << "BVH search, parallel:" << iParallelMs << "ms";
+    qInfo() << "MNEProjectToSurface (incl. setup):" << iProjectorMs << "ms";
+    qInfo() << "Max. distance deviation from exhaustive search:" << fMaxDistError << "m";
+
+    return 0;
+}
@@ -47,7 +47,9 @@ include(../mne-cpp.pri)
 TEMPLATE = subdirs
 
 SUBDIRS += \
+    ex_buffer_performance \
     ex_cancel_noise \
+    ex_dipole_fit_performance \
     ex_evoked_grad_amp \
     ex_fiff_io \
     ex_find_evoked \
@@ -59,7 +61,9 @@ SUBDIRS += \
     ex_read_evoked \
     ex_read_fwd \
     ex_read_raw \
+    ex_read_raw_performance \
     ex_read_write_raw \
+    ex_surface_projection_performance \
 
 !contains(MNECPP_CONFIG, minimalVersion) {
     qtHaveModule(charts) {
@@ -42,8 +42,10 @@
 
 #include "connectivitysettings.h"
 #include "network/network.h"
+#include "network/networknode.h"
 #include "metrics/correlation.h"
 #include "metrics/crosscorrelation.h"
+#include "metrics/coherency.h"
 #include "metrics/coherence.h"
 #include "metrics/imagcoherence.h"
 #include "metrics/phaselagindex.h"
@@ -52,11 +54,14 @@
 #include "metrics/unbiasedsquaredphaselagindex.h"
 #include "metrics/debiasedsquaredweightedphaselagindex.h"
 
+#include <utils/spectral.h>
+
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
 
 #include <QDebug>
+#include <QMap>
 #include <QFutureSynchronizer>
 #include <QtConcurrent>
 
@@ -64,16 +69,39 @@
 // EIGEN INCLUDES
 //=============================================================================================================
 
+#include <unsupported/Eigen/FFT>
+
 //=============================================================================================================
 // USED NAMESPACES
 //=============================================================================================================
 
 using namespace CONNECTIVITYLIB;
+using namespace Eigen;
+using namespace UTILSLIB;
 
 //=============================================================================================================
 // DEFINE GLOBAL METHODS
 //=============================================================================================================
 
+namespace {
+
+const QStringList FUSABLE_METHODS = QStringList() << "WPLI" << "USPLI" << "PLI" << "COH" << "IMAGCOH" << "PLV" << "DSWPLI";
+
+template<typename T>
+void addPairsToSum(QVector<QPair<int,T> >& vecPairSum,
+                   const QVector<QPair<int,T> >& vecPair)
+{
+    if(vecPairSum.isEmpty()) {
+        vecPairSum = vecPair;
+    } else {
+        for (int j = 0; j < vecPairSum.size(); ++j) {
+            vecPairSum[j].second += vecPair.at(j).second;
+        }
+    }
+}
+
+}
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
@@ -84,19 +112,40 @@ Connectivity::Connectivity()
 
 //=============================================================================================================
 
-QList<Network> Connectivity::calculate(ConnectivitySettings& connectivitySettings)
+QList<Network> Connectivity::calculate(ConnectivitySettings& connectivitySettings,
+                                       bool bFuseSpectralMethods)
 {
     QStringList lMethods = connectivitySettings.getConnectivityMethods();
     QList<Network> results;
     QElapsedTimer timer;
     timer.start();
 
+    // Compute the spectral methods in one pass over the trials if more than one of them was requested
+    QStringList lFusedMethods;
+
+    for(int i = 0; i < FUSABLE_METHODS.size(); ++i) {
+        if(lMethods.contains(FUSABLE_METHODS.at(i))) {
+            lFusedMethods << FUSABLE_METHODS.at(i);
+        }
+    }
+
+    QMap<QString, Network> mapFusedResults;
+
+    if(bFuseSpectralMethods && lFusedMethods.size() > 1) {
+        QList<Network> fusedResults = calculateFused(connectivitySettings,
+                                                     lFusedMethods);
+
+        for(int i = 0; i < lFusedMethods.size(); ++i) {
+            mapFusedResults.insert(lFusedMethods.at(i), fusedResults.at(i));
+        }
+    }
+
     if(lMethods.contains("WPLI")) {
-        results.append(WeightedPhaseLagIndex::calculate(connectivitySettings));
+        results.append(mapFusedResults.contains("WPLI") ? mapFusedResults.value("WPLI") : WeightedPhaseLagIndex::calculate(connectivitySettings));
     }
 
     if(lMethods.contains("USPLI")) {
-        results.append(UnbiasedSquaredPhaseLagIndex::calculate(connectivitySettings));
+        results.append(mapFusedResults.contains("USPLI") ? mapFusedResults.value("USPLI") : UnbiasedSquaredPhaseLagIndex::calculate(connectivitySettings));
     }
 
     if(lMethods.contains("COR")) {
@@ -108,23 +157,23 @@ QList<Network> Connectivity::calculate(ConnectivitySettings& connectivitySetting
     }
 
     if(lMethods.contains("PLI")) {
-        results.append(PhaseLagIndex::calculate(connectivitySettings));
+        results.append(mapFusedResults.contains("PLI") ? mapFusedResults.value("PLI") : PhaseLagIndex::calculate(connectivitySettings));
     }
 
     if(lMethods.contains("COH")) {
-        results.append(Coherence::calculate(connectivitySettings));
+        results.append(mapFusedResults.contains("COH") ? mapFusedResults.value("COH") : Coherence::calculate(connectivitySettings));
     }
 
     if(lMethods.contains("IMAGCOH")) {
-        results.append(ImagCoherence::calculate(connectivitySettings));
+        results.append(mapFusedResults.contains("IMAGCOH") ? mapFusedResults.value("IMAGCOH") : ImagCoherence::calculate(connectivitySettings));
     }
 
     if(lMethods.contains("PLV")) {
-        results.append(PhaseLockingValue::calculate(connectivitySettings));
+        results.append(mapFusedResults.contains("PLV") ? mapFusedResults.value("PLV") : PhaseLockingValue::calculate(connectivitySettings));
     }
 
     if(lMethods.contains("DSWPLI")) {
-        results.append(DebiasedSquaredWeightedPhaseLagIndex::calculate(connectivitySettings));
+        results.append(mapFusedResults.contains("DSWPLI") ? mapFusedResults.value("DSWPLI") : DebiasedSquaredWeightedPhaseLagIndex::calculate(connectivitySettings));
     }
 
     qWarning() << "Total" << timer.elapsed();
@@ -132,3 +181,197 @@ QList<Network> Connectivity::calculate(ConnectivitySettings& connectivitySetting
 
     return results;
 }
+
+//=============================================================================================================
+
+QList<Network> Connectivity::calculateFused(ConnectivitySettings& connectivitySettings,
+                                            const QStringList& lMethods)
+{
+    QList<Network> results;
+
+    if(connectivitySettings.isEmpty()) {
+        qWarning() << "Connectivity::calculateFused - Input data is empty";
+
+        for(int i = 0; i < lMethods.size(); ++i) {
+            results.append(Network(lMethods.at(i)));
+        }
+
+        return results;
+    }
+
+    if(AbstractMetric::m_bStorageModeIsActive == false) {
+        connectivitySettings.clearIntermediateData();
+    }
+
+    #ifdef EIGEN_FFTW_DEFAULT
+        fftw_make_planner_thread_safe();
+    #endif
+
+    int iSignalLength = connectivitySettings.at(0).matData.cols();
+    int iNfft = connectivitySettings.getFFTSize();
+
+    // Generate tapers
+    QPair<MatrixXd, VectorXd> tapers = Spectral::generateTapers(iSignalLength, connectivitySettings.getWindowType());
+
+    // Initialize
+    int iNRows = connectivitySettings.at(0).matData.rows();
+    int iNFreqs = int(floor(iNfft / 2.0)) + 1;
+
+    // Create the networks, this also checks the frequency bin range the intermediates are computed for
+    for(int i = 0; i < lMethods.size(); ++i) {
+        Network finalNetwork(lMethods.at(i));
+
+        AbstractMetric::initSpectralNetwork(finalNetwork,
+                                            connectivitySettings,
+                                            iNFreqs);
+
+        results.append(finalNetwork);
+    }
+
+    // Compute the intermediates of all methods in one pass over the trials
+    std::function<void(ConnectivitySettings::IntermediateTrialData&, ConnectivitySettings::IntermediateSumData&)> computeLambda = [&](ConnectivitySettings::IntermediateTrialData& inputData,
+                                                                                                                                      ConnectivitySettings::IntermediateSumData& sumData) {
+        computeFused(inputData,
+                     sumData,
+                     lMethods,
+                     iNRows,
+                     iNFreqs,
+                     iNfft,
+                     tapers);
+    };
+
+    connectivitySettings.computeIntermediateSums(computeLambda);
+
+    // Fill the networks from the summed intermediates
+    for(int i = 0; i < lMethods.size(); ++i) {
+        Network& finalNetwork = results[i];
+
+        if(lMethods.at(i) == "WPLI") {
+            WeightedPhaseLagIndex::computeWPLI(connectivitySettings,
+                                               finalNetwork);
+        } else if(lMethods.at(i) == "USPLI") {
+            UnbiasedSquaredPhaseLagIndex::computeUSPLI(connectivitySettings,
+                                                       finalNetwork);
+        } else if(lMethods.at(i) == "PLI") {
+            PhaseLagIndex::computePLI(connectivitySettings,
+                                      finalNetwork);
+        } else if(lMethods.at(i) == "COH") {
+            Coherency::computeAbs(finalNetwork,
+                                  connectivitySettings);
+        } else if(lMethods.at(i) == "IMAGCOH") {
+            Coherency::computeImag(finalNetwork,
+                                   connectivitySettings);
+        } else if(lMethods.at(i) == "PLV") {
+            PhaseLockingValue::computePLV(connectivitySettings,
+                                          finalNetwork);
+        } else if(lMethods.at(i) == "DSWPLI") {
+            DebiasedSquaredWeightedPhaseLagIndex::computeDSWPLI(connectivitySettings,
+                                                                finalNetwork);
+        }
+    }
+
+    return results;
+}
+
+//=============================================================================================================
+
+void Connectivity::computeFused(ConnectivitySettings::IntermediateTrialData& inputData,
+                                ConnectivitySettings::IntermediateSumData& sumData,
+                                const QStringList& lMethods,
+                                int iNRows,
+                                int iNFreqs,
+                                int iNfft,
+                                const QPair<MatrixXd, VectorXd>& tapers)
+{
+    // Only compute what is missing for this trial. Everything already present was added to the sums before.
+    bool bNewPsd = (lMethods.contains("COH") || lMethods.contains("IMAGCOH")) && inputData.matPsd.rows() != iNRows;
+    bool bNewCsd = inputData.vecPairCsd.size() != iNRows;
+    bool bNewImagSign = (lMethods.contains("PLI") || lMethods.contains("USPLI")) && inputData.vecPairCsdImagSign.size() != iNRows;
+    bool bNewImagAbs = (lMethods.contains("WPLI") || lMethods.contains("DSWPLI")) && inputData.vecPairCsdImagAbs.size() != iNRows;
+    bool bNewImagSqrd = lMethods.contains("DSWPLI") && inputData.vecPairCsdImagSqrd.size() != iNRows;
+    bool bNewNormalized = lMethods.contains("PLV") && inputData.vecPairCsdNormalized.size() != iNRows;
+
+    if(bNewPsd) {
+        AbstractMetric::computePSD(inputData,
+                                   iNRows,
+                                   iNFreqs,
+                                   iNfft,
+                                   tapers);
+    }
+
+    if(bNewCsd) {
+        AbstractMetric::computeCSD(inputData,
+                                   iNRows,
+                                   iNFreqs,
+                                   iNfft,
+                                   tapers);
+    }
+
+    if(bNewImagSign) {
+        inputData.vecPairCsdImagSign.clear();
+    }
+    if(bNewImagAbs) {
+        inputData.vecPairCsdImagAbs.clear();
+    }
+    if(bNewImagSqrd) {
+        inputData.vecPairCsdImagSqrd.clear();
+    }
+    if(bNewNormalized) {
+        inputData.vecPairCsdNormalized.clear();
+    }
+
+    MatrixXd matCsdImag;
+
+    for (int i = 0; i < inputData.vecPairCsd.size(); ++i) {
+        const MatrixXcd& matCsd = inputData.vecPairCsd.at(i).second;
+        matCsdImag = matCsd.imag();
+
+        if(bNewImagSign) {
+            inputData.vecPairCsdImagSign.append(QPair<int,MatrixXd>(i,matCsdImag.cwiseSign()));
+        }
+        if(bNewImagAbs) {
+            inputData.vecPairCsdImagAbs.append(QPair<int,MatrixXd>(i,matCsdImag.cwiseAbs()));
+        }
+        if(bNewImagSqrd) {
+            inputData.vecPairCsdImagSqrd.append(QPair<int,MatrixXd>(i,matCsdImag.array().square()));
+        }
+        if(bNewNormalized) {
+            inputData.vecPairCsdNormalized.append(QPair<int,MatrixXcd>(i,matCsd.cwiseQuotient(matCsd.cwiseAbs())));
+        }
+    }
+
+    // Add everything new to the sums at once
+    if(bNewPsd) {
+        if(sumData.matPsdSum.rows() == 0 || sumData.matPsdSum.cols() == 0) {
+            sumData.matPsdSum = inputData.matPsd;
+        } else {
+            sumData.matPsdSum += inputData.matPsd;
+        }
+    }
+    if(bNewCsd) {
+        addPairsToSum(sumData.vecPairCsdSum, inputData.vecPairCsd);
+    }
+    if(bNewImagSign) {
+        addPairsToSum(sumData.vecPairCsdImagSignSum, inputData.vecPairCsdImagSign);
+    }
+    if(bNewImagAbs) {
+        addPairsToSum(sumData.vecPairCsdImagAbsSum, inputData.vecPairCsdImagAbs);
+    }
+    if(bNewImagSqrd) {
+        addPairsToSum(sumData.vecPairCsdImagSqrdSum, inputData.vecPairCsdImagSqrd);
+    }
+    if(bNewNormalized) {
+        addPairsToSum(sumData.vecPairCsdNormalizedSum, inputData.vecPairCsdNormalized);
+    }
+
+    //Do not store data to save memory
+    if(!AbstractMetric::m_bStorageModeIsActive) {
+        inputData.matPsd.resize(0,0);
+        inputData.vecTapSpectra.clear();
+        inputData.vecPairCsd.clear();
+        inputData.vecPairCsdImagSign.clear();
+        inputData.vecPairCsdImagAbs.clear();
+        inputData.vecPairCsdImagSqrd.clear();
+        inputData.vecPairCsdNormalized.clear();
+    }
+}
@@ -40,12 +40,15 @@
 //=============================================================================================================
 
 #include "connectivity_global.h"
+#include "connectivitysettings.h"
 
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
 
 #include <QSharedPointer>
+#include <QStringList>
+#include <QPair>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -67,7 +70,6 @@ namespace CONNECTIVITYLIB {
 // CONNECTIVITYLIB FORWARD DECLARATIONS
 //=============================================================================================================
 
-class ConnectivitySettings;
 class Network;
 
 //=============================================================================================================
@@ -93,11 +95,52 @@ public:
     /**
      * Computes the network based on the current settings.
      *
+     * If more than one of the spectral methods COH, IMAGCOH, PLI, WPLI, USPLI, DSWPLI and PLV is requested and
+     * bFuseSpectralMethods is set, their trial intermediates are computed in a single pass per trial and summed in a
+     * single reduction. Otherwise each method is computed on its own.
+     *
+     * @param[in] connectivitySettings   The input data and parameters.
+     * @param[in] bFuseSpectralMethods   Whether to compute the requested spectral methods in one fused pass. Default is true.
+     *
      * @return Returns the list with calculated networks for each provided method.
      */
-    static QList<Network> calculate(ConnectivitySettings& connectivitySettings);
+    static QList<Network> calculate(ConnectivitySettings& connectivitySettings,
+                                    bool bFuseSpectralMethods = true);
 
 protected:
+    //=========================================================================================================
+    /**
+     * Computes the networks of all requested spectral methods from one pass over the trials.
+     *
+     * @param[in] connectivitySettings   The input data and parameters.
+     * @param[in] lMethods               The spectral methods to compute.
+     *
+     * @return Returns the calculated networks, one for each method in lMethods and in the same order.
+     */
+    static QList<Network> calculateFused(ConnectivitySettings& connectivitySettings,
+                                         const QStringList& lMethods);
+
+    //=========================================================================================================
+    /**
+     * Computes every intermediate needed by the requested spectral methods for one trial and adds them to the sums.
+     * Intermediates which are already available for the trial (storage mode) are neither recomputed nor summed again.
+     * This function gets called in parallel.
+     *
+     * @param[in] inputData              The input data.
+     * @param[out] sumData               The partial sums of the intermediates the trial is added to.
+     * @param[in] lMethods               The spectral methods to compute.
+     * @param[in] iNRows                 The number of rows.
+     * @param[in] iNFreqs                The number of frequency bins.
+     * @param[in] iNfft                  The FFT length.
+     * @param[in] tapers                 The taper information.
+     */
+    static void computeFused(ConnectivitySettings::IntermediateTrialData& inputData,
+                             ConnectivitySettings::IntermediateSumData& sumData,
+                             const QStringList& lMethods,
+                             int iNRows,
+                             int iNFreqs,
+                             int iNfft,
+                             const QPair<Eigen::MatrixXd, Eigen::VectorXd>& tapers);
 };
 
 //=============================================================================================================
@@ -42,6 +42,8 @@
 #include <fs/surfaceset.h>
 #include <fiff/fiff_info.h>
 
+#include <utils/parallelexecutor.h>
+
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
@@ -63,11 +65,33 @@ using namespace MNELIB;
 using namespace Eigen;
 using namespace FIFFLIB;
 using namespace FSLIB;
+using namespace UTILSLIB;
 
 //=============================================================================================================
 // DEFINE GLOBAL METHODS
 //=============================================================================================================
 
+namespace {
+
+template<typename T>
+void addPairsToSum(QVector<QPair<int,T> >& vecPairSum,
+                   const QVector<QPair<int,T> >& vecPair)
+{
+    if(vecPair.isEmpty()) {
+        return;
+    }
+
+    if(vecPairSum.isEmpty()) {
+        vecPairSum = vecPair;
+    } else {
+        for (int j = 0; j < vecPairSum.size(); ++j) {
+            vecPairSum[j].second += vecPair.at(j).second;
+        }
+    }
+}
+
+}
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
@@ -416,3 +440,69 @@ ConnectivitySettings::IntermediateSumData& ConnectivitySettings::getIntermediate
 {
     return m_intermediateSumData;
 }
+
+//*******************************************************************************************************
+
+void ConnectivitySettings::IntermediateSumData::add(const IntermediateSumData& sumData)
+{
+    if(sumData.matPsdSum.size() != 0) {
+        if(matPsdSum.size() == 0) {
+            matPsdSum = sumData.matPsdSum;
+        } else {
+            matPsdSum += sumData.matPsdSum;
+        }
+    }
+
+    addPairsToSum(vecPairCsdSum, sumData.vecPairCsdSum);
+    addPairsToSum(vecPairCsdNormalizedSum, sumData.vecPairCsdNormalizedSum);
+    addPairsToSum(vecPairCsdImagSignSum, sumData.vecPairCsdImagSignSum);
+    addPairsToSum(vecPairCsdImagAbsSum, sumData.vecPairCsdImagAbsSum);
+    addPairsToSum(vecPairCsdImagSqrdSum, sumData.vecPairCsdImagSqrdSum);
+}
+
+//*******************************************************************************************************
+
+void ConnectivitySettings::computeIntermediateSums(const std::function<void(IntermediateTrialData& inputData, IntermediateSumData& sumData)>& computeTrial)
+{
+    if(m_trialData.isEmpty()) {
+        return;
+    }
+
+    // Collect the trials once, so that the list is not touched from several threads
+    QVector<IntermediateTrialData*> vecTrials;
+    vecTrials.reserve(m_trialData.size());
+
+    for(IntermediateTrialData& trialData : m_trialData) {
+        vecTrials.append(&trialData);
+    }
+
+    int iNumBlocks = qMin(ParallelExecutor::threadCount(), vecTrials.size());
+    QVector<IntermediateSumData> vecBlockSums(iNumBlocks);
+    IntermediateSumData* pBlockSums = vecBlockSums.data();
+    IntermediateTrialData* const* pTrials = vecTrials.constData();
+    int iNumTrials = vecTrials.size();
+
+    // Each block sums up a contiguous range of trials on its own
+    ParallelExecutor::parallelFor(iNumBlocks, [&](int iBlock) {
+        int iStart = int(qint64(iNumTrials) * iBlock / iNumBlocks);
+        int iEnd = int(qint64(iNumTrials) * (iBlock + 1) / iNumBlocks);
+
+        for(int i = iStart; i < iEnd; ++i) {
+            computeTrial(*pTrials[i], pBlockSums[iBlock]);
+        }
+    }, iNumBlocks);
+
+    // Pairwise tree reduction of the block sums
+    for(int iStep = 1; iStep < iNumBlocks; iStep *= 2) {
+        int iNumPairs = (iNumBlocks - iStep + 2 * iStep - 1) / (2 * iStep);
+
+        ParallelExecutor::parallelFor(iNumPairs, [&](int iPair) {
+            int iBlock = iPair * 2 * iStep;
+
+            pBlockSums[iBlock].add(pBlockSums[iBlock + iStep]);
+            pBlockSums[iBlock + iStep] = IntermediateSumData();
+        }, iNumPairs);
+    }
+
+    m_intermediateSumData.add(vecBlockSums.at(0));
+}
@@ -49,6 +49,7 @@
 #include <QSharedPointer>
 #include <QStringList>
 #include <QVector>
+#include <QPair>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -56,6 +57,12 @@
 
 #include <Eigen/Core>
 
+//=============================================================================================================
+// STL INCLUDES
+//=============================================================================================================
+
+#include <functional>
+
 //=============================================================================================================
 // FORWARD DECLARATIONS
 //=============================================================================================================
@@ -113,6 +120,14 @@ public:
         QVector<QPair<int,Eigen::MatrixXd> >    vecPairCsdImagSignSum;
         QVector<QPair<int,Eigen::MatrixXd> >    vecPairCsdImagAbsSum;
         QVector<QPair<int,Eigen::MatrixXd> >    vecPairCsdImagSqrdSum;
+
+        //=========================================================================================================
+        /**
+         * Adds the partial sums of sumData to these sums. Empty partial sums are skipped.
+         *
+         * @param[in] sumData    The partial sums to add.
+         */
+        void add(const IntermediateSumData& sumData);
     };
 
     //=========================================================================================================
@@ -171,6 +186,19 @@ public:
 
     IntermediateSumData& getIntermediateSumData();
 
+    //=========================================================================================================
+    /**
+     * Runs computeTrial for all trials in parallel and adds the resulting partial sums to the intermediate sum data.
+     *
+     * The trials are split into one contiguous block per thread. Each block accumulates into its own partial sums
+     * without locking, in trial order. The partial sums are then combined by a pairwise tree reduction. The result
+     * therefore does not depend on the thread scheduling.
+     *
+     * @param[in] computeTrial   The function computing the intermediates of one trial and adding them to the given
+     *                           partial sums.
+     */
+    void computeIntermediateSums(const std::function<void(IntermediateTrialData& inputData, IntermediateSumData& sumData)>& computeTrial);
+
 protected:
     QStringList                     m_sConnectivityMethods;         /**< The connectivity methods. */
     QString                         m_sWindowType;                  /**< The window type used to compute tapered spectra. */
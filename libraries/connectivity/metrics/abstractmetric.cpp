@@ -37,20 +37,27 @@
 //=============================================================================================================
 
 #include "abstractmetric.h"
+#include "network/networknode.h"
+#include "network/network.h"
 
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
 
+#include <QDebug>
+
 //=============================================================================================================
 // EIGEN INCLUDES
 //=============================================================================================================
 
+#include <unsupported/Eigen/FFT>
+
 //=============================================================================================================
 // USED NAMESPACES
 //=============================================================================================================
 
 using namespace CONNECTIVITYLIB;
+using namespace Eigen;
 
 //=============================================================================================================
 // DEFINE GLOBAL METHODS
@@ -60,6 +67,35 @@ bool AbstractMetric::m_bStorageModeIsActive = false;
 int AbstractMetric::m_iNumberBinStart = -1;
 int AbstractMetric::m_iNumberBinAmount = -1;
 
+//=============================================================================================================
+
+namespace {
+
+/**
+ * Returns the scaling of each bin in the current bin range. The first and last bin of the half spectrum are
+ * divided by two in addition to the taper normalization.
+ */
+VectorXd halfSpectrumBinScaling(double dDenom,
+                                int iNFreqs,
+                                int iNfft)
+{
+    VectorXd vecScaling = VectorXd::Constant(AbstractMetric::m_iNumberBinAmount, 1.0 / dDenom);
+
+    if(AbstractMetric::m_iNumberBinAmount > 0) {
+        if(AbstractMetric::m_iNumberBinStart == 0) {
+            vecScaling(0) /= 2.0;
+        }
+
+        if(iNfft % 2 == 0 && AbstractMetric::m_iNumberBinStart + AbstractMetric::m_iNumberBinAmount >= iNFreqs) {
+            vecScaling(AbstractMetric::m_iNumberBinAmount - 1) /= 2.0;
+        }
+    }
+
+    return vecScaling;
+}
+
+}
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
@@ -68,3 +104,158 @@ AbstractMetric::AbstractMetric()
 {
 }
 
+//=============================================================================================================
+
+void AbstractMetric::initSpectralNetwork(Network& finalNetwork,
+                                         const ConnectivitySettings& connectivitySettings,
+                                         int iNFreqs)
+{
+    finalNetwork.setSamplingFrequency(connectivitySettings.getSamplingFrequency());
+
+    //Create nodes
+    int iNRows = connectivitySettings.at(0).matData.rows();
+    RowVectorXf rowVert = RowVectorXf::Zero(3);
+
+    for(int i = 0; i < iNRows; ++i) {
+        rowVert = RowVectorXf::Zero(3);
+
+        if(connectivitySettings.getNodePositions().rows() != 0 && i < connectivitySettings.getNodePositions().rows()) {
+            rowVert(0) = connectivitySettings.getNodePositions().row(i)(0);
+            rowVert(1) = connectivitySettings.getNodePositions().row(i)(1);
+            rowVert(2) = connectivitySettings.getNodePositions().row(i)(2);
+        }
+
+        finalNetwork.append(NetworkNode::SPtr(new NetworkNode(i, rowVert)));
+    }
+
+    // Check if start and bin amount need to be reset to full spectrum
+    if(m_iNumberBinStart == -1 ||
+       m_iNumberBinAmount == -1 ||
+       m_iNumberBinStart > iNFreqs ||
+       m_iNumberBinAmount > iNFreqs ||
+       m_iNumberBinAmount + m_iNumberBinStart > iNFreqs) {
+        qDebug() << "AbstractMetric::initSpectralNetwork - Resetting to full spectrum";
+        m_iNumberBinStart = 0;
+        m_iNumberBinAmount = iNFreqs;
+    }
+
+    // Pass information about the FFT length. Use iNFreqs because we only use the half spectrum
+    finalNetwork.setFFTSize(iNFreqs);
+    finalNetwork.setUsedFreqBins(m_iNumberBinAmount);
+}
+
+//=============================================================================================================
+
+void AbstractMetric::computeTaperedSpectra(ConnectivitySettings::IntermediateTrialData& inputData,
+                                           int iNRows,
+                                           int iNFreqs,
+                                           int iNfft,
+                                           const QPair<MatrixXd, VectorXd>& tapers)
+{
+    if(inputData.vecTapSpectra.size() == iNRows) {
+        return;
+    }
+
+    inputData.vecTapSpectra.clear();
+    inputData.vecTapSpectra.reserve(iNRows);
+
+    // This code was copied and changed modified Utils/Spectra since we do not want to call the function due to time loss.
+    RowVectorXd vecInputFFT, rowData;
+    RowVectorXcd vecTmpFreq;
+
+    MatrixXcd matTapSpectrum(tapers.first.rows(), iNFreqs);
+
+    FFT<double> fft;
+    fft.SetFlag(fft.HalfSpectrum);
+
+    for (int i = 0; i < iNRows; ++i) {
+        // Substract mean
+        rowData.array() = inputData.matData.row(i).array() - inputData.matData.row(i).mean();
+
+        for(int j = 0; j < tapers.first.rows(); j++) {
+            // Zero padd if necessary. The zero padding in Eigen's FFT is only working for column vectors.
+            if (rowData.cols() < iNfft) {
+                vecInputFFT.setZero(iNfft);
+                vecInputFFT.block(0,0,1,rowData.cols()) = rowData.cwiseProduct(tapers.first.row(j));
+            } else {
+                vecInputFFT = rowData.cwiseProduct(tapers.first.row(j));
+            }
+
+            // FFT for freq domain returning the half spectrum and multiply taper weights
+            fft.fwd(vecTmpFreq, vecInputFFT, iNfft);
+            matTapSpectrum.row(j) = vecTmpFreq * tapers.second(j);
+        }
+
+        inputData.vecTapSpectra.append(matTapSpectrum);
+    }
+}
+
+//=============================================================================================================
+
+void AbstractMetric::computePSD(ConnectivitySettings::IntermediateTrialData& inputData,
+                                int iNRows,
+                                int iNFreqs,
+                                int iNfft,
+                                const QPair<MatrixXd, VectorXd>& tapers)
+{
+    computeTaperedSpectra(inputData,
+                          iNRows,
+                          iNFreqs,
+                          iNfft,
+                          tapers);
+
+    double denomPSD = tapers.second.cwiseAbs2().sum() / 2.0;
+    VectorXd vecScaling = halfSpectrumBinScaling(denomPSD, iNFreqs, iNfft);
+
+    inputData.matPsd.resize(iNRows, m_iNumberBinAmount);
+
+    for (int i = 0; i < iNRows; ++i) {
+        const MatrixXcd& matTapSpectrum = inputData.vecTapSpectra.at(i);
+
+        inputData.matPsd.row(i) = matTapSpectrum.block(0, m_iNumberBinStart, matTapSpectrum.rows(), m_iNumberBinAmount).cwiseAbs2().colwise().sum().cwiseProduct(vecScaling.transpose());
+    }
+}
+
+//=============================================================================================================
+
+void AbstractMetric::computeCSD(ConnectivitySettings::IntermediateTrialData& inputData,
+                                int iNRows,
+                                int iNFreqs,
+                                int iNfft,
+                                const QPair<MatrixXd, VectorXd>& tapers)
+{
+    computeTaperedSpectra(inputData,
+                          iNRows,
+                          iNFreqs,
+                          iNfft,
+                          tapers);
+
+    double denomCSD = sqrt(tapers.second.cwiseAbs2().sum()) * sqrt(tapers.second.cwiseAbs2().sum()) / 2.0;
+    VectorXd vecScaling = halfSpectrumBinScaling(denomCSD, iNFreqs, iNfft);
+
+    inputData.vecPairCsd.clear();
+    inputData.vecPairCsd.reserve(iNRows);
+
+    for (int i = 0; i < iNRows; ++i) {
+        inputData.vecPairCsd.append(QPair<int,MatrixXcd>(i, MatrixXcd::Zero(iNRows, m_iNumberBinAmount)));
+    }
+
+    int iNTapers = tapers.first.rows();
+    MatrixXcd matSpectraBin(iNRows, iNTapers);
+    MatrixXcd matCsdBin(iNRows, iNRows);
+
+    for (int b = 0; b < m_iNumberBinAmount; ++b) {
+        // Gather the conjugated spectra of all rows for this bin, so that matCsdBin(j,i) = sum_t S_i(t) * conj(S_j(t))
+        for (int i = 0; i < iNRows; ++i) {
+            matSpectraBin.row(i) = inputData.vecTapSpectra.at(i).col(m_iNumberBinStart + b).adjoint();
+        }
+
+        // Only the lower triangle is needed, since the CSD matrix is Hermitian
+        matCsdBin.setZero();
+        matCsdBin.selfadjointView<Lower>().rankUpdate(matSpectraBin, vecScaling(b));
+
+        for (int i = 0; i < iNRows; ++i) {
+            inputData.vecPairCsd[i].second.col(b).tail(iNRows - i) = matCsdBin.col(i).tail(iNRows - i);
+        }
+    }
+}
@@ -40,6 +40,7 @@
 //=============================================================================================================
 
 #include "../connectivity_global.h"
+#include "../connectivitysettings.h"
 
 //=============================================================================================================
 // QT INCLUDES
@@ -47,6 +48,7 @@
 
 #include <QSharedPointer>
 #include <QVector>
+#include <QPair>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -68,6 +70,8 @@ namespace CONNECTIVITYLIB {
 // CONNECTIVITYLIB FORWARD DECLARATIONS
 //=============================================================================================================
 
+class Network;
+
 //=============================================================================================================
 /**
  * This class provides basic functionalities for all implemented metrics.
@@ -91,6 +95,75 @@ public:
     static int      m_iNumberBinStart;
     static int      m_iNumberBinAmount;
 
+    //=========================================================================================================
+    /**
+     * Prepares the network of a spectral metric. Sets the sampling frequency, creates one node per row at the
+     * node positions, resets the frequency bin range to the full spectrum if it is unset or does not fit the
+     * half spectrum and passes the number of bins on to the network.
+     *
+     * @param[in, out] finalNetwork          The network to prepare.
+     * @param[in] connectivitySettings       The connectivity settings. Must hold at least one trial.
+     * @param[in] iNFreqs                    The number of frequency bins of the half spectrum.
+     */
+    static void initSpectralNetwork(Network& finalNetwork,
+                                    const ConnectivitySettings& connectivitySettings,
+                                    int iNFreqs);
+
+    //=========================================================================================================
+    /**
+     * Computes the tapered half spectra of all rows of a trial and stores them in inputData.vecTapSpectra, one
+     * (tapers x frequencies) matrix per row. Nothing is done if the spectra are already available.
+     *
+     * @param[in, out] inputData     The trial data. The spectra are written to its vecTapSpectra member.
+     * @param[in] iNRows             The number of rows.
+     * @param[in] iNFreqs            The number of frequency bins.
+     * @param[in] iNfft              The FFT length.
+     * @param[in] tapers             The taper information.
+     */
+    static void computeTaperedSpectra(ConnectivitySettings::IntermediateTrialData& inputData,
+                                      int iNRows,
+                                      int iNFreqs,
+                                      int iNfft,
+                                      const QPair<Eigen::MatrixXd, Eigen::VectorXd>& tapers);
+
+    //=========================================================================================================
+    /**
+     * Computes the taper averaged PSD of all rows for the current frequency bin range and stores it in
+     * inputData.matPsd (rows x bins). The tapered spectra are computed first if necessary.
+     *
+     * @param[in, out] inputData     The trial data. The PSD is written to its matPsd member.
+     * @param[in] iNRows             The number of rows.
+     * @param[in] iNFreqs            The number of frequency bins.
+     * @param[in] iNfft              The FFT length.
+     * @param[in] tapers             The taper information.
+     */
+    static void computePSD(ConnectivitySettings::IntermediateTrialData& inputData,
+                           int iNRows,
+                           int iNFreqs,
+                           int iNfft,
+                           const QPair<Eigen::MatrixXd, Eigen::VectorXd>& tapers);
+
+    //=========================================================================================================
+    /**
+     * Computes the taper averaged CSD of all row pairs for the current frequency bin range and stores it in
+     * inputData.vecPairCsd. Entry i holds a (rows x bins) matrix whose rows j >= i contain the CSD between row i
+     * and row j. The remaining rows are zero. The tapered spectra are computed first if necessary.
+     *
+     * Per frequency bin the spectra of all rows are gathered into one (rows x tapers) block and the lower triangle of
+     * the Hermitian CSD matrix is obtained with a single rank-k update, instead of one reduction per row pair.
+     *
+     * @param[in, out] inputData     The trial data. The CSD is written to its vecPairCsd member.
+     * @param[in] iNRows             The number of rows.
+     * @param[in] iNFreqs            The number of frequency bins.
+     * @param[in] iNfft              The FFT length.
+     * @param[in] tapers             The taper information.
+     */
+    static void computeCSD(ConnectivitySettings::IntermediateTrialData& inputData,
+                           int iNRows,
+                           int iNFreqs,
+                           int iNfft,
+                           const QPair<Eigen::MatrixXd, Eigen::VectorXd>& tapers);
+
 protected:
 };
 
@@ -42,7 +42,6 @@
 
 #include "coherency.h"
 #include "network/networknode.h"
-#include "network/networkedge.h"
 #include "network/network.h"
 
 #include <utils/spectral.h>
@@ -109,13 +108,11 @@ void Coherency::calculateAbs(Network& finalNetwork,
     int iNFreqs = int(floor(iNfft / 2.0)) + 1;
 
     // Compute PSD/CSD for each trial
-    QMutex mutex;
-
-    std::function<void(ConnectivitySettings::IntermediateTrialData&)> computeLambda = [&](ConnectivitySettings::IntermediateTrialData& inputData) {
+    std::function<void(ConnectivitySettings::IntermediateTrialData&, ConnectivitySettings::IntermediateSumData&)> computeLambda = [&](ConnectivitySettings::IntermediateTrialData& inputData,
+                                                                                                                                      ConnectivitySettings::IntermediateSumData& sumData) {
         compute(inputData,
-                connectivitySettings.getIntermediateSumData().matPsdSum,
-                connectivitySettings.getIntermediateSumData().vecPairCsdSum,
-                mutex,
+                sumData.matPsdSum,
+                sumData.vecPairCsdSum,
                 iNRows,
                 iNFreqs,
                 iNfft,
@@ -126,15 +123,28 @@ void Coherency::calculateAbs(Network& finalNetwork,
 //    qWarning() << "Preparation" << iTime;
 //    timer.restart();
 
-    QFuture<void> result = QtConcurrent::map(connectivitySettings.getTrialData(),
-                                             computeLambda);
-    result.waitForFinished();
+    connectivitySettings.computeIntermediateSums(computeLambda);
 
 //    iTime = timer.elapsed();
 //    qWarning() << "ComputeSpectraPSDCSD" << iTime;
 //    timer.restart();
 
     // Compute CSD/sqrt(PSD_X * PSD_Y)
+    computeAbs(finalNetwork,
+               connectivitySettings);
+
+//    iTime = timer.elapsed();
+//    qWarning() << "Compute" << iTime;
+//    timer.restart();
+}
+
+//=============================================================================================================
+
+void Coherency::computeAbs(Network& finalNetwork,
+                           ConnectivitySettings &connectivitySettings)
+{
+    QMutex mutex;
+
     std::function<void(QPair<int,MatrixXcd>&)> computePSDCSDLambda = [&](QPair<int,MatrixXcd>& pairInput) {
         computePSDCSDAbs(mutex,
                          finalNetwork,
@@ -145,10 +155,6 @@ void Coherency::calculateAbs(Network& finalNetwork,
     QFuture<void> resultCSDPSD = QtConcurrent::map(connectivitySettings.getIntermediateSumData().vecPairCsdSum,
                                                    computePSDCSDLambda);
     resultCSDPSD.waitForFinished();
-
-//    iTime = timer.elapsed();
-//    qWarning() << "Compute" << iTime;
-//    timer.restart();
 }
 
 //=============================================================================================================
@@ -180,13 +186,11 @@ void Coherency::calculateImag(Network& finalNetwork,
     int iNFreqs = int(floor(iNfft / 2.0)) + 1;
 
     // Compute PSD/CSD for each trial
-    QMutex mutex;
-
-    std::function<void(ConnectivitySettings::IntermediateTrialData&)> computeLambda = [&](ConnectivitySettings::IntermediateTrialData& inputData) {
+    std::function<void(ConnectivitySettings::IntermediateTrialData&, ConnectivitySettings::IntermediateSumData&)> computeLambda = [&](ConnectivitySettings::IntermediateTrialData& inputData,
+                                                                                                                                      ConnectivitySettings::IntermediateSumData& sumData) {
         compute(inputData,
-                connectivitySettings.getIntermediateSumData().matPsdSum,
-                connectivitySettings.getIntermediateSumData().vecPairCsdSum,
-                mutex,
+                sumData.matPsdSum,
+                sumData.vecPairCsdSum,
                 iNRows,
                 iNFreqs,
                 iNfft,
@@ -197,15 +201,28 @@ void Coherency::calculateImag(Network& finalNetwork,
 //    qWarning() << "Preparation" << iTime;
 //    timer.restart();
 
-    QFuture<void> result = QtConcurrent::map(connectivitySettings.getTrialData(),
-                                             computeLambda);
-    result.waitForFinished();
+    connectivitySettings.computeIntermediateSums(computeLambda);
 
 //    iTime = timer.elapsed();
 //    qWarning() << "ComputeSpectraPSDCSD" << iTime;
 //    timer.restart();
 
     // Compute CSD/sqrt(PSD_X * PSD_Y)
+    computeImag(finalNetwork,
+                connectivitySettings);
+
+//    iTime = timer.elapsed();
+//    qWarning() << "Compute" << iTime;
+//    timer.restart();
+}
+
+//=============================================================================================================
+
+void Coherency::computeImag(Network& finalNetwork,
+                            ConnectivitySettings &connectivitySettings)
+{
+    QMutex mutex;
+
     std::function<void(QPair<int,MatrixXcd>&)> computePSDCSDLambda = [&](QPair<int,MatrixXcd>& pairInput) {
         computePSDCSDImag(mutex,
                           finalNetwork,
@@ -216,10 +233,6 @@ void Coherency::calculateImag(Network& finalNetwork,
     QFuture<void> resultCSDPSD = QtConcurrent::map(connectivitySettings.getIntermediateSumData().vecPairCsdSum,
                                                    computePSDCSDLambda);
     resultCSDPSD.waitForFinished();
-
-//    iTime = timer.elapsed();
-//    qWarning() << "Compute" << iTime;
-//    timer.restart();
 }
 
 //=============================================================================================================
@@ -227,7 +240,6 @@ void Coherency::calculateImag(Network& finalNetwork,
 void Coherency::compute(ConnectivitySettings::IntermediateTrialData& inputData,
                         MatrixXd& matPsdSum,
                         QVector<QPair<int,MatrixXcd> >& vecPairCsdSum,
-                        QMutex& mutex,
                         int iNRows,
                         int iNFreqs,
                         int iNfft,
@@ -245,63 +257,11 @@ void Coherency::compute(ConnectivitySettings::IntermediateTrialData& inputData,
     //qDebug() << "Coherency::compute - vecPairCsdSum and matPsdSum are computed for this trial.";
 
     // Substract mean, compute tapered spectra and PSD
-    // This code was copied and changed modified Utils/Spectra since we do not want to call the function due to time loss.
-    bool bNfftEven = false;
-    if (iNfft % 2 == 0){
-        bNfftEven = true;
-    }
-
-    FFT<double> fft;
-    fft.SetFlag(fft.HalfSpectrum);
-
-    double denomPSD = tapers.second.cwiseAbs2().sum() / 2.0;
-
-    RowVectorXd vecInputFFT, rowData;
-    RowVectorXcd vecTmpFreq;
-
-    MatrixXcd matTapSpectrum(tapers.first.rows(), iNFreqs);
-
-    int i,j;
-
-    inputData.matPsd = MatrixXd(iNRows, m_iNumberBinAmount);
-
-    for (i = 0; i < iNRows; ++i) {
-        // Substract mean
-        rowData.array() = inputData.matData.row(i).array() - inputData.matData.row(i).mean();
-
-        // Calculate tapered spectra if not available already
-        if(inputData.vecTapSpectra.size() != iNRows) {
-            for(j = 0; j < tapers.first.rows(); j++) {
-                // Zero padd if necessary. The zero padding in Eigen's FFT is only working for column vectors.
-                if (rowData.cols() < iNfft) {
-                    vecInputFFT.setZero(iNfft);
-                    vecInputFFT.block(0,0,1,rowData.cols()) = rowData.cwiseProduct(tapers.first.row(j));;
-                } else {
-                    vecInputFFT = rowData.cwiseProduct(tapers.first.row(j));
-                }
-
-                // FFT for freq domain returning the half spectrum and multiply taper weights
-                fft.fwd(vecTmpFreq, vecInputFFT, iNfft);
-                matTapSpectrum.row(j) = vecTmpFreq * tapers.second(j);
-            }
-
-            inputData.vecTapSpectra.append(matTapSpectrum);
-        }
-
-        // Compute PSD (average over tapers if necessary).
-        inputData.matPsd.row(i) = inputData.vecTapSpectra.at(i).block(0,m_iNumberBinStart,inputData.vecTapSpectra.at(i).rows(),m_iNumberBinAmount).cwiseAbs2().colwise().sum() / denomPSD;
-
-        // Divide first and last element by 2 due to half spectrum
-        if(m_iNumberBinStart == 0) {
-            inputData.matPsd.row(i)(0) /= 2.0;
-        }
-
-        if(bNfftEven && m_iNumberBinStart + m_iNumberBinAmount >= iNFreqs) {
-            inputData.matPsd.row(i).tail(1) /= 2.0;
-        }
-    }
-
-    mutex.lock();
+    computePSD(inputData,
+               iNRows,
+               iNFreqs,
+               iNfft,
+               tapers);
 
     if(matPsdSum.rows() == 0 || matPsdSum.cols() == 0) {
         matPsdSum = inputData.matPsd;
@@ -309,50 +269,25 @@ void Coherency::compute(ConnectivitySettings::IntermediateTrialData& inputData,
         matPsdSum += inputData.matPsd;
     }
 
-    mutex.unlock();
-
 //    iTime = timer.elapsed();
 //    qWarning() << QThread::currentThreadId() << "Coherency::compute timer - compute - Tapered spectra and PSD (summing):" << iTime;
 //    timer.restart();
 
     // Compute CSD
     if(inputData.vecPairCsd.size() != iNRows) {
-        inputData.vecPairCsd.clear();
-
-        //MatrixXcd matCsd = MatrixXcd(iNRows, iNFreqs);
-        MatrixXcd matCsd = MatrixXcd(iNRows, m_iNumberBinAmount);
-
-        double denomCSD = sqrt(tapers.second.cwiseAbs2().sum()) * sqrt(tapers.second.cwiseAbs2().sum()) / 2.0;
-
-        for (i = 0; i < iNRows; ++i) {
-            for (j = i; j < iNRows; ++j) {
-                // Compute CSD (average over tapers if necessary)
-                matCsd.row(j) = inputData.vecTapSpectra.at(i).block(0,m_iNumberBinStart,inputData.vecTapSpectra.at(i).rows(),m_iNumberBinAmount).cwiseProduct(inputData.vecTapSpectra.at(j).block(0,m_iNumberBinStart,inputData.vecTapSpectra.at(j).rows(),m_iNumberBinAmount).conjugate()).colwise().sum() / denomCSD;
-
-                // Divide first and last element by 2 due to half spectrum
-                if(m_iNumberBinStart == 0) {
-                    matCsd.row(j)(0) /= 2.0;
-                }
-
-                if(bNfftEven && m_iNumberBinStart + m_iNumberBinAmount >= iNFreqs) {
-                    matCsd.row(j).tail(1) /= 2.0;
-                }
-            }
-
-            inputData.vecPairCsd.append(QPair<int,MatrixXcd>(i,matCsd));
-        }
-
-        mutex.lock();
+        computeCSD(inputData,
+                   iNRows,
+                   iNFreqs,
+                   iNfft,
+                   tapers);
 
         if(vecPairCsdSum.isEmpty()) {
             vecPairCsdSum = inputData.vecPairCsd;
         } else {
-            for (j = 0; j < vecPairCsdSum.size(); ++j) {
+            for (int j = 0; j < vecPairCsdSum.size(); ++j) {
                 vecPairCsdSum[j].second += inputData.vecPairCsd.at(j).second;
             }
         }
-
-        mutex.unlock();
     }
 
 //    iTime = timer.elapsed();
@@ -387,21 +322,15 @@ void Coherency::computePSDCSDAbs(QMutex& mutex,
     // Average. Note that the number of trials cancel each other out.
     MatrixXcd matCohy = pairInput.second.cwiseQuotient(matPSDtmp.cwiseSqrt());
 
-    QSharedPointer<NetworkEdge> pEdge;
-    MatrixXd matWeight;
+    MatrixXd matWeight = matCohy.cwiseAbs();
     int j;
     int i = pairInput.first;
 
-    for(j = i; j < matCohy.rows(); ++j) {
-        matWeight = matCohy.row(j).cwiseAbs().transpose();
-        pEdge = QSharedPointer<NetworkEdge>(new NetworkEdge(i, j, matWeight));
-
-        mutex.lock();
-        finalNetwork.getNodeAt(i)->append(pEdge);
-        finalNetwork.getNodeAt(j)->append(pEdge);
-        finalNetwork.append(pEdge);
-        mutex.unlock();
+    mutex.lock();
+    for(j = i; j < matWeight.rows(); ++j) {
+        finalNetwork.append(i, j, matWeight.row(j));
     }
+    mutex.unlock();
 }
 
 //=============================================================================================================
@@ -420,19 +349,13 @@ void Coherency::computePSDCSDImag(QMutex& mutex,
 
     MatrixXcd matCohy = pairInput.second.cwiseQuotient(matPSDtmp.cwiseSqrt());
 
-    QSharedPointer<NetworkEdge> pEdge;
-    MatrixXd matWeight;
+    MatrixXd matWeight = matCohy.imag();
     int j;
     int i = pairInput.first;
 
-    for(j = i; j < matCohy.rows(); ++j) {
-        matWeight = matCohy.row(j).imag().transpose();
-        pEdge = QSharedPointer<NetworkEdge>(new NetworkEdge(i, j, matWeight));
-
-        mutex.lock();
-        finalNetwork.getNodeAt(i)->append(pEdge);
-        finalNetwork.getNodeAt(j)->append(pEdge);
-        finalNetwork.append(pEdge);
-        mutex.unlock();
+    mutex.lock();
+    for(j = i; j < matWeight.rows(); ++j) {
+        finalNetwork.append(i, j, matWeight.row(j));
     }
+    mutex.unlock();
 }
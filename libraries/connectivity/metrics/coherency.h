@@ -116,6 +116,26 @@ public:
     static void calculateImag(Network& finalNetwork,
                               ConnectivitySettings &connectivitySettings);
 
+    //=========================================================================================================
+    /**
+     * Reduces the summed PSD and CSD of all trials to the absolute value of coherency.
+     *
+     * @param[out]   finalNetwork          The resulting network.
+     * @param[in]    connectivitySettings  The input data and parameters holding the summed PSD and CSD.
+     */
+    static void computeAbs(Network& finalNetwork,
+                           ConnectivitySettings &connectivitySettings);
+
+    //=========================================================================================================
+    /**
+     * Reduces the summed PSD and CSD of all trials to the imaginary part of coherency.
+     *
+     * @param[out]   finalNetwork          The resulting network.
+     * @param[in]    connectivitySettings  The input data and parameters holding the summed PSD and CSD.
+     */
+    static void computeImag(Network& finalNetwork,
+                            ConnectivitySettings &connectivitySettings);
+
 private:
     //=========================================================================================================
     /**
@@ -124,7 +144,6 @@ private:
      * @param[in]    inputData           The input data.
      * @param[out]   matPsdSum           The sum of all PSD matrices for each trial.
      * @param[out]   vecPairCsdSum       The sum of all CSD matrices for each trial.
-     * @param[in]    mutex               The mutex used to safely access matPsdSum and vecPairCsdSum.
      * @param[in]    iNRows              The number of rows.
      * @param[in]    iNFreqs             The number of frequenciy bins.
      * @param[in]    iNfft               The FFT length.
@@ -133,7 +152,6 @@ private:
     static void compute(ConnectivitySettings::IntermediateTrialData& inputData,
                         Eigen::MatrixXd& matPsdSum,
                         QVector<QPair<int,Eigen::MatrixXcd> >& vecPairCsdSum,
-                        QMutex& mutex,
                         int iNRows,
                         int iNFreqs,
                         int iNfft,
@@ -38,7 +38,6 @@
 
 #include "correlation.h"
 #include "network/networknode.h"
-#include "network/networkedge.h"
 #include "network/network.h"
 
 //=============================================================================================================
@@ -135,19 +134,11 @@ Network Correlation::calculate(ConnectivitySettings& connectivitySettings)
 //    timer.restart();
 
     //Add edges to network
-    MatrixXd matWeight(1,1);
-    QSharedPointer<NetworkEdge> pEdge;
     int j;
 
     for(int i = 0; i < matDist.rows(); ++i) {
         for(j = i; j < matDist.cols(); ++j) {
-            matWeight << matDist(i,j);
-
-            pEdge = QSharedPointer<NetworkEdge>(new NetworkEdge(i, j, matWeight));
-
-            finalNetwork.getNodeAt(i)->append(pEdge);
-            finalNetwork.getNodeAt(j)->append(pEdge);
-            finalNetwork.append(pEdge);
+            finalNetwork.append(i, j, matDist.row(i).segment(j,1));
         }
     }
 
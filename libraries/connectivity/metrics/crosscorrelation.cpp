@@ -38,7 +38,6 @@
 
 #include "crosscorrelation.h"
 #include "network/networknode.h"
-#include "network/networkedge.h"
 #include "network/network.h"
 
 #include <utils/spectral.h>
@@ -151,19 +150,11 @@ Network CrossCorrelation::calculate(ConnectivitySettings& connectivitySettings)
 //    timer.restart();
 
     //Add edges to network
-    MatrixXd matWeight(1,1);
-    QSharedPointer<NetworkEdge> pEdge;
     int j;
 
     for(int i = 0; i < matDist.rows(); ++i) {
         for(j = i; j < matDist.cols(); ++j) {
-            matWeight << matDist(i,j);
-
-            pEdge = QSharedPointer<NetworkEdge>(new NetworkEdge(i, j, matWeight));
-
-            finalNetwork.getNodeAt(i)->append(pEdge);
-            finalNetwork.getNodeAt(j)->append(pEdge);
-            finalNetwork.append(pEdge);
+            finalNetwork.append(i, j, matDist.row(i).segment(j,1));
         }
     }
 
@@ -186,8 +177,7 @@ void CrossCorrelation::compute(ConnectivitySettings::IntermediateTrialData& inpu
 //    qint64 iTime = 0;
 //    timer.start();
 
-    // Calculate tapered spectra if not available already
-    RowVectorXd vecInputFFT, rowData;
+    RowVectorXd vecInputFFT;
     RowVectorXcd vecResultFreq;
 
     FFT<double> fft;
@@ -197,33 +187,11 @@ void CrossCorrelation::compute(ConnectivitySettings::IntermediateTrialData& inpu
     int iNRows = inputData.matData.rows();
 
     // Calculate tapered spectra if not available already
-    // This code was copied and changed modified Utils/Spectra since we do not want to call the function due to time loss.
-    if(inputData.vecTapSpectra.isEmpty()) {
-        int iNFreqs = int(floor(iNfft / 2.0)) + 1;
-        MatrixXcd matTapSpectrum(tapers.first.rows(), iNFreqs);
-
-        for (i = 0; i < iNRows; ++i) {
-            // Substract mean
-            rowData.array() = inputData.matData.row(i).array() - inputData.matData.row(i).mean();
-
-            // Calculate tapered spectra
-            for(j = 0; j < tapers.first.rows(); j++) {
-                // Zero padd if necessary. The zero padding in Eigen's FFT is only working for column vectors.
-                if (rowData.cols() < iNfft) {
-                    vecInputFFT.setZero(iNfft);
-                    vecInputFFT.block(0,0,1,rowData.cols()) = rowData.cwiseProduct(tapers.first.row(j));;
-                } else {
-                    vecInputFFT = rowData.cwiseProduct(tapers.first.row(j));
-                }
-
-                // FFT for freq domain returning the half spectrum and multiply taper weights
-                fft.fwd(vecResultFreq, vecInputFFT, iNfft);
-                matTapSpectrum.row(j) = vecResultFreq * tapers.second(j);
-            }
-
-            inputData.vecTapSpectra.append(matTapSpectrum);
-        }
-    }
+    computeTaperedSpectra(inputData,
+                          iNRows,
+                          int(floor(iNfft / 2.0)) + 1,
+                          iNfft,
+                          tapers);
 
 //    iTime = timer.elapsed();
 //    qDebug() << QThread::currentThreadId() << "CrossCorrelation::compute timer - Tapered spectra:" << iTime;
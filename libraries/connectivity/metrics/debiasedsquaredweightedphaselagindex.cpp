@@ -42,7 +42,6 @@
 
 #include "debiasedsquaredweightedphaselagindex.h"
 #include "network/networknode.h"
-#include "network/networkedge.h"
 #include "network/network.h"
 
 #include <utils/spectral.h>
@@ -99,28 +98,10 @@ Network DebiasedSquaredWeightedPhaseLagIndex::calculate(ConnectivitySettings& co
         connectivitySettings.clearIntermediateData();
     }
 
-    finalNetwork.setSamplingFrequency(connectivitySettings.getSamplingFrequency());
-
     #ifdef EIGEN_FFTW_DEFAULT
         fftw_make_planner_thread_safe();
     #endif
 
-    //Create nodes
-    int rows = connectivitySettings.at(0).matData.rows();
-    RowVectorXf rowVert = RowVectorXf::Zero(3);
-
-    for(int i = 0; i < rows; ++i) {
-        rowVert = RowVectorXf::Zero(3);
-
-        if(connectivitySettings.getNodePositions().rows() != 0 && i < connectivitySettings.getNodePositions().rows()) {
-            rowVert(0) = connectivitySettings.getNodePositions().row(i)(0);
-            rowVert(1) = connectivitySettings.getNodePositions().row(i)(1);
-            rowVert(2) = connectivitySettings.getNodePositions().row(i)(2);
-        }
-
-        finalNetwork.append(NetworkNode::SPtr(new NetworkNode(i, rowVert)));
-    }
-
     // Check that iNfft >= signal length
     int iSignalLength = connectivitySettings.at(0).matData.cols();
     int iNfft = connectivitySettings.getFFTSize();
@@ -132,29 +113,17 @@ Network DebiasedSquaredWeightedPhaseLagIndex::calculate(ConnectivitySettings& co
     int iNRows = connectivitySettings.at(0).matData.rows();
     int iNFreqs = int(floor(iNfft / 2.0)) + 1;
 
-    // Check if start and bin amount need to be reset to full spectrum
-    if(m_iNumberBinStart == -1 ||
-       m_iNumberBinAmount == -1 ||
-       m_iNumberBinStart > iNFreqs ||
-       m_iNumberBinAmount > iNFreqs ||
-       m_iNumberBinAmount + m_iNumberBinStart > iNFreqs) {
-        qDebug() << "DebiasedSquaredWeightedPhaseLagIndex::calculate - Resetting to full spectrum";
-        AbstractMetric::m_iNumberBinStart = 0;
-        AbstractMetric::m_iNumberBinAmount = iNFreqs;
-    }
-
-    // Pass information about the FFT length. Use iNFreqs because we only use the half spectrum
-    finalNetwork.setFFTSize(iNFreqs);
-    finalNetwork.setUsedFreqBins(AbstractMetric::m_iNumberBinAmount);
-
-    QMutex mutex;
+    // Create the nodes and check the frequency bin range
+    initSpectralNetwork(finalNetwork,
+                        connectivitySettings,
+                        iNFreqs);
 
-    std::function<void(ConnectivitySettings::IntermediateTrialData&)> computeLambda = [&](ConnectivitySettings::IntermediateTrialData& inputData) {
+    std::function<void(ConnectivitySettings::IntermediateTrialData&, ConnectivitySettings::IntermediateSumData&)> computeLambda = [&](ConnectivitySettings::IntermediateTrialData& inputData,
+                                                                                                                                      ConnectivitySettings::IntermediateSumData& sumData) {
         return compute(inputData,
-                       connectivitySettings.getIntermediateSumData().vecPairCsdSum,
-                       connectivitySettings.getIntermediateSumData().vecPairCsdImagAbsSum,
-                       connectivitySettings.getIntermediateSumData().vecPairCsdImagSqrdSum,
-                       mutex,
+                       sumData.vecPairCsdSum,
+                       sumData.vecPairCsdImagAbsSum,
+                       sumData.vecPairCsdImagSqrdSum,
                        iNRows,
                        iNFreqs,
                        iNfft,
@@ -166,9 +135,7 @@ Network DebiasedSquaredWeightedPhaseLagIndex::calculate(ConnectivitySettings& co
 //    timer.restart();
 
     // Compute DSWPLI in parallel for all trials
-    QFuture<void> result = QtConcurrent::map(connectivitySettings.getTrialData(),
-                                             computeLambda);
-    result.waitForFinished();
+    connectivitySettings.computeIntermediateSums(computeLambda);
 
 //    iTime = timer.elapsed();
 //    qWarning() << "ComputeSpectraPSDCSD" << iTime;
@@ -191,7 +158,6 @@ void DebiasedSquaredWeightedPhaseLagIndex::compute(ConnectivitySettings::Interme
                                                    QVector<QPair<int,MatrixXcd> >& vecPairCsdSum,
                                                    QVector<QPair<int,MatrixXd> >& vecPairCsdImagAbsSum,
                                                    QVector<QPair<int,MatrixXd> >& vecPairCsdImagSqrdSum,
-                                                   QMutex& mutex,
                                                    int iNRows,
                                                    int iNFreqs,
                                                    int iNfft,
@@ -204,105 +170,57 @@ void DebiasedSquaredWeightedPhaseLagIndex::compute(ConnectivitySettings::Interme
         return;
     }
 
-    int i,j;
-
-    // Calculate tapered spectra if not available already
-    // This code was copied and changed modified Utils/Spectra since we do not want to call the function due to time loss.
-    if(inputData.vecTapSpectra.isEmpty()) {
-        RowVectorXd vecInputFFT, rowData;
-        RowVectorXcd vecTmpFreq;
-
-        MatrixXcd matTapSpectrum(tapers.first.rows(), iNFreqs);
-
-        FFT<double> fft;
-        fft.SetFlag(fft.HalfSpectrum);
-
-        for (i = 0; i < iNRows; ++i) {
-            // Substract mean
-            rowData.array() = inputData.matData.row(i).array() - inputData.matData.row(i).mean();
-
-            // Calculate tapered spectra if not available already
-            for(j = 0; j < tapers.first.rows(); j++) {
-                // Zero padd if necessary. The zero padding in Eigen's FFT is only working for column vectors.
-                if (rowData.cols() < iNfft) {
-                    vecInputFFT.setZero(iNfft);
-                    vecInputFFT.block(0,0,1,rowData.cols()) = rowData.cwiseProduct(tapers.first.row(j));;
-                } else {
-                    vecInputFFT = rowData.cwiseProduct(tapers.first.row(j));
-                }
-
-                // FFT for freq domain returning the half spectrum and multiply taper weights
-                fft.fwd(vecTmpFreq, vecInputFFT, iNfft);
-                matTapSpectrum.row(j) = vecTmpFreq * tapers.second(j);
-            }
-
-            inputData.vecTapSpectra.append(matTapSpectrum);
-        }
-    }
+    int i;
 
     // Compute CSD
     if(inputData.vecPairCsd.isEmpty()) {
-        MatrixXcd matCsd(iNRows, m_iNumberBinAmount);
-
-        bool bNfftEven = false;
-        if (iNfft % 2 == 0){
-            bNfftEven = true;
-        }
-
-        double denomCSD = sqrt(tapers.second.cwiseAbs2().sum()) * sqrt(tapers.second.cwiseAbs2().sum()) / 2.0;
+        computeCSD(inputData,
+                   iNRows,
+                   iNFreqs,
+                   iNfft,
+                   tapers);
 
         for (i = 0; i < iNRows; ++i) {
-            for (j = i; j < iNRows; ++j) {
-                // Compute CSD (average over tapers if necessary)
-                matCsd.row(j) = inputData.vecTapSpectra.at(i).block(0,m_iNumberBinStart,inputData.vecTapSpectra.at(i).rows(),m_iNumberBinAmount).cwiseProduct(inputData.vecTapSpectra.at(j).block(0,m_iNumberBinStart,inputData.vecTapSpectra.at(j).rows(),m_iNumberBinAmount).conjugate()).colwise().sum() / denomCSD;
-
-                // Divide first and last element by 2 due to half spectrum
-                if(m_iNumberBinStart == 0) {
-                    matCsd.row(j)(0) /= 2.0;
-                }
-
-                if(bNfftEven && m_iNumberBinStart + m_iNumberBinAmount >= iNFreqs) {
-                    matCsd.row(j).tail(1) /= 2.0;
-                }
-            }
-
-            inputData.vecPairCsd.append(QPair<int,MatrixXcd>(i,matCsd));
-            inputData.vecPairCsdImagSqrd.append(QPair<int,MatrixXd>(i,matCsd.imag().array().square()));
-            inputData.vecPairCsdImagAbs.append(QPair<int,MatrixXd>(i,matCsd.imag().cwiseAbs()));
+            inputData.vecPairCsdImagSqrd.append(QPair<int,MatrixXd>(i,inputData.vecPairCsd.at(i).second.imag().array().square()));
+            inputData.vecPairCsdImagAbs.append(QPair<int,MatrixXd>(i,inputData.vecPairCsd.at(i).second.imag().cwiseAbs()));
         }
 
-        mutex.lock();
-
         if(vecPairCsdSum.isEmpty()) {
             vecPairCsdSum = inputData.vecPairCsd;
-            vecPairCsdImagSqrdSum = inputData.vecPairCsdImagSqrd;
-            vecPairCsdImagAbsSum = inputData.vecPairCsdImagAbs;
         } else {
             for (int j = 0; j < vecPairCsdSum.size(); ++j) {
                 vecPairCsdSum[j].second += inputData.vecPairCsd.at(j).second;
+            }
+        }
+
+        if(vecPairCsdImagSqrdSum.isEmpty()) {
+            vecPairCsdImagSqrdSum = inputData.vecPairCsdImagSqrd;
+        } else {
+            for (int j = 0; j < vecPairCsdImagSqrdSum.size(); ++j) {
                 vecPairCsdImagSqrdSum[j].second += inputData.vecPairCsdImagSqrd.at(j).second;
-                vecPairCsdImagAbsSum[j].second += inputData.vecPairCsdImagAbs.at(j).second;
             }
         }
 
-        mutex.unlock();
+        if(vecPairCsdImagAbsSum.isEmpty()) {
+            vecPairCsdImagAbsSum = inputData.vecPairCsdImagAbs;
+        } else {
+            for (int j = 0; j < vecPairCsdImagAbsSum.size(); ++j) {
+                vecPairCsdImagAbsSum[j].second += inputData.vecPairCsdImagAbs.at(j).second;
+            }
+        }
     } else {
         if(inputData.vecPairCsdImagSqrd.isEmpty()) {
             for (i = 0; i < inputData.vecPairCsd.size(); ++i) {
                 inputData.vecPairCsdImagSqrd.append(QPair<int,MatrixXd>(i,inputData.vecPairCsd.at(i).second.imag().array().square()));
             }
 
-            mutex.lock();
-
             if(vecPairCsdImagSqrdSum.isEmpty()) {
                 vecPairCsdImagSqrdSum = inputData.vecPairCsdImagSqrd;
             } else {
-                for (int j = 0; j < vecPairCsdSum.size(); ++j) {
+                for (int j = 0; j < vecPairCsdImagSqrdSum.size(); ++j) {
                     vecPairCsdImagSqrdSum[j].second += inputData.vecPairCsdImagSqrd.at(j).second;
                 }
             }
-
-            mutex.unlock();
         }
 
         if(inputData.vecPairCsdImagAbs.isEmpty()) {
@@ -310,17 +228,13 @@ void DebiasedSquaredWeightedPhaseLagIndex::compute(ConnectivitySettings::Interme
                 inputData.vecPairCsdImagAbs.append(QPair<int,MatrixXd>(i,inputData.vecPairCsd.at(i).second.imag().cwiseAbs()));
             }
 
-            mutex.lock();
-
             if(vecPairCsdImagAbsSum.isEmpty()) {
                 vecPairCsdImagAbsSum = inputData.vecPairCsdImagAbs;
             } else {
-                for (int j = 0; j < vecPairCsdSum.size(); ++j) {
+                for (int j = 0; j < vecPairCsdImagAbsSum.size(); ++j) {
                     vecPairCsdImagAbsSum[j].second += inputData.vecPairCsdImagAbs.at(j).second;
                 }
             }
-
-            mutex.unlock();
         }
     }
 
@@ -339,8 +253,6 @@ void DebiasedSquaredWeightedPhaseLagIndex::computeDSWPLI(ConnectivitySettings &c
 {
     // Compute final DSWPLI and create Network
     MatrixXd matNom, matDenom;
-    MatrixXd matWeight;
-    QSharedPointer<NetworkEdge> pEdge;
     int j;
 
     for (int i = 0; i < connectivitySettings.at(0).matData.rows(); ++i) {
@@ -355,13 +267,7 @@ void DebiasedSquaredWeightedPhaseLagIndex::computeDSWPLI(ConnectivitySettings &c
         matDenom = matNom.cwiseQuotient(matDenom);
 
         for(j = i; j < connectivitySettings.at(0).matData.rows(); ++j) {
-            matWeight = matDenom.row(j).transpose();
-
-            pEdge = QSharedPointer<NetworkEdge>(new NetworkEdge(i, j, matWeight));
-
-            finalNetwork.getNodeAt(i)->append(pEdge);
-            finalNetwork.getNodeAt(j)->append(pEdge);
-            finalNetwork.append(pEdge);
+            finalNetwork.append(i, j, matDenom.row(j));
         }
 
     }
@@ -42,7 +42,6 @@
 #include "coherency.h"
 #include "imagcoherence.h"
 #include "network/networknode.h"
-#include "network/networkedge.h"
 #include "network/network.h"
 
 //=============================================================================================================
@@ -92,9 +91,6 @@ Network ImagCoherence::calculate(ConnectivitySettings& connectivitySettings)
         connectivitySettings.clearIntermediateData();
     }
 
-    finalNetwork.setSamplingFrequency(connectivitySettings.getSamplingFrequency());
-
-    // Check if start and bin amount need to be reset to full spectrum
     int iNfft = connectivitySettings.getFFTSize();
 
 //    // Check that iNfft >= signal length
@@ -104,35 +100,10 @@ Network ImagCoherence::calculate(ConnectivitySettings& connectivitySettings)
 
     int iNFreqs = int(floor(iNfft / 2.0)) + 1;
 
-    if(m_iNumberBinStart == -1 ||
-       m_iNumberBinAmount == -1 ||
-       m_iNumberBinStart > iNFreqs ||
-       m_iNumberBinAmount > iNFreqs ||
-       m_iNumberBinAmount + m_iNumberBinStart > iNFreqs) {
-        qDebug() << "ImagCoherence::calculate - Resetting to full spectrum";
-        AbstractMetric::m_iNumberBinStart = 0;
-        AbstractMetric::m_iNumberBinAmount = iNFreqs;
-    }
-
-    // Pass information about the FFT length. Use iNFreqs because we only use the half spectrum
-    finalNetwork.setFFTSize(iNFreqs);
-    finalNetwork.setUsedFreqBins(AbstractMetric::m_iNumberBinAmount);
-
-    //Create nodes
-    int rows = connectivitySettings.at(0).matData.rows();
-    RowVectorXf rowVert = RowVectorXf::Zero(3);
-
-    for(int i = 0; i < rows; ++i) {
-        rowVert = RowVectorXf::Zero(3);
-
-        if(connectivitySettings.getNodePositions().rows() != 0 && i < connectivitySettings.getNodePositions().rows()) {
-            rowVert(0) = connectivitySettings.getNodePositions().row(i)(0);
-            rowVert(1) = connectivitySettings.getNodePositions().row(i)(1);
-            rowVert(2) = connectivitySettings.getNodePositions().row(i)(2);
-        }
-
-        finalNetwork.append(NetworkNode::SPtr(new NetworkNode(i, rowVert)));
-    }
+    // Create the nodes and check the frequency bin range
+    initSpectralNetwork(finalNetwork,
+                        connectivitySettings,
+                        iNFreqs);
 
     //Calculate all-to-all imaginary coherence matrix over epochs
     Coherency::calculateImag(finalNetwork,
@@ -53,7 +53,6 @@
 //=============================================================================================================
 
 #include <QSharedPointer>
-#include <QMutex>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -106,6 +105,16 @@ public:
      */
     static Network calculate(ConnectivitySettings &connectivitySettings);
 
+    //=========================================================================================================
+    /**
+     * Reduces the PLV computation to a final result.
+     *
+     * @param[out] connectivitySettings   The input data.
+     * @param[in]  finalNetwork           The final network.
+     */
+    static void computePLV(ConnectivitySettings &connectivitySettings,
+                           Network& finalNetwork);
+
 protected:
     //=========================================================================================================
     /**
@@ -114,7 +123,6 @@ protected:
      * @param[in] inputData                  The input data.
      * @param[out]vecPairCsdSum              The sum of all CSD matrices for each trial.
      * @param[out]vecPairCsdNormalizedSum    The sum of all normalized CSD matrices for each trial.
-     * @param[in] mutex                      The mutex used to safely access vecPairCsdSum.
      * @param[in] iNRows                     The number of rows.
      * @param[in] iNFreqs                    The number of frequenciy bins.
      * @param[in] iNfft                      The FFT length.
@@ -123,21 +131,10 @@ protected:
     static void compute(ConnectivitySettings::IntermediateTrialData& inputData,
                         QVector<QPair<int,Eigen::MatrixXcd> >& vecPairCsdSum,
                         QVector<QPair<int,Eigen::MatrixXcd> >& vecPairCsdNormalizedSum,
-                        QMutex& mutex,
                         int iNRows,
                         int iNFreqs,
                         int iNfft,
                         const QPair<Eigen::MatrixXd, Eigen::VectorXd>& tapers);
-
-    //=========================================================================================================
-    /**
-     * Reduces the PLV computation to a final result.
-     *
-     * @param[out] connectivitySettings   The input data.
-     * @param[in]  finalNetwork           The final network.
-     */
-    static void computePLV(ConnectivitySettings &connectivitySettings,
-                           Network& finalNetwork);
 };
 
 //=============================================================================================================
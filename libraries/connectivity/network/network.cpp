@@ -44,6 +44,7 @@
 
 #include <utils/spectral.h>
 
+#include <algorithm>
 #include <limits>
 
 //=============================================================================================================
@@ -68,13 +69,79 @@ using namespace UTILSLIB;
 // DEFINE GLOBAL METHODS
 //=============================================================================================================
 
+namespace {
+
+//=============================================================================================================
+
+bool getAveragingBins(const QPair<int,int>& minMaxFreqBins,
+                      int iNumberBins,
+                      int& iStartBin,
+                      int& iNumberAveragedBins)
+{
+    // Same bin range rules as NetworkEdge::calculateAveragedWeight
+    if(minMaxFreqBins.first == -1 && minMaxFreqBins.second == -1) {
+        iStartBin = 0;
+        iNumberAveragedBins = iNumberBins;
+        return iNumberBins > 0;
+    }
+
+    if(minMaxFreqBins.second < minMaxFreqBins.first || minMaxFreqBins.first < 0 || minMaxFreqBins.first >= iNumberBins) {
+        return false;
+    }
+
+    iStartBin = minMaxFreqBins.first;
+    iNumberAveragedBins = std::min(minMaxFreqBins.second, iNumberBins - 1) - iStartBin + 1;
+
+    return true;
+}
+
+//=============================================================================================================
+
+VectorXi countEdges(const Array<bool, Dynamic, Dynamic>& matEdgeMask,
+                    int iNumberNodes,
+                    bool bCountIn,
+                    bool bCountOut)
+{
+    VectorXi vecDegrees = VectorXi::Zero(iNumberNodes);
+
+    if(matEdgeMask.rows() != iNumberNodes) {
+        return vecDegrees;
+    }
+
+    // Rows hold the outgoing, columns the incoming edges of a node
+    if(bCountOut) {
+        vecDegrees += matEdgeMask.rowwise().count().cast<int>().matrix();
+    }
+
+    if(bCountIn) {
+        vecDegrees += matEdgeMask.colwise().count().transpose().cast<int>().matrix();
+    }
+
+    return vecDegrees;
+}
+
+//=============================================================================================================
+
+QPair<int,int> getMinMax(const VectorXi& vecDegrees)
+{
+    if(vecDegrees.size() == 0) {
+        return QPair<int,int>(0,0);
+    }
+
+    return QPair<int,int>(vecDegrees.minCoeff(),vecDegrees.maxCoeff());
+}
+
+}
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
 
 Network::Network(const QString& sConnectivityMethod,
                  double dThreshold)
-: m_sConnectivityMethod(sConnectivityMethod)
+: m_pBinWeights(new NetworkBinWeights)
+, m_minMaxFreqBins(QPair<int,int>(-1,-1))
+, m_sConnectivityMethod(sConnectivityMethod)
 , m_minMaxFullWeights(QPair<double,double>(std::numeric_limits<double>::max(),0.0))
 , m_minMaxThresholdedWeights(QPair<double,double>(std::numeric_limits<double>::max(),0.0))
 , m_dThreshold(dThreshold)
@@ -92,102 +159,190 @@ Network::Network(const QString& sConnectivityMethod,
 
 MatrixXd Network::getFullConnectivityMatrix(bool bGetMirroredVersion) const
 {
-    MatrixXd matDist(m_lNodes.size(), m_lNodes.size());
-    matDist.setZero();
+    int iNumberNodes = m_matNodePositions.rows();
 
-    for(int i = 0; i < m_lFullEdges.size(); ++i) {
-        int row = m_lFullEdges.at(i)->getStartNodeID();
-        int col = m_lFullEdges.at(i)->getEndNodeID();
+    if(m_matEdgeMask.size() == 0) {
+        return MatrixXd::Zero(iNumberNodes, iNumberNodes);
+    }
 
-        if(row < matDist.rows() && col < matDist.cols()) {
-            matDist(row,col) = m_lFullEdges.at(i)->getWeight();
+    if(bGetMirroredVersion) {
+        return m_matEdgeMask.select(m_matWeights, m_matWeights.transpose());
+    }
 
-            if(bGetMirroredVersion) {
-                matDist(col,row) = m_lFullEdges.at(i)->getWeight();
-            }
-        }
+    return m_matWeights;
+}
+
+//=============================================================================================================
+
+MatrixXd Network::getThresholdedConnectivityMatrix(bool bGetMirroredVersion) const
+{
+    int iNumberNodes = m_matNodePositions.rows();
+
+    if(m_matEdgeMask.size() == 0) {
+        return MatrixXd::Zero(iNumberNodes, iNumberNodes);
+    }
+
+    Array<bool, Dynamic, Dynamic> matActive = getThresholdedEdgeMask();
+    MatrixXd matDist = matActive.select(m_matWeights, 0.0);
+
+    if(bGetMirroredVersion) {
+        return matActive.select(matDist, matDist.transpose());
     }
 
-    //IOUtils::write_eigen_matrix(matDist,"eigen.txt");
     return matDist;
 }
 
 //=============================================================================================================
 
-MatrixXd Network::getThresholdedConnectivityMatrix(bool bGetMirroredVersion) const
+SparseMatrix<double, RowMajor> Network::getThresholdedSparseConnectivityMatrix() const
 {
-    MatrixXd matDist(m_lNodes.size(), m_lNodes.size());
-    matDist.setZero();
+    int iNumberNodes = m_matNodePositions.rows();
+    SparseMatrix<double, RowMajor> matDist(iNumberNodes, iNumberNodes);
 
-    for(int i = 0; i < m_lThresholdedEdges.size(); ++i) {
-        int row = m_lThresholdedEdges.at(i)->getStartNodeID();
-        int col = m_lThresholdedEdges.at(i)->getEndNodeID();
+    if(m_matEdgeMask.size() == 0) {
+        return matDist;
+    }
 
-        if(row < matDist.rows() && col < matDist.cols()) {
-            matDist(row,col) = m_lThresholdedEdges.at(i)->getWeight();
+    Array<bool, Dynamic, Dynamic> matActive = getThresholdedEdgeMask();
+    matDist.reserve(VectorXi(matActive.rowwise().count().cast<int>().matrix()));
 
-            if(bGetMirroredVersion) {
-                matDist(col,row) = m_lThresholdedEdges.at(i)->getWeight();
+    // Walking the columns in the outer loop keeps the inserts of each row sorted and the dense reads contiguous
+    for(int j = 0; j < iNumberNodes; ++j) {
+        for(int i = 0; i < iNumberNodes; ++i) {
+            if(matActive(i,j)) {
+                matDist.insert(i,j) = m_matWeights(i,j);
             }
         }
     }
 
-    //IOUtils::write_eigen_matrix(matDist,"eigen.txt");
+    matDist.makeCompressed();
+
     return matDist;
 }
 
 //=============================================================================================================
 
-const QList<NetworkEdge::SPtr>& Network::getFullEdges() const
+VectorXd Network::getEdgeWeights(int iStartNodeID,
+                                 int iEndNodeID) const
 {
-    return m_lFullEdges;
+    int iNumberNodes = m_matEdgeMask.rows();
+
+    if(iStartNodeID < 0 || iEndNodeID < 0 || iStartNodeID >= iNumberNodes || iEndNodeID >= iNumberNodes
+       || !m_matEdgeMask(iStartNodeID,iEndNodeID)) {
+        return VectorXd();
+    }
+
+    return m_pBinWeights->matWeights.col(iStartNodeID * iNumberNodes + iEndNodeID);
 }
 
 //=============================================================================================================
 
-const QList<NetworkEdge::SPtr>& Network::getThresholdedEdges() const
+QList<NetworkEdge::SPtr> Network::getFullEdges() const
 {
-    return m_lThresholdedEdges;
+    return createEdges(false);
 }
 
 //=============================================================================================================
 
-const QList<NetworkNode::SPtr>& Network::getNodes() const
+QList<NetworkEdge::SPtr> Network::getThresholdedEdges() const
 {
-    return m_lNodes;
+    return createEdges(true);
 }
 
 //=============================================================================================================
 
-NetworkNode::SPtr Network::getNodeAt(int i)
+QList<NetworkNode::SPtr> Network::getNodes() const
 {
-    return m_lNodes.at(i);
+    QList<NetworkNode::SPtr> lNodes;
+    lNodes.reserve(m_matNodePositions.rows());
+
+    for(int i = 0; i < m_matNodePositions.rows(); ++i) {
+        lNodes << NetworkNode::SPtr(new NetworkNode(i, m_matNodePositions.row(i)));
+    }
+
+    QList<NetworkEdge::SPtr> lEdges = createEdges(false);
+
+    for(int i = 0; i < lEdges.size(); ++i) {
+        lNodes.at(lEdges.at(i)->getStartNodeID())->append(lEdges.at(i));
+        lNodes.at(lEdges.at(i)->getEndNodeID())->append(lEdges.at(i));
+    }
+
+    return lNodes;
 }
 
 //=============================================================================================================
 
-qint16 Network::getFullDistribution() const
+const MatrixX3f& Network::getNodePositions() const
 {
-    qint16 distribution = 0;
+    return m_matNodePositions;
+}
+
+//=============================================================================================================
 
-    for(int i = 0; i < m_lNodes.size(); ++i) {
-        distribution += m_lNodes.at(i)->getFullDegree();
+NetworkEdge::SPtr Network::getEdgeAt(int i)
+{
+    for(int iStart = 0; iStart < m_matEdgeMask.rows(); ++iStart) {
+        for(int iEnd = 0; iEnd < m_matEdgeMask.cols(); ++iEnd) {
+            if(m_matEdgeMask(iStart,iEnd) && i-- == 0) {
+                return createEdge(iStart, iEnd, fabs(m_matWeights(iStart,iEnd)) >= m_dThreshold);
+            }
+        }
     }
 
-    return distribution;
+    return NetworkEdge::SPtr();
 }
 
 //=============================================================================================================
 
-qint16 Network::getThresholdedDistribution() const
+NetworkNode::SPtr Network::getNodeAt(int i)
 {
-    qint16 distribution = 0;
+    NetworkNode::SPtr pNode = NetworkNode::SPtr(new NetworkNode(i, m_matNodePositions.row(i)));
 
-    for(int i = 0; i < m_lNodes.size(); ++i) {
-        distribution += m_lNodes.at(i)->getThresholdedDegree();
+    if(m_matEdgeMask.size() == 0) {
+        return pNode;
     }
 
-    return distribution;
+    Array<bool, Dynamic, Dynamic> matActive = getThresholdedEdgeMask();
+
+    for(int j = 0; j < m_matEdgeMask.rows(); ++j) {
+        if(m_matEdgeMask(i,j)) {
+            pNode->append(createEdge(i, j, matActive(i,j)));
+        }
+
+        if(m_matEdgeMask(j,i)) {
+            pNode->append(createEdge(j, i, matActive(j,i)));
+        }
+    }
+
+    return pNode;
+}
+
+//=============================================================================================================
+
+qint16 Network::getFullDistribution() const
+{
+    return getFullDegrees().sum();
+}
+
+//=============================================================================================================
+
+qint16 Network::getThresholdedDistribution() const
+{
+    return getThresholdedDegrees().sum();
+}
+
+//=============================================================================================================
+
+VectorXi Network::getFullDegrees() const
+{
+    return countEdges(m_matEdgeMask, m_matNodePositions.rows(), true, true);
+}
+
+//=============================================================================================================
+
+VectorXi Network::getThresholdedDegrees() const
+{
+    return countEdges(getThresholdedEdgeMask(), m_matNodePositions.rows(), true, true);
 }
 
 //=============================================================================================================
@@ -222,125 +377,50 @@ QPair<double, double> Network::getMinMaxThresholdedWeights() const
 
 QPair<int,int> Network::getMinMaxFullDegrees() const
 {
-    int maxDegree = 0;
-    int minDegree = 1000000;
-
-    for(int i = 0; i < m_lNodes.size(); ++i) {
-        if(m_lNodes.at(i)->getFullDegree() > maxDegree){
-            maxDegree = m_lNodes.at(i)->getFullDegree();
-        } else if (m_lNodes.at(i)->getFullDegree() < minDegree){
-            minDegree = m_lNodes.at(i)->getFullDegree();
-        }
-    }
-
-    return QPair<int,int>(minDegree,maxDegree);
+    return getMinMax(getFullDegrees());
 }
 
 //=============================================================================================================
 
 QPair<int,int> Network::getMinMaxThresholdedDegrees() const
 {
-    int maxDegree = 0;
-    int minDegree = 1000000;
-
-    for(int i = 0; i < m_lNodes.size(); ++i) {
-        if(m_lNodes.at(i)->getThresholdedDegree() > maxDegree){
-            maxDegree = m_lNodes.at(i)->getThresholdedDegree();
-        } else if (m_lNodes.at(i)->getThresholdedDegree() < minDegree){
-            minDegree = m_lNodes.at(i)->getThresholdedDegree();
-        }
-    }
-
-    return QPair<int,int>(minDegree,maxDegree);
+    return getMinMax(getThresholdedDegrees());
 }
 
 //=============================================================================================================
 
 QPair<int,int> Network::getMinMaxFullIndegrees() const
 {
-    int maxDegree = 0;
-    int minDegree = 1000000;
-
-    for(int i = 0; i < m_lNodes.size(); ++i) {
-        if(m_lNodes.at(i)->getFullIndegree() > maxDegree){
-            maxDegree = m_lNodes.at(i)->getFullIndegree();
-        } else if (m_lNodes.at(i)->getFullIndegree() < minDegree){
-            minDegree = m_lNodes.at(i)->getFullIndegree();
-        }
-    }
-
-    return QPair<int,int>(minDegree,maxDegree);
+    return getMinMax(countEdges(m_matEdgeMask, m_matNodePositions.rows(), true, false));
 }
 
 //=============================================================================================================
 
 QPair<int,int> Network::getMinMaxThresholdedIndegrees() const
 {
-    int maxDegree = 0;
-    int minDegree = 1000000;
-
-    for(int i = 0; i < m_lNodes.size(); ++i) {
-        if(m_lNodes.at(i)->getThresholdedIndegree() > maxDegree){
-            maxDegree = m_lNodes.at(i)->getThresholdedIndegree();
-        } else if (m_lNodes.at(i)->getThresholdedIndegree() < minDegree){
-            minDegree = m_lNodes.at(i)->getThresholdedIndegree();
-        }
-    }
-
-    return QPair<int,int>(minDegree,maxDegree);
+    return getMinMax(countEdges(getThresholdedEdgeMask(), m_matNodePositions.rows(), true, false));
 }
 
 //=============================================================================================================
 
 QPair<int,int> Network::getMinMaxFullOutdegrees() const
 {
-    int maxDegree = 0;
-    int minDegree = 1000000;
-
-    for(int i = 0; i < m_lNodes.size(); ++i) {
-        if(m_lNodes.at(i)->getFullOutdegree() > maxDegree){
-            maxDegree = m_lNodes.at(i)->getFullOutdegree();
-        } else if (m_lNodes.at(i)->getFullOutdegree() < minDegree){
-            minDegree = m_lNodes.at(i)->getFullOutdegree();
-        }
-    }
-
-    return QPair<int,int>(minDegree,maxDegree);
+    return getMinMax(countEdges(m_matEdgeMask, m_matNodePositions.rows(), false, true));
 }
 
 //=============================================================================================================
 
 QPair<int,int> Network::getMinMaxThresholdedOutdegrees() const
 {
-    int maxDegree = 0;
-    int minDegree = 1000000;
-
-    for(int i = 0; i < m_lNodes.size(); ++i) {
-        if(m_lNodes.at(i)->getThresholdedOutdegree() > maxDegree){
-            maxDegree = m_lNodes.at(i)->getThresholdedOutdegree();
-        } else if (m_lNodes.at(i)->getThresholdedOutdegree() < minDegree){
-            minDegree = m_lNodes.at(i)->getThresholdedOutdegree();
-        }
-    }
-
-    return QPair<int,int>(minDegree,maxDegree);
+    return getMinMax(countEdges(getThresholdedEdgeMask(), m_matNodePositions.rows(), false, true));
 }
 
 //=============================================================================================================
 
 void Network::setThreshold(double dThreshold)
 {
+    // The active edges are derived from the averaged weights whenever they are requested
     m_dThreshold = dThreshold;
-    m_lThresholdedEdges.clear();
-
-    for(int i = 0; i < m_lFullEdges.size(); ++i) {
-        if(fabs(m_lFullEdges.at(i)->getWeight()) >= m_dThreshold) {
-            m_lFullEdges.at(i)->setActive(true);
-            m_lThresholdedEdges.append(m_lFullEdges.at(i));
-        } else {
-            m_lFullEdges.at(i)->setActive(false);
-        }
-    }
 
     m_minMaxThresholdedWeights.first = m_dThreshold;
     m_minMaxThresholdedWeights.second = m_minMaxFullWeights.second;
@@ -385,17 +465,18 @@ void Network::setFrequencyRange(float fLowerFreq, float fUpperFreq)
     int iLowerBin = fLowerFreq * dScaleFactor;
     int iUpperBin = fUpperFreq * dScaleFactor;
 
+    m_minMaxFreqBins = QPair<int,int>(iLowerBin,iUpperBin);
+
+    updateAveragedWeights();
+
     // Update the min max values
     m_minMaxFullWeights = QPair<double,double>(std::numeric_limits<double>::max(),0.0);
 
-    for(int i = 0; i < m_lFullEdges.size(); ++i) {
-        m_lFullEdges.at(i)->setFrequencyBins(QPair<int,int>(iLowerBin,iUpperBin));
+    if(m_matEdgeMask.size() != 0) {
+        ArrayXXd matAbsWeights = m_matWeights.array().abs();
 
-        if(fabs(m_lFullEdges.at(i)->getWeight()) < m_minMaxFullWeights.first) {
-            m_minMaxFullWeights.first = fabs(m_lFullEdges.at(i)->getWeight());
-        } else if(fabs(m_lFullEdges.at(i)->getWeight()) > m_minMaxFullWeights.second) {
-            m_minMaxFullWeights.second = fabs(m_lFullEdges.at(i)->getWeight());
-        }
+        m_minMaxFullWeights.first = m_matEdgeMask.select(matAbsWeights, std::numeric_limits<double>::max()).minCoeff();
+        m_minMaxFullWeights.second = m_matEdgeMask.select(matAbsWeights, 0.0).maxCoeff();
     }
 }
 
@@ -410,19 +491,32 @@ const QPair<float,float>& Network::getFrequencyRange() const
 
 void Network::append(NetworkEdge::SPtr newEdge)
 {
-    if(newEdge->getEndNodeID() != newEdge->getStartNodeID()) {
-        double dEdgeWeight = newEdge->getWeight();
-        if(dEdgeWeight < m_minMaxFullWeights.first) {
-            m_minMaxFullWeights.first = dEdgeWeight;
-        } else if(dEdgeWeight >= m_minMaxFullWeights.second) {
-            m_minMaxFullWeights.second = dEdgeWeight;
-        }
+    int iStartNodeID = newEdge->getStartNodeID();
+    int iEndNodeID = newEdge->getEndNodeID();
+    MatrixXd matWeight = newEdge->getMatrixWeight();
 
-        m_lFullEdges << newEdge;
+    // Only the first weight column is kept, which is also the one NetworkEdge averages over a frequency range
+    if(appendBinWeights(iStartNodeID, iEndNodeID, matWeight.col(0).transpose())) {
+        setAveragedWeight(iStartNodeID, iEndNodeID, newEdge->getWeight());
+    }
+}
 
-        if(fabs(newEdge->getWeight()) >= m_dThreshold) {
-            m_lThresholdedEdges << newEdge;
-        }
+//=============================================================================================================
+
+void Network::append(int iStartNodeID,
+                     int iEndNodeID,
+                     const Ref<const RowVectorXd, 0, InnerStride<> >& vecWeights)
+{
+    if(!appendBinWeights(iStartNodeID, iEndNodeID, vecWeights)) {
+        return;
+    }
+
+    int iStartBin, iNumberAveragedBins;
+
+    if(getAveragingBins(m_minMaxFreqBins, vecWeights.size(), iStartBin, iNumberAveragedBins)) {
+        setAveragedWeight(iStartNodeID, iEndNodeID, vecWeights.segment(iStartBin, iNumberAveragedBins).mean());
+    } else {
+        setAveragedWeight(iStartNodeID, iEndNodeID, vecWeights.mean());
     }
 }
 
@@ -430,14 +524,24 @@ void Network::append(NetworkEdge::SPtr newEdge)
 
 void Network::append(NetworkNode::SPtr newNode)
 {
-    m_lNodes << newNode;
+    int iNumberNodes = m_matNodePositions.rows();
+    const RowVectorXf& vecVert = newNode->getVert();
+    int iNumberCoords = std::min<int>(3, vecVert.cols());
+
+    m_matNodePositions.conservativeResize(iNumberNodes + 1, NoChange);
+    m_matNodePositions.row(iNumberNodes).setZero();
+    m_matNodePositions.row(iNumberNodes).head(iNumberCoords) = vecVert.head(iNumberCoords);
+
+    if(m_matEdgeMask.size() != 0) {
+        resizeEdgeData(m_pBinWeights.constData()->matWeights.rows());
+    }
 }
 
 //=============================================================================================================
 
 bool Network::isEmpty() const
 {
-    if(m_lFullEdges.isEmpty() || m_lNodes.isEmpty()) {
+    if(m_matEdgeMask.size() == 0 || m_matNodePositions.rows() == 0) {
         return true;
     }
 
@@ -454,9 +558,7 @@ void Network::normalize()
         return;
     }
 
-    for(int i = 0; i < m_lFullEdges.size(); ++i) {
-        m_lFullEdges.at(i)->setWeight(m_lFullEdges.at(i)->getWeight()/m_minMaxFullWeights.second);
-    }
+    m_matWeights /= m_minMaxFullWeights.second;
 
     m_minMaxFullWeights.first = m_minMaxFullWeights.first/m_minMaxFullWeights.second;
     m_minMaxFullWeights.second = 1.0;
@@ -521,3 +623,148 @@ int Network::getFFTSize()
     return m_iFFTSize;
 }
 
+//=============================================================================================================
+
+Array<bool, Dynamic, Dynamic> Network::getThresholdedEdgeMask() const
+{
+    if(m_matEdgeMask.size() == 0) {
+        return m_matEdgeMask;
+    }
+
+    return m_matEdgeMask && (m_matWeights.array().abs() >= m_dThreshold);
+}
+
+//=============================================================================================================
+
+NetworkEdge::SPtr Network::createEdge(int iStartNodeID,
+                                      int iEndNodeID,
+                                      bool bIsActive) const
+{
+    NetworkEdge::SPtr pEdge = NetworkEdge::SPtr(new NetworkEdge(iStartNodeID,
+                                                                iEndNodeID,
+                                                                getEdgeWeights(iStartNodeID, iEndNodeID),
+                                                                bIsActive,
+                                                                m_minMaxFreqBins.first,
+                                                                m_minMaxFreqBins.second));
+
+    // The averaged weight might have been normalized in the meantime
+    pEdge->setWeight(m_matWeights(iStartNodeID,iEndNodeID));
+
+    return pEdge;
+}
+
+//=============================================================================================================
+
+QList<NetworkEdge::SPtr> Network::createEdges(bool bOnlyThresholded) const
+{
+    QList<NetworkEdge::SPtr> lEdges;
+
+    if(m_matEdgeMask.size() == 0) {
+        return lEdges;
+    }
+
+    Array<bool, Dynamic, Dynamic> matActive = getThresholdedEdgeMask();
+
+    for(int i = 0; i < m_matEdgeMask.rows(); ++i) {
+        for(int j = 0; j < m_matEdgeMask.cols(); ++j) {
+            if(m_matEdgeMask(i,j) && (matActive(i,j) || !bOnlyThresholded)) {
+                lEdges << createEdge(i, j, matActive(i,j));
+            }
+        }
+    }
+
+    return lEdges;
+}
+
+//=============================================================================================================
+
+bool Network::appendBinWeights(int iStartNodeID,
+                               int iEndNodeID,
+                               const Ref<const RowVectorXd, 0, InnerStride<> >& vecWeights)
+{
+    int iNumberNodes = m_matNodePositions.rows();
+
+    if(iStartNodeID == iEndNodeID) {
+        return false;
+    }
+
+    if(iStartNodeID < 0 || iEndNodeID < 0 || iStartNodeID >= iNumberNodes || iEndNodeID >= iNumberNodes) {
+        qDebug() << "Network::append - Edge node IDs are out of range. Nodes need to be appended before their edges. Returning.";
+        return false;
+    }
+
+    if(vecWeights.size() == 0) {
+        qDebug() << "Network::append - Edge has no weights. Returning.";
+        return false;
+    }
+
+    if(m_matEdgeMask.size() == 0) {
+        resizeEdgeData(vecWeights.size());
+    } else if(vecWeights.size() != m_pBinWeights.constData()->matWeights.rows()) {
+        qDebug() << "Network::append - Number of edge weights differs from the other edges. Returning.";
+        return false;
+    }
+
+    // Detaches the weights if they are still shared with a copy of this network
+    m_pBinWeights->matWeights.col(iStartNodeID * iNumberNodes + iEndNodeID) = vecWeights.transpose();
+
+    return true;
+}
+
+//=============================================================================================================
+
+void Network::setAveragedWeight(int iStartNodeID,
+                                int iEndNodeID,
+                                double dWeight)
+{
+    m_matWeights(iStartNodeID,iEndNodeID) = dWeight;
+    m_matEdgeMask(iStartNodeID,iEndNodeID) = true;
+
+    if(dWeight < m_minMaxFullWeights.first) {
+        m_minMaxFullWeights.first = dWeight;
+    }
+
+    if(dWeight > m_minMaxFullWeights.second) {
+        m_minMaxFullWeights.second = dWeight;
+    }
+}
+
+//=============================================================================================================
+
+void Network::resizeEdgeData(int iNumberBins)
+{
+    int iNumberNodes = m_matNodePositions.rows();
+    int iOldNumberNodes = m_matEdgeMask.rows();
+    const MatrixXd& matOldWeights = m_pBinWeights.constData()->matWeights;
+
+    // Edge (i,j) lives in column i*nodes+j, so the block of each start node moves as a whole. Columns without an edge
+    // are zeroed since the averaging reads all columns before masking them out.
+    NetworkBinWeights* pBinWeights = new NetworkBinWeights;
+    pBinWeights->matWeights.setZero(iNumberBins, iNumberNodes * iNumberNodes);
+
+    for(int i = 0; i < iOldNumberNodes; ++i) {
+        pBinWeights->matWeights.middleCols(i * iNumberNodes, iOldNumberNodes) = matOldWeights.middleCols(i * iOldNumberNodes, iOldNumberNodes);
+    }
+
+    m_pBinWeights = pBinWeights;
+    m_matWeights.conservativeResizeLike(MatrixXd::Zero(iNumberNodes, iNumberNodes));
+    m_matEdgeMask.conservativeResizeLike(Array<bool, Dynamic, Dynamic>::Constant(iNumberNodes, iNumberNodes, false));
+}
+
+//=============================================================================================================
+
+void Network::updateAveragedWeights()
+{
+    int iStartBin, iNumberAveragedBins;
+
+    const MatrixXd& matBinWeights = m_pBinWeights.constData()->matWeights;
+
+    if(m_matEdgeMask.size() == 0 || !getAveragingBins(m_minMaxFreqBins, matBinWeights.rows(), iStartBin, iNumberAveragedBins)) {
+        return;
+    }
+
+    int iNumberNodes = m_matEdgeMask.rows();
+    RowVectorXd vecMeans = matBinWeights.middleRows(iStartBin, iNumberAveragedBins).colwise().mean();
+
+    m_matWeights = m_matEdgeMask.select(Map<const Matrix<double, Dynamic, Dynamic, RowMajor> >(vecMeans.data(), iNumberNodes, iNumberNodes), 0.0);
+}
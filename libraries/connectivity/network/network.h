@@ -45,6 +45,8 @@
 // QT INCLUDES
 //=============================================================================================================
 
+#include <QSharedData>
+#include <QSharedDataPointer>
 #include <QSharedPointer>
 
 //=============================================================================================================
@@ -52,6 +54,7 @@
 //=============================================================================================================
 
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 
 //=============================================================================================================
 // FORWARD DECLARATIONS
@@ -77,9 +80,21 @@ struct VisualizationInfo {
     Eigen::Vector4i colEdges = Eigen::Vector4i(255, 0, 0, 255); /**< The edge color.*/
 };
 
+//=============================================================================================================
+/**
+ * The per frequency bin weights of all edges of a network. Implicitly shared between copies of a network, so copying a
+ * network does not copy the weights.
+ */
+struct NetworkBinWeights : public QSharedData
+{
+    Eigen::MatrixXd matWeights;     /**< The weights as one (bins x nodes*nodes) block. Edge (i,j) is column i*nodes+j. Columns without an edge are zero.*/
+};
+
 //=============================================================================================================
 /**
  * This class holds information (nodes and connecting edges) about a network, can compute a distance table and provide network metrics.
+ * Edges are not stored as individual objects. Their per frequency bin weights live in one contiguous block, the averaged weights
+ * in a dense nodes x nodes matrix. NetworkEdge and NetworkNode objects are created on request as views of this data.
  *
  * @brief This class holds information about a network, can compute a distance table and provide network metrics.
  */
@@ -127,27 +142,57 @@ public:
 
     //=========================================================================================================
     /**
-     * Returns the full and non thresholded edges.
+     * Returns the thresholded network as a sparse matrix in compressed row storage. Row i holds the active edges starting at node i,
+     * the lower part of the matrix is only populated for directional edges.
+     *
+     * @return    The sparse thresholded connectivity matrix.
+     */
+    Eigen::SparseMatrix<double, Eigen::RowMajor> getThresholdedSparseConnectivityMatrix() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the per frequency bin weights of an edge.
+     *
+     * @param[in] iStartNodeID   The start node of the edge.
+     * @param[in] iEndNodeID     The end node of the edge.
+     *
+     * @return    The weights of the edge as a column vector. Empty if the edge is not part of the network.
+     */
+    Eigen::VectorXd getEdgeWeights(int iStartNodeID,
+                                   int iEndNodeID) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the full and non thresholded edges. The edges are created from the network data on each call.
      *
      * @return Returns the network edges.
      */
-    const QList<QSharedPointer<NetworkEdge> >& getFullEdges() const;
+    QList<QSharedPointer<NetworkEdge> > getFullEdges() const;
 
     //=========================================================================================================
     /**
-     * Returns the thresholded edges.
+     * Returns the thresholded edges. The edges are created from the network data on each call.
      *
      * @return Returns the network edges.
      */
-    const QList<QSharedPointer<NetworkEdge> >& getThresholdedEdges() const;
+    QList<QSharedPointer<NetworkEdge> > getThresholdedEdges() const;
 
     //=========================================================================================================
     /**
-     * Returns the nodes.
+     * Returns the nodes together with their edges. The nodes are created from the network data on each call, changes made to
+     * them are not written back to the network.
      *
      * @return Returns the network nodes.
      */
-    const QList<QSharedPointer<NetworkNode> >& getNodes() const;
+    QList<QSharedPointer<NetworkNode> > getNodes() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the node positions.
+     *
+     * @return Returns the 3D positions of the nodes. Row i corresponds to the node with ID i.
+     */
+    const Eigen::MatrixX3f& getNodePositions() const;
 
     //=========================================================================================================
     /**
@@ -165,7 +210,7 @@ public:
      *
      * @param[in] i      The index to look up the node. i must be a valid index position in the network list (i.e., 0 <= i < size()).
      *
-     * @return Returns the network node.
+     * @return Returns the network node. Changes made to it are not written back to the network.
      */
     QSharedPointer<NetworkNode> getNodeAt(int i);
 
@@ -185,6 +230,22 @@ public:
      */
     qint16 getThresholdedDistribution() const;
 
+    //=========================================================================================================
+    /**
+     * Returns the degree (in and out) of each node corresponding to the full network.
+     *
+     * @return   The node degrees. Entry i corresponds to the node with ID i.
+     */
+    Eigen::VectorXi getFullDegrees() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the degree (in and out) of each node corresponding to the thresholded network.
+     *
+     * @return   The node degrees. Entry i corresponds to the node with ID i.
+     */
+    Eigen::VectorXi getThresholdedDegrees() const;
+
     //=========================================================================================================
     /**
      * Sets the connectivity measure method used to create the data of this network structure.
@@ -306,6 +367,19 @@ public:
      */
     void append(QSharedPointer<NetworkEdge> newEdge);
 
+    //=========================================================================================================
+    /**
+     * Appends a network edge by writing its weights directly into the network data. The start and end node must
+     * have been appended before. Self-connections are ignored.
+     *
+     * @param[in] iStartNodeID   The start node of the edge.
+     * @param[in] iEndNodeID     The end node of the edge.
+     * @param[in] vecWeights     The weights of the edge, e.g. one per frequency bin. All edges must have the same number of weights.
+     */
+    void append(int iStartNodeID,
+                int iEndNodeID,
+                const Eigen::Ref<const Eigen::RowVectorXd, 0, Eigen::InnerStride<> >& vecWeights);
+
     //=========================================================================================================
     /**
      * Appends a network edge to this network node.
@@ -393,10 +467,83 @@ public:
     int getFFTSize();
 
 protected:
-    QList<QSharedPointer<NetworkEdge> >     m_lFullEdges;               /**< List with all edges of the network.*/
-    QList<QSharedPointer<NetworkEdge> >     m_lThresholdedEdges;        /**< List with all the active (thresholded) edges of the network.*/
+    //=========================================================================================================
+    /**
+     * Returns which node pairs are connected by an edge that passes the current threshold.
+     *
+     * @return   The mask of active edges. Empty if no edge was appended yet.
+     */
+    Eigen::Array<bool, Eigen::Dynamic, Eigen::Dynamic> getThresholdedEdgeMask() const;
+
+    //=========================================================================================================
+    /**
+     * Creates an edge object from the network data.
+     *
+     * @param[in] iStartNodeID   The start node of the edge.
+     * @param[in] iEndNodeID     The end node of the edge.
+     * @param[in] bIsActive      Whether the edge passes the current threshold.
+     *
+     * @return   The edge.
+     */
+    QSharedPointer<NetworkEdge> createEdge(int iStartNodeID,
+                                           int iEndNodeID,
+                                           bool bIsActive) const;
+
+    //=========================================================================================================
+    /**
+     * Creates the edge objects, ordered by start and then end node.
+     *
+     * @param[in] bOnlyThresholded   Whether to only create the edges which pass the current threshold.
+     *
+     * @return   The edges.
+     */
+    QList<QSharedPointer<NetworkEdge> > createEdges(bool bOnlyThresholded) const;
+
+    //=========================================================================================================
+    /**
+     * Writes the per frequency bin weights of an edge into the network data.
+     *
+     * @param[in] iStartNodeID   The start node of the edge.
+     * @param[in] iEndNodeID     The end node of the edge.
+     * @param[in] vecWeights     The weights of the edge.
+     *
+     * @return   Whether the edge is part of the network, i.e. no self-connection and valid node IDs and weights.
+     */
+    bool appendBinWeights(int iStartNodeID,
+                          int iEndNodeID,
+                          const Eigen::Ref<const Eigen::RowVectorXd, 0, Eigen::InnerStride<> >& vecWeights);
+
+    //=========================================================================================================
+    /**
+     * Sets the averaged weight of an edge, marks the edge as present and updates the minimum and maximum weight.
+     *
+     * @param[in] iStartNodeID   The start node of the edge.
+     * @param[in] iEndNodeID     The end node of the edge.
+     * @param[in] dWeight        The averaged weight.
+     */
+    void setAveragedWeight(int iStartNodeID,
+                           int iEndNodeID,
+                           double dWeight);
+
+    //=========================================================================================================
+    /**
+     * Resizes the edge data to the current number of nodes. Existing edges are kept.
+     *
+     * @param[in] iNumberBins    The number of weights per edge.
+     */
+    void resizeEdgeData(int iNumberBins);
+
+    //=========================================================================================================
+    /**
+     * Recalculates the averaged edge weights from the per frequency bin weights and the current frequency bins.
+     */
+    void updateAveragedWeights();
 
-    QList<QSharedPointer<NetworkNode> >     m_lNodes;                   /**< List with all nodes of the network.*/
+    QSharedDataPointer<NetworkBinWeights>   m_pBinWeights;              /**< The per frequency bin weights of all edges.*/
+    Eigen::MatrixXd                         m_matWeights;               /**< The edge weights averaged over the current frequency bins (nodes x nodes). Zero where there is no edge.*/
+    Eigen::Array<bool, Eigen::Dynamic, Eigen::Dynamic> m_matEdgeMask;   /**< Flags which node pairs are connected by an edge (nodes x nodes). Empty as long as no edge was appended.*/
+    Eigen::MatrixX3f                        m_matNodePositions;         /**< The 3D positions of the nodes. Row i corresponds to the node with ID i.*/
+    QPair<int,int>                          m_minMaxFreqBins;           /**< The lower/upper bin indices to average the edge weights from/to. -1 means an average over all weights.*/
 
     Eigen::MatrixXd                         m_matDistMatrix;            /**< The distance matrix.*/
 
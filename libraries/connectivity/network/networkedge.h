@@ -71,7 +71,8 @@ class NetworkNode;
 
 //=============================================================================================================
 /**
- * This class holds an object to describe the edge of a network.
+ * This class holds an object to describe the edge of a network. Network does not store these objects, it creates them
+ * on request from its own edge data.
  *
  * @brief This class holds an object to describe the edge of a network.
  */
@@ -73,7 +73,8 @@ class NetworkEdge;
 
 //=============================================================================================================
 /**
- * This class holds an object to describe the node of a network.
+ * This class holds an object to describe the node of a network. Network hands these out as snapshots of its data, together
+ * with the edges connected to the node.
  *
  * @brief This class holds an object to describe the node of a network.
  */
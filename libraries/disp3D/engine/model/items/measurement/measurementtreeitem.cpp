@@ -335,7 +335,7 @@ DigitizerSetTreeItem* MeasurementTreeItem::addData(const FiffDigPointSet& tDigit
 NetworkTreeItem* MeasurementTreeItem::addData(const Network& tNetworkData,
                                               Qt3DCore::QEntity* p3DEntityParent)
 {
-    if(!tNetworkData.getNodes().isEmpty()) {
+    if(tNetworkData.getNodePositions().rows() != 0) {
         NetworkTreeItem* pReturnItem = Q_NULLPTR;
 
         QPair<float,float> freqs = tNetworkData.getFrequencyRange();
@@ -47,9 +47,6 @@
 
 #include <disp/plots/helpers/colormap.h>
 
-#include <connectivity/network/networknode.h>
-#include <connectivity/network/networkedge.h>
-
 #include <fiff/fiff_types.h>
 
 #include <mne/mne_sourceestimate.h>
@@ -68,6 +65,7 @@
 //=============================================================================================================
 
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -253,8 +251,9 @@ void NetworkTreeItem::plotNodes(const Network& tNetworkData)
         return;
     }
 
-    QList<NetworkNode::SPtr> lNetworkNodes = tNetworkData.getNodes();
-    qint16 iMaxDegree = tNetworkData.getMinMaxThresholdedDegrees().second;
+    const MatrixX3f& matNodePositions = tNetworkData.getNodePositions();
+    VectorXi vecDegrees = tNetworkData.getThresholdedDegrees();
+    qint16 iMaxDegree = vecDegrees.maxCoeff();
 
     VisualizationInfo visualizationInfo = tNetworkData.getVisualizationInfo();
 
@@ -285,13 +284,13 @@ void NetworkTreeItem::plotNodes(const Network& tNetworkData)
     QVector3D tempPos;
     qint16 iDegree = 0;
 
-    for(int i = 0; i < lNetworkNodes.size(); ++i) {
-        iDegree = lNetworkNodes.at(i)->getThresholdedDegree();
+    for(int i = 0; i < vecDegrees.size(); ++i) {
+        iDegree = vecDegrees(i);
 
         if(iDegree != 0) {
-            tempPos = QVector3D(lNetworkNodes.at(i)->getVert()(0),
-                                lNetworkNodes.at(i)->getVert()(1),
-                                lNetworkNodes.at(i)->getVert()(2));
+            tempPos = QVector3D(matNodePositions(i,0),
+                                matNodePositions(i,1),
+                                matNodePositions(i,2));
 
             //Set position and scale
             QMatrix4x4 tempTransform;
@@ -336,8 +335,8 @@ void NetworkTreeItem::plotEdges(const Network &tNetworkData)
     double dMaxWeight = tNetworkData.getMinMaxThresholdedWeights().second;
     double dMinWeight = tNetworkData.getMinMaxThresholdedWeights().first;
 
-    QList<NetworkEdge::SPtr> lNetworkEdges = tNetworkData.getThresholdedEdges();
-    QList<NetworkNode::SPtr> lNetworkNodes = tNetworkData.getNodes();
+    SparseMatrix<double, RowMajor> matEdges = tNetworkData.getThresholdedSparseConnectivityMatrix();
+    const MatrixX3f& matNodePositions = tNetworkData.getNodePositions();
 
     VisualizationInfo visualizationInfo = tNetworkData.getVisualizationInfo();
 
@@ -370,26 +369,22 @@ void NetworkTreeItem::plotEdges(const Network &tNetworkData)
     double dWeight = 0.0;
     int iStartID, iEndID;
 
-    for(int i = 0; i < lNetworkEdges.size(); ++i) {
+    for(int i = 0; i < matEdges.outerSize(); ++i) {
         //Plot in edges
-        NetworkEdge::SPtr pNetworkEdge = lNetworkEdges.at(i);
-
-        if(pNetworkEdge->isActive()) {
-            iStartID = pNetworkEdge->getStartNodeID();
-            iEndID = pNetworkEdge->getEndNodeID();
+        for(SparseMatrix<double, RowMajor>::InnerIterator itEdge(matEdges, i); itEdge; ++itEdge) {
+            iStartID = itEdge.row();
+            iEndID = itEdge.col();
 
-            RowVectorXf vectorStart = lNetworkNodes.at(iStartID)->getVert();
-            startPos = QVector3D(vectorStart(0),
-                                 vectorStart(1),
-                                 vectorStart(2));
+            startPos = QVector3D(matNodePositions(iStartID,0),
+                                 matNodePositions(iStartID,1),
+                                 matNodePositions(iStartID,2));
 
-            RowVectorXf vectorEnd = lNetworkNodes.at(iEndID)->getVert();
-            endPos = QVector3D(vectorEnd(0),
-                               vectorEnd(1),
-                               vectorEnd(2));
+            endPos = QVector3D(matNodePositions(iEndID,0),
+                               matNodePositions(iEndID,1),
+                               matNodePositions(iEndID,2));
 
             if(startPos != endPos) {
-                dWeight = fabs(pNetworkEdge->getWeight());
+                dWeight = fabs(itEdge.value());
                 if(dWeight != 0.0) {
                     diff = endPos - startPos;
                     edgePos = endPos - diff/2;
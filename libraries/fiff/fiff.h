@@ -50,12 +50,14 @@
 #include "fiff_dir_entry.h"
 #include "fiff_named_matrix.h"
 #include "fiff_tag.h"
+#include "fiff_tag_view.h"
 #include "fiff_types.h"
 #include "fiff_proj.h"
 #include "fiff_ctf_comp.h"
 #include "fiff_info.h"
 #include "fiff_raw_data.h"
 #include "fiff_raw_dir.h"
+#include "fiff_raw_segment_reader.h"
 #include "fiff_stream.h"
 #include "fiff_evoked_set.h"
 
@@ -38,7 +38,7 @@ include(../../mne-cpp.pri)
 
 TEMPLATE = lib
 
-QT += network
+QT += network concurrent
 QT -= gui
 
 DEFINES += FIFF_LIBRARY
@@ -71,11 +71,13 @@ CONFIG(debug, debug|release) {
 
 SOURCES += fiff.cpp \
     fiff_tag.cpp \
+    fiff_tag_view.cpp \
     fiff_coord_trans.cpp \
     fiff_ch_info.cpp \
     fiff_proj.cpp \
     fiff_named_matrix.cpp \
     fiff_raw_data.cpp \
+    fiff_raw_segment_reader.cpp \
     fiff_ctf_comp.cpp \
     fiff_id.cpp \
     fiff_info.cpp \
@@ -104,6 +106,7 @@ HEADERS += fiff.h \
     fiff_id.h \
     fiff_constants.h \
     fiff_tag.h \
+    fiff_tag_view.h \
     fiff_coord_trans.h \
     fiff_ch_info.h \
     fiff_proj.h \
@@ -111,6 +114,7 @@ HEADERS += fiff.h \
     fiff_ctf_comp.h \
     fiff_info.h \
     fiff_raw_data.h \
+    fiff_raw_segment_reader.h \
     fiff_dir_entry.h \
     fiff_raw_dir.h \
     fiff_dig_point.h \
@@ -41,6 +41,7 @@
 #include "fiff_raw_data.h"
 #include "fiff_tag.h"
 #include "fiff_stream.h"
+#include "fiff_raw_segment_reader.h"
 #include "cstdlib"
 
 //=============================================================================================================
@@ -457,6 +458,21 @@ bool FiffRawData::read_raw_segment(MatrixXd& data,
 
 //=============================================================================================================
 
+bool FiffRawData::read_raw_segment(MatrixXf& data,
+                                   MatrixXd& times,
+                                   fiff_int_t from,
+                                   fiff_int_t to,
+                                   const RowVectorXi& sel,
+                                   bool do_debug) const
+{
+    Q_UNUSED(do_debug);
+
+    FiffRawSegmentReader reader(*this, 0);
+    return reader.read_raw_segment(data, times, from, to, sel);
+}
+
+//=============================================================================================================
+
 bool FiffRawData::read_raw_segment(MatrixXd& data,
                                    MatrixXd& times,
                                    SparseMatrix<double>& multSegment,
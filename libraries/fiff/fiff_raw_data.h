@@ -149,6 +149,26 @@ public:
                           const Eigen::RowVectorXi& sel = defaultRowVectorXi,
                           bool do_debug = false) const;
 
+    //=========================================================================================================
+    /**
+     * Read a specific raw data segment in single precision. Halves the memory footprint and bandwidth compared
+     * to the double precision version, the samples are stored as float or short in the file anyway.
+     *
+     * @param[out] data      returns the data matrix (channels x samples)
+     * @param[out] times     returns the time values corresponding to the samples
+     * @param[in] from       first sample to include. If omitted, defaults to the first sample in data (optional)
+     * @param[in] to         last sample to include. If omitted, defaults to the last sample in data (optional)
+     * @param[in] sel        channel selection vector (optional)
+     *
+     * @return true if succeeded, false otherwise
+     */
+    bool read_raw_segment(Eigen::MatrixXf& data,
+                          Eigen::MatrixXd& times,
+                          fiff_int_t from = -1,
+                          fiff_int_t to = -1,
+                          const Eigen::RowVectorXi& sel = defaultRowVectorXi,
+                          bool do_debug = false) const;
+
     //=========================================================================================================
     /**
      * ### MNE toolbox root function ###: Definition of the fiff_read_raw_segment function
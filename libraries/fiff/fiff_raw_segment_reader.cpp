@@ -0,0 +1,670 @@
+//=============================================================================================================
+/**
+ * @file     fiff_raw_segment_reader.cpp
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the FiffRawSegmentReader Class.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_raw_segment_reader.h"
+#include "fiff_tag.h"
+#include "fiff_tag_view.h"
+#include "fiff_stream.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QDebug>
+#include <QMutexLocker>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+//=============================================================================================================
+// STL INCLUDES
+//=============================================================================================================
+
+#include <algorithm>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace {
+
+/**
+ * Applies matMult to the picked samples of a raw buffer stored as S. Native byte order data is read in place,
+ * otherwise the picked samples are byte swapped in one pass before the product.
+ */
+template<typename T, typename S>
+void decodeTagData(const FiffTagView& p_tagView,
+                   const SparseMatrix<T>& matMult,
+                   int nchan,
+                   int nsamp,
+                   int iFirstPick,
+                   Ref<Matrix<T, Dynamic, Dynamic> > matDest)
+{
+    typedef Matrix<S, Dynamic, Dynamic> MatrixS;
+
+    int iPickSamp = matDest.cols();
+
+    if(p_tagView.isNativeByteOrder()) {
+        Map<const MatrixS> matData(reinterpret_cast<const S*>(p_tagView.data()), nchan, nsamp);
+        matDest.noalias() = matMult * matData.middleCols(iFirstPick, iPickSamp).template cast<T>();
+    } else {
+        MatrixS matData(nchan, iPickSamp);
+        p_tagView.toNative<S>(matData.data(), qint64(iFirstPick) * nchan, qint64(iPickSamp) * nchan);
+        matDest.noalias() = matMult * matData.template cast<T>();
+    }
+}
+
+} // namespace
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+FiffRawSegmentReader::FiffRawSegmentReader(const FiffRawData& p_FiffRawData,
+                                           int iCacheSizeMB)
+: m_rawData(p_FiffRawData)
+, m_iCacheHits(0)
+, m_iCacheMisses(0)
+{
+    m_vecBufferLast.reserve(m_rawData.rawdir.size());
+    for(int i = 0; i < m_rawData.rawdir.size(); ++i) {
+        m_vecBufferLast.append(m_rawData.rawdir.at(i).last);
+    }
+
+    setCacheSize(iCacheSizeMB);
+}
+
+//=============================================================================================================
+
+FiffRawSegmentReader::~FiffRawSegmentReader()
+{
+}
+
+//=============================================================================================================
+
+bool FiffRawSegmentReader::read_raw_segment(MatrixXd& data,
+                                            MatrixXd& times,
+                                            fiff_int_t from,
+                                            fiff_int_t to,
+                                            const RowVectorXi& sel)
+{
+    if(!checkRange(from, to)) {
+        return false;
+    }
+
+    QMutexLocker locker(&m_mutex);
+
+    const SelectionOperator& selOp = selectionOperator(sel);
+
+    data = MatrixXd::Zero(selOp.matMult.rows(), to - from + 1);
+
+    //
+    //  Only visit the buffers which overlap with the requested range
+    //
+    int k = std::lower_bound(m_vecBufferLast.constBegin(), m_vecBufferLast.constEnd(), from) - m_vecBufferLast.constBegin();
+
+    for(; k < m_rawData.rawdir.size(); ++k) {
+        const FiffRawDir& rawDir = m_rawData.rawdir.at(k);
+
+        if(rawDir.first > to) {
+            break;
+        }
+
+        QSharedPointer<const MatrixXd> pBuffer = buffer(k, selOp);
+
+        if(!pBuffer) {
+            return false;
+        }
+
+        fiff_int_t first_pick = qMax(from, rawDir.first);
+        fiff_int_t last_pick = qMin(to, rawDir.last);
+        fiff_int_t picksamp = last_pick - first_pick + 1;
+
+        if(picksamp > 0) {
+            data.block(0, first_pick - from, data.rows(), picksamp) = pBuffer->block(0, first_pick - rawDir.first, data.rows(), picksamp);
+        }
+    }
+
+    times = makeTimes(from, to);
+
+    return true;
+}
+
+//=============================================================================================================
+
+bool FiffRawSegmentReader::read_raw_segment(MatrixXf& data,
+                                            MatrixXd& times,
+                                            fiff_int_t from,
+                                            fiff_int_t to,
+                                            const RowVectorXi& sel)
+{
+    if(!checkRange(from, to)) {
+        return false;
+    }
+
+    QMutexLocker locker(&m_mutex);
+
+    if(!decodeSegment<float>(data, from, to, selectionOperator(sel).matMultFloat, 1)) {
+        return false;
+    }
+
+    times = makeTimes(from, to);
+
+    return true;
+}
+
+//=============================================================================================================
+
+bool FiffRawSegmentReader::read_raw_segment_parallel(MatrixXd& data,
+                                                     MatrixXd& times,
+                                                     fiff_int_t from,
+                                                     fiff_int_t to,
+                                                     const RowVectorXi& sel,
+                                                     int iNumThreads)
+{
+    if(!checkRange(from, to)) {
+        return false;
+    }
+
+    QMutexLocker locker(&m_mutex);
+
+    if(!decodeSegment<double>(data, from, to, selectionOperator(sel).matMult, iNumThreads)) {
+        return false;
+    }
+
+    times = makeTimes(from, to);
+
+    return true;
+}
+
+//=============================================================================================================
+
+bool FiffRawSegmentReader::read_raw_segment_parallel(MatrixXf& data,
+                                                     MatrixXd& times,
+                                                     fiff_int_t from,
+                                                     fiff_int_t to,
+                                                     const RowVectorXi& sel,
+                                                     int iNumThreads)
+{
+    if(!checkRange(from, to)) {
+        return false;
+    }
+
+    QMutexLocker locker(&m_mutex);
+
+    if(!decodeSegment<float>(data, from, to, selectionOperator(sel).matMultFloat, iNumThreads)) {
+        return false;
+    }
+
+    times = makeTimes(from, to);
+
+    return true;
+}
+
+//=============================================================================================================
+
+int FiffRawSegmentReader::findBuffer(fiff_int_t sample) const
+{
+    int k = std::lower_bound(m_vecBufferLast.constBegin(), m_vecBufferLast.constEnd(), sample) - m_vecBufferLast.constBegin();
+
+    if(k >= m_rawData.rawdir.size() || m_rawData.rawdir.at(k).first > sample) {
+        return -1;
+    }
+
+    return k;
+}
+
+//=============================================================================================================
+
+QSharedPointer<const MatrixXd> FiffRawSegmentReader::readBuffer(int iBuffer,
+                                                                const RowVectorXi& sel)
+{
+    if(iBuffer < 0 || iBuffer >= m_rawData.rawdir.size()) {
+        qWarning("[FiffRawSegmentReader::readBuffer] Buffer index %d out of range.", iBuffer);
+        return QSharedPointer<const MatrixXd>();
+    }
+
+    QMutexLocker locker(&m_mutex);
+
+    return buffer(iBuffer, selectionOperator(sel));
+}
+
+//=============================================================================================================
+
+SparseMatrix<double> FiffRawSegmentReader::multiplicationMatrix(const RowVectorXi& sel)
+{
+    QMutexLocker locker(&m_mutex);
+
+    return selectionOperator(sel).matMult;
+}
+
+//=============================================================================================================
+
+void FiffRawSegmentReader::setCacheSize(int iCacheSizeMB)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_cacheBuffers.setMaxCost(qMax(0, iCacheSizeMB) * 1024);
+}
+
+//=============================================================================================================
+
+void FiffRawSegmentReader::clearCache()
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_cacheBuffers.clear();
+    m_mapOperators.clear();
+}
+
+//=============================================================================================================
+
+int FiffRawSegmentReader::cacheHits() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_iCacheHits;
+}
+
+//=============================================================================================================
+
+int FiffRawSegmentReader::cacheMisses() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    return m_iCacheMisses;
+}
+
+//=============================================================================================================
+
+bool FiffRawSegmentReader::checkRange(fiff_int_t& from,
+                                      fiff_int_t& to) const
+{
+    if(from == -1) {
+        from = m_rawData.first_samp;
+    }
+    if(to == -1) {
+        to = m_rawData.last_samp;
+    }
+
+    //
+    //  Initial checks
+    //
+    if(from < m_rawData.first_samp) {
+        from = m_rawData.first_samp;
+    }
+    if(to > m_rawData.last_samp) {
+        to = m_rawData.last_samp;
+    }
+
+    if(from > to) {
+        qWarning("[FiffRawSegmentReader::checkRange] No data in this range %d ... %d", from, to);
+        return false;
+    }
+
+    return true;
+}
+
+//=============================================================================================================
+
+MatrixXd FiffRawSegmentReader::makeTimes(fiff_int_t from,
+                                         fiff_int_t to) const
+{
+    MatrixXd times(1, to - from + 1);
+
+    for(int i = 0; i < times.cols(); ++i) {
+        times(0, i) = ((float)(from + i)) / m_rawData.info.sfreq;
+    }
+
+    return times;
+}
+
+//=============================================================================================================
+
+const FiffRawSegmentReader::SelectionOperator& FiffRawSegmentReader::selectionOperator(const RowVectorXi& sel)
+{
+    QVector<int> vecKey(sel.size());
+    for(int i = 0; i < sel.size(); ++i) {
+        vecKey[i] = sel[i];
+    }
+
+    QMap<QVector<int>, SelectionOperator>::iterator it = m_mapOperators.find(vecKey);
+
+    if(it == m_mapOperators.end()) {
+        SelectionOperator selOp;
+        selOp.iId = m_mapOperators.size();
+        selOp.matMult = makeMultiplicationMatrix(sel);
+        selOp.matMultFloat = selOp.matMult.cast<float>();
+        it = m_mapOperators.insert(vecKey, selOp);
+    }
+
+    return it.value();
+}
+
+//=============================================================================================================
+
+SparseMatrix<double> FiffRawSegmentReader::makeMultiplicationMatrix(const RowVectorXi& sel) const
+{
+    typedef Eigen::Triplet<double> T;
+    std::vector<T> tripletList;
+
+    qint32 nchan = m_rawData.info.nchan;
+    qint32 nrows = sel.size() == 0 ? nchan : sel.size();
+    qint32 i, k;
+
+    bool projAvailable = m_rawData.proj.size() != 0;
+    bool compAvailable = m_rawData.comp.kind != -1;
+
+    if(!projAvailable && !compAvailable) {
+        //
+        //  Calibration and picking only
+        //
+        tripletList.reserve(nrows);
+        for(i = 0; i < nrows; ++i) {
+            qint32 iChan = sel.size() == 0 ? i : sel[i];
+            tripletList.push_back(T(i, iChan, m_rawData.cals[iChan]));
+        }
+    } else {
+        //
+        //  Combine projector, compensator and calibration
+        //
+        MatrixXd mult_full = MatrixXd::Identity(nchan, nchan);
+
+        if(compAvailable) {
+            mult_full = m_rawData.comp.data->data;
+        }
+
+        if(projAvailable) {
+            mult_full = m_rawData.proj * mult_full;
+        }
+
+        mult_full = mult_full * m_rawData.cals.asDiagonal();
+
+        tripletList.reserve(nrows * nchan);
+        for(i = 0; i < nrows; ++i) {
+            qint32 iChan = sel.size() == 0 ? i : sel[i];
+            for(k = 0; k < nchan; ++k) {
+                if(mult_full(iChan, k) != 0) {
+                    tripletList.push_back(T(i, k, mult_full(iChan, k)));
+                }
+            }
+        }
+    }
+
+    SparseMatrix<double> mult(nrows, nchan);
+    mult.setFromTriplets(tripletList.begin(), tripletList.end());
+    mult.makeCompressed();
+
+    return mult;
+}
+
+//=============================================================================================================
+
+QSharedPointer<const MatrixXd> FiffRawSegmentReader::buffer(int iBuffer,
+                                                            const SelectionOperator& selOp)
+{
+    quint64 iKey = (quint64(selOp.iId) << 32) | quint32(iBuffer);
+
+    if(QSharedPointer<const MatrixXd>* pCached = m_cacheBuffers.object(iKey)) {
+        ++m_iCacheHits;
+        return *pCached;
+    }
+
+    ++m_iCacheMisses;
+
+    QSharedPointer<MatrixXd> pBuffer = QSharedPointer<MatrixXd>::create();
+
+    if(!decodeBuffer(iBuffer, selOp.matMult, *pBuffer)) {
+        return QSharedPointer<const MatrixXd>();
+    }
+
+    int iCost = qMax(1, int(pBuffer->size() * sizeof(double) / 1024));
+
+    if(iCost <= m_cacheBuffers.maxCost()) {
+        m_cacheBuffers.insert(iKey, new QSharedPointer<const MatrixXd>(pBuffer), iCost);
+    }
+
+    return pBuffer;
+}
+
+//=============================================================================================================
+
+bool FiffRawSegmentReader::decodeBuffer(int iBuffer,
+                                        const SparseMatrix<double>& matMult,
+                                        MatrixXd& matBuffer)
+{
+    const FiffRawDir& rawDir = m_rawData.rawdir.at(iBuffer);
+
+    if(rawDir.ent->kind == -1) {
+        //
+        //  Take the easy route: skip is translated to zeros
+        //
+        matBuffer = MatrixXd::Zero(matMult.rows(), rawDir.nsamp);
+        return true;
+    }
+
+    FiffTag::SPtr t_pTag;
+    FiffTagView t_tagView;
+
+    if(!readTag(iBuffer, t_pTag, t_tagView)) {
+        return false;
+    }
+
+    matBuffer.resize(matMult.rows(), rawDir.nsamp);
+
+    return decodeTag<double>(t_tagView, matMult, m_rawData.info.nchan, rawDir.nsamp, 0, matBuffer);
+}
+
+//=============================================================================================================
+
+bool FiffRawSegmentReader::readTag(int iBuffer,
+                                   FiffTag::SPtr& p_pTag,
+                                   FiffTagView& p_tagView)
+{
+    const FiffRawDir& rawDir = m_rawData.rawdir.at(iBuffer);
+    FiffStream::SPtr fid = m_rawData.file;
+
+    if(fid->isMapped()) {
+        //
+        //  The view points straight into the mapped file, nothing to copy
+        //
+        return fid->read_tag_view(p_tagView, rawDir.ent->pos);
+    }
+
+    if(!fid->device()->isOpen()) {
+        if(!fid->device()->open(QIODevice::ReadOnly)) {
+            qWarning("[FiffRawSegmentReader::readTag] Cannot open file %s", m_rawData.info.filename.toUtf8().constData());
+            return false;
+        }
+    }
+
+    //
+    //  Read the payload without converting it. The byte order is converted while decoding.
+    //
+    if(!fid->device()->seek(rawDir.ent->pos) || fid->read_tag_info(p_pTag, false) < 0) {
+        qWarning("[FiffRawSegmentReader::readTag] Cannot read tag at position %d", rawDir.ent->pos);
+        return false;
+    }
+
+    if(fid->readRawData(p_pTag->data(), p_pTag->size()) != p_pTag->size()) {
+        qWarning("[FiffRawSegmentReader::readTag] Cannot read tag data at position %d", rawDir.ent->pos);
+        return false;
+    }
+
+    bool bSwap = (fid->byteOrder() == QDataStream::BigEndian) != (QSysInfo::ByteOrder == QSysInfo::BigEndian);
+
+    p_tagView = FiffTagView(p_pTag->kind,
+                            p_pTag->type,
+                            p_pTag->next,
+                            p_pTag->data(),
+                            p_pTag->size(),
+                            bSwap);
+
+    return true;
+}
+
+//=============================================================================================================
+
+template<typename T>
+bool FiffRawSegmentReader::decodeSegment(Matrix<T, Dynamic, Dynamic>& data,
+                                         fiff_int_t from,
+                                         fiff_int_t to,
+                                         const SparseMatrix<T>& matMult,
+                                         int iNumThreads)
+{
+    if(iNumThreads <= 0) {
+        iNumThreads = QThread::idealThreadCount();
+    }
+
+    int nchan = m_rawData.info.nchan;
+
+    data.resize(matMult.rows(), to - from + 1);
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(iNumThreads);
+
+    //
+    //  Bound the number of buffers which were read but are not decoded yet
+    //
+    QSemaphore semFreeSlots(2 * iNumThreads);
+    QAtomicInt iFailed(0);
+
+    int k = std::lower_bound(m_vecBufferLast.constBegin(), m_vecBufferLast.constEnd(), from) - m_vecBufferLast.constBegin();
+
+    for(; k < m_rawData.rawdir.size(); ++k) {
+        const FiffRawDir& rawDir = m_rawData.rawdir.at(k);
+
+        if(rawDir.first > to) {
+            break;
+        }
+
+        fiff_int_t first_pick = qMax(from, rawDir.first);
+        int picksamp = qMin(to, rawDir.last) - first_pick + 1;
+        int iDest = first_pick - from;
+        int iFirstPick = first_pick - rawDir.first;
+        int nsamp = rawDir.nsamp;
+
+        if(picksamp <= 0) {
+            continue;
+        }
+
+        if(rawDir.ent->kind == -1) {
+            data.middleCols(iDest, picksamp).setZero();
+            continue;
+        }
+
+        //
+        //  I/O stage: read the buffers sequentially in this thread
+        //
+        FiffTag::SPtr pTag;
+        FiffTagView tagView;
+
+        semFreeSlots.acquire();
+
+        if(!readTag(k, pTag, tagView)) {
+            semFreeSlots.release();
+            iFailed.storeRelease(1);
+            break;
+        }
+
+        if(iNumThreads == 1) {
+            if(!decodeTag<T>(tagView, matMult, nchan, nsamp, iFirstPick, data.middleCols(iDest, picksamp))) {
+                iFailed.storeRelease(1);
+            }
+            semFreeSlots.release();
+            continue;
+        }
+
+        //
+        //  Decoding stage: type conversion, calibration, compensation, projection and picking in the pool.
+        //  Each job writes to its own columns of the preallocated output.
+        //
+        QtConcurrent::run(&threadPool, [pTag, tagView, nchan, nsamp, iFirstPick, iDest, picksamp, &matMult, &data, &semFreeSlots, &iFailed]() {
+            if(!decodeTag<T>(tagView, matMult, nchan, nsamp, iFirstPick, data.middleCols(iDest, picksamp))) {
+                iFailed.storeRelease(1);
+            }
+            semFreeSlots.release();
+        });
+    }
+
+    threadPool.waitForDone();
+
+    if(iFailed.loadAcquire() != 0) {
+        qWarning("[FiffRawSegmentReader::decodeSegment] Reading %d ... %d failed.", from, to);
+        return false;
+    }
+
+    return true;
+}
+
+//=============================================================================================================
+
+template<typename T>
+bool FiffRawSegmentReader::decodeTag(const FiffTagView& p_tagView,
+                                     const SparseMatrix<T>& matMult,
+                                     int nchan,
+                                     int nsamp,
+                                     int iFirstPick,
+                                     Ref<Matrix<T, Dynamic, Dynamic> > matDest)
+{
+    switch(p_tagView.type) {
+        case FIFFT_DAU_PACK16:
+        case FIFFT_SHORT:
+            decodeTagData<T, qint16>(p_tagView, matMult, nchan, nsamp, iFirstPick, matDest);
+            break;
+        case FIFFT_INT:
+            decodeTagData<T, qint32>(p_tagView, matMult, nchan, nsamp, iFirstPick, matDest);
+            break;
+        case FIFFT_FLOAT:
+            decodeTagData<T, float>(p_tagView, matMult, nchan, nsamp, iFirstPick, matDest);
+            break;
+        default:
+            qWarning("[FiffRawSegmentReader::decodeTag] Data storage format not known yet. Type: %d", p_tagView.type);
+            return false;
+    }
+
+    return true;
+}
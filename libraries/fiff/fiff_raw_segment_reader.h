@@ -0,0 +1,423 @@
+//=============================================================================================================
+/**
+ * @file     fiff_raw_segment_reader.h
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    FiffRawSegmentReader class declaration.
+ *
+ */
+
+#ifndef FIFF_RAW_SEGMENT_READER_H
+#define FIFF_RAW_SEGMENT_READER_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_global.h"
+#include "fiff_types.h"
+#include "fiff_raw_data.h"
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+#include <Eigen/SparseCore>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QCache>
+#include <QMap>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QVector>
+
+//=============================================================================================================
+// DEFINE NAMESPACE FIFFLIB
+//=============================================================================================================
+
+namespace FIFFLIB
+{
+
+//=============================================================================================================
+// FORWARD DECLARATIONS
+//=============================================================================================================
+
+class FiffTag;
+class FiffTagView;
+
+//=============================================================================================================
+/**
+ * Reads segments of a FiffRawData set repeatedly without paying the setup costs of
+ * FiffRawData::read_raw_segment on every call. The raw directory is searched by sample with a binary search,
+ * the multiplication matrix (compensator, projector and calibration) is built once per channel selection and
+ * the decoded raw buffers are kept in a least recently used cache, so that adjacent or overlapping segments
+ * never decode the same tag twice. If the stream of the raw data is memory mapped (see FiffStream::map), the
+ * buffers are decoded straight from the mapped file.
+ *
+ * @brief Indexed and cached raw data segment reader.
+ */
+class FIFFSHARED_EXPORT FiffRawSegmentReader
+{
+public:
+    typedef QSharedPointer<FiffRawSegmentReader> SPtr;              /**< Shared pointer type for FiffRawSegmentReader. */
+    typedef QSharedPointer<const FiffRawSegmentReader> ConstSPtr;   /**< Const shared pointer type for FiffRawSegmentReader. */
+
+    //=========================================================================================================
+    /**
+     * Constructs a segment reader operating on the given raw data. The raw data is copied, the underlying
+     * FiffStream is shared with p_FiffRawData.
+     *
+     * @param[in] p_FiffRawData      The raw data to read from. Projectors and compensators must be set up beforehand.
+     * @param[in] iCacheSizeMB       The maximum amount of decoded buffers to keep in memory in MB (default = 64).
+     */
+    explicit FiffRawSegmentReader(const FiffRawData& p_FiffRawData,
+                                  int iCacheSizeMB = 64);
+
+    //=========================================================================================================
+    /**
+     * Destroys the segment reader.
+     */
+    ~FiffRawSegmentReader();
+
+    //=========================================================================================================
+    /**
+     * Returns the raw data this reader operates on.
+     *
+     * @return the raw data.
+     */
+    const FiffRawData& rawData() const;
+
+    //=========================================================================================================
+    /**
+     * Read a specific raw data segment. Produces the same output as FiffRawData::read_raw_segment.
+     *
+     * @param[out] data      returns the data matrix (channels x samples)
+     * @param[out] times     returns the time values corresponding to the samples
+     * @param[in] from       first sample to include. If omitted, defaults to the first sample in data (optional)
+     * @param[in] to         last sample to include. If omitted, defaults to the last sample in data (optional)
+     * @param[in] sel        channel selection vector (optional)
+     *
+     * @return true if succeeded, false otherwise
+     */
+    bool read_raw_segment(Eigen::MatrixXd& data,
+                          Eigen::MatrixXd& times,
+                          fiff_int_t from = -1,
+                          fiff_int_t to = -1,
+                          const Eigen::RowVectorXi& sel = defaultRowVectorXi);
+
+    //=========================================================================================================
+    /**
+     * Read a specific raw data segment in single precision. The samples are converted, calibrated, compensated
+     * and projected in single precision, so that the data never passes through a double precision matrix. The
+     * decoded buffers bypass the cache.
+     *
+     * @param[out] data      returns the data matrix (channels x samples)
+     * @param[out] times     returns the time values corresponding to the samples
+     * @param[in] from       first sample to include. If omitted, defaults to the first sample in data (optional)
+     * @param[in] to         last sample to include. If omitted, defaults to the last sample in data (optional)
+     * @param[in] sel        channel selection vector (optional)
+     *
+     * @return true if succeeded, false otherwise
+     */
+    bool read_raw_segment(Eigen::MatrixXf& data,
+                          Eigen::MatrixXd& times,
+                          fiff_int_t from = -1,
+                          fiff_int_t to = -1,
+                          const Eigen::RowVectorXi& sel = defaultRowVectorXi);
+
+    //=========================================================================================================
+    /**
+     * Read a specific raw data segment with a pipelined reader. This thread reads the raw buffers sequentially,
+     * while a pool of worker threads converts, calibrates, compensates, projects and picks them in parallel,
+     * writing straight into the output matrix. Meant for reading large parts of a file at once, hence the decoded
+     * buffers bypass the cache. Produces the same output as read_raw_segment.
+     *
+     * @param[out] data          returns the data matrix (channels x samples)
+     * @param[out] times         returns the time values corresponding to the samples
+     * @param[in] from           first sample to include. If omitted, defaults to the first sample in data (optional)
+     * @param[in] to             last sample to include. If omitted, defaults to the last sample in data (optional)
+     * @param[in] sel            channel selection vector (optional)
+     * @param[in] iNumThreads    number of decoding threads. If omitted, defaults to QThread::idealThreadCount (optional)
+     *
+     * @return true if succeeded, false otherwise
+     */
+    bool read_raw_segment_parallel(Eigen::MatrixXd& data,
+                                   Eigen::MatrixXd& times,
+                                   fiff_int_t from = -1,
+                                   fiff_int_t to = -1,
+                                   const Eigen::RowVectorXi& sel = defaultRowVectorXi,
+                                   int iNumThreads = -1);
+
+    //=========================================================================================================
+    /**
+     * Read a specific raw data segment in single precision with a pipelined reader, see
+     * read_raw_segment_parallel.
+     *
+     * @param[out] data          returns the data matrix (channels x samples)
+     * @param[out] times         returns the time values corresponding to the samples
+     * @param[in] from           first sample to include. If omitted, defaults to the first sample in data (optional)
+     * @param[in] to             last sample to include. If omitted, defaults to the last sample in data (optional)
+     * @param[in] sel            channel selection vector (optional)
+     * @param[in] iNumThreads    number of decoding threads. If omitted, defaults to QThread::idealThreadCount (optional)
+     *
+     * @return true if succeeded, false otherwise
+     */
+    bool read_raw_segment_parallel(Eigen::MatrixXf& data,
+                                   Eigen::MatrixXd& times,
+                                   fiff_int_t from = -1,
+                                   fiff_int_t to = -1,
+                                   const Eigen::RowVectorXi& sel = defaultRowVectorXi,
+                                   int iNumThreads = -1);
+
+    //=========================================================================================================
+    /**
+     * Returns the index of the raw directory entry which holds the given sample.
+     *
+     * @param[in] sample     The sample to look for (including first_samp).
+     *
+     * @return the index into FiffRawData::rawdir, -1 if the sample is not part of any buffer.
+     */
+    int findBuffer(fiff_int_t sample) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the decoded, calibrated, compensated and projected raw buffer with the given index. The buffer
+     * is taken from the cache if present, decoded and inserted into the cache otherwise.
+     *
+     * @param[in] iBuffer    The index into FiffRawData::rawdir.
+     * @param[in] sel        channel selection vector (optional)
+     *
+     * @return the decoded buffer (channels x samples of the buffer), a null pointer if the buffer could not be read.
+     */
+    QSharedPointer<const Eigen::MatrixXd> readBuffer(int iBuffer,
+                                                     const Eigen::RowVectorXi& sel = defaultRowVectorXi);
+
+    //=========================================================================================================
+    /**
+     * Returns the multiplication matrix (compensator, projector and calibration) which is applied to the
+     * raw buffers for the given selection. The matrix is computed on first use and cached afterwards.
+     *
+     * @param[in] sel        channel selection vector (optional)
+     *
+     * @return the multiplication matrix (selected channels x all channels)
+     */
+    Eigen::SparseMatrix<double> multiplicationMatrix(const Eigen::RowVectorXi& sel = defaultRowVectorXi);
+
+    //=========================================================================================================
+    /**
+     * Sets the maximum size of the decoded buffer cache. Setting the size to 0 disables caching.
+     *
+     * @param[in] iCacheSizeMB       The maximum amount of decoded buffers to keep in memory in MB.
+     */
+    void setCacheSize(int iCacheSizeMB);
+
+    //=========================================================================================================
+    /**
+     * Drops all decoded buffers and multiplication matrices. Call this after changing the projectors or
+     * compensators of the raw data.
+     */
+    void clearCache();
+
+    //=========================================================================================================
+    /**
+     * Returns the number of buffer requests which were served from the cache.
+     *
+     * @return the number of cache hits.
+     */
+    int cacheHits() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of buffer requests which had to be read and decoded from file.
+     *
+     * @return the number of cache misses.
+     */
+    int cacheMisses() const;
+
+private:
+    //=========================================================================================================
+    /**
+     * The multiplication matrix of one channel selection together with the id used in the buffer cache keys.
+     */
+    struct SelectionOperator {
+        int                         iId;        /**< The id of the selection. */
+        Eigen::SparseMatrix<double> matMult;        /**< The multiplication matrix. */
+        Eigen::SparseMatrix<float>  matMultFloat;   /**< The multiplication matrix in single precision. */
+    };
+
+    //=========================================================================================================
+    /**
+     * Applies the defaults and limits of FiffRawData::read_raw_segment to the requested range.
+     *
+     * @param[in, out] from  first sample to include.
+     * @param[in, out] to    last sample to include.
+     *
+     * @return true if the range contains data, false otherwise.
+     */
+    bool checkRange(fiff_int_t& from,
+                    fiff_int_t& to) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the time values corresponding to the samples of the given range.
+     *
+     * @param[in] from   first sample.
+     * @param[in] to     last sample.
+     *
+     * @return the time values (1 x samples).
+     */
+    Eigen::MatrixXd makeTimes(fiff_int_t from,
+                              fiff_int_t to) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the operator for the given selection. Builds it if it was not requested yet. m_mutex must be locked.
+     *
+     * @param[in] sel        channel selection vector
+     *
+     * @return the operator of the selection.
+     */
+    const SelectionOperator& selectionOperator(const Eigen::RowVectorXi& sel);
+
+    //=========================================================================================================
+    /**
+     * Builds the multiplication matrix for the given selection, see FiffRawData::read_raw_segment.
+     *
+     * @param[in] sel        channel selection vector
+     *
+     * @return the multiplication matrix.
+     */
+    Eigen::SparseMatrix<double> makeMultiplicationMatrix(const Eigen::RowVectorXi& sel) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the decoded buffer. m_mutex must be locked.
+     *
+     * @param[in] iBuffer    The index into FiffRawData::rawdir.
+     * @param[in] selOp      The operator of the selection.
+     *
+     * @return the decoded buffer, a null pointer if the buffer could not be read.
+     */
+    QSharedPointer<const Eigen::MatrixXd> buffer(int iBuffer,
+                                                 const SelectionOperator& selOp);
+
+    //=========================================================================================================
+    /**
+     * Reads and decodes a raw buffer from file. m_mutex must be locked.
+     *
+     * @param[in] iBuffer    The index into FiffRawData::rawdir.
+     * @param[in] matMult    The multiplication matrix to apply.
+     * @param[out] matBuffer The decoded buffer.
+     *
+     * @return true if succeeded, false otherwise.
+     */
+    bool decodeBuffer(int iBuffer,
+                      const Eigen::SparseMatrix<double>& matMult,
+                      Eigen::MatrixXd& matBuffer);
+
+    //=========================================================================================================
+    /**
+     * Reads the tag of a raw buffer without converting it. If the stream is mapped, the view points into the
+     * mapped file. Otherwise the data is read into p_pTag and the view points into it. m_mutex must be locked.
+     *
+     * @param[in] iBuffer        The index into FiffRawData::rawdir.
+     * @param[out] p_pTag        Holds the tag data if the stream is not mapped. Must outlive p_tagView.
+     * @param[out] p_tagView     The view of the tag data.
+     *
+     * @return true if succeeded, false otherwise.
+     */
+    bool readTag(int iBuffer,
+                 QSharedPointer<FiffTag>& p_pTag,
+                 FiffTagView& p_tagView);
+
+    //=========================================================================================================
+    /**
+     * Decodes a segment straight into the output matrix, bypassing the cache. This thread reads the raw buffers
+     * sequentially, the decoding is distributed over a pool of iNumThreads threads. m_mutex must be locked.
+     *
+     * @param[out] data          returns the data matrix (channels x samples)
+     * @param[in] from           first sample to include, see checkRange.
+     * @param[in] to             last sample to include, see checkRange.
+     * @param[in] matMult        The multiplication matrix to apply.
+     * @param[in] iNumThreads    number of decoding threads. 1 decodes in this thread, <= 0 uses QThread::idealThreadCount.
+     *
+     * @return true if succeeded, false otherwise
+     */
+    template<typename T>
+    bool decodeSegment(Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& data,
+                       fiff_int_t from,
+                       fiff_int_t to,
+                       const Eigen::SparseMatrix<T>& matMult,
+                       int iNumThreads);
+
+    //=========================================================================================================
+    /**
+     * Converts, calibrates, compensates, projects and picks the samples of a raw buffer. Does not touch any
+     * member and can therefore run in parallel for different buffers.
+     *
+     * @param[in] p_tagView      The view of the raw buffer tag.
+     * @param[in] matMult        The multiplication matrix to apply.
+     * @param[in] nchan          The number of channels stored in the buffer.
+     * @param[in] nsamp          The number of samples stored in the buffer.
+     * @param[in] iFirstPick     The first sample of the buffer to decode.
+     * @param[out] matDest       The destination, the number of columns is the number of samples to decode.
+     *
+     * @return true if succeeded, false otherwise.
+     */
+    template<typename T>
+    static bool decodeTag(const FiffTagView& p_tagView,
+                          const Eigen::SparseMatrix<T>& matMult,
+                          int nchan,
+                          int nsamp,
+                          int iFirstPick,
+                          Eigen::Ref<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > matDest);
+
+    FiffRawData                                         m_rawData;          /**< The raw data to read from. */
+    QVector<fiff_int_t>                                 m_vecBufferLast;    /**< The last sample of each raw buffer, sorted ascending. */
+    QMap<QVector<int>, SelectionOperator>               m_mapOperators;     /**< The multiplication matrices per channel selection. */
+    QCache<quint64, QSharedPointer<const Eigen::MatrixXd> > m_cacheBuffers; /**< LRU cache of decoded buffers, cost is in KB. */
+    int                                                 m_iCacheHits;       /**< Number of buffer requests served from the cache. */
+    int                                                 m_iCacheMisses;     /**< Number of buffers read from file. */
+    mutable QMutex                                      m_mutex;            /**< Guards the caches and the file stream. */
+};
+
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+inline const FiffRawData& FiffRawSegmentReader::rawData() const
+{
+    return m_rawData;
+}
+} // NAMESPACE
+
+#endif // FIFF_RAW_SEGMENT_READER_H
@@ -41,6 +41,7 @@
 
 #include "fiff_stream.h"
 #include "fiff_tag.h"
+#include "fiff_tag_view.h"
 #include "fiff_dir_node.h"
 #include "fiff_ctf_comp.h"
 #include "fiff_info.h"
@@ -84,6 +85,7 @@
 
 #include <QFile>
 #include <QTcpSocket>
+#include <QtEndian>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -99,6 +101,8 @@ using namespace Eigen;
 
 FiffStream::FiffStream(QIODevice *p_pIODevice)
 : QDataStream(p_pIODevice)
+, m_pMappedData(Q_NULLPTR)
+, m_iMappedSize(0)
 {
     this->setFloatingPointPrecision(QDataStream::SinglePrecision);
     this->setByteOrder(QDataStream::BigEndian);
@@ -109,6 +113,8 @@ FiffStream::FiffStream(QIODevice *p_pIODevice)
 
 FiffStream::FiffStream(QByteArray * a, QIODevice::OpenMode mode)
 : QDataStream(a, mode)
+, m_pMappedData(Q_NULLPTR)
+, m_iMappedSize(0)
 {
     this->setFloatingPointPrecision(QDataStream::SinglePrecision);
     this->setByteOrder(QDataStream::BigEndian);
@@ -341,6 +347,8 @@ bool FiffStream::open(QIODevice::OpenModeFlag mode)
 
 bool FiffStream::close()
 {
+    unmap();
+
     if(this->device()->isOpen())
         this->device()->close();
 
@@ -1645,6 +1653,119 @@ bool FiffStream::read_tag(FiffTag::SPtr &p_pTag, fiff_long_t pos)
 
 //=============================================================================================================
 
+bool FiffStream::map()
+{
+    if(m_pMappedData) {
+        return true;
+    }
+
+    QFile* t_pFile = qobject_cast<QFile*>(this->device());
+
+    if(!t_pFile) {
+        qWarning("[FiffStream::map] Only files can be mapped into memory.");
+        return false;
+    }
+
+    if(!t_pFile->isOpen() && !t_pFile->open(QIODevice::ReadOnly)) {
+        qWarning("[FiffStream::map] Cannot open %s", t_pFile->fileName().toUtf8().constData());
+        return false;
+    }
+
+    if(t_pFile->openMode() & QIODevice::WriteOnly) {
+        qWarning("[FiffStream::map] Files opened for writing cannot be mapped.");
+        return false;
+    }
+
+    m_pMappedData = t_pFile->map(0, t_pFile->size());
+
+    if(!m_pMappedData) {
+        qWarning("[FiffStream::map] Mapping %s failed: %s", t_pFile->fileName().toUtf8().constData(), t_pFile->errorString().toUtf8().constData());
+        return false;
+    }
+
+    m_iMappedSize = t_pFile->size();
+
+    return true;
+}
+
+//=============================================================================================================
+
+void FiffStream::unmap()
+{
+    if(!m_pMappedData) {
+        return;
+    }
+
+    if(QFile* t_pFile = qobject_cast<QFile*>(this->device())) {
+        t_pFile->unmap(m_pMappedData);
+    }
+
+    m_pMappedData = Q_NULLPTR;
+    m_iMappedSize = 0;
+}
+
+//=============================================================================================================
+
+bool FiffStream::isMapped() const
+{
+    return m_pMappedData != Q_NULLPTR;
+}
+
+//=============================================================================================================
+
+bool FiffStream::read_tag_view(FiffTagView& p_tagView, fiff_long_t pos) const
+{
+    if(!m_pMappedData) {
+        qWarning("[FiffStream::read_tag_view] Stream is not mapped. Call map() first.");
+        return false;
+    }
+
+    const qint64 iDataOffset = FIFFC_DATA_OFFSET;
+
+    if(pos < 0 || pos + iDataOffset > m_iMappedSize) {
+        qWarning("[FiffStream::read_tag_view] Tag position %lld is outside of the file.", (long long)pos);
+        return false;
+    }
+
+    //
+    // Read fiff tag header from the mapped memory
+    //
+    const uchar* pHeader = m_pMappedData + pos;
+    bool bBigEndian = this->byteOrder() == QDataStream::BigEndian;
+
+    fiff_int_t kind, type, size, next;
+
+    if(bBigEndian) {
+        kind = qFromBigEndian<qint32>(pHeader);
+        type = qFromBigEndian<qint32>(pHeader + 4);
+        size = qFromBigEndian<qint32>(pHeader + 8);
+        next = qFromBigEndian<qint32>(pHeader + 12);
+    } else {
+        kind = qFromLittleEndian<qint32>(pHeader);
+        type = qFromLittleEndian<qint32>(pHeader + 4);
+        size = qFromLittleEndian<qint32>(pHeader + 8);
+        next = qFromLittleEndian<qint32>(pHeader + 12);
+    }
+
+    if(size < 0 || pos + iDataOffset + size > m_iMappedSize) {
+        qWarning("[FiffStream::read_tag_view] Tag at position %lld exceeds the file size.", (long long)pos);
+        return false;
+    }
+
+    bool bSwap = (QSysInfo::ByteOrder == QSysInfo::BigEndian) != bBigEndian;
+
+    p_tagView = FiffTagView(kind,
+                            type,
+                            next,
+                            reinterpret_cast<const char*>(pHeader + iDataOffset),
+                            size,
+                            bSwap);
+
+    return true;
+}
+
+//=============================================================================================================
+
 bool FiffStream::setup_read_raw(QIODevice &p_IODevice, FiffRawData& data, bool allow_maxshield, bool is_littleEndian)
 {
     //
@@ -3088,6 +3209,29 @@ bool FiffStream::write_raw_buffer(const MatrixXd& buf)
 
 //=============================================================================================================
 
+bool FiffStream::write_raw_buffer(const MatrixXf& buf, const RowVectorXd& cals)
+{
+    if (buf.rows() != cals.cols())
+    {
+        qWarning("buffer and calibration sizes do not match\n");
+        return false;
+    }
+
+    MatrixXf tmp = cals.transpose().cast<float>().cwiseInverse().asDiagonal() * buf;
+    this->write_float(FIFF_DATA_BUFFER,tmp.data(),tmp.rows()*tmp.cols());
+    return true;
+}
+
+//=============================================================================================================
+
+bool FiffStream::write_raw_buffer(const MatrixXf& buf)
+{
+    this->write_float(FIFF_DATA_BUFFER,buf.data(),buf.rows()*buf.cols());
+    return true;
+}
+
+//=============================================================================================================
+
 fiff_long_t FiffStream::write_string(fiff_int_t kind, const QString& data)
 {
     fiff_long_t pos = this->device()->pos();
@@ -80,6 +80,7 @@ namespace FIFFLIB
 
 class FiffStream;
 class FiffTag;
+class FiffTagView;
 class FiffCtfComp;
 class FiffRawData;
 class FiffInfo;
@@ -428,6 +429,41 @@ public:
      */
     bool read_tag(QSharedPointer<FiffTag>& p_pTag, fiff_long_t pos = -1);
 
+    //=========================================================================================================
+    /**
+     * Maps the underlying file into memory. While the stream is mapped, read_tag_view hands out views into the
+     * mapped memory instead of copies. Only QFile devices which are opened read-only can be mapped.
+     *
+     * @return true if succeeded, false otherwise
+     */
+    bool map();
+
+    //=========================================================================================================
+    /**
+     * Unmaps the underlying file from memory. All views returned by read_tag_view become invalid.
+     */
+    void unmap();
+
+    //=========================================================================================================
+    /**
+     * Returns whether the underlying file is mapped into memory, see map.
+     *
+     * @return true if the file is mapped, false otherwise
+     */
+    bool isMapped() const;
+
+    //=========================================================================================================
+    /**
+     * Read one tag from the memory mapped file without copying its data. The stream needs to be mapped,
+     * see map. The file position of the stream is not changed.
+     *
+     * @param[out] p_tagView the view of the tag, valid until the stream is unmapped.
+     * @param[in] pos position of the tag inside the fif file
+     *
+     * @return true if succeeded, false otherwise
+     */
+    bool read_tag_view(FiffTagView& p_tagView, fiff_long_t pos) const;
+
     //=========================================================================================================
     /**
      * fiff_setup_read_raw
@@ -832,6 +868,28 @@ public:
      */
     bool write_raw_buffer(const Eigen::MatrixXd& buf);
 
+    //=========================================================================================================
+    /**
+     * Writes a single precision raw buffer. The calibrations are removed in single precision, no double
+     * precision copy of the buffer is made.
+     *
+     * @param[in] buf        the buffer to write
+     * @param[in] cals       calibration factors
+     *
+     * @return true if succeeded, false otherwise
+     */
+    bool write_raw_buffer(const Eigen::MatrixXf& buf, const Eigen::RowVectorXd& cals);
+
+    //=========================================================================================================
+    /**
+     * Writes a single precision raw buffer without calibrations. The buffer is written as is.
+     *
+     * @param[in] buf        the buffer to write
+     *
+     * @return true if succeeded, false otherwise
+     */
+    bool write_raw_buffer(const Eigen::MatrixXf& buf);
+
     //=========================================================================================================
     /**
      * Writes a string tag
@@ -884,6 +942,8 @@ private:
     QList<FiffDirEntry::SPtr>   m_dir;  /**< This is the directory. If no directory exists, open automatically scans the file to create one. */
 //    int         nent;           /**< How many entries? */ -> Use nent() instead
     FiffDirNode::SPtr           m_dirtree; /**< Directory compiled into a tree */
+    uchar*                      m_pMappedData;  /**< The memory mapped file, NULL if the file is not mapped. */
+    qint64                      m_iMappedSize;  /**< The size of the memory mapped file in bytes. */
 //    char        *ext_file_name; /**< Name of the file holding the external data */
 //    FILE        *ext_fd;        /**< The file descriptor of the above file if open  */
 
@@ -0,0 +1,380 @@
+//=============================================================================================================
+/**
+ * @file     fiff_tag_view.h
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    FiffTagView class declaration.
+ *
+ */
+
+#ifndef FIFF_TAG_VIEW_H
+#define FIFF_TAG_VIEW_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_global.h"
+#include "fiff_types.h"
+#include "fiff_file.h"
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtEndian>
+
+//=============================================================================================================
+// STL INCLUDES
+//=============================================================================================================
+
+#include <cstring>
+
+//=============================================================================================================
+// DEFINE NAMESPACE FIFFLIB
+//=============================================================================================================
+
+namespace FIFFLIB
+{
+
+//=============================================================================================================
+/**
+ * Eigen functor which converts a value from the byte order of a memory mapped FIFF file to the native byte
+ * order. The swap flag is a template parameter so that the decision is made once per tag and not per element.
+ * Used by FiffTagView to hand out endian converting Eigen expressions and to convert whole spans of tag data.
+ *
+ * @brief Byte order conversion functor.
+ */
+template<typename T, bool bSwap>
+struct FiffEndianConvert
+{
+    inline T operator()(const T& value) const
+    {
+        return value;
+    }
+
+    static inline void convert(const char* pSource,
+                               T* pDest,
+                               qint64 iCount)
+    {
+        memcpy(pDest, pSource, iCount * sizeof(T));
+    }
+};
+
+//=============================================================================================================
+/**
+ * Specialization for data which is stored in non-native byte order. The bytes are reversed with qbswap on an
+ * unsigned integer of the same size, which the compiler turns into a single bswap instruction and vectorizes
+ * when a whole span is converted.
+ *
+ * @brief Byte swapping conversion functor.
+ */
+template<typename T>
+struct FiffEndianConvert<T, true>
+{
+    typedef typename QIntegerForSize<sizeof(T)>::Unsigned UInt;
+
+    inline T operator()(const T& value) const
+    {
+        return swap(value);
+    }
+
+    static inline T swap(T value)
+    {
+        UInt bits;
+        memcpy(&bits, &value, sizeof(T));
+        bits = qbswap(bits);
+        memcpy(&value, &bits, sizeof(T));
+        return value;
+    }
+
+    static inline void convert(const char* pSource,
+                               T* pDest,
+                               qint64 iCount)
+    {
+        for(qint64 i = 0; i < iCount; ++i) {
+            UInt bits;
+            memcpy(&bits, pSource + i * sizeof(T), sizeof(T));
+            bits = qbswap(bits);
+            memcpy(pDest + i, &bits, sizeof(T));
+        }
+    }
+};
+
+//=============================================================================================================
+/**
+ * A lightweight view of a tag inside a memory mapped FIFF file, see FiffStream::map and
+ * FiffStream::read_tag_view. In contrast to FiffTag no data is copied or converted on read. The pointer
+ * accessors can be used directly when the file is stored in native byte order. The map accessors return Eigen
+ * expressions, which convert the byte order on the fly while being evaluated into their destination.
+ * The view is only valid as long as the stream stays mapped.
+ *
+ * @brief Zero-copy view of a memory mapped FIFF tag.
+ */
+class FIFFSHARED_EXPORT FiffTagView
+{
+public:
+    template<typename T, bool bSwap>
+    using MatrixMap = Eigen::CwiseUnaryOp<FiffEndianConvert<T, bSwap>,
+                                          const Eigen::Map<const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > >;   /**< Endian converting matrix expression. */
+
+    //=========================================================================================================
+    /**
+     * Default constructor. Constructs an empty view.
+     */
+    FiffTagView();
+
+    //=========================================================================================================
+    /**
+     * Constructs a view of tag data which is located in mapped memory.
+     *
+     * @param[in] p_kind     Tag number.
+     * @param[in] p_type     Data type.
+     * @param[in] p_next     Pointer to the next object.
+     * @param[in] pData      Pointer to the tag data inside the mapped memory.
+     * @param[in] iSize      Size of the tag data in bytes.
+     * @param[in] bSwap      Whether the data is stored in non-native byte order.
+     */
+    FiffTagView(fiff_int_t p_kind,
+                fiff_int_t p_type,
+                fiff_int_t p_next,
+                const char* pData,
+                fiff_int_t iSize,
+                bool bSwap);
+
+    //=========================================================================================================
+    /**
+     * Returns whether the view points to data.
+     *
+     * @return true if no data is referenced, false otherwise.
+     */
+    inline bool isEmpty() const;
+
+    //=========================================================================================================
+    /**
+     * Returns whether the data is stored in native byte order. Only then the pointer accessors may be used
+     * without a byte order conversion.
+     *
+     * @return true if no byte order conversion is needed.
+     */
+    inline bool isNativeByteOrder() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the size of the tag data in bytes.
+     *
+     * @return the size of the tag data.
+     */
+    inline fiff_int_t size() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the raw tag data. No byte order conversion is applied.
+     *
+     * @return pointer to the tag data inside the mapped memory.
+     */
+    inline const char* data() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the tag data as 32-bit floats. No byte order conversion is applied, see isNativeByteOrder.
+     *
+     * @return pointer to the float data, NULL if the tag is not of type FIFFT_FLOAT.
+     */
+    inline const float* toFloat() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the tag data as 32-bit integers. No byte order conversion is applied, see isNativeByteOrder.
+     *
+     * @return pointer to the integer data, NULL if the tag is not of type FIFFT_INT.
+     */
+    inline const qint32* toInt() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the tag data as 16-bit integers. No byte order conversion is applied, see isNativeByteOrder.
+     *
+     * @return pointer to the short data, NULL if the tag is not of type FIFFT_SHORT.
+     */
+    inline const qint16* toShort() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the tag data as 16-bit packed data. No byte order conversion is applied, see isNativeByteOrder.
+     *
+     * @return pointer to the packed data, NULL if the tag is not of type FIFFT_DAU_PACK16.
+     */
+    inline const qint16* toDauPack16() const;
+
+    //=========================================================================================================
+    /**
+     * Returns an endian converting column-major matrix expression of the tag data. The expression does not
+     * allocate, the data is converted while the expression is evaluated. bSwap has to match
+     * !isNativeByteOrder().
+     *
+     * @param[in] rows   Number of rows.
+     * @param[in] cols   Number of columns.
+     *
+     * @return the matrix expression.
+     */
+    template<typename T, bool bSwap>
+    inline MatrixMap<T, bSwap> toMatrixMap(Eigen::Index rows,
+                                           Eigen::Index cols) const;
+
+    //=========================================================================================================
+    /**
+     * Copies a span of the tag data to pDest and converts it to native byte order. The byte order is checked
+     * once for the whole span.
+     *
+     * @param[out] pDest     The destination, has to hold iCount values.
+     * @param[in] iOffset    The index of the first value to copy.
+     * @param[in] iCount     The number of values to copy.
+     */
+    template<typename T>
+    inline void toNative(T* pDest,
+                         qint64 iOffset,
+                         qint64 iCount) const;
+
+public:
+    fiff_int_t  kind;       /**< Tag number. */
+    fiff_int_t  type;       /**< Data type. */
+    fiff_int_t  next;       /**< Pointer to the next object. */
+
+private:
+    const char* m_pData;    /**< Pointer to the tag data inside the mapped memory. */
+    fiff_int_t  m_iSize;    /**< Size of the tag data in bytes. */
+    bool        m_bSwap;    /**< Whether the data is stored in non-native byte order. */
+};
+
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+inline bool FiffTagView::isEmpty() const
+{
+    return m_pData == Q_NULLPTR;
+}
+
+//=============================================================================================================
+
+inline bool FiffTagView::isNativeByteOrder() const
+{
+    return !m_bSwap;
+}
+
+//=============================================================================================================
+
+inline fiff_int_t FiffTagView::size() const
+{
+    return m_iSize;
+}
+
+//=============================================================================================================
+
+inline const char* FiffTagView::data() const
+{
+    return m_pData;
+}
+
+//=============================================================================================================
+
+inline const float* FiffTagView::toFloat() const
+{
+    if(this->type != FIFFT_FLOAT) {
+        return Q_NULLPTR;
+    }
+    return reinterpret_cast<const float*>(m_pData);
+}
+
+//=============================================================================================================
+
+inline const qint32* FiffTagView::toInt() const
+{
+    if(this->type != FIFFT_INT) {
+        return Q_NULLPTR;
+    }
+    return reinterpret_cast<const qint32*>(m_pData);
+}
+
+//=============================================================================================================
+
+inline const qint16* FiffTagView::toShort() const
+{
+    if(this->type != FIFFT_SHORT) {
+        return Q_NULLPTR;
+    }
+    return reinterpret_cast<const qint16*>(m_pData);
+}
+
+//=============================================================================================================
+
+inline const qint16* FiffTagView::toDauPack16() const
+{
+    if(this->type != FIFFT_DAU_PACK16) {
+        return Q_NULLPTR;
+    }
+    return reinterpret_cast<const qint16*>(m_pData);
+}
+
+//=============================================================================================================
+
+template<typename T, bool bSwap>
+inline FiffTagView::MatrixMap<T, bSwap> FiffTagView::toMatrixMap(Eigen::Index rows,
+                                                                 Eigen::Index cols) const
+{
+    typedef Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> MatrixT;
+
+    Eigen::Map<const MatrixT> map(reinterpret_cast<const T*>(m_pData), rows, cols);
+    return map.unaryExpr(FiffEndianConvert<T, bSwap>());
+}
+
+//=============================================================================================================
+
+template<typename T>
+inline void FiffTagView::toNative(T* pDest,
+                                  qint64 iOffset,
+                                  qint64 iCount) const
+{
+    const char* pSource = m_pData + iOffset * sizeof(T);
+
+    if(m_bSwap) {
+        FiffEndianConvert<T, true>::convert(pSource, pDest, iCount);
+    } else {
+        FiffEndianConvert<T, false>::convert(pSource, pDest, iCount);
+    }
+}
+} // NAMESPACE
+
+#endif // FIFF_TAG_VIEW_H
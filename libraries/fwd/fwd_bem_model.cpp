@@ -44,6 +44,7 @@
 #include <mne/c/mne_surface_old.h>
 #include <mne/c/mne_triangle.h>
 #include <mne/c/mne_source_space_old.h>
+#include <mne/mne_triangle_bvh.h>
 
 #include "fwd_comp_data.h"
 #include "fwd_bem_model.h"
@@ -1556,6 +1557,7 @@ int FwdBemModel::fwd_bem_specify_els(FwdBemModel* m, FwdCoilSet *els)
     MneTriangle* tri;
     float       x,y,z;
     FwdBemSolution* sol;
+    MNETriangleBVH scalp_bvh;
 
     if (!m) {
         printf("Model missing in fwd_bem_specify_els");
@@ -1577,6 +1579,11 @@ int FwdBemModel::fwd_bem_specify_els(FwdBemModel* m, FwdCoilSet *els)
     sol->ncoil = els->ncoil;
     sol->np    = m->nsol;
     sol->solution  = ALLOC_CMATRIX_40(sol->ncoil,sol->np);
+    /*
+       * All integration points are projected onto the same scalp surface
+       */
+    scalp = m->surfs[0];
+    scalp_bvh = MneSurfaceOrVolume::mne_make_triangle_bvh(scalp);
     /*
        * Go through all coils
        */
@@ -1585,7 +1592,6 @@ int FwdBemModel::fwd_bem_specify_els(FwdBemModel* m, FwdCoilSet *els)
         one_sol = sol->solution[k];
         for (q = 0; q < m->nsol; q++)
             one_sol[q] = 0.0;
-        scalp = m->surfs[0];
         /*
          * Go through all 'integration points'
          */
@@ -1593,7 +1599,7 @@ int FwdBemModel::fwd_bem_specify_els(FwdBemModel* m, FwdCoilSet *els)
             VEC_COPY_40(r,el->rmag[p]);
             if (m->head_mri_t != NULL)
                 FiffCoordTransOld::fiff_coord_trans(r,m->head_mri_t,FIFFV_MOVE);
-            best = MneSurfaceOrVolume::mne_project_to_surface(scalp,NULL,r,FALSE,&dist);
+            best = MneSurfaceOrVolume::mne_project_to_surface(scalp,scalp_bvh,r,FALSE,&dist);
             if (best < 0) {
                 printf("One of the electrodes could not be projected onto the scalp surface. How come?");
                 goto bad;
@@ -4,8 +4,12 @@
 #include "../c/mne_meas_data_set.h"
 #include "guess_data.h"
 
+#include <utils/parallelexecutor.h>
+
 #include <string.h>
+
 #include <QScopedPointer>
+#include <QVector>
 
 using namespace INVERSELIB;
 using namespace MNELIB;
@@ -566,6 +570,7 @@ ECDSet DipoleFit::calculateFit() const
     MneMeasData*        data     = NULL;
     MneRawData*         raw      = NULL;
     mneChSelection      sel      = NULL;
+    int                 nthread  = 1;
 
     printf("---- Setting up...\n\n");
     if (settings->include_eeg) {
@@ -662,19 +667,24 @@ ECDSet DipoleFit::calculateFit() const
     printf("\n---- Computing the forward solution for the guesses...\n\n");
     guess.reset(new GuessData( settings->guessname,
                                settings->guess_surfname,
-                               settings->guess_mindist, settings->guess_exclude, settings->guess_grid, fit_data));
+                               settings->guess_mindist, settings->guess_exclude, settings->guess_grid, fit_data,
+                               settings->guess_cachename));
     if (guess.isNull())
         goto out;
 
     fprintf (stderr,"\n---- Fitting : %7.1f ... %7.1f ms (step: %6.1f ms integ: %6.1f ms)\n\n",
              1000*settings->tmin,1000*settings->tmax,1000*settings->tstep,1000*settings->integ);
 
+    nthread = UTILSLIB::ParallelExecutor::threadCount(settings->nthread);
+    if (nthread > 1)
+        fprintf (stderr,"Using %d threads.\n",nthread);
+
     if (raw) {
-        if (fit_dipoles_raw(settings->measname,raw,sel,fit_data,guess.take(),settings->tmin,settings->tmax,settings->tstep,settings->integ,settings->verbose) == FAIL)
+        if (fit_dipoles_raw(settings->measname,raw,sel,fit_data,guess.take(),settings->tmin,settings->tmax,settings->tstep,settings->integ,settings->verbose,nthread) == FAIL)
             goto out;
     }
     else {
-        if (fit_dipoles(settings->measname,data,fit_data,guess.take(),settings->tmin,settings->tmax,settings->tstep,settings->integ,settings->verbose,set) == FAIL)
+        if (fit_dipoles(settings->measname,data,fit_data,guess.take(),settings->tmin,settings->tmax,settings->tstep,settings->integ,settings->verbose,set,nthread) == FAIL)
             goto out;
     }
     printf("%d dipoles fitted\n",set.size());
@@ -686,52 +696,116 @@ out : {
 
 //=============================================================================================================
 
-int DipoleFit::fit_dipoles( const QString& dataname, MneMeasData* data, DipoleFitData* fit, GuessData* guess, float tmin, float tmax, float tstep, float integ, int verbose, ECDSet& p_set)
+static void fit_dipole_batch(DipoleFitData* fit,
+                             GuessData*     guess,
+                             const QVector<float>& times,
+                             float          **vals,
+                             int            verbose,
+                             int            nthread,
+                             ECDSet&        set)
+/*
+ * Fit the picked data points and add the dipoles to the set in time order.
+ * The initial guesses for all points are found at once. With more than one
+ * thread the points are then dealt out round robin, each thread with its own
+ * forward calculation workspace.
+ */
+{
+    int   npts = times.size();
+    int   report_interval = 10;
+    int   p;
+    QVector<ECD>  dips(npts);
+    QVector<int>  fitted(npts);
+    QVector<int>  best(npts);
+
+    if (npts == 0)
+        return;
+    if (nthread > npts)
+        nthread = npts;
+
+    if (DipoleFitData::find_best_guesses(fit,guess,vals,npts,best.data()) == FAIL)
+        best.fill(-1);
+
+    if (nthread <= 1) {
+        for (p = 0; p < npts; p++)
+            fitted[p] = best[p] >= 0 && DipoleFitData::fit_one_guess(fit,guess,best[p],times[p],vals[p],verbose,dips[p]);
+    }
+    else {
+        ECD   *dipp    = dips.data();
+        int   *fittedp = fitted.data();
+        int   *bestp   = best.data();
+
+        /*
+         * Reporting from inside the simplex would interleave between the threads
+         */
+        UTILSLIB::ParallelExecutor::run([&](int t, int nt) {
+            dipoleFitWorkspace ws = DipoleFitData::new_fit_workspace(fit);
+            for (int q = t; q < npts; q += nt)
+                fittedp[q] = bestp[q] >= 0 && DipoleFitData::fit_one_guess(fit,guess,bestp[q],times[q],vals[q],FALSE,dipp[q],ws);
+            DipoleFitData::free_fit_workspace(ws);
+        }, nthread);
+    }
+
+    for (p = 0; p < npts; p++) {
+        if (!fitted[p])
+            printf("t = %7.1f ms : %s\n",1000*times[p],"error (tbd: catch)");
+        else {
+            set.addEcd(dips[p]);
+            if (verbose)
+                dips[p].print(stdout);
+            else {
+                if (set.size() % report_interval == 0)
+                    fprintf(stderr,"%d..",set.size());
+            }
+        }
+    }
+    return;
+}
+
+//=============================================================================================================
+
+int DipoleFit::fit_dipoles( const QString& dataname, MneMeasData* data, DipoleFitData* fit, GuessData* guess, float tmin, float tmax, float tstep, float integ, int verbose, ECDSet& p_set, int nthread)
 {
-    float *one = MALLOC(data->nchan,float);
+    float **vals;
     float time;
     ECDSet set;
-    ECD   dip;
-    int   s;
-    int   report_interval = 10;
+    int   s,npts;
+    QVector<float> times;
 
     set.dataname = dataname;
 
+    for (s = 0, time = tmin; time < tmax; s++, time = tmin  + s*tstep)
+        ;
+    vals = ALLOC_CMATRIX(s > 0 ? s : 1,data->nchan);
+
     fprintf(stderr,"Fitting...%c",verbose ? '\n' : '\0');
-    for (s = 0, time = tmin; time < tmax; s++, time = tmin  + s*tstep) {
+    for (s = 0, npts = 0, time = tmin; time < tmax; s++, time = tmin  + s*tstep) {
         /*
      * Pick the data point
      */
         if (mne_get_values_from_data(time,integ,data->current->data,data->current->np,data->nchan,data->current->tmin,
-                                     1.0/data->current->tstep,FALSE,one) == FAIL) {
+                                     1.0/data->current->tstep,FALSE,vals[npts]) == FAIL) {
             fprintf(stderr,"Cannot pick time: %7.1f ms\n",1000*time);
             continue;
         }
-
-        if (!DipoleFitData::fit_one(fit,guess,time,one,verbose,dip))
-            printf("t = %7.1f ms : %s\n",1000*time,"error (tbd: catch)");
-        else {
-            set.addEcd(dip);
-            if (verbose)
-                dip.print(stdout);
-            else {
-                if (set.size() % report_interval == 0)
-                    fprintf(stderr,"%d..",set.size());
-            }
-        }
+        times.append(time);
+        npts++;
     }
+    /*
+     * The time points are independent of each other
+     */
+    fit_dipole_batch(fit,guess,times,vals,verbose,nthread,set);
+
     if (!verbose)
         fprintf(stderr,"[done]\n");
-    FREE(one);
+    FREE_CMATRIX(vals);
     p_set = set;
     return OK;
 }
 
 //=============================================================================================================
 
-int DipoleFit::fit_dipoles_raw(const QString& dataname, MneRawData* raw, mneChSelection sel, DipoleFitData* fit, GuessData* guess, float tmin, float tmax, float tstep, float integ, int verbose, ECDSet& p_set)
+int DipoleFit::fit_dipoles_raw(const QString& dataname, MneRawData* raw, mneChSelection sel, DipoleFitData* fit, GuessData* guess, float tmin, float tmax, float tstep, float integ, int verbose, ECDSet& p_set, int nthread)
 {
-    float *one    = MALLOC(sel->nchan,float);
     float sfreq   = raw->info->sfreq;
     float myinteg = integ > 0.0 ? 2*integ : 0.1;
     int   overlap = ceil(myinteg*sfreq);
@@ -742,9 +816,10 @@ int DipoleFit::fit_dipoles_raw(const QString& dataname, MneRawData* raw, mneChSe
     int   s,picks;
     float time,stime;
     float **data  = ALLOC_CMATRIX(sel->nchan,length);
-    ECD    dip;
+    int   nbatch  = length;			/* At most this many points are fitted at once */
+    float **vals  = ALLOC_CMATRIX(nbatch,sel->nchan);
+    QVector<float> times;
     ECDSet set;
-    int    report_interval = 10;
 
     set.dataname = dataname;
 
@@ -758,52 +833,51 @@ int DipoleFit::fit_dipoles_raw(const QString& dataname, MneRawData* raw, mneChSe
     for (s = 0, time = tmin; time < tmax; s++, time = tmin  + s*tstep) {
         picks = time*sfreq - start;
         if (picks > stepo) {		/* Need a new data segment? */
+            /*
+             * Fit what was picked from the current segment first
+             */
+            fit_dipole_batch(fit,guess,times,vals,verbose,nthread,set);
+            times.clear();
+
             start = start + step;
             if (MneRawData::mne_raw_pick_data_filt(raw,sel,start,length,data) == FAIL)
                 goto bad;
             picks = time*sfreq - start;
             stime = start/sfreq;
         }
+        if (times.size() >= nbatch) {
+            fit_dipole_batch(fit,guess,times,vals,verbose,nthread,set);
+            times.clear();
+        }
         /*
      * Get the values
      */
-        if (mne_get_values_from_data_ch (time,integ,data,length,sel->nchan,stime,sfreq,FALSE,one) == FAIL) {
+        if (mne_get_values_from_data_ch (time,integ,data,length,sel->nchan,stime,sfreq,FALSE,vals[times.size()]) == FAIL) {
             fprintf(stderr,"Cannot pick time: %8.3f s\n",time);
             continue;
         }
-        /*
-     * Fit
-     */
-        if (!DipoleFitData::fit_one(fit,guess,time,one,verbose,dip))
-            qWarning() << "Error";
-        else {
-            set.addEcd(dip);
-            if (verbose)
-                dip.print(stdout);
-            else {
-                if (set.size() % report_interval == 0)
-                    fprintf(stderr,"%d..",set.size());
-            }
-        }
+        times.append(time);
     }
+    fit_dipole_batch(fit,guess,times,vals,verbose,nthread,set);
+
     if (!verbose)
         fprintf(stderr,"[done]\n");
     FREE_CMATRIX(data);
-    FREE(one);
+    FREE_CMATRIX(vals);
     p_set = set;
     return OK;
 
 bad : {
         FREE_CMATRIX(data);
-        FREE(one);
+        FREE_CMATRIX(vals);
         return FAIL;
     }
 }
 
 //=============================================================================================================
 
-int DipoleFit::fit_dipoles_raw(const QString& dataname, MneRawData* raw, mneChSelection sel, DipoleFitData* fit, GuessData* guess, float tmin, float tmax, float tstep, float integ, int verbose)
+int DipoleFit::fit_dipoles_raw(const QString& dataname, MneRawData* raw, mneChSelection sel, DipoleFitData* fit, GuessData* guess, float tmin, float tmax, float tstep, float integ, int verbose, int nthread)
 {
     ECDSet set;
-    return fit_dipoles_raw(dataname, raw, sel, fit, guess, tmin, tmax, tstep, integ, verbose, set);
+    return fit_dipoles_raw(dataname, raw, sel, fit, guess, tmin, tmax, tstep, integ, verbose, set, nthread);
 }
@@ -112,10 +112,11 @@ public:
      * @param[in] integ      Integration time
      * @param[in] verbose    Verbose output?
      * @param[out] p_set     the fitted ECD Set
+     * @param[in] nthread    Number of threads to distribute the time points over
      *
      * @return true when successful
      */
-    static int fit_dipoles( const QString& dataname, MneMeasData* data, DipoleFitData* fit, GuessData* guess, float tmin, float tmax, float tstep, float integ, int verbose, ECDSet& p_set);
+    static int fit_dipoles( const QString& dataname, MneMeasData* data, DipoleFitData* fit, GuessData* guess, float tmin, float tmax, float tstep, float integ, int verbose, ECDSet& p_set, int nthread = 1);
 
     //=========================================================================================================
     /**
@@ -134,10 +135,11 @@ public:
      * @param[in] integ      Integration time
      * @param[in] verbose    Verbose output?
      * @param[out] p_set     Return all results here. Warning: for large data files this may take a lot of memory
+     * @param[in] nthread    Number of threads to distribute the time points over
      *
      * @return true when successful
      */
-    static int fit_dipoles_raw(const QString& dataname, MNELIB::MneRawData* raw, mneChSelection sel, DipoleFitData* fit, GuessData* guess, float tmin, float tmax, float tstep, float integ, int verbose, ECDSet& p_set);
+    static int fit_dipoles_raw(const QString& dataname, MNELIB::MneRawData* raw, mneChSelection sel, DipoleFitData* fit, GuessData* guess, float tmin, float tmax, float tstep, float integ, int verbose, ECDSet& p_set, int nthread = 1);
 
     //=========================================================================================================
     /**
@@ -155,10 +157,11 @@ public:
      * @param[in] tstep      Time step to use
      * @param[in] integ      Integration time
      * @param[in] verbose    Verbose output?
+     * @param[in] nthread    Number of threads to distribute the time points over
      *
      * @return true when successful
      */
-    static int fit_dipoles_raw(const QString& dataname, MNELIB::MneRawData* raw, mneChSelection sel, DipoleFitData* fit, GuessData* guess, float tmin, float tmax, float tstep, float integ, int verbose);
+    static int fit_dipoles_raw(const QString& dataname, MNELIB::MneRawData* raw, mneChSelection sel, DipoleFitData* fit, GuessData* guess, float tmin, float tmax, float tstep, float integ, int verbose, int nthread = 1);
 
 private:
     DipoleFitSettings* settings;
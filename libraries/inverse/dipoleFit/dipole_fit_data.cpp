@@ -158,6 +158,8 @@ void mne_free_dcmatrix_3 (double **m)
     (diff)[Z_3] = (to)[Z_3] - (from)[Z_3];\
     }
 
+#define RADIAL_LIMIT_3 0.2f  /* (Pseudo) radial component omission limit in the fits */
+
 #define VEC_COPY_3(to,from) {\
     (to)[X_3] = (from)[X_3];\
     (to)[Y_3] = (from)[Y_3];\
@@ -457,6 +459,8 @@ FiffSparseMatrix* mne_convert_to_sparse_3(float **dense,        /* The dense mat
 }
 
 typedef struct {
+    DipoleFitData*  fit;
+    dipoleFitFuncs  funcs;
     float          limit;
     int            report_dim;
     float          *B;
@@ -1323,6 +1327,97 @@ static dipoleFitFuncs new_dipole_fit_funcs()
     return f;
 }
 
+static dipoleFitFuncs dup_dipole_fit_funcs(dipoleFitFuncs f,
+                                           FwdBemModel    *bem_model,
+                                           FwdBemModel    *bem_dup)
+/*
+ * Duplicate the forward functions to make them thread safe
+ * Do not duplicate read-only parts of the relevant structures
+ */
+{
+    dipoleFitFuncs res;
+    FwdCompData*   orig;
+    FwdCompData*   comp;
+
+    if (!f)
+        return NULL;
+    res = new_dipole_fit_funcs();
+    *res = *f;
+    res->meg_client_free = NULL;
+    res->eeg_client_free = NULL;
+
+    if (f->meg_client) {
+        orig = (FwdCompData*)f->meg_client;
+        res->meg_client = comp = new FwdCompData;
+        *comp = *orig;
+        comp->work     = NULL;
+        comp->vec_work = NULL;
+        comp->set      = orig->set ? new MneCTFCompDataSet(*(orig->set)) : NULL;
+        if (bem_model && comp->client == bem_model)
+            comp->client = bem_dup;
+    }
+    if (bem_model && f->eeg_client == bem_model)
+        res->eeg_client = bem_dup;
+    return res;
+}
+
+static void free_dipole_fit_funcs_dup(dipoleFitFuncs f)
+
+{
+    FwdCompData* comp;
+
+    if (!f)
+        return;
+    if (f->meg_client) {
+        comp = (FwdCompData*)f->meg_client;
+        FREE_3(comp->work);
+        FREE_CMATRIX_3(comp->vec_work);
+        if (comp->set)
+            delete comp->set;
+        FREE_3(comp);
+    }
+    FREE_3(f);
+    return;
+}
+
+//=============================================================================================================
+
+dipoleFitWorkspace DipoleFitData::new_fit_workspace(DipoleFitData* fit)
+{
+    dipoleFitWorkspace ws = MALLOC_3(1,dipoleFitWorkspaceRec);
+
+    ws->bem_model = NULL;
+    ws->fwd       = NULL;
+    if (fit->bem_model) {
+        /*
+         * Only the infinite-medium potential buffer is written to during the field computations
+         */
+        ws->bem_model     = new FwdBemModel();
+        *(ws->bem_model)  = *(fit->bem_model);
+        ws->bem_model->v0 = NULL;
+    }
+    ws->sphere_funcs = dup_dipole_fit_funcs(fit->sphere_funcs,fit->bem_model,ws->bem_model);
+    ws->bem_funcs    = dup_dipole_fit_funcs(fit->bem_funcs,fit->bem_model,ws->bem_model);
+    return ws;
+}
+
+//=============================================================================================================
+
+void DipoleFitData::free_fit_workspace(dipoleFitWorkspace ws)
+{
+    if (!ws)
+        return;
+    free_dipole_fit_funcs_dup(ws->sphere_funcs);
+    free_dipole_fit_funcs_dup(ws->bem_funcs);
+    if (ws->bem_model) {
+        FREE_3(ws->bem_model->v0);
+        FREE_3(ws->bem_model);
+    }
+    delete ws->fwd;
+    FREE_3(ws);
+    return;
+}
+
 //============================= mne_simplex_fit.c =============================
 
 /*
@@ -4223,6 +4318,7 @@ out : {
 //=============================================================================================================
 
 DipoleForward* dipole_forward(DipoleFitData* d,
+                              dipoleFitFuncs funcs,
                               float         **rd,
                               int           ndip,
                               DipoleForward* old)
@@ -4259,7 +4355,7 @@ DipoleForward* dipole_forward(DipoleFitData* d,
         /*
      * Calculate the field of three orthogonal dipoles
      */
-        if ((DipoleFitData::compute_dipole_field(d,rd[k],TRUE,this_fwd)) == FAIL)
+        if ((DipoleFitData::compute_dipole_field(d,funcs,rd[k],TRUE,this_fwd)) == FAIL)
             goto bad;
         /*
      * Choice of column normalization
@@ -4317,10 +4413,23 @@ DipoleForward* DipoleFitData::dipole_forward_one(DipoleFitData* d,
 /*
  * Convenience function to compute the field of one dipole
  */
+{
+    return dipole_forward_one(d,d->funcs,rd,old);
+}
+
+//=============================================================================================================
+
+DipoleForward* DipoleFitData::dipole_forward_one(DipoleFitData* d,
+                                                 dipoleFitFuncs funcs,
+                                                 float         *rd,
+                                                 DipoleForward* old)
+/*
+ * Ditto with explicitly given forward functions
+ */
 {
     float *rds[1];
     rds[0] = rd;
-    return dipole_forward(d,rds,1,old);
+    return dipole_forward(d,funcs,rds,1,old);
 }
 
 //=============================================================================================================
@@ -4330,13 +4439,12 @@ static float fit_eval(float *rd,int npar,void *user)
  * Calculate the residual sum of squares
  */
 {
-    DipoleFitData* fit   = (DipoleFitData*)user;
+    fitDipUser       fuser = (fitDipUser)user;
     DipoleForward* fwd;
-    fitDipUser       fuser = (fitDipUser)fit->user;
     double        Bm2,one;
     int           ncomp,c;
 
-    fwd = fuser->fwd = DipoleFitData::dipole_forward_one(fit,rd,fuser->fwd);
+    fwd = fuser->fwd = DipoleFitData::dipole_forward_one(fuser->fit,fuser->funcs,rd,fuser->fwd);
     ncomp = fwd->sing[2]/fwd->sing[0] > fuser->limit ? 3 : 2;
     if (fuser->report_dim)
         fprintf(stderr,"ncomp = %d\n",ncomp);
@@ -4348,48 +4456,6 @@ static float fit_eval(float *rd,int npar,void *user)
     return fuser->B2-Bm2;
 }
 
-static int find_best_guess(float     *B,         /* The whitened data */
-                           int       nch,
-                           GuessData* guess,	 /* Guesses */
-                           float     limit,	 /* Pseudoradial component omission limit */
-                           int       *bestp,	 /* Which is the best */
-                           float     *goodp)	 /* Best goodness of fit */
-/*
- * Thanks to the precomputed SVD everything is really simple
- */
-{
-    int    k,c;
-    double B2,Bm2,this_good,one;
-    int    best = -1;
-    float  good = 0.0;
-    DipoleForward* fwd;
-    int    ncomp;
-
-    B2 = mne_dot_vectors_3(B,B,nch);
-    for (k = 0; k < guess->nguess; k++) {
-        fwd = guess->guess_fwd[k];
-        if (fwd->nch == nch) {
-            ncomp = fwd->sing[2]/fwd->sing[0] > limit ? 3 : 2;
-            for (c = 0, Bm2 = 0.0; c < ncomp; c++) {
-                one = mne_dot_vectors_3(fwd->uu[c],B,nch);
-                Bm2 = Bm2 + one*one;
-            }
-            this_good = 1.0 - (B2 - Bm2)/B2;
-            if (this_good > good) {
-                best = k;
-                good = this_good;
-            }
-        }
-    }
-    if (best < 0) {
-        printf("No reasonable initial guess found.");
-        return FAIL;
-    }
-     *bestp = best;
-     *goodp = good;
-    return OK;
-}
-
 static float **make_initial_dipole_simplex(float  *r0,
                                            float  size)
 /*
@@ -4441,6 +4507,7 @@ static int report_func(int     loop,
 }
 
 static int fit_Q(DipoleFitData* fit,	     /* The fit data */
+                 dipoleFitFuncs funcs,	     /* The forward functions to use */
                  float *B,		     /* Measurement */
                  float *rd,		     /* Dipole position */
                  float limit,		     /* Radial component omission limit */
@@ -4452,7 +4519,7 @@ static int fit_Q(DipoleFitData* fit,	     /* The fit data */
  */
 {
     int c;
-    DipoleForward* fwd = DipoleFitData::dipole_forward_one(fit,rd,NULL);
+    DipoleForward* fwd = DipoleFitData::dipole_forward_one(fit,funcs,rd,NULL);
     float Bm2,one;
 
     if (!fwd)
@@ -4643,17 +4710,68 @@ int simplex_minimize(float **p,		                              /* The initial si
 
 //=============================================================================================================
 // fit_dipoles.c
+int DipoleFitData::find_best_guesses(DipoleFitData* fit,    /* Precomputed fitting data */
+                                     GuessData*     guess,  /* The initial guesses */
+                                     float          **B,    /* The fields, projected and whitened in place */
+                                     int            npts,   /* How many of them */
+                                     int            *best)  /* The best guess for each, -1 if none */
+{
+    int      nchan = fit->nmeg+fit->neeg;
+    int      p;
+    MatrixXf matB(nchan,npts);
+    VectorXi vecBest;
+    VectorXf vecGood;
+
+    for (p = 0; p < npts; p++)
+        if (MneProjOp::mne_proj_op_proj_vector(fit->proj,B[p],nchan,TRUE) == FAIL)
+            return FAIL;
+    if (mne_whiten_data(B,B,npts,nchan,fit->noise) == FAIL)
+        return FAIL;
+
+    for (p = 0; p < npts; p++)
+        matB.col(p) = Map<VectorXf>(B[p],nchan);
+    if (!guess->find_best_guesses(matB,RADIAL_LIMIT_3,vecBest,vecGood))
+        return FAIL;
+    for (p = 0; p < npts; p++) {
+        if ((best[p] = vecBest[p]) < 0)
+            printf("No reasonable initial guess found.");
+    }
+    return OK;
+}
+
+//=============================================================================================================
+
 bool DipoleFitData::fit_one(DipoleFitData* fit,	            /* Precomputed fitting data */
                     GuessData*     guess,	            /* The initial guesses */
                     float         time,              /* Which time is it? */
                     float         *B,	            /* The field to fit */
                     int           verbose,
-                    ECD&          res               /* The fitted dipole */
+                    ECD&          res,              /* The fitted dipole */
+                    dipoleFitWorkspace ws           /* Thread-private workspace (optional) */
                     )
+{
+    int best;
+
+    if (find_best_guesses(fit,guess,&B,1,&best) == FAIL || best < 0)
+        return false;
+    return fit_one_guess(fit,guess,best,time,B,verbose,res,ws);
+}
+
+//=============================================================================================================
+
+bool DipoleFitData::fit_one_guess(DipoleFitData* fit,	    /* Precomputed fitting data */
+                          GuessData*     guess,	    /* The initial guesses */
+                          int           best,        /* The best initial guess */
+                          float         time,        /* Which time is it? */
+                          float         *B,	    /* The projected and whitened field to fit */
+                          int           verbose,
+                          ECD&          res,         /* The fitted dipole */
+                          dipoleFitWorkspace ws     /* Thread-private workspace (optional) */
+                          )
 {
     float  **simplex       = NULL;	       /* The simplex */
     float  vals[4];			       /* Values at the vertices */
-    float  limit           = 0.2;	               /* (pseudo) radial component omission limit */
+    float  limit           = RADIAL_LIMIT_3;       /* (pseudo) radial component omission limit */
     float  size            = 1e-2;	       /* Size of the initial simplex */
     float  ftol[]          = { 1e-2, 1e-2 };     /* Tolerances on the the two passes */
     float  atol[]          = { 0.2e-3, 0.2e-3 }; /* If dipole movement between two iterations is less than this,
@@ -4662,32 +4780,20 @@ bool DipoleFitData::fit_one(DipoleFitData* fit,	            /* Precomputed fitti
     int    max_eval        = 1000;	       /* Limit for fit function evaluations */
     int    report_interval = verbose ? 1 : -1;   /* How often to report the intermediate result */
 
-    int        best;
-    float      good,rd_guess[3],rd_final[3],Q[3],final_val;
+    float      rd_guess[3],rd_final[3],Q[3],final_val;
     fitDipUserRec user;
     int        k,p,neval,neval_tot,nchan,ncomp;
     int        fit_fail;
 
     nchan = fit->nmeg+fit->neeg;
-    user.fwd = NULL;
-
-    if (MneProjOp::mne_proj_op_proj_vector(fit->proj,B,nchan,TRUE) == FAIL)
-        goto bad;
-
-    if (mne_whiten_one_data(B,B,nchan,fit->noise) == FAIL)
-        goto bad;
-    /*
-   * Get the initial guess
-   */
-    if (find_best_guess(B,nchan,guess,limit,&best,&good) < 0)
-        goto bad;
+    user.fwd = ws ? ws->fwd : NULL;
 
+    user.fit   = fit;
+    user.funcs = fit->funcs;
     user.limit = limit;
     user.B     = B;
     user.B2    = mne_dot_vectors_3(B,B,nchan);
-    user.fwd   = NULL;
     user.report_dim = FALSE;
-    fit->user  = &user;
 
     VEC_COPY_3(rd_guess,guess->rr[best]);
     VEC_COPY_3(rd_final,guess->rr[best]);
@@ -4699,20 +4805,22 @@ bool DipoleFitData::fit_one(DipoleFitData* fit,	            /* Precomputed fitti
      * Do first pass with the sphere model
      */
         if (k == 0)
-            fit->funcs = fit->sphere_funcs;
+            user.funcs = ws ? ws->sphere_funcs : fit->sphere_funcs;
+        else if (!fit->bemname.isEmpty())
+            user.funcs = ws ? ws->bem_funcs : fit->bem_funcs;
         else
-            fit->funcs = !fit->bemname.isEmpty() ? fit->bem_funcs : fit->sphere_funcs;
+            user.funcs = ws ? ws->sphere_funcs : fit->sphere_funcs;
 
         simplex = make_initial_dipole_simplex(rd_guess,size);
         for (p = 0; p < 4; p++)
-            vals[p] = fit_eval(simplex[p],3,fit);
+            vals[p] = fit_eval(simplex[p],3,&user);
         if (simplex_minimize(simplex,           /* The initial simplex */
                              vals,              /* Function values at the vertices */
                              3,                 /* Number of variables */
                              ftol[k],           /* Relative convergence tolerance for the target function */
                              atol[k],           /* Absolute tolerance for the change in the parameters */
                              fit_eval,          /* The function to be evaluated */
-                             fit,               /* Data to be passed to the above function in each evaluation */
+                             &user,             /* Data to be passed to the above function in each evaluation */
                              max_eval,          /* Maximum number of function evaluations */
                              &neval,            /* Number of function evaluations */
                              report_interval,   /* How often to report (-1 = no_reporting) */
@@ -4738,7 +4846,7 @@ bool DipoleFitData::fit_one(DipoleFitData* fit,	            /* Precomputed fitti
     /*
    * Compute the dipole moment at the final point
    */
-    if (fit_Q(fit,user.B,rd_final,user.limit,Q,&ncomp,&final_val) == OK) {
+    if (fit_Q(fit,user.funcs,user.B,rd_final,user.limit,Q,&ncomp,&final_val) == OK) {
         res.time  = time;
         res.valid = true;
         for(int i = 0; i < 3; ++i)
@@ -4757,13 +4865,19 @@ bool DipoleFitData::fit_one(DipoleFitData* fit,	            /* Precomputed fitti
     }
     else
         goto bad;
-    delete user.fwd;
+    if (ws)
+        ws->fwd = user.fwd;
+    else
+        delete user.fwd;
     FREE_CMATRIX_3(simplex);
 
     return true;
 
 bad : {
-        delete user.fwd;
+        if (ws)
+            ws->fwd = user.fwd;
+        else
+            delete user.fwd;
         FREE_CMATRIX_3(simplex);
         return false;
     }
@@ -4772,6 +4886,13 @@ bad : {
 //=============================================================================================================
 
 int DipoleFitData::compute_dipole_field(DipoleFitData* d, float *rd, int whiten, float **fwd)
+{
+    return compute_dipole_field(d,d->funcs,rd,whiten,fwd);
+}
+
+//=============================================================================================================
+
+int DipoleFitData::compute_dipole_field(DipoleFitData* d, dipoleFitFuncs funcs, float *rd, int whiten, float **fwd)
 /*
  * Compute the field and take whitening and projection into account
  */
@@ -4785,34 +4906,34 @@ int DipoleFitData::compute_dipole_field(DipoleFitData* d, float *rd, int whiten,
    * Compute the fields
    */
     if (d->nmeg > 0) {
-        if (d->funcs->meg_vec_field) {
-            if (d->funcs->meg_vec_field(rd,d->meg_coils,fwd,d->funcs->meg_client) != OK)
+        if (funcs->meg_vec_field) {
+            if (funcs->meg_vec_field(rd,d->meg_coils,fwd,funcs->meg_client) != OK)
                 goto bad;
         }
         else {
-            if (d->funcs->meg_field(rd,Qx,d->meg_coils,fwd[0],d->funcs->meg_client) != OK)
+            if (funcs->meg_field(rd,Qx,d->meg_coils,fwd[0],funcs->meg_client) != OK)
                 goto bad;
-            if (d->funcs->meg_field(rd,Qy,d->meg_coils,fwd[1],d->funcs->meg_client) != OK)
+            if (funcs->meg_field(rd,Qy,d->meg_coils,fwd[1],funcs->meg_client) != OK)
                 goto bad;
-            if (d->funcs->meg_field(rd,Qz,d->meg_coils,fwd[2],d->funcs->meg_client) != OK)
+            if (funcs->meg_field(rd,Qz,d->meg_coils,fwd[2],funcs->meg_client) != OK)
                 goto bad;
         }
     }
 
     if (d->neeg > 0) {
-        if (d->funcs->eeg_vec_pot) {
+        if (funcs->eeg_vec_pot) {
             eeg_fwd[0] = fwd[0]+d->nmeg;
             eeg_fwd[1] = fwd[1]+d->nmeg;
             eeg_fwd[2] = fwd[2]+d->nmeg;
-            if (d->funcs->eeg_vec_pot(rd,d->eeg_els,eeg_fwd,d->funcs->eeg_client) != OK)
+            if (funcs->eeg_vec_pot(rd,d->eeg_els,eeg_fwd,funcs->eeg_client) != OK)
                 goto bad;
         }
         else {
-            if (d->funcs->eeg_pot(rd,Qx,d->eeg_els,fwd[0]+d->nmeg,d->funcs->eeg_client) != OK)
+            if (funcs->eeg_pot(rd,Qx,d->eeg_els,fwd[0]+d->nmeg,funcs->eeg_client) != OK)
                 goto bad;
-            if (d->funcs->eeg_pot(rd,Qy,d->eeg_els,fwd[1]+d->nmeg,d->funcs->eeg_client) != OK)
+            if (funcs->eeg_pot(rd,Qy,d->eeg_els,fwd[1]+d->nmeg,funcs->eeg_client) != OK)
                 goto bad;
-            if (d->funcs->eeg_pot(rd,Qz,d->eeg_els,fwd[2]+d->nmeg,d->funcs->eeg_client) != OK)
+            if (funcs->eeg_pot(rd,Qz,d->eeg_els,fwd[2]+d->nmeg,funcs->eeg_client) != OK)
                 goto bad;
         }
     }
@@ -86,6 +86,18 @@ typedef struct {
   mneUserFreeFunc eeg_client_free;
 } *dipoleFitFuncs,dipoleFitFuncsRec;
 
+/*
+ * Forward calculation workspace private to one fitting thread.
+ * The read-only parts (coils, BEM solution, sphere model) are shared with the fit data.
+ */
+
+typedef struct {
+  dipoleFitFuncs            sphere_funcs;   /* Sphere model functions with private workspace */
+  dipoleFitFuncs            bem_funcs;      /* BEM functions with private workspace */
+  FWDLIB::FwdBemModel       *bem_model;     /* Copy of the BEM model holding the private potential buffer */
+  INVERSELIB::DipoleForward *fwd;           /* Forward solution buffer reused between the fits */
+} *dipoleFitWorkspace,dipoleFitWorkspaceRec;
+
 //=============================================================================================================
 // DEFINE NAMESPACE INVERSELIB
 //=============================================================================================================
@@ -177,19 +189,76 @@ public:
      * @param[in] B          The field to fit
      * @param[in] verbose
      * @param[in] res        The fitted dipole
+     * @param[in] ws         Workspace private to the calling thread (optional). Without one the forward
+     *                       functions of fit are used, so only one fit may run at a time.
+     */
+    static bool fit_one(DipoleFitData* fit, GuessData* guess, float time, float *B, int verbose, ECD& res, dipoleFitWorkspace ws = NULL);
+
+    //=========================================================================================================
+    /**
+     * Project and whiten the data and find the best initial guess for each time point, with all guesses
+     * and time points searched by one matrix product.
+     *
+     * @param[in] fit        Precomputed fitting data
+     * @param[in] guess      The initial guesses
+     * @param[in, out] B     The fields to fit, projected and whitened in place
+     * @param[in] npts       Number of fields
+     * @param[out] best      The best guess for each field, -1 if there is no reasonable one
+     *
+     * @return OK or FAIL
+     */
+    static int find_best_guesses(DipoleFitData* fit, GuessData* guess, float **B, int npts, int *best);
+
+    //=========================================================================================================
+    /**
+     * Fit a single dipole to data already prepared by find_best_guesses
+     *
+     * @param[in] fit        Precomputed fitting data
+     * @param[in] guess      The initial guesses
+     * @param[in] best       The best initial guess
+     * @param[in] time       Which time is it?
+     * @param[in] B          The projected and whitened field to fit
+     * @param[in] verbose
+     * @param[in] res        The fitted dipole
+     * @param[in] ws         Workspace private to the calling thread (optional)
+     */
+    static bool fit_one_guess(DipoleFitData* fit, GuessData* guess, int best, float time, float *B, int verbose, ECD& res, dipoleFitWorkspace ws = NULL);
+
+    //=========================================================================================================
+    /**
+     * Create a forward calculation workspace so that fit_one can be called from several threads at once.
+     *
+     * @param[in] fit        Precomputed fitting data
+     *
+     * @return the workspace, to be released with free_fit_workspace
      */
-    static bool fit_one(DipoleFitData* fit, GuessData* guess, float time, float *B, int verbose, ECD& res);
+    static dipoleFitWorkspace new_fit_workspace(DipoleFitData* fit);
+
+    //=========================================================================================================
+    /**
+     * Release a workspace created with new_fit_workspace.
+     *
+     * @param[in] ws         The workspace
+     */
+    static void free_fit_workspace(dipoleFitWorkspace ws);
 
 //============================= dipole_forward.c
 
     static int compute_dipole_field(DipoleFitData* d, float *rd, int whiten, float **fwd);
 
+    static int compute_dipole_field(DipoleFitData* d, dipoleFitFuncs funcs, float *rd, int whiten, float **fwd);
+
     //============================= dipole_forward.c
 
     static DipoleForward* dipole_forward_one(DipoleFitData* d,
                                      float         *rd,
                                      DipoleForward* old);
 
+    static DipoleForward* dipole_forward_one(DipoleFitData* d,
+                                     dipoleFitFuncs funcs,
+                                     float         *rd,
+                                     DipoleForward* old);
+
 public:
       FIFFLIB::FiffCoordTransOld*    mri_head_t; /**< MRI <-> head coordinate transformation */
       FIFFLIB::FiffCoordTransOld*    meg_head_t; /**< MEG <-> head coordinate transformation */
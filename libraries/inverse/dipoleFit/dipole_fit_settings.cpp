@@ -103,6 +103,7 @@ void DipoleFitSettings::initMembers()
     do_baseline  = false;         
     setno        = 1;             
     verbose      = false;
+    nthread      = 1;
     omit_data_proj = false;
 
          
@@ -167,6 +168,8 @@ void DipoleFitSettings::checkIntegrity()
         if (guess_exclude > 0)
             printf("Guess exclude    : %6.1f mm\n",1000*guess_exclude);
     }
+    if (!guess_cachename.isEmpty())
+        printf("Guess cache      : %s\n",guess_cachename.toUtf8().data());
     printf("Data             : %s\n",measname.toUtf8().data());
     if (projnames.size() > 0) {
         printf("SSP sources      :\n");
@@ -262,7 +265,9 @@ void DipoleFitSettings::usage(char *name)
     printf("\t--exclude dist/mm Exclude points which are closer than this distance from the CM of the inner skull surface (default =  %6.1f mm).\n",1000*guess_exclude);
     printf("\t--mindist dist/mm Exclude points which are closer than this distance from the inner skull surface  (default = %6.1f mm).\n",1000*guess_mindist);
     printf("\t--grid    dist/mm Source space grid size (default = %6.1f mm).\n",1000*guess_grid);
+    printf("\t--guesscache dir  Cache the forward fields of the guesses in this directory.\n");
     printf("\t--magdip          Fit magnetic dipoles instead of current dipoles.\n");
+    printf("\t--threads n       Fit the time points on n threads, 0 = as many as allowed (default = %d).\n",nthread);
     printf("\nOutput:\n\n");
     printf("\t--dip     name    xfit dip format output file name\n");
     printf("\t--bdip    name    xfit bdip format output file name\n");
@@ -395,6 +400,14 @@ bool DipoleFitSettings::check_args (int *argc,char **argv)
             }
             guess_grid = guess_grid/1000.0;
         }
+        else if (strcmp(argv[k],"--guesscache") == 0) {
+            found = 2;
+            if (k == *argc - 1) {
+                qCritical ("--guesscache: argument required.");
+                return false;
+            }
+            guess_cachename = QString(argv[k+1]);
+        }
         else if (strcmp(argv[k],"--mri") == 0) {
             found = 2;
             if (k == *argc - 1) {
@@ -807,6 +820,18 @@ bool DipoleFitSettings::check_args (int *argc,char **argv)
             found = 1;
             fit_mag_dipoles = true;
         }
+        else if (strcmp(argv[k],"--threads") == 0) {
+            found = 2;
+            if (k == *argc - 1) {
+                qCritical ("--threads: argument required.");
+                return false;
+            }
+            if (sscanf(argv[k+1],"%d",&ival) != 1 || ival < 0) {
+                qCritical() << "Illegal number of threads:" << argv[k+1];
+                return false;
+            }
+            nthread = ival;
+        }
         else if (strcmp(argv[k],"--dip") == 0) {
             found = 2;
             if (k == *argc - 1) {
@@ -138,6 +138,7 @@ float guess_rad;       			/**< Radius of spherical guess surface */
     float guess_mindist;       		/**< Minimum allowed distance to the surface */
     float guess_exclude;       		/**< Exclude points closer than this to the origin */
     float guess_grid;       		/**< Grid spacing */
+    QString guess_cachename;            /**< Directory for the cached guess fields (no caching if empty) */
 
     QString noisename;                  /**< Noise-covariance matrix */
     float grad_std;        		/**< Standard deviations to be used if noise covariance is not specified */
@@ -159,6 +160,7 @@ float guess_rad;       			/**< Radius of spherical guess surface */
     bool  do_baseline;         		/**< Are both baseline limits set? */
     int   setno;             		/**< Which data set */
     bool  verbose;
+    int   nthread;                      /**< Number of threads to fit with (0 = UTILSLIB::ParallelExecutor::maxThreads()) */
     mneFilterDefRec filter;
     QStringList projnames;              /**< Projection file names */
     bool omit_data_proj;
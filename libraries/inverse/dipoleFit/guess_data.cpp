@@ -43,11 +43,22 @@
 #include "dipole_forward.h"
 #include <mne/c/mne_surface_old.h>
 #include <mne/c/mne_source_space_old.h>
+#include <mne/c/mne_cov_matrix.h>
+#include <mne/c/mne_proj_op.h>
+
+#include <fwd/fwd_coil_set.h>
+#include <fwd/fwd_coil.h>
 
 #include <fiff/fiff_stream.h>
 #include <fiff/fiff_tag.h>
+#include <fiff/c/fiff_coord_trans_old.h>
 
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -92,6 +103,8 @@ using namespace INVERSELIB;
 
 #define ALLOC_CMATRIX_16(x,y) mne_cmatrix_16((x),(y))
 
+#define GUESS_BLOCK_16 128      /* Time points per product in find_best_guesses */
+
 static void matrix_error_16(int kind, int nr, int nc)
 
 {
@@ -162,14 +175,53 @@ void fromIntEigenMatrix_16(const Eigen::MatrixXi& from_mat, int **&to_mat)
     fromIntEigenMatrix_16(from_mat, to_mat, from_mat.rows(), from_mat.cols());
 }
 
+static void hash_coord_trans_16(QCryptographicHash& hash, const FiffCoordTransOld* t)
+/*
+ * Add a coordinate transformation to the guess field cache key
+ */
+{
+    int present = t != NULL;
+
+    hash.addData(reinterpret_cast<const char*>(&present),sizeof(int));
+    if (!t)
+        return;
+    hash.addData(reinterpret_cast<const char*>(&t->from),sizeof(fiff_int_t));
+    hash.addData(reinterpret_cast<const char*>(&t->to),sizeof(fiff_int_t));
+    hash.addData(reinterpret_cast<const char*>(t->rot.data()),9*sizeof(float));
+    hash.addData(reinterpret_cast<const char*>(t->move.data()),3*sizeof(float));
+}
+
+static void hash_coil_set_16(QCryptographicHash& hash, const FwdCoilSet* coils)
+/*
+ * Add the integration points of the coils, in the coordinate frame the fields are computed in,
+ * to the guess field cache key
+ */
+{
+    int ncoil = coils ? coils->ncoil : 0;
+
+    hash.addData(reinterpret_cast<const char*>(&ncoil),sizeof(int));
+    for (int k = 0; k < ncoil; k++) {
+        const FwdCoil* coil = coils->coils[k];
+        hash.addData(reinterpret_cast<const char*>(&coil->coil_class),sizeof(int));
+        hash.addData(reinterpret_cast<const char*>(&coil->type),sizeof(int));
+        hash.addData(reinterpret_cast<const char*>(&coil->accuracy),sizeof(int));
+        hash.addData(reinterpret_cast<const char*>(&coil->np),sizeof(int));
+        for (int p = 0; p < coil->np; p++) {
+            hash.addData(reinterpret_cast<const char*>(coil->rmag[p]),3*sizeof(float));
+            hash.addData(reinterpret_cast<const char*>(coil->cosmag[p]),3*sizeof(float));
+        }
+        hash.addData(reinterpret_cast<const char*>(coil->w),coil->np*sizeof(float));
+    }
+}
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
 
 GuessData::GuessData()
 : rr(NULL)
-, guess_fwd(NULL)
 , nguess(0)
+, nch(0)
 {
 }
 
@@ -181,7 +233,8 @@ GuessData::GuessData()
 
 //=============================================================================================================
 
-GuessData::GuessData(const QString &guessname, const QString &guess_surfname, float mindist, float exclude, float grid, DipoleFitData *f)
+GuessData::GuessData(const QString &guessname, const QString &guess_surfname, float mindist, float exclude, float grid, DipoleFitData *f, const QString &cachename)
+: nch(0)
 {
     MneSourceSpaceOld* *sp = NULL;
     int            nsp = 0;
@@ -189,7 +242,6 @@ GuessData::GuessData(const QString &guessname, const QString &guess_surfname, fl
     int            k,p;
     float          guessrad = 0.080;
     MneSourceSpaceOld* guesses = NULL;
-    dipoleFitFuncs orig;
 
     if (!guessname.isEmpty()) {
         /*
@@ -242,30 +294,11 @@ GuessData::GuessData(const QString &guessname, const QString &guess_surfname, fl
         }
     delete guesses; guesses = NULL;
 
-    fprintf(stderr,"Go through all guess source locations...");
-    this->guess_fwd = MALLOC_16(this->nguess,DipoleForward*);
-    for (k = 0; k < this->nguess; k++)
-        this->guess_fwd[k] = NULL;
     /*
         * Compute the guesses using the sphere model for speed
         */
-    orig = f->funcs;
-    if (f->fit_mag_dipoles)
-        f->funcs = f->mag_dipole_funcs;
-    else
-        f->funcs = f->sphere_funcs;
-
-    for (k = 0; k < this->nguess; k++) {
-        if ((this->guess_fwd[k] = DipoleFitData::dipole_forward_one(f,this->rr[k],NULL)) == NULL)
-            goto bad;
-#ifdef DEBUG
-        sing = this->guess_fwd[k]->sing;
-        printf("%f %f %f\n",sing[0],sing[1],sing[2]);
-#endif
-    }
-    f->funcs = orig;
-
-    fprintf(stderr,"[done %d sources]\n",p);
+    if (!this->compute_guess_fields(f,cachename))
+        goto bad;
 
     return;
 //    return res;
@@ -282,6 +315,7 @@ bad : {
 //=============================================================================================================
 
 GuessData::GuessData(const QString &guessname, const QString &guess_surfname, float mindist, float exclude, float grid, DipoleFitData *f, char *guess_save_name)
+: nch(0)
 {
     MneSourceSpaceOld* *sp = NULL;
     int             nsp = 0;
@@ -361,9 +395,6 @@ GuessData::GuessData(const QString &guessname, const QString &guess_surfname, fl
         delete guesses;
     guesses = NULL;
 
-    this->guess_fwd = MALLOC_16(this->nguess,DipoleForward*);
-    for (k = 0; k < this->nguess; k++)
-        this->guess_fwd[k] = NULL;
     /*
         * Compute the guesses using the sphere model for speed
         */
@@ -387,19 +418,17 @@ bad : {
 GuessData::~GuessData()
 {
     FREE_CMATRIX_16(rr);
-    if (guess_fwd) {
-        for (int k = 0; k < nguess; k++)
-            delete guess_fwd[k];
-        FREE_16(guess_fwd);
-    }
     return;
 }
 
 //=============================================================================================================
 
-bool GuessData::compute_guess_fields(DipoleFitData* f)
+bool GuessData::compute_guess_fields(DipoleFitData* f, const QString& cachename)
 {
-    dipoleFitFuncs orig = NULL;
+    dipoleFitFuncs funcs = NULL;
+    DipoleForward* fwd = NULL;
+    QByteArray     key;
+    QString        cachefile;
 
     if (!f) {
         qCritical("Data missing in compute_guess_fields");
@@ -409,25 +438,200 @@ bool GuessData::compute_guess_fields(DipoleFitData* f)
         qCritical("Noise covariance missing in compute_guess_fields");
         return false;
     }
+    if (!cachename.isEmpty()) {
+        key = guess_fields_key(f);
+        cachefile = QDir(cachename).filePath(QString("guess-%1.dat").arg(QString::fromLatin1(key.toHex())));
+        if (read_guess_fields(cachefile,key,f)) {
+            printf("Read the guess fields from %s [%d sources]\n",cachefile.toUtf8().constData(),this->nguess);
+            return true;
+        }
+    }
     printf("Go through all guess source locations...");
-    orig = f->funcs;
     if (f->fit_mag_dipoles)
-        f->funcs = f->mag_dipole_funcs;
+        funcs = f->mag_dipole_funcs;
     else
-        f->funcs = f->sphere_funcs;
+        funcs = f->sphere_funcs;
+
+    this->nch = f->nmeg+f->neeg;
+    this->guess_uu.resize(this->nch,3*this->nguess);
+    this->guess_sing_ratio.resize(this->nguess);
     for (int k = 0; k < this->nguess; k++) {
-        if ((this->guess_fwd[k] = DipoleFitData::dipole_forward_one(f,this->rr[k],this->guess_fwd[k])) == NULL){
-            if (orig)
-                f->funcs = orig;
+        if ((fwd = DipoleFitData::dipole_forward_one(f,funcs,this->rr[k],fwd)) == NULL)
+            return false;
+        if (fwd->nch != this->nch) {
+            qCritical("Channel count mismatch in compute_guess_fields");
+            delete fwd;
             return false;
         }
 #ifdef DEBUG
-        sing = this->guess_fwd[k]->sing;
+        sing = fwd->sing;
         printf("%f %f %f\n",sing[0],sing[1],sing[2]);
 #endif
+        for (int c = 0; c < 3; c++)
+            this->guess_uu.col(3*k+c) = Map<VectorXf>(fwd->uu[c],this->nch);
+        this->guess_sing_ratio[k] = fwd->sing[2]/fwd->sing[0];
     }
-    f->funcs = orig;
+    delete fwd;
     printf("[done %d sources]\n",this->nguess);
 
+    if (!cachefile.isEmpty() && write_guess_fields(cachefile,key))
+        printf("Wrote the guess fields to %s\n",cachefile.toUtf8().constData());
+
+    return true;
+}
+
+//=============================================================================================================
+
+bool GuessData::find_best_guesses(const MatrixXf &B, float limit, VectorXi &best, VectorXf &good) const
+{
+    if (B.rows() != this->nch) {
+        qCritical("Data do not match the guess fields (%d vs. %d channels)",(int)B.rows(),this->nch);
+        return false;
+    }
+    best = VectorXi::Constant(B.cols(),-1);
+    good = VectorXf::Zero(B.cols());
+    if (this->nguess == 0)
+        return true;
+    /*
+     * The pseudoradial component only counts where it is not negligible
+     */
+    RowVectorXf third = (this->guess_sing_ratio.array() > limit).cast<float>().transpose();
+    MatrixXf    proj;
+    RowVectorXf Bm2;
+
+    for (int t0 = 0; t0 < B.cols(); t0 += GUESS_BLOCK_16) {
+        int nt = qMin((int)B.cols()-t0,GUESS_BLOCK_16);
+        /*
+         * Projections of all time points on all guess bases at once
+         */
+        proj.noalias() = this->guess_uu.transpose()*B.middleCols(t0,nt);
+        proj = proj.array().square().matrix();
+        for (int t = 0; t < nt; t++) {
+            Map<const MatrixXf> one(proj.col(t).data(),3,this->nguess);
+            double B2 = B.col(t0+t).squaredNorm();
+            int    k;
+
+            Bm2 = one.topRows(2).colwise().sum() + one.row(2).cwiseProduct(third);
+            if (B2 > 0.0 && Bm2.maxCoeff(&k) > 0.0f) {
+                best[t0+t] = k;
+                good[t0+t] = Bm2[k]/B2;
+            }
+        }
+    }
+    return true;
+}
+
+//=============================================================================================================
+
+QByteArray GuessData::guess_fields_key(DipoleFitData *f) const
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    MneCovMatrix* noise = f->noise;
+    int  k;
+
+    /*
+     * Everything the whitened sphere model fields depend on: the guess grid,
+     * the model, the sensors, the whitener and the projection. The coils are
+     * created in the head frame through meg_head_t, so their transformed
+     * integration points and the transformations are part of the key.
+     */
+    hash.addData(reinterpret_cast<const char*>(&this->nguess),sizeof(int));
+    if (this->nguess > 0)
+        hash.addData(reinterpret_cast<const char*>(this->rr[0]),3*this->nguess*sizeof(float));
+    hash.addData(reinterpret_cast<const char*>(&f->fit_mag_dipoles),sizeof(int));
+    hash.addData(reinterpret_cast<const char*>(&f->column_norm),sizeof(int));
+    hash.addData(reinterpret_cast<const char*>(&f->coord_frame),sizeof(int));
+    hash.addData(reinterpret_cast<const char*>(f->r0),3*sizeof(float));
+
+    for (k = 0; k < f->chs.size(); k++) {
+        const FiffChInfo& ch = f->chs[k];
+        hash.addData(ch.ch_name.toUtf8());
+        hash.addData(reinterpret_cast<const char*>(&ch.kind),sizeof(fiff_int_t));
+        hash.addData(reinterpret_cast<const char*>(&ch.chpos.coil_type),sizeof(fiff_int_t));
+        hash.addData(reinterpret_cast<const char*>(ch.chpos.r0.data()),3*sizeof(float));
+        hash.addData(reinterpret_cast<const char*>(ch.chpos.ex.data()),3*sizeof(float));
+        hash.addData(reinterpret_cast<const char*>(ch.chpos.ey.data()),3*sizeof(float));
+        hash.addData(reinterpret_cast<const char*>(ch.chpos.ez.data()),3*sizeof(float));
+    }
+    hash_coord_trans_16(hash,f->meg_head_t);
+    hash_coord_trans_16(hash,f->mri_head_t);
+    hash_coil_set_16(hash,f->meg_coils);
+    hash_coil_set_16(hash,f->eeg_els);
+    if (f->eeg_model) {
+        hash.addData(reinterpret_cast<const char*>(f->eeg_model->r0.data()),3*sizeof(float));
+        for (k = 0; k < f->eeg_model->layers.size(); k++) {
+            hash.addData(reinterpret_cast<const char*>(&f->eeg_model->layers[k].rad),sizeof(float));
+            hash.addData(reinterpret_cast<const char*>(&f->eeg_model->layers[k].sigma),sizeof(float));
+        }
+    }
+
+    hash.addData(reinterpret_cast<const char*>(&noise->ncov),sizeof(int));
+    hash.addData(reinterpret_cast<const char*>(&noise->nzero),sizeof(int));
+    if (noise->inv_lambda)
+        hash.addData(reinterpret_cast<const char*>(noise->inv_lambda),noise->ncov*sizeof(double));
+    if (noise->eigen)
+        for (k = 0; k < noise->ncov; k++)
+            hash.addData(reinterpret_cast<const char*>(noise->eigen[k]),noise->ncov*sizeof(float));
+
+    if (f->proj) {
+        hash.addData(reinterpret_cast<const char*>(&f->proj->nvec),sizeof(int));
+        for (k = 0; k < f->proj->nvec; k++)
+            hash.addData(reinterpret_cast<const char*>(f->proj->proj_data[k]),f->proj->nch*sizeof(float));
+    }
+    return hash.result();
+}
+
+//=============================================================================================================
+
+bool GuessData::read_guess_fields(const QString &name, const QByteArray &key, DipoleFitData *f)
+{
+    QFile file(name);
+    QByteArray fileKey;
+    qint32 fileNGuess, fileNch;
+
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream >> fileKey >> fileNGuess >> fileNch;
+    if (stream.status() != QDataStream::Ok || fileKey != key || fileNGuess != this->nguess)
+        return false;
+    if (fileNch != f->nmeg + f->neeg) {
+        qWarning("Ignoring the guess fields in %s (%d channels instead of %d)",
+                 name.toUtf8().constData(),fileNch,f->nmeg + f->neeg);
+        return false;
+    }
+
+    MatrixXf uu(fileNch,3*fileNGuess);
+    VectorXf ratio(fileNGuess);
+    int nuu = uu.size()*sizeof(float);
+    int nratio = ratio.size()*sizeof(float);
+
+    if (stream.readRawData(reinterpret_cast<char*>(uu.data()),nuu) != nuu ||
+        stream.readRawData(reinterpret_cast<char*>(ratio.data()),nratio) != nratio)
+        return false;
+
+    this->nch = fileNch;
+    this->guess_uu = uu;
+    this->guess_sing_ratio = ratio;
     return true;
 }
+
+//=============================================================================================================
+
+bool GuessData::write_guess_fields(const QString &name, const QByteArray &key) const
+{
+    QSaveFile file(name);
+
+    if (!QDir().mkpath(QFileInfo(name).absolutePath()) || !file.open(QIODevice::WriteOnly)) {
+        qWarning("Could not write the guess fields to %s",name.toUtf8().constData());
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream << key << (qint32)this->nguess << (qint32)this->nch;
+    stream.writeRawData(reinterpret_cast<const char*>(this->guess_uu.data()),this->guess_uu.size()*sizeof(float));
+    stream.writeRawData(reinterpret_cast<const char*>(this->guess_sing_ratio.data()),this->guess_sing_ratio.size()*sizeof(float));
+
+    return stream.status() == QDataStream::Ok && file.commit();
+}
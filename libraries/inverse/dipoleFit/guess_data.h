@@ -55,6 +55,8 @@
 //=============================================================================================================
 
 #include <QSharedPointer>
+#include <QByteArray>
+#include <QString>
 
 //=============================================================================================================
 // DEFINE NAMESPACE INVERSELIB
@@ -102,9 +104,10 @@ public:
      * Refactored: make_guess_data (setup.c)
      *
      * @param[in] guessname
+     * @param[in] cachename  Directory for the cached guess fields (no caching if empty)
      *
      */
-    GuessData( const QString& guessname, const QString& guess_surfname, float mindist, float exclude, float grid, DipoleFitData* f);
+    GuessData( const QString& guessname, const QString& guess_surfname, float mindist, float exclude, float grid, DipoleFitData* f, const QString& cachename = QString());
 
     //=========================================================================================================
     /**
@@ -128,16 +131,72 @@ public:
      * Once the guess locations have been set up we can compute the fields
      * Refactored: compute_guess_fields (dipole_fit_setup.c)
      *
-     * @param[in] f      Dipole Fit Data to the Compute Guess Fields
+     * The fields are kept as the orthonormal bases of the whitened sphere model fields, three columns
+     * per guess. If a cache directory is given, the fields are read from there when the guess grid, the
+     * sensors, the whitener and the projection match, and written there otherwise.
+     *
+     * @param[in] f          Dipole Fit Data to the Compute Guess Fields
+     * @param[in] cachename  Directory for the cached guess fields (no caching if empty)
+     *
+     * @return true when successful
+     */
+    bool compute_guess_fields(DipoleFitData* f, const QString& cachename = QString());
+
+    //=========================================================================================================
+    /**
+     * Find the best guess for each time point. All guesses and time points are handled with one matrix
+     * product per block of time points.
+     * Refactored: find_best_guess (fit_dipoles.c)
+     *
+     * @param[in] B          The whitened data, one column per time point
+     * @param[in] limit      Pseudoradial component omission limit
+     * @param[out] best      Index of the best guess for each time point, -1 if none fits
+     * @param[out] good      Goodness of fit of the best guess
+     *
+     * @return true when successful
+     */
+    bool find_best_guesses(const Eigen::MatrixXf& B, float limit, Eigen::VectorXi& best, Eigen::VectorXf& good) const;
+
+private:
+    //=========================================================================================================
+    /**
+     * Hash everything the whitened guess fields depend on.
+     *
+     * @param[in] f          Dipole Fit Data the fields are computed with
+     *
+     * @return the cache key
+     */
+    QByteArray guess_fields_key(DipoleFitData* f) const;
+
+    //=========================================================================================================
+    /**
+     * Read cached guess fields.
+     *
+     * @param[in] name       The cache file
+     * @param[in] key        The expected cache key
+     * @param[in] f          Dipole Fit Data the fields are used with
+     *
+     * @return true if the file exists, matches the key and has one row per MEG and EEG channel
+     */
+    bool read_guess_fields(const QString& name, const QByteArray& key, DipoleFitData* f);
+
+    //=========================================================================================================
+    /**
+     * Write the guess fields to the cache.
+     *
+     * @param[in] name       The cache file
+     * @param[in] key        The cache key
      *
      * @return true when successful
      */
-    bool compute_guess_fields(DipoleFitData* f);
+    bool write_guess_fields(const QString& name, const QByteArray& key) const;
 
 public:
     float          **rr;            /**< These are the guess dipole locations */
-    DipoleForward** guess_fwd;      /**< Forward solutions for the guesses */
     int            nguess;          /**< How many sources */
+    int            nch;             /**< Number of channels in the guess fields */
+    Eigen::MatrixXf guess_uu;       /**< Orthonormal bases of the whitened guess fields (nch x 3*nguess) */
+    Eigen::VectorXf guess_sing_ratio; /**< Ratio of the smallest to the largest singular value of each guess field */
 
 // ### OLD STRUCT ###
 //    typedef struct {
@@ -43,6 +43,7 @@
 
 #include <utils/ioutils.h>
 #include <utils/mnemath.h>
+#include <utils/parallelexecutor.h>
 
 #include <iostream>
 #include <fiff/fiff_cov.h>
@@ -61,8 +62,8 @@
 // QT INCLUDES
 //=============================================================================================================
 
-#include <QFuture>
-#include <QtConcurrent/QtConcurrent>
+#include <QDateTime>
+#include <QDir>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -82,6 +83,9 @@ using namespace FWDLIB;
 //=============================================================================================================
 
 HPIFit::HPIFit()
+: m_iSamplingFreq(0)
+, m_dErrorPrev(-1.0)
+, m_bWarmStart(true)
 {
 }
 
@@ -97,6 +101,32 @@ void HPIFit::fitHPI(const MatrixXd& t_mat,
                     FiffInfo::SPtr pFiffInfo,
                     bool bDoDebug,
                     const QString& sHPIResourceDir)
+{
+    HPIFit hpiFit;
+    hpiFit.fit(t_mat,
+               t_matProjectors,
+               transDevHead,
+               vFreqs,
+               vError,
+               vGoF,
+               fittedPointSet,
+               pFiffInfo,
+               bDoDebug,
+               sHPIResourceDir);
+}
+
+//=============================================================================================================
+
+void HPIFit::fit(const MatrixXd& t_mat,
+                 const MatrixXd& t_matProjectors,
+                 FiffCoordTrans& transDevHead,
+                 const QVector<int>& vFreqs,
+                 QVector<double>& vError,
+                 VectorXd& vGoF,
+                 FiffDigPointSet& fittedPointSet,
+                 FiffInfo::SPtr pFiffInfo,
+                 bool bDoDebug,
+                 const QString& sHPIResourceDir)
 {
     //Check if data was passed
     if(t_mat.rows() == 0 || t_mat.cols() == 0 ) {
@@ -107,13 +137,8 @@ void HPIFit::fitHPI(const MatrixXd& t_mat,
         std::cout<<std::endl<< "HPIFit::fitHPI - No projector passed. Returning.";
     }
 
-    // Setup Constructors for Coil Set
-    FwdCoilSet* templates = NULL;
-    FwdCoilSet* megCoils = NULL;
-
     //struct SensorInfo sensors;
     struct CoilParam coil;
-    int numCh = pFiffInfo->nchan;
     int samF = pFiffInfo->sfreq;
     int samLoc = t_mat.cols(); // minimum samples required to localize numLoc times in a second
 
@@ -147,20 +172,12 @@ void HPIFit::fitHPI(const MatrixXd& t_mat,
     coil.dpfiterror = VectorXd::Zero(numCoils);
     coil.dpfitnumitr = VectorXd::Zero(numCoils);
 
-    // Generate simulated data
-    MatrixXd simsig(samLoc,numCoils*2);
-    VectorXd time(samLoc);
+    // Only rebuild what depends on changed inputs
+    bool bSensorsChanged = updateSensorSet(pFiffInfo);
+    updateSignalModel(coilfreq, samF, samLoc);
+    updateProjector(t_matProjectors, bSensorsChanged);
 
-    for (int i = 0; i < samLoc; ++i) {
-        time[i] = i*1.0/samF;
-    }
-
-    for(int i = 0; i < numCoils; ++i) {
-        for(int j = 0; j < samLoc; ++j) {
-            simsig(j,i) = sin(2*M_PI*coilfreq[i]*time[j]);
-            simsig(j,i+numCoils) = cos(2*M_PI*coilfreq[i]*time[j]);
-        }
-    }
+    const QVector<int>& innerind = m_vInnerInd;
 
     // Create digitized HPI coil position matrix
     MatrixXd headHPI(numCoils,3);
@@ -180,48 +197,6 @@ void HPIFit::fitHPI(const MatrixXd& t_mat,
         }
     }
 
-    // Get the indices of inner layer channels and exclude bad channels and create channellist
-    QList<FiffChInfo> channels;
-    QVector<int> innerind(0);
-
-    for (int i = 0; i < numCh; ++i) {
-        if(pFiffInfo->chs[i].chpos.coil_type == FIFFV_COIL_BABY_MAG ||
-                pFiffInfo->chs[i].chpos.coil_type == FIFFV_COIL_VV_PLANAR_T1 ||
-                pFiffInfo->chs[i].chpos.coil_type == FIFFV_COIL_VV_PLANAR_T2 ||
-                pFiffInfo->chs[i].chpos.coil_type == FIFFV_COIL_VV_PLANAR_T3) {
-            // Check if the sensor is bad, if not append to innerind
-            if(!(pFiffInfo->bads.contains(pFiffInfo->ch_names.at(i)))) {
-                innerind.append(i);
-                channels.append(pFiffInfo->chs[i]);
-            }
-        }
-    }
-
-    // Create MEG-Coils and read doil_def.dat
-    QString qPath = QString(QCoreApplication::applicationDirPath() + "/resources/general/coilDefinitions/coil_def.dat");
-    // Create MEG-Coils and read data
-    int acc = 2;
-    int nch = channels.size();
-    FiffCoordTransOld* t = NULL;
-
-    templates = FwdCoilSet::read_coil_defs(qPath);
-
-    QList<Sensor> sensorSet;
-    megCoils = templates->create_meg_coils(channels,nch,acc,t);
-    createSensorSet(sensorSet,megCoils);
-
-    //Create new projector based on the excluded channels, first exclude the rows then the columns
-    MatrixXd matProjectorsRows(innerind.size(),t_matProjectors.cols());
-    MatrixXd matProjectorsInnerind(innerind.size(),innerind.size());
-
-    for (int i = 0; i < matProjectorsRows.rows(); ++i) {
-        matProjectorsRows.row(i) = t_matProjectors.row(innerind.at(i));
-    }
-
-    for (int i = 0; i < matProjectorsInnerind.cols(); ++i) {
-        matProjectorsInnerind.col(i) = matProjectorsRows.col(innerind.at(i));
-    }
-
     MatrixXd topo(innerind.size(), numCoils*2);
     MatrixXd amp(innerind.size(), numCoils);
     MatrixXd ampC(innerind.size(), numCoils);
@@ -234,7 +209,7 @@ void HPIFit::fitHPI(const MatrixXd& t_mat,
     }
 
     // Calculate topo
-    topo = innerdata * UTILSLIB::MNEMath::pinv(simsig).transpose(); // topo: # of good inner channel x 8
+    topo = innerdata * m_matSimsigPinvT; // topo: # of good inner channel x 8
 
     // Select sine or cosine component depending on the relative size
     amp  = topo.leftCols(numCoils); // amp: # of good inner channel x 4
@@ -278,7 +253,10 @@ void HPIFit::fitHPI(const MatrixXd& t_mat,
     double error = std::accumulate(vError.begin(), vError.end(), .0) / vError.size();
     MatrixXd coilPos = MatrixXd::Zero(numCoils,3);
 
-    if(transDevHead.trans == MatrixXd::Identity(4,4).cast<float>() || error > 0.003){
+    if(m_bWarmStart && m_matCoilPosPrev.rows() == numCoils && m_dErrorPrev >= 0.0 && m_dErrorPrev <= 0.003) {
+        // The previous block was fitted well, its coil positions are the closest guess we have
+        coilPos = m_matCoilPosPrev;
+    } else if(transDevHead.trans == MatrixXd::Identity(4,4).cast<float>() || error > 0.003){
         for (int j = 0; j < chIdcs.rows(); ++j) {
             int chIdx = chIdcs(j);
             if(chIdx < pFiffInfo->chs.size()) {
@@ -299,7 +277,7 @@ void HPIFit::fitHPI(const MatrixXd& t_mat,
     coil.pos = coilPos;
 
     // Perform actual localization
-    coil = dipfit(coil, sensorSet, amp, numCoils, matProjectorsInnerind);
+    coil = dipfit(coil, m_lSensorSet, amp, numCoils, m_matProjectorsInnerind);
 
     Matrix4d trans = computeTransformation(headHPI, coil.pos);
     //Eigen::Matrix4d trans = computeTransformation(coil.pos, headHPI);
@@ -327,6 +305,10 @@ void HPIFit::fitHPI(const MatrixXd& t_mat,
         vError.append(diffPos.col(i).norm());
     }
 
+    // Remember this fit as seed for the next block
+    m_matCoilPosPrev = coil.pos;
+    m_dErrorPrev = numCoils > 0 ? diffPos.colwise().norm().mean() : -1.0;
+
     // store Goodness of Fit
     vGoF = coil.dpfiterror;
     for(int i = 0; i < vGoF.size(); ++i) {
@@ -403,12 +385,16 @@ void HPIFit::findOrder(const MatrixXd& t_mat,
     QVector<double> vErrorTemp = vError;
     VectorXd vGoFTemp = vGoF;
 
+    // share the sensor set and projectors between the trials, but seed every trial independently
+    HPIFit hpiFit;
+    hpiFit.setWarmStart(false);
+
     // perform vFreqs.size() hpi fits with same frequencies in each iteration
     for(int i = 0; i < vFreqs.size(); i++){
         vFreqTemp.fill(vFreqs[i]);
 
         // hpi Fit
-        fitHPI(t_mat, t_matProjectors, transDevHeadTemp, vFreqTemp, vErrorTemp, vGoFTemp, fittedPointSetTemp, pFiffInfoTemp);
+        hpiFit.fit(t_mat, t_matProjectors, transDevHeadTemp, vFreqTemp, vErrorTemp, vGoFTemp, fittedPointSetTemp, pFiffInfoTemp);
 
         // get location of maximum GoF -> correct assignment of coil - frequency
         VectorXd::Index indMax;
@@ -454,9 +440,9 @@ CoilParam HPIFit::dipfit(struct CoilParam coil,
 //        }
 
         //Do concurrent
-        QFuture<void> future = QtConcurrent::map(lCoilData,
-                                                 &HPIFitData::doDipfitConcurrent);
-        future.waitForFinished();
+        UTILSLIB::ParallelExecutor::parallelFor(lCoilData.size(), [&](int i) {
+            lCoilData[i].doDipfitConcurrent();
+        });
 
         //Transform results to final coil information
         for(qint32 i = 0; i < lCoilData.size(); ++i) {
@@ -575,6 +561,157 @@ void HPIFit::createSensorSet(QList<struct Sensor>& sensors, FwdCoilSet* coils)
 
 //=============================================================================================================
 
+void HPIFit::setWarmStart(bool bWarmStart)
+{
+    m_bWarmStart = bWarmStart;
+}
+
+//=============================================================================================================
+
+void HPIFit::reset()
+{
+    m_lSensorSet.clear();
+    m_vInnerInd.clear();
+    m_lChNames.clear();
+    m_lBads.clear();
+
+    m_vecCoilFreqs.resize(0);
+    m_iSamplingFreq = 0;
+    m_matSimsigPinvT.resize(0,0);
+
+    m_matProjectors.resize(0,0);
+    m_matProjectorsInnerind.resize(0,0);
+
+    m_matCoilPosPrev.resize(0,0);
+    m_dErrorPrev = -1.0;
+}
+
+//=============================================================================================================
+
+bool HPIFit::updateSensorSet(FiffInfo::SPtr pFiffInfo)
+{
+    if(!m_lSensorSet.isEmpty() && m_lChNames == pFiffInfo->ch_names && m_lBads == pFiffInfo->bads) {
+        return false;
+    }
+
+    m_lChNames = pFiffInfo->ch_names;
+    m_lBads = pFiffInfo->bads;
+    m_lSensorSet.clear();
+    m_vInnerInd.clear();
+
+    // The previous fit was done with other sensors, do not start the next one from it
+    m_matCoilPosPrev.resize(0,0);
+    m_dErrorPrev = -1.0;
+
+    // Get the indices of inner layer channels and exclude bad channels and create channellist
+    QList<FiffChInfo> channels;
+
+    for (int i = 0; i < pFiffInfo->nchan; ++i) {
+        if(pFiffInfo->chs[i].chpos.coil_type == FIFFV_COIL_BABY_MAG ||
+                pFiffInfo->chs[i].chpos.coil_type == FIFFV_COIL_VV_PLANAR_T1 ||
+                pFiffInfo->chs[i].chpos.coil_type == FIFFV_COIL_VV_PLANAR_T2 ||
+                pFiffInfo->chs[i].chpos.coil_type == FIFFV_COIL_VV_PLANAR_T3) {
+            // Check if the sensor is bad, if not append to innerind
+            if(!(pFiffInfo->bads.contains(pFiffInfo->ch_names.at(i)))) {
+                m_vInnerInd.append(i);
+                channels.append(pFiffInfo->chs[i]);
+            }
+        }
+    }
+
+    // The coil definitions do not depend on the measurement, read coil_def.dat only once
+    if(!m_pCoilTemplate) {
+        QString qPath = QString(QCoreApplication::applicationDirPath() + "/resources/general/coilDefinitions/coil_def.dat");
+        m_pCoilTemplate = FwdCoilSet::SPtr(FwdCoilSet::read_coil_defs(qPath));
+
+        if(!m_pCoilTemplate) {
+            std::cout<<std::endl<< "HPIFit::updateSensorSet - Could not read coil definitions from " << qPath.toStdString();
+            return true;
+        }
+    }
+
+    // Create MEG-Coils
+    int acc = 2;
+    FiffCoordTransOld* t = NULL;
+
+    FwdCoilSet* megCoils = m_pCoilTemplate->create_meg_coils(channels, channels.size(), acc, t);
+
+    if(megCoils) {
+        createSensorSet(m_lSensorSet, megCoils);
+        delete megCoils;
+    }
+
+    return true;
+}
+
+//=============================================================================================================
+
+void HPIFit::updateSignalModel(const VectorXd& vecCoilFreqs,
+                               int iSamplingFreq,
+                               int iNumSamples)
+{
+    if(m_matSimsigPinvT.rows() == iNumSamples &&
+       m_iSamplingFreq == iSamplingFreq &&
+       m_vecCoilFreqs.size() == vecCoilFreqs.size() &&
+       m_vecCoilFreqs == vecCoilFreqs) {
+        return;
+    }
+
+    // The previous coil positions may belong to other frequencies, do not start the next fit from them
+    m_matCoilPosPrev.resize(0,0);
+    m_dErrorPrev = -1.0;
+
+    int numCoils = vecCoilFreqs.size();
+
+    // Generate simulated data
+    MatrixXd simsig(iNumSamples,numCoils*2);
+    VectorXd time(iNumSamples);
+
+    for (int i = 0; i < iNumSamples; ++i) {
+        time[i] = i*1.0/iSamplingFreq;
+    }
+
+    for(int i = 0; i < numCoils; ++i) {
+        for(int j = 0; j < iNumSamples; ++j) {
+            simsig(j,i) = sin(2*M_PI*vecCoilFreqs[i]*time[j]);
+            simsig(j,i+numCoils) = cos(2*M_PI*vecCoilFreqs[i]*time[j]);
+        }
+    }
+
+    m_matSimsigPinvT = UTILSLIB::MNEMath::pinv(simsig).transpose();
+    m_vecCoilFreqs = vecCoilFreqs;
+    m_iSamplingFreq = iSamplingFreq;
+}
+
+//=============================================================================================================
+
+void HPIFit::updateProjector(const MatrixXd& t_matProjectors,
+                             bool bForce)
+{
+    if(!bForce &&
+       m_matProjectors.rows() == t_matProjectors.rows() &&
+       m_matProjectors.cols() == t_matProjectors.cols() &&
+       m_matProjectors == t_matProjectors) {
+        return;
+    }
+
+    m_matProjectors = t_matProjectors;
+
+    //Create new projector based on the excluded channels, first exclude the rows then the columns
+    MatrixXd matProjectorsRows(m_vInnerInd.size(),t_matProjectors.cols());
+    m_matProjectorsInnerind.resize(m_vInnerInd.size(),m_vInnerInd.size());
+
+    for (int i = 0; i < matProjectorsRows.rows(); ++i) {
+        matProjectorsRows.row(i) = t_matProjectors.row(m_vInnerInd.at(i));
+    }
+
+    for (int i = 0; i < m_matProjectorsInnerind.cols(); ++i) {
+        m_matProjectorsInnerind.col(i) = matProjectorsRows.col(m_vInnerInd.at(i));
+    }
+}
+
+//=============================================================================================================
+
 void HPIFit::storeHeadPosition(float time,
                                const Eigen::MatrixXf& devHeadT,
                                Eigen::MatrixXd& position,
@@ -42,6 +42,7 @@
 //=============================================================================================================
 
 #include "../inverse_global.h"
+#include "hpifitdata.h"
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -54,6 +55,8 @@
 //=============================================================================================================
 
 #include <QSharedPointer>
+#include <QStringList>
+#include <QVector>
 
 //=============================================================================================================
 // FORWARD DECLARATIONS
@@ -96,7 +99,10 @@ struct CoilParam {
 
 //=============================================================================================================
 /**
- * HPI Fit algorithms.
+ * HPI Fit algorithms. An HPIFit object keeps the coil definitions, the inner layer sensor set, the projector
+ * sub-matrix and the pseudo-inverse of the sin/cos reference signals between calls to fit(), so that
+ * consecutive data blocks only pay for the amplitude estimation and the dipole fits. The static fitHPI()
+ * performs a single fit with a throw-away context.
  *
  * @brief HPI Fit algorithms.
  */
@@ -113,6 +119,49 @@ public:
      */
     explicit HPIFit();
 
+    //=========================================================================================================
+    /**
+     * Performs an HPI fit on one data block. The sensor set, the projector sub-matrix and the reference signal
+     * model are only rebuilt if the channel selection, the projectors, the coil frequencies, the sampling
+     * frequency or the block length changed since the last call. If warm starting is active and the previous
+     * fit had a mean error below 3 mm, the previously fitted coil positions are used as seed points.
+     *
+     * @param[in]    t_mat           Data to estimate the HPI positions from
+     * @param[in]    t_matProjectors The projectors to apply. Bad channels are still included.
+     * @param[out]   transDevHead    The final dev head transformation matrix
+     * @param[in]    vFreqs          The frequencies for each coil.
+     * @param[out]   vError          The HPI estimation Error in mm for each fitted HPI coil.
+     * @param[out]   vGoF            The goodness of fit for each fitted HPI coil
+     * @param[out]   fittedPointSet  The final fitted positions in form of a digitizer set.
+     * @param[in]    p_pFiffInfo     Associated Fiff Information.
+     * @param[in]    bDoDebug        Print debug info to cmd line and write debug info to file.
+     * @param[in]    sHPIResourceDir The path to the debug file which is to be written.
+     */
+    void fit(const Eigen::MatrixXd& t_mat,
+             const Eigen::MatrixXd& t_matProjectors,
+             FIFFLIB::FiffCoordTrans &transDevHead,
+             const QVector<int>& vFreqs,
+             QVector<double> &vError,
+             Eigen::VectorXd& vGoF,
+             FIFFLIB::FiffDigPointSet& fittedPointSet,
+             QSharedPointer<FIFFLIB::FiffInfo> pFiffInfo,
+             bool bDoDebug = false,
+             const QString& sHPIResourceDir = QString("./HPIFittingDebug"));
+
+    //=========================================================================================================
+    /**
+     * Sets whether fit() seeds the dipole fits with the coil positions of the previous block.
+     *
+     * @param[in]    bWarmStart      Whether to warm start from the previous coil positions.
+     */
+    void setWarmStart(bool bWarmStart);
+
+    //=========================================================================================================
+    /**
+     * Drops all cached sensor, projector and reference signal data as well as the previous coil positions.
+     */
+    void reset();
+
     //=========================================================================================================
     /**
      * Perform one single HPI fit.
@@ -225,8 +274,59 @@ protected:
     static void createSensorSet(QList<struct Sensor>& sensors, FWDLIB::FwdCoilSet* coils);
 
     //=========================================================================================================
+    /**
+     * Selects the good inner layer channels and creates their sensor set. Does nothing if the channel names
+     * and bad channels did not change since the last call.
+     *
+     * @param[in] pFiffInfo     Associated Fiff Information.
+     *
+     * @return Returns true if the channel selection was rebuilt.
+     */
+    bool updateSensorSet(QSharedPointer<FIFFLIB::FiffInfo> pFiffInfo);
+
+    //=========================================================================================================
+    /**
+     * Computes the transposed pseudo-inverse of the sin/cos reference signals if the coil frequencies,
+     * the sampling frequency or the number of samples changed.
+     *
+     * @param[in] vecCoilFreqs  The frequencies for each coil.
+     * @param[in] iSamplingFreq The sampling frequency.
+     * @param[in] iNumSamples   The number of samples per block.
+     */
+    void updateSignalModel(const Eigen::VectorXd& vecCoilFreqs,
+                           int iSamplingFreq,
+                           int iNumSamples);
+
+    //=========================================================================================================
+    /**
+     * Restricts the projectors to the good inner layer channels if they or the channel selection changed.
+     *
+     * @param[in] t_matProjectors   The projectors to apply. Bad channels are still included.
+     * @param[in] bForce            Whether to rebuild even if the projectors did not change.
+     */
+    void updateProjector(const Eigen::MatrixXd& t_matProjectors,
+                         bool bForce);
+
+    //=========================================================================================================
+
+    static QString                      m_sHPIResourceDir;          /**< Hold the resource folder to store the debug information in. */
+
+    QSharedPointer<FWDLIB::FwdCoilSet>  m_pCoilTemplate;            /**< The coil definitions read from coil_def.dat. */
+    QList<Sensor>                       m_lSensorSet;               /**< The sensor set of the good inner layer channels. */
+    QVector<int>                        m_vInnerInd;                /**< The indices of the good inner layer channels. */
+    QStringList                         m_lChNames;                 /**< The channel names the sensor set was built for. */
+    QStringList                         m_lBads;                    /**< The bad channels the sensor set was built for. */
+
+    Eigen::VectorXd                     m_vecCoilFreqs;             /**< The coil frequencies the reference signals were built for. */
+    int                                 m_iSamplingFreq;            /**< The sampling frequency the reference signals were built for. */
+    Eigen::MatrixXd                     m_matSimsigPinvT;           /**< The transposed pseudo-inverse of the sin/cos reference signals. */
+
+    Eigen::MatrixXd                     m_matProjectors;            /**< The full projectors the sub-matrix was built from. */
+    Eigen::MatrixXd                     m_matProjectorsInnerind;    /**< The projectors restricted to the good inner layer channels. */
 
-    static QString         m_sHPIResourceDir;      /**< Hold the resource folder to store the debug information in. */
+    Eigen::MatrixXd                     m_matCoilPosPrev;           /**< The coil positions of the previous fit in device coordinates. */
+    double                              m_dErrorPrev;               /**< The mean estimation error of the previous fit in m, negative if unknown. */
+    bool                                m_bWarmStart;               /**< Whether to seed the fits with the previous coil positions. */
 };
 
 //=============================================================================================================
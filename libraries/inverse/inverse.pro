@@ -136,16 +136,6 @@ contains(MNECPP_CONFIG, withCodeCov) {
     QMAKE_LFLAGS += --coverage
 }
 
-# OpenMP
-win32:!contains(MNECPP_CONFIG, wasm) {
-    QMAKE_CXXFLAGS  +=  -openmp
-    #QMAKE_LFLAGS    +=  -openmp
-}
-unix:!macx:!contains(MNECPP_CONFIG, wasm) {
-    QMAKE_CXXFLAGS  +=  -fopenmp
-    QMAKE_LFLAGS    +=  -fopenmp
-}
-
 # Deploy library in non-static builds only
 win32:!contains(MNECPP_CONFIG, static) {
     EXTRA_ARGS =
@@ -39,9 +39,7 @@
 
 #include "pwlrapmusic.h"
 
-#ifdef _OPENMP
-#include <omp.h>
-#endif
+#include <utils/parallelexecutor.h>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -50,6 +48,7 @@
 using namespace INVERSELIB;
 using namespace MNELIB;
 using namespace FIFFLIB;
+using namespace UTILSLIB;
 
 //=============================================================================================================
 // DEFINE MEMBER METHODS
@@ -216,28 +215,19 @@ MNESourceEstimate PwlRapMusic::calculateInverse(const MatrixXd& p_matMeasurement
         {
 
             //Multithreading correlation calculation
-            #ifdef _OPENMP
-            #pragma omp parallel num_threads(m_iMaxNumThreads)
-            #endif
-            {
-            #ifdef _OPENMP
-            #pragma omp for
-            #endif
-                for(int i = 0; i < t_iNumVecElements; i++)
-                {
-                    int k = t_pVecIdxElements(i);
-                    //new Version: calculate matrix multiplication before
-                    //Create Lead Field combinations -> It would be better to use a pointer construction, to increase performance
-                    MatrixX6T t_matProj_G(t_matProj_LeadField.rows(),6);
-
-                    int idx1 = m_ppPairIdxCombinations[k]->x1;
-                    int idx2 = m_ppPairIdxCombinations[k]->x2;
-
-                    RapMusic::getGainMatrixPair(t_matProj_LeadField, t_matProj_G, idx1, idx2);
-
-                    t_vecRoh(k) = RapMusic::subcorr(t_matProj_G, t_matU_B);//t_vecRoh holds the correlations roh_k
-                }
-            }
+            ParallelExecutor::parallelFor(t_iNumVecElements, [&](int i) {
+                int k = t_pVecIdxElements(i);
+                //new Version: calculate matrix multiplication before
+                //Create Lead Field combinations -> It would be better to use a pointer construction, to increase performance
+                MatrixX6T t_matProj_G(t_matProj_LeadField.rows(),6);
+
+                int idx1 = m_ppPairIdxCombinations[k]->x1;
+                int idx2 = m_ppPairIdxCombinations[k]->x2;
+
+                RapMusic::getGainMatrixPair(t_matProj_LeadField, t_matProj_G, idx1, idx2);
+
+                t_vecRoh(k) = RapMusic::subcorr(t_matProj_G, t_matU_B);//t_vecRoh holds the correlations roh_k
+            }, m_iMaxNumThreads);
 
     //         if(r==0)
     //         {
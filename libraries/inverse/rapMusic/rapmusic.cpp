@@ -40,10 +40,7 @@
 #include "rapmusic.h"
 
 #include <utils/mnemath.h>
-
-#ifdef _OPENMP
-#include <omp.h>
-#endif
+#include <utils/parallelexecutor.h>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -103,14 +100,8 @@ RapMusic::~RapMusic()
 bool RapMusic::init(MNEForwardSolution& p_pFwd, bool p_bSparsed, int p_iN, double p_dThr)
 {
     //Get available thread number
-    #ifdef _OPENMP
-        std::cout << "OpenMP enabled" << std::endl;
-        m_iMaxNumThreads = omp_get_max_threads();
-    #else
-        std::cout << "OpenMP disabled (to enable it: VS2010->Project Properties->C/C++->Language, then modify OpenMP Support)" << std::endl;
-        m_iMaxNumThreads = 1;
-    #endif
-        std::cout << "Available Threats: " << m_iMaxNumThreads << std::endl << std::endl;
+    m_iMaxNumThreads = ParallelExecutor::threadCount();
+    std::cout << "Available Threads: " << m_iMaxNumThreads << std::endl << std::endl;
 
     //Initialize RAP MUSIC
     std::cout << "##### Initialization RAP MUSIC started ######\n\n";
@@ -469,27 +460,18 @@ MNESourceEstimate RapMusic::calculateInverse(const MatrixXd& p_matMeasurement, Q
         start_subcorr = clock();
 
         //Multithreading correlation calculation
-        #ifdef _OPENMP
-        #pragma omp parallel num_threads(m_iMaxNumThreads)
-        #endif
-        {
-        #ifdef _OPENMP
-        #pragma omp for
-        #endif
-            for(int i = 0; i < m_iNumLeadFieldCombinations; i++)
-            {
-                //new Version: calculate matrix multiplication before
-                //Create Lead Field combinations -> It would be better to use a pointer construction, to increase performance
-                MatrixX6T t_matProj_G(t_matProj_LeadField.rows(),6);
+        ParallelExecutor::parallelFor(m_iNumLeadFieldCombinations, [&](int i) {
+            //new Version: calculate matrix multiplication before
+            //Create Lead Field combinations -> It would be better to use a pointer construction, to increase performance
+            MatrixX6T t_matProj_G(t_matProj_LeadField.rows(),6);
 
-                int idx1 = m_ppPairIdxCombinations[i]->x1;
-                int idx2 = m_ppPairIdxCombinations[i]->x2;
+            int idx1 = m_ppPairIdxCombinations[i]->x1;
+            int idx2 = m_ppPairIdxCombinations[i]->x2;
 
-                RapMusic::getGainMatrixPair(t_matProj_LeadField, t_matProj_G, idx1, idx2);
+            RapMusic::getGainMatrixPair(t_matProj_LeadField, t_matProj_G, idx1, idx2);
 
-                t_vecRoh(i) = RapMusic::subcorr(t_matProj_G, t_matU_B);//t_vecRoh holds the correlations roh_k
-            }
-        }
+            t_vecRoh(i) = RapMusic::subcorr(t_matProj_G, t_matU_B);//t_vecRoh holds the correlations roh_k
+        }, m_iMaxNumThreads);
 
 //         if(r==0)
 //         {
@@ -794,28 +776,19 @@ void RapMusic::calcPairCombinations(    const int p_iNumPoints,
                                         const int p_iNumCombinations,
                                         Pair** p_ppPairIdxCombinations) const
 {
-    int idx1 = 0;
-    int idx2 = 0;
+    //Process Code in {m_max_num_threads} threads
+    ParallelExecutor::parallelFor(p_iNumCombinations, [&](int i) {
+        int idx1 = 0;
+        int idx2 = 0;
 
-    //Process Code in {m_max_num_threads} threads -> When compile with Intel Compiler -> probably obsolete
-    #ifdef _OPENMP
-    #pragma omp parallel num_threads(m_iMaxNumThreads) private(idx1, idx2)
-    #endif
-    {
-    #ifdef _OPENMP
-    #pragma omp for
-    #endif
-        for (int i = 0; i < p_iNumCombinations; ++i)
-        {
-            RapMusic::getPointPair(p_iNumPoints, i, idx1, idx2);
+        RapMusic::getPointPair(p_iNumPoints, i, idx1, idx2);
 
-            Pair* t_pairCombination = new Pair();
-            t_pairCombination->x1 = idx1;
-            t_pairCombination->x2 = idx2;
+        Pair* t_pairCombination = new Pair();
+        t_pairCombination->x1 = idx1;
+        t_pairCombination->x2 = idx2;
 
-            p_ppPairIdxCombinations[i] = t_pairCombination;
-        }
-    }
+        p_ppPairIdxCombinations[i] = t_pairCombination;
+    }, m_iMaxNumThreads);
 }
 
 //=============================================================================================================
@@ -432,8 +432,7 @@ int MneProjOp::mne_proj_op_proj_vector(MneProjOp *op, float *vec, int nvec, int
      * Assume that all dimension checking etc. has been done before
      */
 {
-    static float *res = NULL;
-    int    res_size   = 0;
+    float *res;
     float *pvec;
     float  w;
     int k,p;
@@ -445,11 +444,10 @@ int MneProjOp::mne_proj_op_proj_vector(MneProjOp *op, float *vec, int nvec, int
         printf("Data vector size does not match projection operator");
         return FAIL;
     }
-
-    if (op->nch > res_size) {
-        res = REALLOC_23(res,op->nch,float);
-        res_size = op->nch;
-    }
+    /*
+     * Private result buffer so that several threads can project at the same time
+     */
+    res = MALLOC_23(op->nch,float);
 
     for (k = 0; k < op->nch; k++)
         res[k] = 0.0;
@@ -468,6 +466,7 @@ int MneProjOp::mne_proj_op_proj_vector(MneProjOp *op, float *vec, int nvec, int
         for (k = 0; k < op->nch; k++)
             vec[k] = res[k];
     }
+    FREE_23(res);
     return OK;
 }
 
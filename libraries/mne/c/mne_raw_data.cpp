@@ -316,54 +316,281 @@ int mne_compare_filters(mneFilterDef f1,
 }
 
 //============================= mne_fft.c =============================
+/*
+ * Real FFT in the FFTPACK rfftf/rfftb storage order:
+ *
+ *      r0, Re r1, Im r1, Re r2, Im r2, ... [, r(n/2) for even n]
+ *
+ * The precalculated data cached through precalcp is a single malloc'ed float array
+ * starting with the transform length, so that it can be released with free() by the
+ * owner and is recomputed if a different length comes along. It ends with a work
+ * area, so that repeated transforms of the same length do not allocate:
+ *
+ *   Power of two n    : n, cos/sin(2 pi k/n) for k < n/2, bit reversal for n/2 points,
+ *                       n+2 work values
+ *   Other lengths     : n, cos/sin(2 pi k/n) for k < n (direct transform), n work values
+ */
+
+#define FFT_HEADER 1
+
+static int mne_fft_is_pow2(int np)
+
+{
+    return np >= 2 && (np & (np-1)) == 0;
+}
+
+static int mne_fft_precalc_size(int np)
+
+{
+    if (mne_fft_is_pow2(np))
+        return FFT_HEADER + np + np/2 + np + 2;
+    else
+        return FFT_HEADER + 2*np + np;
+}
+
+static float *mne_fft_work(float *precalc, int np)
+/*
+ * The work area at the end of the precalculated data
+ */
+{
+    if (mne_fft_is_pow2(np))
+        return precalc + FFT_HEADER + np + np/2;
+    else
+        return precalc + FFT_HEADER + 2*np;
+}
+
+static float *mne_fft_precalc(int np, float **precalcp)
+/*
+ * Get the cached tables or compute new ones
+ */
+{
+    float *precalc;
+    int   k,j,m,bits,rev,ntwiddle;
+
+    if (precalcp && *precalcp && (int)((*precalcp)[0]) == np)
+        return *precalcp;
+
+    precalc = MALLOC_36(mne_fft_precalc_size(np),float);
+    precalc[0] = np;
+    /*
+     * Twiddle factors exp(-2 pi i k/np), computed in double
+     */
+    ntwiddle = mne_fft_is_pow2(np) ? np/2 : np;
+    for (k = 0; k < ntwiddle; k++) {
+        precalc[FFT_HEADER+2*k]   = cos(2.0*M_PI*k/np);
+        precalc[FFT_HEADER+2*k+1] = sin(2.0*M_PI*k/np);
+    }
+    /*
+     * Bit reversal permutation for the half length complex transform
+     */
+    if (mne_fft_is_pow2(np)) {
+        m = np/2;
+        for (bits = 0; (1 << bits) < m; bits++)
+            ;
+        for (k = 0; k < m; k++) {
+            for (j = 0, rev = 0; j < bits; j++)
+                rev = (rev << 1) | ((k >> j) & 1);
+            precalc[FFT_HEADER+np+k] = rev;
+        }
+    }
+    if (precalcp) {
+        FREE_36(*precalcp);
+        *precalcp = precalc;
+    }
+    return precalc;
+}
+
+static void mne_fft_complex(float *z, int m, const float *precalc, int inverse)
+/*
+ * In-place radix-2 transform of m = np/2 interleaved complex values.
+ * The twiddles for length m are every other entry of the length np table.
+ * The inverse is not normalized.
+ */
+{
+    const float *cs  = precalc + FFT_HEADER;
+    const float *rev = precalc + FFT_HEADER + 2*m;
+    float sign = inverse ? 1.0 : -1.0;
+    float tr,ti,wr,wi;
+    int   k,j,len,half,step,t;
+
+    for (k = 0; k < m; k++) {
+        j = (int)rev[k];
+        if (j > k) {
+            tr = z[2*k]; z[2*k] = z[2*j]; z[2*j] = tr;
+            ti = z[2*k+1]; z[2*k+1] = z[2*j+1]; z[2*j+1] = ti;
+        }
+    }
+    for (len = 2; len <= m; len <<= 1) {
+        half = len/2;
+        step = 2*(m/len);		/* Index step in the length 2m table */
+        for (k = 0; k < m; k += len) {
+            for (j = 0, t = 0; j < half; j++, t += step) {
+                float *a = z + 2*(k+j);
+                float *b = z + 2*(k+j+half);
+                wr = cs[2*t];
+                wi = sign*cs[2*t+1];
+                tr = wr*b[0] - wi*b[1];
+                ti = wr*b[1] + wi*b[0];
+                b[0] = a[0] - tr;
+                b[1] = a[1] - ti;
+                a[0] = a[0] + tr;
+                a[1] = a[1] + ti;
+            }
+        }
+    }
+    return;
+}
+
+static void mne_fft_real_pow2(float *data, int np, float *precalc, int inverse)
+/*
+ * Real transform of even length via a complex transform of half the length
+ */
+{
+    const float *cs = precalc + FFT_HEADER;
+    float *tmp = mne_fft_work(precalc,np);
+    int   m = np/2;
+    int   k;
+    float er,ei,or_,oi,wr,wi,xr,xi,yr,yi;
+
+    if (!inverse) {
+        /*
+         * Even samples go to the real part, odd ones to the imaginary part
+         */
+        mne_fft_complex(data,m,precalc,FALSE);
+        tmp[0] = data[0] + data[1];
+        tmp[1] = 0.0;
+        tmp[np]   = data[0] - data[1];
+        tmp[np+1] = 0.0;
+        for (k = 1; k < m; k++) {
+            xr = data[2*k];      xi = data[2*k+1];
+            yr = data[2*(m-k)];  yi = -data[2*(m-k)+1];	/* conj(Z[m-k]) */
+            er = 0.5*(xr + yr);  ei = 0.5*(xi + yi);
+            or_ = 0.5*(xi - yi); oi = -0.5*(xr - yr);	/* (Z[k] - conj(Z[m-k]))/2i */
+            wr = cs[2*k]; wi = -cs[2*k+1];
+            tmp[2*k]   = er + wr*or_ - wi*oi;
+            tmp[2*k+1] = ei + wr*oi + wi*or_;
+        }
+        /*
+         * Pack into the FFTPACK order
+         */
+        data[0] = tmp[0];
+        for (k = 1; k < m; k++) {
+            data[2*k-1] = tmp[2*k];
+            data[2*k]   = tmp[2*k+1];
+        }
+        data[np-1] = tmp[np];
+    }
+    else {
+        /*
+         * Unpack the half spectrum and recombine into the half length complex spectrum
+         */
+        tmp[0] = data[0];
+        tmp[1] = 0.0;
+        for (k = 1; k < m; k++) {
+            tmp[2*k]   = data[2*k-1];
+            tmp[2*k+1] = data[2*k];
+        }
+        tmp[np]   = data[np-1];
+        tmp[np+1] = 0.0;
+        for (k = 0; k < m; k++) {
+            xr = tmp[2*k];      xi = tmp[2*k+1];
+            yr = tmp[2*(m-k)];  yi = -tmp[2*(m-k)+1];	/* conj(X[m-k]) */
+            er = xr + yr;       ei = xi + yi;
+            wr = cs[2*k]; wi = cs[2*k+1];		/* exp(+2 pi i k/np) */
+            or_ = (xr - yr)*wr - (xi - yi)*wi;
+            oi  = (xr - yr)*wi + (xi - yi)*wr;
+            data[2*k]   = er - oi;			/* E + iO */
+            data[2*k+1] = ei + or_;
+        }
+        mne_fft_complex(data,m,precalc,TRUE);
+    }
+    return;
+}
+
+static void mne_fft_real_direct(float *data, int np, float *precalc, int inverse)
+/*
+ * Direct transform for lengths which are not a power of two
+ */
+{
+    const float *cs = precalc + FFT_HEADER;
+    float  *res = mne_fft_work(precalc,np);
+    int    n = np % 2 == 0 ? np/2 : (np+1)/2;
+    int    k,j,idx;
+    double re,im;
+
+    if (!inverse) {
+        for (k = 0; k < n || (k == n && np % 2 == 0); k++) {
+            re = im = 0.0;
+            for (j = 0, idx = 0; j < np; j++, idx = (idx + k) % np) {
+                re += data[j]*cs[2*idx];
+                im -= data[j]*cs[2*idx+1];
+            }
+            if (k == 0)
+                res[0] = re;
+            else if (2*k == np)
+                res[np-1] = re;
+            else {
+                res[2*k-1] = re;
+                res[2*k]   = im;
+            }
+        }
+    }
+    else {
+        for (j = 0; j < np; j++) {
+            re = data[0];
+            for (k = 1, idx = j; k < n; k++, idx = (idx + j) % np)
+                re += 2.0*(data[2*k-1]*cs[2*idx] - data[2*k]*cs[2*idx+1]);
+            if (np % 2 == 0)
+                re += (j % 2 == 0) ? data[np-1] : -data[np-1];
+            res[j] = re;
+        }
+    }
+    for (j = 0; j < np; j++)
+        data[j] = res[j];
+    return;
+}
 
-void mne_fft_ana(float *data,int np, float **precalcp)
+void MneRawData::mne_fft_ana(float *data,int np, float **precalcp)
 /*
       * FFT analysis for real data
       */
 {
     float *precalc;
 
-    printf("##################### DEBUG Error: FFT analysis needs to be implemented");
-
-    //  if (precalcp && *precalcp)
-    //    precalc = *precalcp;
-    //  else {
-    //    precalc = MALLOC(2*np+15,float);
-    //    rffti(&np,precalc);
-    //    if (precalcp)
-    //      *precalcp = precalc;
-    //  }
-    //  rfftf(&np,data,precalc);
+    if (np < 2)
+        return;
+    precalc = mne_fft_precalc(np,precalcp);
+    if (mne_fft_is_pow2(np))
+        mne_fft_real_pow2(data,np,precalc,FALSE);
+    else
+        mne_fft_real_direct(data,np,precalc,FALSE);
     if (!precalcp)
         FREE_36(precalc);
     return;
 }
 
-void mne_fft_syn(float *data,int np, float **precalcp)
+void MneRawData::mne_fft_syn(float *data,int np, float **precalcp)
 /*
       * FFT synthesis for real data
       */
 {
     float *precalc;
     float mult;
+    int   k;
 
-    printf("##################### DEBUG Error: FFT synthesis needs to be implemented");
-
-    //  if (precalcp && *precalcp)
-    //    precalc = *precalcp;
-    //  else {
-    //    precalc = MALLOC(2*np+15,float);
-    //    rffti(&np,precalc);
-    //    if (precalcp)
-    //      *precalcp = precalc;
-    //  }
-    //  rfftb(&np,data,precalc);
-    //  /*
-    //   * Normalization
-    //   */
-    //  mult = 1.0/np;
-    //  mne_scale_vector(mult,data,np);
+    if (np < 2)
+        return;
+    precalc = mne_fft_precalc(np,precalcp);
+    if (mne_fft_is_pow2(np))
+        mne_fft_real_pow2(data,np,precalc,TRUE);
+    else
+        mne_fft_real_direct(data,np,precalc,TRUE);
+    /*
+     * Normalization
+     */
+    mult = 1.0/np;
+    for (k = 0; k < np; k++)
+        data[k] = mult*data[k];
 
     if (!precalcp)
         FREE_36(precalc);
@@ -408,7 +635,7 @@ int mne_apply_filter(mneFilterDef filter, void *datap, float *data, int ns, int
     /*
    * Next comes the FFT
    */
-    mne_fft_ana(data,ns,&d->precalc);
+    MneRawData::mne_fft_ana(data,ns,&d->precalc);
     /*
    * Multiply with the frequency response
    * See FFTpack doc for details of the arrangement
@@ -436,7 +663,7 @@ int mne_apply_filter(mneFilterDef filter, void *datap, float *data, int ns, int
     if (ns % 2 == 0)
         data[p] = data[p]*freq_resp[k];
 
-    mne_fft_syn(data,ns,&d->precalc);
+    MneRawData::mne_fft_syn(data,ns,&d->precalc);
 
     return OK;
 }
@@ -135,6 +135,27 @@ public:
 
     static MneRawData* mne_raw_open_file(const QString& name, int omit_skip, int allow_maxshield, mneFilterDef filter);
 
+    //=========================================================================================================
+    /**
+     * Real FFT analysis in the FFTPACK rfftf storage order: r0, Re r1, Im r1, ... [, r(np/2) for even np].
+     *
+     * @param[in, out] data      The np samples, replaced by the spectrum.
+     * @param[in] np             The number of samples.
+     * @param[in, out] precalcp  The cached tables for the length, allocated or replaced if needed and released
+     *                           with free() by the caller. NULL allocates and releases them per call.
+     */
+    static void mne_fft_ana(float *data, int np, float **precalcp);
+
+    //=========================================================================================================
+    /**
+     * Real FFT synthesis, the normalized inverse of mne_fft_ana.
+     *
+     * @param[in, out] data      The spectrum in the FFTPACK rfftf storage order, replaced by the np samples.
+     * @param[in] np             The number of samples.
+     * @param[in, out] precalcp  The cached tables for the length, see mne_fft_ana.
+     */
+    static void mne_fft_syn(float *data, int np, float **precalcp);
+
 public:
     QString         filename;             /* This is our file */
     //  FIFFLIB::fiffFile       file;
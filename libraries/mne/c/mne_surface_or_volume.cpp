@@ -51,6 +51,7 @@
 #include "mne_vol_geom.h"
 #include "mne_mgh_tag_group.h"
 #include "mne_mgh_tag.h"
+#include "../mne_triangle_bvh.h"
 
 #include <fiff/fiff_stream.h>
 #include <fiff/c/fiff_digitizer_data.h>
@@ -1497,6 +1498,47 @@ int MneSurfaceOrVolume::mne_project_to_surface(MneSurfaceOld* s, void *proj_data
 
 //=============================================================================================================
 
+MNETriangleBVH MneSurfaceOrVolume::mne_make_triangle_bvh(MneSurfaceOld* s)
+{
+    MatrixX3f matVertices(s->np,3);
+    MatrixX3i matTris(s->ntri,3);
+    int k;
+
+    for (k = 0; k < s->np; k++)
+        matVertices.row(k) << s->rr[k][X_17], s->rr[k][Y_17], s->rr[k][Z_17];
+    for (k = 0; k < s->ntri; k++)
+        matTris.row(k) << s->tris[k].vert[0], s->tris[k].vert[1], s->tris[k].vert[2];
+
+    return MNETriangleBVH(matVertices,matTris);
+}
+
+//=============================================================================================================
+
+int MneSurfaceOrVolume::mne_project_to_surface(MneSurfaceOld* s, const MNETriangleBVH& bvh, float *r, int project_it, float *distp)
+/*
+          * Project the point onto the closest point on the surface
+          */
+{
+    float p,q,dist;
+    float dist0 = 0.0;
+    int   best;
+    Vector3f rClosest;
+
+    best = bvh.nearestTriangle(Vector3f(r[X_17],r[Y_17],r[Z_17]),rClosest,dist);
+    /*
+     * The signed distance and the triangle coordinates follow the conventions of nearest_triangle_point
+     */
+    if (best >= 0 && nearest_triangle_point(r,s,NULL,best,&p,&q,&dist0)) {
+        if (project_it)
+            project_to_triangle(s,best,p,q,r);
+    }
+    if (distp)
+        *distp = dist0;
+    return best;
+}
+
+//=============================================================================================================
+
 void MneSurfaceOrVolume::mne_project_to_triangle(MneSurfaceOld* s,
                                                  int        best,
                                                  float      *r,
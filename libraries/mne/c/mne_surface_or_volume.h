@@ -103,6 +103,7 @@ class MneSurfaceOld;
 class MneMshDisplaySurface;
 class MneProjData;
 class MneMghTagGroup;
+class MNETriangleBVH;
 
 //=============================================================================================================
 /**
@@ -232,6 +233,25 @@ public:
 
     static int mne_project_to_surface(MneSurfaceOld* s, void *proj_data, float *r, int project_it, float *distp);
 
+    //=========================================================================================================
+    /**
+     * Builds a bounding volume hierarchy over the triangles of a surface. It stays valid as long as the vertex
+     * locations of the surface are not changed.
+     *
+     * @param[in] s     The surface.
+     *
+     * @return the bounding volume hierarchy.
+     */
+    static MNETriangleBVH mne_make_triangle_bvh(MneSurfaceOld* s);
+
+    //=========================================================================================================
+    /**
+     * Projects the point onto the closest point on the surface as mne_project_to_surface does without search
+     * restriction, but finds the closest triangle in a bounding volume hierarchy made by mne_make_triangle_bvh.
+     * Use this for repeated projections onto the same surface.
+     */
+    static int mne_project_to_surface(MneSurfaceOld* s, const MNETriangleBVH& bvh, float *r, int project_it, float *distp);
+
     static void mne_project_to_triangle(MneSurfaceOld* s,
                                             int        best,
                                             float      *r,
@@ -84,6 +84,7 @@ SOURCES += \
     mne_bem.cpp\
     mne_bem_surface.cpp \
     mne_project_to_surface.cpp \
+    mne_triangle_bvh.cpp \
     c/mne_cov_matrix.cpp \
     c/mne_ctf_comp_data.cpp \
     c/mne_ctf_comp_data_set.cpp \
@@ -134,6 +135,7 @@ HEADERS += \
     mne_bem.h\
     mne_bem_surface.h \
     mne_project_to_surface.h \
+    mne_triangle_bvh.h \
     c/mne_cov_matrix.h \
     c/mne_ctf_comp_data.h \
     c/mne_ctf_comp_data_set.h \
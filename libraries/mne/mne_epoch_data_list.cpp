@@ -43,11 +43,16 @@
 
 #include <utils/mnemath.h>
 
+#include <fiff/fiff_raw_segment_reader.h>
+
+#include <algorithm>
+
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
 
 #include <QPointer>
+#include <QVector>
 #include <QtConcurrent>
 #include <QDebug>
 
@@ -60,6 +65,26 @@ using namespace MNELIB;
 using namespace UTILSLIB;
 using namespace Eigen;
 
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace {
+
+/**
+ * Returns the index of the first raw buffer which ends at or after sample, the number of buffers if there is none.
+ * Unlike FiffRawSegmentReader::findBuffer this also returns the buffer following a gap in the raw data.
+ */
+int findBufferEndingAfter(const QList<FiffRawDir>& rawdir,
+                          fiff_int_t sample)
+{
+    return std::lower_bound(rawdir.constBegin(), rawdir.constEnd(), sample, [](const FiffRawDir& rawDir, fiff_int_t iSample) {
+        return rawDir.last < iSample;
+    }) - rawdir.constBegin();
+}
+
+} // namespace
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
@@ -92,6 +117,61 @@ MNEEpochDataList MNEEpochDataList::readEpochs(const FiffRawData& raw,
 {
     MNEEpochDataList data;
 
+    QVector<MNEEpochData::SPtr> vecEpochs(events.rows());
+
+    streamEpochs(raw,
+                 events,
+                 tmin,
+                 tmax,
+                 event,
+                 mapReject,
+                 [&vecEpochs](qint32 iEventRow, const MNEEpochData::SPtr& pEpoch) {
+                     vecEpochs[iEventRow] = pEpoch;
+                 },
+                 lExcludeChs,
+                 picks);
+
+    // Collect the epochs in the order of the events
+    fiff_int_t dropCount = 0;
+
+    for (qint32 p = 0; p < events.rows(); ++p) {
+        if (events(p,1) != 0 || events(p,2) != event) {
+            continue;
+        }
+
+        if(MNEEpochData::SPtr pEpoch = vecEpochs.at(p)) {
+            //Check if data block has the same size as the previous one
+            if(!data.isEmpty() && pEpoch->epoch.size() != data.last()->epoch.size()) {
+                continue;
+            }
+
+            data.append(pEpoch);
+
+            if (pEpoch->bReject) {
+                dropCount++;
+            }
+        } else {
+            printf("Can't read the event data segments\n");
+        }
+    }
+
+    qDebug() << "MNEEpochDataList::readEpochs - Read a total of"<< data.size() <<"epochs of type" << event << "and marked"<< dropCount <<"for rejection";
+
+    return data;
+}
+
+//=============================================================================================================
+
+qint32 MNEEpochDataList::streamEpochs(const FiffRawData& raw,
+                                      const MatrixXi& events,
+                                      float tmin,
+                                      float tmax,
+                                      qint32 event,
+                                      const QMap<QString,double>& mapReject,
+                                      const std::function<void(qint32 iEventRow, const MNEEpochData::SPtr& pEpoch)>& epochReady,
+                                      const QStringList& lExcludeChs,
+                                      const RowVectorXi& picks)
+{
     // Select the desired events
     qint32 count = 0;
     qint32 p;
@@ -109,7 +189,7 @@ MNEEpochDataList MNEEpochDataList::readEpochs(const FiffRawData& raw,
         printf("%d matching events found\n",count);
     } else {
         printf("No desired events found.\n");
-        return MNEEpochDataList();
+        return 0;
     }
 
     // If picks are empty, pick all
@@ -121,57 +201,105 @@ MNEEpochDataList MNEEpochDataList::readEpochs(const FiffRawData& raw,
         }
     }
 
-    fiff_int_t event_samp, from, to;
-    fiff_int_t dropCount = 0;
-    MatrixXd timesDummy;
-    MatrixXd times;
-
-    QScopedPointer<MNEEpochData> epoch(Q_NULLPTR);
+    // Determine the sample range of each epoch. Epochs reaching beyond the data are cut at the edges.
+    fiff_int_t event_samp;
+    qint32 iNumEpochs = 0;
+    QVector<fiff_int_t> vecFrom(count), vecTo(count);
+    QVector<int> vecOrder;
 
     for (p = 0; p < count; ++p) {
-        // Read a data segment
         event_samp = events(selected(p),0);
-        from = event_samp + tmin*raw.info.sfreq;
-        to   = event_samp + floor(tmax*raw.info.sfreq + 0.5);
+        vecFrom[p] = event_samp + tmin*raw.info.sfreq;
+        vecTo[p] = event_samp + floor(tmax*raw.info.sfreq + 0.5);
+        vecFrom[p] = qMax(vecFrom[p], raw.first_samp);
+        vecTo[p] = qMin(vecTo[p], raw.last_samp);
 
-        epoch.reset(new MNEEpochData());
+        if(vecFrom[p] <= vecTo[p]) {
+            vecOrder.append(p);
+        }
+    }
 
-        if(raw.read_raw_segment(epoch->epoch, timesDummy, from, to, picksNew)) {
-            if (p == 0) {
-                times.resize(1, to-from+1);
-                for (qint32 i = 0; i < times.cols(); ++i)
-                    times(0, i) = ((float)(from-event_samp+i)) / raw.info.sfreq;
-            }
+    // Walk the raw buffers once in the order of the epochs. Each buffer is decoded a single time and sliced into
+    // all epochs it intersects. Only the current buffer and the epochs which are not yet complete are kept in memory.
+    std::stable_sort(vecOrder.begin(), vecOrder.end(), [&vecFrom](int a, int b) {
+        return vecFrom[a] < vecFrom[b];
+    });
+
+    FiffRawSegmentReader reader(raw, 0);
+    QMap<int, MNEEpochData::SPtr> mapOpen;
+    QVector<fiff_int_t> vecNumRead(count, 0);
+    int iNext = 0;
+    int k = vecOrder.isEmpty() ? raw.rawdir.size() : findBufferEndingAfter(raw.rawdir, vecFrom[vecOrder.first()]);
+
+    while (k < raw.rawdir.size() && (iNext < vecOrder.size() || !mapOpen.isEmpty())) {
+        const FiffRawDir& rawDir = raw.rawdir.at(k);
+
+        // Open the epochs starting in this buffer
+        while (iNext < vecOrder.size() && vecFrom[vecOrder.at(iNext)] <= rawDir.last) {
+            p = vecOrder.at(iNext++);
+            MNEEpochData::SPtr pEpoch(new MNEEpochData());
+            pEpoch->epoch = MatrixXd::Zero(picksNew.cols(), vecTo[p] - vecFrom[p] + 1);
+            mapOpen.insert(p, pEpoch);
+        }
+
+        // Jump over the buffers no epoch is interested in
+        if(mapOpen.isEmpty()) {
+            int kNext = findBufferEndingAfter(raw.rawdir, vecFrom[vecOrder.at(iNext)]);
+            k = kNext > k ? kNext : k + 1;
+            continue;
+        }
 
-            epoch->event = event;
-            epoch->tmin = tmin;
-            epoch->tmax = tmax;
+        QSharedPointer<const MatrixXd> pBuffer = reader.readBuffer(k, picksNew);
 
-            epoch->bReject = checkForArtifact(epoch->epoch,
-                                              raw.info,
-                                              mapReject,
-                                              lExcludeChs);
+        QMutableMapIterator<int, MNEEpochData::SPtr> itOpen(mapOpen);
+        while (itOpen.hasNext()) {
+            itOpen.next();
+            p = itOpen.key();
 
-            if (epoch->bReject) {
-                dropCount++;
+            if(!pBuffer) {
+                itOpen.remove();
+                continue;
             }
 
-            //Check if data block has the same size as the previous one
-            if(!data.isEmpty()) {
-                if(epoch->epoch.size() == data.last()->epoch.size()) {
-                    data.append(MNEEpochData::SPtr(epoch.take()));//List takes ownwership of the pointer - no delete need
+            const MNEEpochData::SPtr& pEpoch = itOpen.value();
+            fiff_int_t first_pick = qMax(vecFrom[p], rawDir.first);
+            fiff_int_t last_pick = qMin(vecTo[p], rawDir.last);
+
+            if(last_pick >= first_pick) {
+                pEpoch->epoch.middleCols(first_pick - vecFrom[p], last_pick - first_pick + 1) = pBuffer->middleCols(first_pick - rawDir.first, last_pick - first_pick + 1);
+                vecNumRead[p] += last_pick - first_pick + 1;
+            }
+
+            if(vecTo[p] <= rawDir.last) {
+                // The epoch is complete, scan it for artifacts and hand it out right away
+                pEpoch->event = event;
+                pEpoch->tmin = tmin;
+                pEpoch->tmax = tmax;
+
+                if(vecNumRead[p] < pEpoch->epoch.cols()) {
+                    // Part of the epoch falls into a gap between the raw buffers and was left at zero
+                    qWarning("[MNEEpochDataList::streamEpochs] Samples %d ... %d of event %d are not covered by the raw data. Marking the epoch for rejection.",
+                             vecFrom[p], vecTo[p], selected(p));
+                    pEpoch->bReject = true;
+                } else {
+                    pEpoch->bReject = checkForArtifact(pEpoch->epoch,
+                                                       raw.info,
+                                                       mapReject,
+                                                       lExcludeChs);
                 }
-            } else {
-                data.append(MNEEpochData::SPtr(epoch.take()));//List takes ownwership of the pointer - no delete need
+
+                epochReady(selected(p), pEpoch);
+                ++iNumEpochs;
+
+                itOpen.remove();
             }
-        } else {
-            printf("Can't read the event data segments\n");
         }
-    }
 
-    qDebug() << "MNEEpochDataList::readEpochs - Read a total of"<< data.size() <<"epochs of type" << event << "and marked"<< dropCount <<"for rejection";
+        ++k;
+    }
 
-    return data;
+    // Epochs which could not be completed are dropped
+    return iNumEpochs;
 }
 
 //=============================================================================================================
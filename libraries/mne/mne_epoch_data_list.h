@@ -55,6 +55,12 @@
 #include <QList>
 #include <QSharedPointer>
 
+//=============================================================================================================
+// STL INCLUDES
+//=============================================================================================================
+
+#include <functional>
+
 //=============================================================================================================
 // DEFINE NAMESPACE MNELIB
 //=============================================================================================================
@@ -96,7 +102,8 @@ public:
 
     //=========================================================================================================
     /**
-     * Read the epochs from a raw file based on provided events.
+     * Read the epochs from a raw file based on provided events. The epochs are read with streamEpochs and
+     * collected in the order of the events. Use streamEpochs directly if the epochs do not need to be kept.
      *
      * @param[in] raw            The raw data.
      * @param[in] events         The events provided in samples and event kind.
@@ -117,6 +124,37 @@ public:
                                        const QStringList &lExcludeChs = QStringList(),
                                        const Eigen::RowVectorXi& picks = Eigen::RowVectorXi());
 
+    //=========================================================================================================
+    /**
+     * Streams the epochs of a raw file based on provided events to a callback. The raw file is read in a single
+     * pass, every raw buffer is decoded once and sliced into all epochs it overlaps with. Each epoch is scanned
+     * for artifacts and handed to epochReady as soon as it is complete. Only the epochs currently being filled
+     * are held in memory, epochs are released once the callback no longer references them. Epochs are handed
+     * out in the order of their first sample. Epochs reaching beyond the data are cut at the edges. Epochs which
+     * overlap with a gap between the raw buffers are handed out marked for rejection.
+     *
+     * @param[in] raw            The raw data.
+     * @param[in] events         The events provided in samples and event kind.
+     * @param[in] tmin           The start time relative to the event in seconds.
+     * @param[in] tmax           The end time relative to the event in seconds.
+     * @param[in] event          The event kind.
+     * @param[in] mapReject      The channel data types to scan for and their rejection thresholds.
+     * @param[in] epochReady     Called with the row of the event in events and the completed epoch.
+     * @param[in] lExcludeChs    List of channel names to exclude.
+     * @param[in] picks          Which channels to pick.
+     *
+     * @return the number of epochs handed to epochReady.
+     */
+    static qint32 streamEpochs(const FIFFLIB::FiffRawData& raw,
+                               const Eigen::MatrixXi& events,
+                               float tmin,
+                               float tmax,
+                               qint32 event,
+                               const QMap<QString,double>& mapReject,
+                               const std::function<void(qint32 iEventRow, const MNEEpochData::SPtr& pEpoch)>& epochReady,
+                               const QStringList &lExcludeChs = QStringList(),
+                               const Eigen::RowVectorXi& picks = Eigen::RowVectorXi());
+
     //=========================================================================================================
     /**
      * Averages epoch list. Note that no baseline correction performed.
@@ -117,6 +117,8 @@ MNEProjectToSurface::MNEProjectToSurface(const MNEBemSurface &p_MNEBemSurf)
         }
     }
     det = (a.array()*b.array() - c.array()*c.array()).matrix();
+
+    bvh = MNETriangleBVH(p_MNEBemSurf.rr, p_MNEBemSurf.tris);
 }
 
 //=============================================================================================================
@@ -143,6 +145,17 @@ MNEProjectToSurface::MNEProjectToSurface(const MNESurface &p_MNESurf)
     }
 
     det = (a.array()*b.array() - c.array()*c.array()).matrix();
+
+    //Build the tree from the triangle corners, which are already laid out per triangle
+    int ntri = p_MNESurf.ntri;
+    MatrixX3f matCorners(3*ntri, 3);
+    MatrixX3i matTris(ntri, 3);
+    matCorners << r1, r1 + r12, r1 + r13;
+    for (int i = 0; i < ntri; ++i)
+    {
+        matTris.row(i) << i, ntri + i, 2*ntri + i;
+    }
+    bvh = MNETriangleBVH(matCorners, matTris);
 }
 
 //=============================================================================================================
@@ -157,23 +170,24 @@ bool MNEProjectToSurface::mne_find_closest_on_surface(const MatrixXf &r, const i
         qDebug() << "No surface loaded to make the projection./n";
         return false;
     }
-    int bestTri = -1;
-    float bestDist = -1;
+    rTri.resize(np, 3);
+
+    //Look up the closest triangles of all points at once, this runs in parallel for larger point sets
+    MatrixX3f matClosest;
+    VectorXf vecEuclidDist;
+    this->bvh.nearestTriangles(r.topRows(np), nearest, matClosest, vecEuclidDist);
+
+    float p = 0, q = 0;
     Vector3f rTriK;
     for (int k = 0; k < np; ++k)
     {
-        /*
-         * To do: decide_search_restriction for the use in an iterative closest point to plane algorithm
-         * For now it's OK to go through all triangles.
-         */
-        if (!this->mne_project_to_surface(r.row(k).transpose(), rTriK, bestTri, bestDist))
+        if (nearest[k] < 0 || !this->nearest_triangle_point(r.row(k).transpose(), nearest[k], p, q, dist[k])
+                || !this->project_to_triangle(rTriK, p, q, nearest[k]))
         {
             qDebug() << "The projection of point number " << k << " didn't work./n";
             return false;
         }
         rTri.row(k) = rTriK.transpose();
-        nearest[k] = bestTri;
-        dist[k] = bestDist;
     }
     return true;
 }
@@ -182,24 +196,18 @@ bool MNEProjectToSurface::mne_find_closest_on_surface(const MatrixXf &r, const i
 
 bool MNEProjectToSurface::mne_project_to_surface(const Vector3f &r, Vector3f &rTri, int &bestTri, float &bestDist)
 {
-    float p = 0, q = 0, p0 = 0, q0 = 0, dist0 = 0;
+    float p = 0, q = 0;
     bestDist = 0.0f;
-    bestTri = -1;
-    for (int tri = 0; tri < a .size(); ++tri)
-    {
-        if (!this->nearest_triangle_point(r, tri, p0, q0, dist0))
-        {
-            qDebug() << "The projection on triangle " << tri << " didn't work./n";
-            return false;
-        }
 
-        if ((bestTri < 0) || (std::fabs(dist0) < std::fabs(bestDist)))
-        {
-            bestDist = dist0;
-            p = p0;
-            q = q0;
-            bestTri = tri;
-        }
+    //The tree finds the triangle with the smallest Euclidean distance, the triangle coordinates follow from it
+    Vector3f rClosest;
+    float euclidDist = 0.0f;
+    bestTri = this->bvh.nearestTriangle(r, rClosest, euclidDist);
+
+    if (bestTri >= 0 && !this->nearest_triangle_point(r, bestTri, p, q, bestDist))
+    {
+        qDebug() << "The projection on triangle " << bestTri << " didn't work./n";
+        return false;
     }
 
     if (bestTri >= 0)
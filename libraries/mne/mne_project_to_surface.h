@@ -41,6 +41,7 @@
 //=============================================================================================================
 
 #include "mne_global.h"
+#include "mne_triangle_bvh.h"
 
 //=============================================================================================================
 // QT INCLUDES
@@ -111,7 +112,7 @@ public:
 
     //=========================================================================================================
     /**
-     * Projects a set of points r on the Surface
+     * Projects a set of points r on the Surface. The closest triangles are looked up in parallel.
      *
      * @brief mne_find_closest_on_surface
      *
@@ -131,7 +132,7 @@ protected:
 private:
     //=========================================================================================================
     /**
-     * Projects a point r on the Surface
+     * Projects a point r on the Surface. The closest triangle is looked up in the bounding volume hierarchy.
      *
      * @brief mne_project_to_surface
      *
@@ -183,6 +184,7 @@ private:
     Eigen::VectorXf b;           /**< r13*r13 */
     Eigen::VectorXf c;           /**< r12*r13 */
     Eigen::VectorXf det;         /**< Determinant of the Matrix [a c, c b] */
+    MNETriangleBVH bvh;          /**< Bounding volume hierarchy over the triangles */
 };
 
 //=============================================================================================================
@@ -0,0 +1,438 @@
+//=============================================================================================================
+/**
+ * @file     mne_triangle_bvh.cpp
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief     MNETriangleBVH class definition.
+ *
+ */
+
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "mne_triangle_bvh.h"
+#include "mne_bem_surface.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtConcurrent>
+#include <QThread>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Geometry>
+
+//=============================================================================================================
+// STL INCLUDES
+//=============================================================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace MNELIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace {
+    const int   BVH_STACK_SIZE = 64;       /**< Traversal stack depth, the tree depth is ~log2(ntri). */
+    const int   BVH_MIN_POINTS_PER_TASK = 64;  /**< Smaller point sets are queried in the calling thread. */
+}
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+MNETriangleBVH::MNETriangleBVH()
+{
+}
+
+//=============================================================================================================
+
+MNETriangleBVH::MNETriangleBVH(const MatrixX3f& matVertices,
+                               const MatrixX3i& matTris,
+                               int iMaxLeafSize)
+{
+    m_vecR1.resize(matTris.rows());
+    m_vecR2.resize(matTris.rows());
+    m_vecR3.resize(matTris.rows());
+
+    for(int i = 0; i < matTris.rows(); ++i) {
+        m_vecR1[i] = matVertices.row(matTris(i,0)).transpose();
+        m_vecR2[i] = matVertices.row(matTris(i,1)).transpose();
+        m_vecR3[i] = matVertices.row(matTris(i,2)).transpose();
+    }
+
+    build(iMaxLeafSize);
+}
+
+//=============================================================================================================
+
+MNETriangleBVH::MNETriangleBVH(const MNEBemSurface &p_MNEBemSurf)
+: MNETriangleBVH(p_MNEBemSurf.rr, p_MNEBemSurf.tris)
+{
+}
+
+//=============================================================================================================
+
+int MNETriangleBVH::nearestTriangle(const Vector3f& r,
+                                    Vector3f& rClosest,
+                                    float& dist) const
+{
+    if(m_vecNodes.isEmpty()) {
+        return -1;
+    }
+
+    int iBestTri = -1;
+    float fBestDistSquared = std::numeric_limits<float>::max();
+
+    int stack[BVH_STACK_SIZE];
+    int iStackSize = 0;
+    stack[iStackSize++] = 0;
+
+    while(iStackSize > 0) {
+        const Node& node = m_vecNodes.at(stack[--iStackSize]);
+
+        if(boxDistSquared(node, r) >= fBestDistSquared) {
+            continue;
+        }
+
+        if(node.iCount > 0) {
+            for(int i = node.iFirst; i < node.iFirst + node.iCount; ++i) {
+                int tri = m_vecTriIdx.at(i);
+                Vector3f rTri = closestPointOnTriangle(r, tri);
+                float fDistSquared = (rTri - r).squaredNorm();
+
+                if(fDistSquared < fBestDistSquared) {
+                    fBestDistSquared = fDistSquared;
+                    iBestTri = tri;
+                    rClosest = rTri;
+                }
+            }
+        } else {
+            //Push the farther child first so that the nearer one is searched first and tightens the bound
+            float fDistLeft = boxDistSquared(m_vecNodes.at(node.iFirst), r);
+            float fDistRight = boxDistSquared(m_vecNodes.at(node.iFirst + 1), r);
+
+            if(fDistLeft <= fDistRight) {
+                stack[iStackSize++] = node.iFirst + 1;
+                stack[iStackSize++] = node.iFirst;
+            } else {
+                stack[iStackSize++] = node.iFirst;
+                stack[iStackSize++] = node.iFirst + 1;
+            }
+        }
+    }
+
+    dist = std::sqrt(fBestDistSquared);
+
+    return iBestTri;
+}
+
+//=============================================================================================================
+
+void MNETriangleBVH::nearestTriangles(const MatrixX3f& matPoints,
+                                      VectorXi& vecNearest,
+                                      MatrixX3f& matClosest,
+                                      VectorXf& vecDist) const
+{
+    int np = matPoints.rows();
+
+    vecNearest.resize(np);
+    matClosest.resize(np, 3);
+    vecDist.resize(np);
+
+    std::function<void(QPair<int,int>&)> queryRange = [&](QPair<int,int>& range) {
+        Vector3f rClosest;
+        float dist;
+
+        for(int k = range.first; k < range.second; ++k) {
+            vecNearest[k] = nearestTriangle(matPoints.row(k).transpose(), rClosest, dist);
+            matClosest.row(k) = rClosest.transpose();
+            vecDist[k] = dist;
+        }
+    };
+
+    if(np < 2 * BVH_MIN_POINTS_PER_TASK) {
+        QPair<int,int> range(0, np);
+        queryRange(range);
+        return;
+    }
+
+    //Each task writes a disjoint range of the outputs
+    int iNumTasks = qMin(np / BVH_MIN_POINTS_PER_TASK, 4 * QThread::idealThreadCount());
+    QList<QPair<int,int> > lRanges;
+
+    for(int i = 0; i < iNumTasks; ++i) {
+        lRanges.append(qMakePair(i * np / iNumTasks, (i + 1) * np / iNumTasks));
+    }
+
+    QtConcurrent::blockingMap(lRanges, queryRange);
+}
+
+//=============================================================================================================
+
+int MNETriangleBVH::intersectRay(const Vector3f& origin,
+                                 const Vector3f& direction,
+                                 float& t,
+                                 float tMax) const
+{
+    if(m_vecNodes.isEmpty()) {
+        return -1;
+    }
+
+    const float fEps = 1.0e-12f;
+
+    Vector3f vecInvDir;
+    for(int i = 0; i < 3; ++i) {
+        vecInvDir[i] = 1.0f / (std::fabs(direction[i]) > fEps ? direction[i] : (direction[i] < 0.0f ? -fEps : fEps));
+    }
+
+    int iBestTri = -1;
+    float fBestT = tMax;
+
+    int stack[BVH_STACK_SIZE];
+    int iStackSize = 0;
+    stack[iStackSize++] = 0;
+
+    while(iStackSize > 0) {
+        const Node& node = m_vecNodes.at(stack[--iStackSize]);
+
+        //Slab test
+        Vector3f vecT0 = (node.vecMin - origin).cwiseProduct(vecInvDir);
+        Vector3f vecT1 = (node.vecMax - origin).cwiseProduct(vecInvDir);
+        float fEnter = qMax(vecT0.cwiseMin(vecT1).maxCoeff(), 0.0f);
+        float fExit = qMin(vecT0.cwiseMax(vecT1).minCoeff(), fBestT);
+
+        if(fEnter > fExit) {
+            continue;
+        }
+
+        if(node.iCount > 0) {
+            //Moeller-Trumbore
+            for(int i = node.iFirst; i < node.iFirst + node.iCount; ++i) {
+                int tri = m_vecTriIdx.at(i);
+                Vector3f r12 = m_vecR2.at(tri) - m_vecR1.at(tri);
+                Vector3f r13 = m_vecR3.at(tri) - m_vecR1.at(tri);
+                Vector3f p = direction.cross(r13);
+                float det = r12.dot(p);
+
+                if(std::fabs(det) < fEps) {
+                    continue;
+                }
+
+                float fInvDet = 1.0f / det;
+                Vector3f s = origin - m_vecR1.at(tri);
+                float u = s.dot(p) * fInvDet;
+                if(u < 0.0f || u > 1.0f) {
+                    continue;
+                }
+
+                Vector3f q = s.cross(r12);
+                float v = direction.dot(q) * fInvDet;
+                if(v < 0.0f || u + v > 1.0f) {
+                    continue;
+                }
+
+                float fHitT = r13.dot(q) * fInvDet;
+                if(fHitT >= 0.0f && fHitT < fBestT) {
+                    fBestT = fHitT;
+                    iBestTri = tri;
+                }
+            }
+        } else {
+            stack[iStackSize++] = node.iFirst;
+            stack[iStackSize++] = node.iFirst + 1;
+        }
+    }
+
+    if(iBestTri >= 0) {
+        t = fBestT;
+    }
+
+    return iBestTri;
+}
+
+//=============================================================================================================
+
+void MNETriangleBVH::build(int iMaxLeafSize)
+{
+    int ntri = m_vecR1.size();
+    m_vecNodes.clear();
+
+    if(ntri == 0) {
+        return;
+    }
+
+    iMaxLeafSize = qMax(1, iMaxLeafSize);
+
+    QVector<Vector3f> vecCentroids(ntri);
+    m_vecTriIdx.resize(ntri);
+    for(int i = 0; i < ntri; ++i) {
+        vecCentroids[i] = (m_vecR1.at(i) + m_vecR2.at(i) + m_vecR3.at(i)) / 3.0f;
+        m_vecTriIdx[i] = i;
+    }
+
+    m_vecNodes.reserve(2 * ntri / iMaxLeafSize + 1);
+
+    Node root;
+    root.iFirst = 0;
+    root.iCount = ntri;
+    m_vecNodes.append(root);
+
+    //Split the nodes breadth first at the centroid median of their longest axis
+    QVector<int> vecOpen;
+    vecOpen.append(0);
+
+    while(!vecOpen.isEmpty()) {
+        int iNode = vecOpen.takeLast();
+        int iFirst = m_vecNodes.at(iNode).iFirst;
+        int iCount = m_vecNodes.at(iNode).iCount;
+
+        Vector3f vecMin = m_vecR1.at(m_vecTriIdx.at(iFirst));
+        Vector3f vecMax = vecMin;
+        Vector3f vecCentMin = vecCentroids.at(m_vecTriIdx.at(iFirst));
+        Vector3f vecCentMax = vecCentMin;
+
+        for(int i = iFirst; i < iFirst + iCount; ++i) {
+            int tri = m_vecTriIdx.at(i);
+            vecMin = vecMin.cwiseMin(m_vecR1.at(tri)).cwiseMin(m_vecR2.at(tri)).cwiseMin(m_vecR3.at(tri));
+            vecMax = vecMax.cwiseMax(m_vecR1.at(tri)).cwiseMax(m_vecR2.at(tri)).cwiseMax(m_vecR3.at(tri));
+            vecCentMin = vecCentMin.cwiseMin(vecCentroids.at(tri));
+            vecCentMax = vecCentMax.cwiseMax(vecCentroids.at(tri));
+        }
+
+        m_vecNodes[iNode].vecMin = vecMin;
+        m_vecNodes[iNode].vecMax = vecMax;
+
+        if(iCount <= iMaxLeafSize) {
+            continue;
+        }
+
+        int iAxis;
+        (vecCentMax - vecCentMin).maxCoeff(&iAxis);
+
+        int* pBegin = m_vecTriIdx.data() + iFirst;
+        int* pMid = pBegin + iCount / 2;
+        std::nth_element(pBegin, pMid, pBegin + iCount, [&vecCentroids, iAxis](int a, int b) {
+            return vecCentroids.at(a)[iAxis] < vecCentroids.at(b)[iAxis];
+        });
+
+        Node left, right;
+        left.iFirst = iFirst;
+        left.iCount = iCount / 2;
+        right.iFirst = iFirst + iCount / 2;
+        right.iCount = iCount - iCount / 2;
+
+        int iLeft = m_vecNodes.size();
+        m_vecNodes.append(left);
+        m_vecNodes.append(right);
+
+        m_vecNodes[iNode].iFirst = iLeft;
+        m_vecNodes[iNode].iCount = 0;
+
+        vecOpen.append(iLeft);
+        vecOpen.append(iLeft + 1);
+    }
+}
+
+//=============================================================================================================
+
+inline float MNETriangleBVH::boxDistSquared(const Node& node,
+                                            const Vector3f& r)
+{
+    Vector3f vecDelta = (node.vecMin - r).cwiseMax(r - node.vecMax).cwiseMax(Vector3f::Zero());
+    return vecDelta.squaredNorm();
+}
+
+//=============================================================================================================
+
+inline Vector3f MNETriangleBVH::closestPointOnTriangle(const Vector3f& r,
+                                                       int tri) const
+{
+    //Region tests on the barycentric coordinates, see Ericson, Real-Time Collision Detection, 5.1.5
+    const Vector3f& r1 = m_vecR1.at(tri);
+    const Vector3f& r2 = m_vecR2.at(tri);
+    const Vector3f& r3 = m_vecR3.at(tri);
+
+    Vector3f r12 = r2 - r1;
+    Vector3f r13 = r3 - r1;
+    Vector3f r1p = r - r1;
+
+    float d1 = r12.dot(r1p);
+    float d2 = r13.dot(r1p);
+    if(d1 <= 0.0f && d2 <= 0.0f) {
+        return r1;
+    }
+
+    Vector3f r2p = r - r2;
+    float d3 = r12.dot(r2p);
+    float d4 = r13.dot(r2p);
+    if(d3 >= 0.0f && d4 <= d3) {
+        return r2;
+    }
+
+    float vc = d1*d4 - d3*d2;
+    if(vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        return r1 + (d1 / (d1 - d3)) * r12;
+    }
+
+    Vector3f r3p = r - r3;
+    float d5 = r12.dot(r3p);
+    float d6 = r13.dot(r3p);
+    if(d6 >= 0.0f && d5 <= d6) {
+        return r3;
+    }
+
+    float vb = d5*d2 - d1*d6;
+    if(vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        return r1 + (d2 / (d2 - d6)) * r13;
+    }
+
+    float va = d3*d6 - d5*d4;
+    if(va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+        return r2 + ((d4 - d3) / ((d4 - d3) + (d5 - d6))) * (r3 - r2);
+    }
+
+    float denom = 1.0f / (va + vb + vc);
+    return r1 + r12 * (vb * denom) + r13 * (vc * denom);
+}
@@ -0,0 +1,229 @@
+//=============================================================================================================
+/**
+ * @file     mne_triangle_bvh.h
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief     MNETriangleBVH class declaration.
+ *
+ */
+
+#ifndef MNELIB_MNETRIANGLEBVH_H
+#define MNELIB_MNETRIANGLEBVH_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "mne_global.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QSharedPointer>
+#include <QVector>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// DEFINE NAMESPACE MNELIB
+//=============================================================================================================
+
+namespace MNELIB {
+
+//=============================================================================================================
+// MNELIB FORWARD DECLARATIONS
+//=============================================================================================================
+
+class MNEBemSurface;
+
+//=============================================================================================================
+/**
+ * Bounding volume hierarchy of axis aligned boxes over the triangles of a surface. Nearest point and ray queries
+ * descend only into boxes which can still contain a better triangle, which makes them roughly logarithmic in the
+ * number of triangles instead of linear. The tree is immutable once built and can be queried from several threads.
+ *
+ * @brief Triangle AABB tree for nearest point and ray queries.
+ */
+class MNESHARED_EXPORT MNETriangleBVH
+{
+
+public:
+    typedef QSharedPointer<MNETriangleBVH> SPtr;            /**< Shared pointer type for MNETriangleBVH. */
+    typedef QSharedPointer<const MNETriangleBVH> ConstSPtr; /**< Const shared pointer type for MNETriangleBVH. */
+
+    //=========================================================================================================
+    /**
+     * Constructs an empty MNETriangleBVH.
+     */
+    MNETriangleBVH();
+
+    //=========================================================================================================
+    /**
+     * Constructs a MNETriangleBVH over a triangulation.
+     *
+     * @param[in] matVertices    The vertex locations (nvert x 3).
+     * @param[in] matTris        The vertex indices of the triangles (ntri x 3).
+     * @param[in] iMaxLeafSize   The maximal number of triangles in a leaf.
+     */
+    MNETriangleBVH(const Eigen::MatrixX3f& matVertices,
+                   const Eigen::MatrixX3i& matTris,
+                   int iMaxLeafSize = 4);
+
+    //=========================================================================================================
+    /**
+     * Constructs a MNETriangleBVH over the triangles of a MNEBemSurface.
+     *
+     * @param[in] p_MNEBemSurf   The BEM surface.
+     */
+    MNETriangleBVH(const MNELIB::MNEBemSurface &p_MNEBemSurf);
+
+    //=========================================================================================================
+    /**
+     * Returns whether the tree holds no triangles.
+     *
+     * @return true if the tree is empty.
+     */
+    inline bool isEmpty() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of triangles.
+     *
+     * @return the number of triangles.
+     */
+    inline int ntri() const;
+
+    //=========================================================================================================
+    /**
+     * Finds the triangle closest to a point.
+     *
+     * @param[in] r          The point.
+     * @param[out] rClosest  The closest point on the surface.
+     * @param[out] dist      The Euclidean distance between r and rClosest.
+     *
+     * @return the index of the closest triangle, -1 if the tree is empty.
+     */
+    int nearestTriangle(const Eigen::Vector3f& r,
+                        Eigen::Vector3f& rClosest,
+                        float& dist) const;
+
+    //=========================================================================================================
+    /**
+     * Finds the closest triangle for a set of points. Large sets are processed in parallel.
+     *
+     * @param[in] matPoints      The points (np x 3).
+     * @param[out] vecNearest    The index of the closest triangle per point.
+     * @param[out] matClosest    The closest point on the surface per point (np x 3).
+     * @param[out] vecDist       The Euclidean distance per point.
+     */
+    void nearestTriangles(const Eigen::MatrixX3f& matPoints,
+                          Eigen::VectorXi& vecNearest,
+                          Eigen::MatrixX3f& matClosest,
+                          Eigen::VectorXf& vecDist) const;
+
+    //=========================================================================================================
+    /**
+     * Finds the first triangle hit by a ray.
+     *
+     * @param[in] origin     The origin of the ray.
+     * @param[in] direction  The direction of the ray, does not need to be normalized.
+     * @param[out] t         The hit location as origin + t * direction.
+     * @param[in] tMax       Hits beyond origin + tMax * direction are ignored.
+     *
+     * @return the index of the hit triangle, -1 if nothing was hit.
+     */
+    int intersectRay(const Eigen::Vector3f& origin,
+                     const Eigen::Vector3f& direction,
+                     float& t,
+                     float tMax = 1.0e30f) const;
+
+private:
+    //=========================================================================================================
+    /**
+     * A node of the tree. Inner nodes store the index of their first child, the second child follows at
+     * iFirst + 1. Leaves store the range [iFirst, iFirst + iCount) of m_vecTriIdx.
+     */
+    struct Node {
+        Eigen::Vector3f vecMin;     /**< Lower corner of the bounding box. */
+        Eigen::Vector3f vecMax;     /**< Upper corner of the bounding box. */
+        int iFirst;                 /**< First child or first triangle. */
+        int iCount;                 /**< Number of triangles, 0 for inner nodes. */
+    };
+
+    //=========================================================================================================
+    /**
+     * Builds the tree over the stored triangle corners.
+     *
+     * @param[in] iMaxLeafSize   The maximal number of triangles in a leaf.
+     */
+    void build(int iMaxLeafSize);
+
+    //=========================================================================================================
+    /**
+     * Returns the squared distance between a point and a bounding box, zero if the point is inside.
+     */
+    static inline float boxDistSquared(const Node& node,
+                                       const Eigen::Vector3f& r);
+
+    //=========================================================================================================
+    /**
+     * Returns the closest point to r on triangle tri.
+     */
+    inline Eigen::Vector3f closestPointOnTriangle(const Eigen::Vector3f& r,
+                                                  int tri) const;
+
+    QVector<Eigen::Vector3f>    m_vecR1;        /**< First corner per triangle. */
+    QVector<Eigen::Vector3f>    m_vecR2;        /**< Second corner per triangle. */
+    QVector<Eigen::Vector3f>    m_vecR3;        /**< Third corner per triangle. */
+    QVector<int>                m_vecTriIdx;    /**< Triangle indices ordered by leaf. */
+    QVector<Node>               m_vecNodes;     /**< The nodes, the root is the first one. */
+};
+
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+inline bool MNETriangleBVH::isEmpty() const
+{
+    return m_vecNodes.isEmpty();
+}
+
+//=============================================================================================================
+
+inline int MNETriangleBVH::ntri() const
+{
+    return m_vecR1.size();
+}
+} // namespace MNELIB
+
+#endif // MNELIB_MNETRIANGLEBVH_H
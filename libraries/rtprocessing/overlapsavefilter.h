@@ -0,0 +1,383 @@
+//=============================================================================================================
+/**
+ * @file     overlapsavefilter.h
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief     OverlapSaveFilter class declaration.
+ *
+ */
+
+#ifndef OVERLAPSAVEFILTER_H
+#define OVERLAPSAVEFILTER_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/filterTools/filterdata.h>
+#include <utils/parallelexecutor.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QList>
+#include <QVector>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+#include <unsupported/Eigen/FFT>
+
+//=============================================================================================================
+// DEFINE NAMESPACE RTPROCESSINGLIB
+//=============================================================================================================
+
+namespace RTPROCESSINGLIB
+{
+
+//=============================================================================================================
+/**
+ * Streaming FIR filter based on the overlap-save method. The filter spectrum is computed once per FFT length and
+ * the last filter length - 1 input samples of every channel are kept as state, so that consecutive blocks of
+ * arbitrary size are filtered as one continuous signal. The picked channels are gathered into one contiguous,
+ * channel-major work matrix. Large blocks are split into ranges of channels, which are filtered in parallel
+ * through UTILSLIB::ParallelExecutor, each thread with its own FFT object and frame buffers.
+ *
+ * @brief Streaming overlap-save FIR filter.
+ */
+template<typename T>
+class OverlapSaveFilter
+{
+public:
+    typedef Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>    MatrixT;    /**< Data matrix type. */
+    typedef Eigen::Matrix<T, Eigen::Dynamic, 1>                 VectorT;    /**< Time domain frame type. */
+    typedef Eigen::Matrix<std::complex<T>, Eigen::Dynamic, 1>   VectorCT;   /**< Frequency domain frame type. */
+
+    //=========================================================================================================
+    /**
+     * Constructs an OverlapSaveFilter without a filter. filter() does not touch the data until setFilter was called.
+     */
+    OverlapSaveFilter();
+
+    //=========================================================================================================
+    /**
+     * Sets the filters to apply. Multiple filters are applied in cascade, i.e. their spectra are multiplied.
+     * The state is only reset if the coefficients differ from the current ones.
+     *
+     * @param [in] lFilterData   The filters to apply.
+     *
+     * @return true if the filter changed, false otherwise.
+     */
+    bool setFilter(const QList<UTILSLIB::FilterData>& lFilterData);
+
+    //=========================================================================================================
+    /**
+     * Resets the channel states, i.e. the next block is filtered as if it was preceded by zeros.
+     */
+    void reset();
+
+    //=========================================================================================================
+    /**
+     * Filters the picked rows of a block and writes them to the same rows of the output. The block is assumed to
+     * directly follow the block of the previous call. A change of the picks resets the state.
+     *
+     * @param [in] matDataIn     The data block (channels x samples).
+     * @param [in] vecPicks      The rows to filter.
+     * @param [out] matDataOut   The output, must have the size of matDataIn. Only the picked rows are written.
+     */
+    void filter(const MatrixT& matDataIn,
+                const Eigen::RowVectorXi& vecPicks,
+                MatrixT& matDataOut);
+
+    //=========================================================================================================
+    /**
+     * Returns the length of the (cascaded) filter impulse response.
+     *
+     * @return the filter length, 0 if no filter was set.
+     */
+    inline int filterLength() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the FFT length currently used.
+     *
+     * @return the FFT length, 0 if no block has been filtered yet.
+     */
+    inline int fftLength() const;
+
+private:
+    //=========================================================================================================
+    /**
+     * Chooses the FFT length for blocks of the given size and recomputes the filter spectrum if it changes.
+     * Small blocks get a short FFT, large blocks are split into hops of about three filter lengths. The
+     * length is kept as long as it is neither too short nor more than four times too long.
+     *
+     * @param [in] iNumSamples   The number of samples of the block.
+     */
+    void updateFFTLength(int iNumSamples);
+
+    //=========================================================================================================
+    /**
+     * The FFT object and frame buffers of one filtering thread.
+     */
+    struct Workspace
+    {
+        Eigen::FFT<T>   fft;            /**< The FFT object, keeps the plans/twiddles between the calls. */
+        VectorT         vecFrame;       /**< The time domain frame. */
+        VectorT         vecResult;      /**< The filtered time domain frame. */
+        VectorCT        vecFreq;        /**< The frequency domain frame. */
+    };
+
+    //=========================================================================================================
+    /**
+     * Filters a range of the picked channels of m_matWork with the given workspace.
+     *
+     * @param [in] workspace     The workspace of the calling thread.
+     * @param [in] iFirstPick    The first pick to filter.
+     * @param [in] iLastPick     One past the last pick to filter.
+     * @param [in] iNumSamples   The number of samples of the block.
+     * @param [out] matDataOut   The output.
+     */
+    void filterPicks(Workspace& workspace,
+                     int iFirstPick,
+                     int iLastPick,
+                     int iNumSamples,
+                     MatrixT& matDataOut) const;
+
+    static const int s_iMinSamplesPerThread = 1 << 16;    /**< The minimal number of samples worth a thread. */
+
+    QVector<Workspace>          m_vecWorkspaces;    /**< The workspaces, one per filtering thread. */
+    QList<Eigen::RowVectorXd>   m_lCoeffs;          /**< The coefficients of the cascaded filters. */
+    VectorCT                    m_vecSpectrum;      /**< The half spectrum of the cascaded filters for m_iFFTLength. */
+    MatrixT                     m_matHistory;       /**< The last m_iFilterLength - 1 input samples (samples x picks). */
+    MatrixT                     m_matWork;          /**< The history followed by the current block (samples x picks). */
+    Eigen::RowVectorXi          m_vecPicks;         /**< The picks the state belongs to. */
+    int                         m_iFilterLength;    /**< The length of the cascaded filter. */
+    int                         m_iFFTLength;       /**< The current FFT length. */
+};
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+template<typename T>
+OverlapSaveFilter<T>::OverlapSaveFilter()
+: m_vecWorkspaces(1)
+, m_iFilterLength(0)
+, m_iFFTLength(0)
+{
+    m_vecWorkspaces[0].fft.SetFlag(Eigen::FFT<T>::HalfSpectrum);
+}
+
+//=============================================================================================================
+
+template<typename T>
+bool OverlapSaveFilter<T>::setFilter(const QList<UTILSLIB::FilterData>& lFilterData)
+{
+    bool bChanged = lFilterData.size() != m_lCoeffs.size();
+
+    for(int i = 0; !bChanged && i < lFilterData.size(); ++i) {
+        const Eigen::RowVectorXd& vecCoeffs = lFilterData.at(i).m_dCoeffA;
+        bChanged = vecCoeffs.cols() != m_lCoeffs.at(i).cols() || vecCoeffs != m_lCoeffs.at(i);
+    }
+
+    if(!bChanged) {
+        return false;
+    }
+
+    m_lCoeffs.clear();
+    m_iFilterLength = 0;
+
+    for(int i = 0; i < lFilterData.size(); ++i) {
+        if(lFilterData.at(i).m_dCoeffA.cols() > 0) {
+            m_lCoeffs.append(lFilterData.at(i).m_dCoeffA);
+            m_iFilterLength += lFilterData.at(i).m_dCoeffA.cols() - (m_iFilterLength > 0 ? 1 : 0);
+        }
+    }
+
+    m_iFFTLength = 0;
+    reset();
+
+    return true;
+}
+
+//=============================================================================================================
+
+template<typename T>
+void OverlapSaveFilter<T>::reset()
+{
+    m_matHistory.resize(0,0);
+}
+
+//=============================================================================================================
+
+template<typename T>
+void OverlapSaveFilter<T>::filter(const MatrixT& matDataIn,
+                                  const Eigen::RowVectorXi& vecPicks,
+                                  MatrixT& matDataOut)
+{
+    const int iNumSamples = matDataIn.cols();
+    const int iNumPicks = vecPicks.cols();
+
+    if(m_iFilterLength == 0 || iNumSamples == 0 || iNumPicks == 0) {
+        return;
+    }
+
+    if(vecPicks.cols() != m_vecPicks.cols() || vecPicks != m_vecPicks) {
+        m_vecPicks = vecPicks;
+        reset();
+    }
+
+    const int iHistory = m_iFilterLength - 1;
+
+    if(m_matHistory.rows() != iHistory || m_matHistory.cols() != iNumPicks) {
+        m_matHistory = MatrixT::Zero(iHistory, iNumPicks);
+    }
+
+    updateFFTLength(iNumSamples);
+
+    // Gather the picked channels behind their history, one contiguous column per channel
+    m_matWork.resize(iHistory + iNumSamples, iNumPicks);
+    m_matWork.topRows(iHistory) = m_matHistory;
+    for(int c = 0; c < iNumPicks; ++c) {
+        m_matWork.col(c).tail(iNumSamples) = matDataIn.row(vecPicks[c]).transpose();
+    }
+
+    // Split the picks across threads once the block is large enough to pay for them
+    int iNumThreads = static_cast<int>(qMin<qint64>(iNumPicks, static_cast<qint64>(iNumPicks) * m_matWork.rows() / s_iMinSamplesPerThread));
+    iNumThreads = UTILSLIB::ParallelExecutor::threadCount(qMax(1, iNumThreads));
+
+    while(m_vecWorkspaces.size() < iNumThreads) {
+        m_vecWorkspaces.append(Workspace());
+        m_vecWorkspaces.last().fft.SetFlag(Eigen::FFT<T>::HalfSpectrum);
+    }
+
+    Workspace* pWorkspaces = m_vecWorkspaces.data();
+
+    if(iNumThreads == 1) {
+        filterPicks(pWorkspaces[0], 0, iNumPicks, iNumSamples, matDataOut);
+    } else {
+        UTILSLIB::ParallelExecutor::run([&](int iThread, int iThreads) {
+            filterPicks(pWorkspaces[iThread],
+                        iNumPicks * iThread / iThreads,
+                        iNumPicks * (iThread + 1) / iThreads,
+                        iNumSamples,
+                        matDataOut);
+        }, iNumThreads);
+    }
+
+    m_matHistory = m_matWork.bottomRows(iHistory);
+}
+
+//=============================================================================================================
+
+template<typename T>
+void OverlapSaveFilter<T>::filterPicks(Workspace& workspace,
+                                       int iFirstPick,
+                                       int iLastPick,
+                                       int iNumSamples,
+                                       MatrixT& matDataOut) const
+{
+    // Every frame holds the history of the hop followed by the hop. The first iHistory samples of the circular
+    // convolution are wrapped around and discarded, the last iHop samples are the linear convolution.
+    const int iHistory = m_iFilterLength - 1;
+    const int iHop = m_iFFTLength - iHistory;
+
+    workspace.vecFrame.resize(m_iFFTLength);
+
+    for(int c = iFirstPick; c < iLastPick; ++c) {
+        for(int iPos = 0; iPos < iNumSamples; iPos += iHop) {
+            int iLength = qMin(iHop, iNumSamples - iPos);
+            int iFrame = iHistory + iLength;
+
+            workspace.vecFrame.head(m_iFFTLength - iFrame).setZero();
+            workspace.vecFrame.tail(iFrame) = m_matWork.col(c).segment(iPos, iFrame);
+
+            workspace.fft.fwd(workspace.vecFreq, workspace.vecFrame);
+            workspace.vecFreq.array() *= m_vecSpectrum.array();
+            workspace.fft.inv(workspace.vecResult, workspace.vecFreq, m_iFFTLength);
+
+            matDataOut.row(m_vecPicks[c]).segment(iPos, iLength) = workspace.vecResult.tail(iLength).transpose();
+        }
+    }
+}
+
+//=============================================================================================================
+
+template<typename T>
+inline int OverlapSaveFilter<T>::filterLength() const
+{
+    return m_iFilterLength;
+}
+
+//=============================================================================================================
+
+template<typename T>
+inline int OverlapSaveFilter<T>::fftLength() const
+{
+    return m_iFFTLength;
+}
+
+//=============================================================================================================
+
+template<typename T>
+void OverlapSaveFilter<T>::updateFFTLength(int iNumSamples)
+{
+    const int iHistory = m_iFilterLength - 1;
+    int iFFTLength = 2;
+    while(iFFTLength < iHistory + qMin(iNumSamples, 3 * m_iFilterLength)) {
+        iFFTLength *= 2;
+    }
+
+    if(m_iFFTLength != 0 && iFFTLength <= m_iFFTLength && 4 * iFFTLength > m_iFFTLength) {
+        return;
+    }
+
+    m_iFFTLength = iFFTLength;
+
+    VectorT vecCoeffs = VectorT::Zero(m_iFFTLength);
+    VectorCT vecSpectrum;
+
+    for(int i = 0; i < m_lCoeffs.size(); ++i) {
+        vecCoeffs.head(m_lCoeffs.at(i).cols()) = m_lCoeffs.at(i).transpose().template cast<T>();
+        m_vecWorkspaces[0].fft.fwd(vecSpectrum, vecCoeffs);
+        vecCoeffs.setZero();
+
+        if(i == 0) {
+            m_vecSpectrum = vecSpectrum;
+        } else {
+            m_vecSpectrum.array() *= vecSpectrum.array();
+        }
+    }
+}
+} // NAMESPACE RTPROCESSINGLIB
+
+#endif // OVERLAPSAVEFILTER_H
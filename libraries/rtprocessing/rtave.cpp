@@ -65,6 +65,173 @@ using namespace UTILSLIB;
 using namespace Eigen;
 using namespace MNELIB;
 
+//=============================================================================================================
+// DEFINE MEMBER METHODS RunningAverage
+//=============================================================================================================
+
+RunningAverage::RunningAverage(int iMaxEpochs,
+                               bool bComputeVariance)
+: m_iMaxEpochs(qMax(1, iMaxEpochs))
+, m_iNextSlot(0)
+, m_iCount(0)
+, m_iUpdatesSinceResum(0)
+, m_bComputeVariance(bComputeVariance)
+{
+}
+
+//=============================================================================================================
+
+void RunningAverage::append(const MatrixXd& matEpoch)
+{
+    if(m_iCount > 0 && (matEpoch.rows() != m_matSum.rows() || matEpoch.cols() != m_matSum.cols())) {
+        m_iCount = 0;
+        m_iNextSlot = 0;
+    }
+
+    //Allocate all ring slots once, later epochs are copied into the existing storage
+    if(m_iCount == 0) {
+        m_vecEpochs.resize(m_iMaxEpochs);
+        for(int i = 0; i < m_vecEpochs.size(); ++i) {
+            m_vecEpochs[i].resize(matEpoch.rows(), matEpoch.cols());
+        }
+
+        m_matSum = MatrixXd::Zero(matEpoch.rows(), matEpoch.cols());
+        m_matSumSquares = m_bComputeVariance ? MatrixXd::Zero(matEpoch.rows(), matEpoch.cols()) : MatrixXd();
+        m_iUpdatesSinceResum = 0;
+    }
+
+    MatrixXd& matSlot = m_vecEpochs[m_iNextSlot];
+
+    if(m_iCount == m_iMaxEpochs) {
+        m_matSum -= matSlot;
+        if(m_bComputeVariance) {
+            m_matSumSquares -= matSlot.cwiseAbs2();
+        }
+    } else {
+        ++m_iCount;
+    }
+
+    matSlot = matEpoch;
+
+    m_matSum += matSlot;
+    if(m_bComputeVariance) {
+        m_matSumSquares += matSlot.cwiseAbs2();
+    }
+
+    m_iNextSlot = (m_iNextSlot + 1) % m_iMaxEpochs;
+
+    //A full recomputation every m_iMaxEpochs updates keeps the cost per trial at O(channels x samples)
+    if(++m_iUpdatesSinceResum >= m_iMaxEpochs) {
+        resum();
+    }
+}
+
+//=============================================================================================================
+
+void RunningAverage::setMaxEpochs(int iMaxEpochs)
+{
+    iMaxEpochs = qMax(1, iMaxEpochs);
+
+    if(iMaxEpochs == m_iMaxEpochs) {
+        return;
+    }
+
+    //Reorder the kept epochs from oldest to newest into a ring of the new size
+    int iKeep = qMin(m_iCount, iMaxEpochs);
+    int iOldest = (m_iNextSlot - iKeep + m_iMaxEpochs) % m_iMaxEpochs;
+
+    QVector<MatrixXd> vecEpochs(iMaxEpochs);
+    for(int i = 0; i < iKeep; ++i) {
+        vecEpochs[i].swap(m_vecEpochs[(iOldest + i) % m_iMaxEpochs]);
+    }
+    for(int i = iKeep; i < iMaxEpochs; ++i) {
+        vecEpochs[i].resize(m_matSum.rows(), m_matSum.cols());
+    }
+
+    m_vecEpochs.swap(vecEpochs);
+    m_iMaxEpochs = iMaxEpochs;
+    m_iCount = iKeep;
+    m_iNextSlot = iKeep % m_iMaxEpochs;
+
+    resum();
+}
+
+//=============================================================================================================
+
+void RunningAverage::setComputeVariance(bool bComputeVariance)
+{
+    if(bComputeVariance == m_bComputeVariance) {
+        return;
+    }
+
+    m_bComputeVariance = bComputeVariance;
+    resum();
+}
+
+//=============================================================================================================
+
+MatrixXd RunningAverage::mean() const
+{
+    if(m_iCount == 0) {
+        return MatrixXd();
+    }
+
+    return m_matSum / m_iCount;
+}
+
+//=============================================================================================================
+
+MatrixXd RunningAverage::variance() const
+{
+    if(!m_bComputeVariance || m_iCount < 2) {
+        return MatrixXd::Zero(m_matSum.rows(), m_matSum.cols());
+    }
+
+    MatrixXd matVariance = (m_matSumSquares - m_matSum.cwiseAbs2() / m_iCount) / (m_iCount - 1);
+
+    return matVariance.cwiseMax(0.0);
+}
+
+//=============================================================================================================
+
+MatrixXd RunningAverage::snr() const
+{
+    MatrixXd matVariance = variance();
+
+    if(m_iCount < 2) {
+        return matVariance;
+    }
+
+    ArrayXXd arrayStdErr = (matVariance.array() / m_iCount).sqrt();
+
+    return (arrayStdErr > 0.0).select(mean().array().abs() / arrayStdErr, 0.0).matrix();
+}
+
+//=============================================================================================================
+
+void RunningAverage::resum()
+{
+    m_iUpdatesSinceResum = 0;
+
+    if(m_iCount == 0) {
+        return;
+    }
+
+    m_matSum.setZero();
+    for(int i = 0; i < m_iCount; ++i) {
+        m_matSum += m_vecEpochs.at(i);
+    }
+
+    if(m_bComputeVariance) {
+        m_matSumSquares = MatrixXd::Zero(m_matSum.rows(), m_matSum.cols());
+        for(int i = 0; i < m_iCount; ++i) {
+            m_matSumSquares += m_vecEpochs.at(i).cwiseAbs2();
+        }
+    } else {
+        m_matSumSquares.resize(0, 0);
+    }
+}
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS RtAveWorker
 //=============================================================================================================
@@ -85,6 +252,7 @@ RtAveWorker::RtAveWorker(quint32 numAverages,
 , m_iTriggerChIndex(-1)
 , m_iNewTriggerIndex(iTriggerIndex)
 , m_bDoBaselineCorrection(false)
+, m_bComputeVariance(false)
 , m_pairBaselineSec(qMakePair(QVariant(QString::number(iBaselineFromSecs)),QVariant(QString::number(iBaselineToSecs))))
 , m_bActivateThreshold(false)
 {
@@ -125,22 +293,12 @@ void RtAveWorker::setAverageNumber(qint32 numAve)
         return;
     }
 
-    if(numAve < m_iNumAverages) {
-        int iDiff = m_iNumAverages - numAve;
-
-        //Do averaging for each trigger type
-        QMutableMapIterator<double,QList<Eigen::MatrixXd> > idx(m_mapStimAve);
+    //Resize the epoch ring of each trigger type, the most recent epochs are kept
+    QMutableMapIterator<double,RunningAverage> idx(m_mapStimAve);
 
-        while(idx.hasNext()) {
-            idx.next();
-
-            if(idx.value().size() > iDiff) {
-                //Pop data from buffer
-                for(int i = 0; i < iDiff; ++i) {
-                    idx.value().pop_front();
-                }
-            }
-        }
+    while(idx.hasNext()) {
+        idx.next();
+        idx.value().setMaxEpochs(numAve);
     }
 
     m_iNumAverages = numAve;
@@ -352,6 +510,14 @@ void RtAveWorker::emitEvoked(double dTriggerType, QStringList& lResponsibleTrigg
         emit resultReady(m_stimEvokedSet, lResponsibleTriggerTypes);
     }
 
+    QMap<double,RunningAverage>::const_iterator itAve = m_mapStimAve.constFind(dTriggerType);
+
+    if(m_bComputeVariance && itAve != m_mapStimAve.constEnd() && !itAve->isEmpty()) {
+        emit statisticsReady(dTriggerType,
+                             itAve->variance(),
+                             itAve->snr());
+    }
+
 //    qDebug()<<"RtAveWorker::emitEvoked() - dTriggerType:" << dTriggerType;
 //    qDebug()<<"RtAveWorker::emitEvoked() - m_mapStimAve[dTriggerType].size():" << m_mapStimAve[dTriggerType].size();
 }
@@ -437,16 +603,12 @@ void RtAveWorker::mergeData(double dTriggerType)
     }
 
     if(!bArtifactDetected) {
-        //Add cut data to average buffer
-        m_mapStimAve[dTriggerType].append(mergedData);
-
-        //Pop data from buffer
-        int iDiff =  m_mapStimAve[dTriggerType].size() - m_iNumAverages;
-        if(iDiff > 0) {
-            for(int i = 0; i < iDiff; ++i) {
-                m_mapStimAve[dTriggerType].pop_front();
-            }
+        if(!m_mapStimAve.contains(dTriggerType)) {
+            m_mapStimAve.insert(dTriggerType, RunningAverage(m_iNumAverages, m_bComputeVariance));
         }
+
+        //Add cut data to average buffer, this evicts the oldest epoch once m_iNumAverages is reached
+        m_mapStimAve[dTriggerType].append(mergedData);
     }
 }
 
@@ -454,7 +616,10 @@ void RtAveWorker::mergeData(double dTriggerType)
 
 void RtAveWorker::generateEvoked(double dTriggerType)
 {
-    if(m_mapStimAve[dTriggerType].isEmpty()) {
+    //Look up without operator[], which would insert an empty average and hide the trigger type from mergeData
+    QMap<double,RunningAverage>::const_iterator itAve = m_mapStimAve.constFind(dTriggerType);
+
+    if(itAve == m_mapStimAve.constEnd() || itAve->isEmpty()) {
         qDebug() << "RtAveWorker::generateEvoked - m_mapStimAve is empty for type" << dTriggerType << "Returning.";
         return;
     }
@@ -486,16 +651,8 @@ void RtAveWorker::generateEvoked(double dTriggerType)
         evoked.comment = QString::number(dTriggerType);
     }
 
-    // Generate final evoked
-    MatrixXd finalAverage = MatrixXd::Zero(m_mapStimAve[dTriggerType].first().rows(), m_iPreStimSamples+m_iPostStimSamples);
-
-    for(int i = 0; i < m_mapStimAve[dTriggerType].size(); ++i) {
-        finalAverage += m_mapStimAve[dTriggerType].at(i);
-    }
-
-    if(!m_mapStimAve[dTriggerType].isEmpty()) {
-        finalAverage = finalAverage/m_mapStimAve[dTriggerType].size();
-    }
+    // Generate final evoked from the running sum
+    MatrixXd finalAverage = itAve->mean();
 
     if(m_bDoBaselineCorrection) {
         finalAverage = MNEMath::rescale(finalAverage, evoked.times, m_pairBaselineSec, QString("mean"));
@@ -503,7 +660,7 @@ void RtAveWorker::generateEvoked(double dTriggerType)
 
     evoked.data = finalAverage;
 
-    evoked.nave = m_mapStimAve[dTriggerType].size();
+    evoked.nave = itAve->count();
 
     //Add new data to evoked data set
     if(iEvokedIdx != -1) {
@@ -517,6 +674,20 @@ void RtAveWorker::generateEvoked(double dTriggerType)
 
 //=============================================================================================================
 
+void RtAveWorker::setVarianceActive(bool activate)
+{
+    m_bComputeVariance = activate;
+
+    QMutableMapIterator<double,RunningAverage> idx(m_mapStimAve);
+
+    while(idx.hasNext()) {
+        idx.next();
+        idx.value().setComputeVariance(activate);
+    }
+}
+
+//=============================================================================================================
+
 void RtAveWorker::reset()
 {
     //Reset
@@ -569,6 +740,8 @@ RtAve::RtAve(quint32 numAverages,
 
     connect(worker, &RtAveWorker::resultReady,
             this, &RtAve::handleResults, Qt::DirectConnection);
+    connect(worker, &RtAveWorker::statisticsReady,
+            this, &RtAve::handleStatistics, Qt::DirectConnection);
 
     connect(this, &RtAve::averageNumberChanged,
             worker, &RtAveWorker::setAverageNumber);
@@ -586,6 +759,8 @@ RtAve::RtAve(quint32 numAverages,
             worker, &RtAveWorker::setBaselineFrom);
     connect(this, &RtAve::averageBaselineToChanged,
             worker, &RtAveWorker::setBaselineTo);
+    connect(this, &RtAve::averageVarianceActiveChanged,
+            worker, &RtAveWorker::setVarianceActive);
     connect(this, &RtAve::averageResetRequested,
             worker, &RtAveWorker::reset);
 
@@ -617,6 +792,17 @@ void RtAve::handleResults(const FiffEvokedSet& evokedStimSet,
 
 //=============================================================================================================
 
+void RtAve::handleStatistics(double dTriggerType,
+                             const MatrixXd& matVariance,
+                             const MatrixXd& matSnr)
+{
+    emit evokedStatistics(dTriggerType,
+                          matVariance,
+                          matSnr);
+}
+
+//=============================================================================================================
+
 void RtAve::restart(quint32 numAverages,
                     quint32 iPreStimSamples,
                     quint32 iPostStimSamples,
@@ -644,6 +830,8 @@ void RtAve::restart(quint32 numAverages,
 
     connect(worker, &RtAveWorker::resultReady,
             this, &RtAve::handleResults, Qt::DirectConnection);
+    connect(worker, &RtAveWorker::statisticsReady,
+            this, &RtAve::handleStatistics, Qt::DirectConnection);
 
     connect(this, &RtAve::averageNumberChanged,
             worker, &RtAveWorker::setAverageNumber);
@@ -661,6 +849,8 @@ void RtAve::restart(quint32 numAverages,
             worker, &RtAveWorker::setBaselineFrom);
     connect(this, &RtAve::averageBaselineToChanged,
             worker, &RtAveWorker::setBaselineTo);
+    connect(this, &RtAve::averageVarianceActiveChanged,
+            worker, &RtAveWorker::setVarianceActive);
     connect(this, &RtAve::averageResetRequested,
             worker, &RtAveWorker::reset);
 
@@ -742,6 +932,13 @@ void RtAve::setBaselineTo(int toSamp, int toMSec)
 
 //=============================================================================================================
 
+void RtAve::setVarianceActive(bool activate)
+{
+    emit averageVarianceActiveChanged(activate);
+}
+
+//=============================================================================================================
+
 void RtAve::reset()
 {
     emit averageResetRequested();
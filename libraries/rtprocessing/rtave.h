@@ -52,6 +52,7 @@
 #include <QThread>
 #include <QSharedPointer>
 #include <QObject>
+#include <QVector>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -74,6 +75,111 @@ namespace RTPROCESSINGLIB
 // RTPROCESSINGLIB FORWARD DECLARATIONS
 //=============================================================================================================
 
+//=============================================================================================================
+/**
+ * Keeps the most recent epochs of one trigger type in a preallocated ring together with their running sum and,
+ * optionally, their running sum of squares. Appending an epoch adds it to the sums and subtracts the evicted one,
+ * so the cost per trial does not depend on the number of averages.
+ *
+ * @brief Running average over a ring of epochs
+ */
+class RTPROCESINGSHARED_EXPORT RunningAverage
+{
+public:
+    //=========================================================================================================
+    /**
+     * Creates the running average.
+     *
+     * @param[in] iMaxEpochs         Number of epochs to average
+     * @param[in] bComputeVariance   Whether to keep the sum of squares for variance and SNR
+     */
+    explicit RunningAverage(int iMaxEpochs = 1,
+                            bool bComputeVariance = false);
+
+    //=========================================================================================================
+    /**
+     * Appends an epoch. The oldest epoch is evicted once the number of averages is reached. An epoch of a different
+     * shape than the stored ones restarts the average.
+     *
+     * @param[in] matEpoch   The epoch (channels x samples)
+     */
+    void append(const Eigen::MatrixXd& matEpoch);
+
+    //=========================================================================================================
+    /**
+     * Sets the number of averages. The most recent epochs are kept.
+     *
+     * @param[in] iMaxEpochs     New number of averages
+     */
+    void setMaxEpochs(int iMaxEpochs);
+
+    //=========================================================================================================
+    /**
+     * Enables or disables the variance and SNR computation.
+     *
+     * @param[in] bComputeVariance   Whether to keep the sum of squares
+     */
+    void setComputeVariance(bool bComputeVariance);
+
+    //=========================================================================================================
+    /**
+     * Returns the number of stored epochs.
+     *
+     * @return the number of stored epochs.
+     */
+    inline int count() const;
+
+    //=========================================================================================================
+    /**
+     * Returns whether no epoch is stored.
+     *
+     * @return true if no epoch is stored.
+     */
+    inline bool isEmpty() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the average of the stored epochs.
+     *
+     * @return the average.
+     */
+    Eigen::MatrixXd mean() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the unbiased sample variance of the stored epochs. Zero if the variance computation is disabled or
+     * less than two epochs are stored.
+     *
+     * @return the variance.
+     */
+    Eigen::MatrixXd variance() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the signal to noise ratio, the absolute average divided by its standard error.
+     *
+     * @return the signal to noise ratio.
+     */
+    Eigen::MatrixXd snr() const;
+
+private:
+    //=========================================================================================================
+    /**
+     * Recomputes the sums from the stored epochs, which removes the rounding error the add and subtract updates
+     * accumulate.
+     */
+    void resum();
+
+    QVector<Eigen::MatrixXd>    m_vecEpochs;            /**< The ring of stored epochs. Slots 0 to m_iCount-1 are valid. */
+    Eigen::MatrixXd             m_matSum;               /**< Running sum of the stored epochs. */
+    Eigen::MatrixXd             m_matSumSquares;        /**< Running sum of the squared stored epochs. */
+    int                         m_iMaxEpochs;           /**< Number of averages. */
+    int                         m_iNextSlot;            /**< Ring slot the next epoch is written to. */
+    int                         m_iCount;               /**< Number of stored epochs. */
+    int                         m_iUpdatesSinceResum;   /**< Number of incremental updates since the last resum. */
+    bool                        m_bComputeVariance;     /**< Whether the sum of squares is kept. */
+};
+
 //=============================================================================================================
 /**
  * Real-time averaging worker
@@ -185,6 +291,14 @@ public:
     void setBaselineTo(int toSamp,
                        int toMSec);
 
+    //=========================================================================================================
+    /**
+     * Sets whether the variance and SNR of the averages are computed and emitted via statisticsReady.
+     *
+     * @param[in] activate    Whether to compute the variance and SNR
+     */
+    void setVarianceActive(bool activate);
+
     //=========================================================================================================
     /**
      * Resets the averaged data stored.
@@ -247,6 +361,8 @@ protected:
 
     bool                                            m_bDoBaselineCorrection;    /**< Whether to perform baseline correction. */
 
+    bool                                            m_bComputeVariance;         /**< Whether to compute the variance and SNR of the averages. */
+
     QPair<QVariant,QVariant>                        m_pairBaselineSec;          /**< Baseline information in seconds form where the seconds are seen relative to the trigger, meaning they can also be negative [from to]*/
     QPair<QVariant,QVariant>                        m_pairBaselineSamp;         /**< Baseline information in samples form where the seconds are seen relative to the trigger, meaning they can also be negative [from to]*/
 
@@ -254,7 +370,7 @@ protected:
     FIFFLIB::FiffEvokedSet                          m_stimEvokedSet;            /**< Holds the evoked information. */
 
     QMap<QString,double>                            m_mapThresholds;            /**< Holds the current thresholds for artifact rejection. */
-    QMap<double,QList<Eigen::MatrixXd> >            m_mapStimAve;               /**< the current stimulus average buffer. Holds m_iNumAverages vectors */
+    QMap<double,RunningAverage>                     m_mapStimAve;               /**< the current stimulus average buffer. Holds m_iNumAverages epochs per trigger type */
     QMap<double,Eigen::MatrixXd>                    m_mapDataPre;               /**< The matrix holding pre stim data. */
     QMap<double,Eigen::MatrixXd>                    m_mapDataPost;              /**< The matrix holding post stim data. */
     QMap<double,qint32>                             m_mapMatDataPostIdx;        /**< Current index inside of the matrix m_matDataPost */
@@ -270,6 +386,18 @@ signals:
      */
     void resultReady(const FIFFLIB::FiffEvokedSet& evokedStimSet,
                      const QStringList& lResponsibleTriggerTypes);
+
+    //=========================================================================================================
+    /**
+     * Signal which is emitted with every new evoked if the variance computation is active.
+     *
+     * @param[in] dTriggerType   The trigger type of the average.
+     * @param[in] matVariance    The variance of the averaged epochs (channels x samples).
+     * @param[in] matSnr         The signal to noise ratio of the average (channels x samples).
+     */
+    void statisticsReady(double dTriggerType,
+                         const Eigen::MatrixXd& matVariance,
+                         const Eigen::MatrixXd& matSnr);
 };
 
 //=============================================================================================================
@@ -420,6 +548,14 @@ public:
     void setBaselineTo(int toSamp,
                        int toMSec);
 
+    //=========================================================================================================
+    /**
+     * Sets whether the variance and SNR of the averages are computed and emitted via evokedStatistics.
+     *
+     * @param[in] activate    Whether to compute the variance and SNR
+     */
+    void setVarianceActive(bool activate);
+
     //=========================================================================================================
     /**
      * Reset the data processing in the real-time worker
@@ -434,11 +570,22 @@ protected:
     void handleResults(const FIFFLIB::FiffEvokedSet& evokedStimSet,
                        const QStringList& lResponsibleTriggerTypes);
 
+    //=========================================================================================================
+    /**
+     * Handles the variance and SNR results.
+     */
+    void handleStatistics(double dTriggerType,
+                          const Eigen::MatrixXd& matVariance,
+                          const Eigen::MatrixXd& matSnr);
+
     QThread             m_workerThread;         /**< The worker thread. */
 
 signals:
     void evokedStim(const FIFFLIB::FiffEvokedSet& evokedStimSet,
                     const QStringList& lResponsibleTriggerTypes);
+    void evokedStatistics(double dTriggerType,
+                          const Eigen::MatrixXd& matVariance,
+                          const Eigen::MatrixXd& matSnr);
     void operate(const Eigen::MatrixXd& matData);
     void averageNumberChanged(qint32 numAve);
     void averagePreStimChanged(qint32 samples,
@@ -452,6 +599,7 @@ signals:
                                     int fromMSec);
     void averageBaselineToChanged(int toSamp,
                                   int toMSec);
+    void averageVarianceActiveChanged(bool activate);
     void averageResetRequested();
 };
 
@@ -459,6 +607,20 @@ signals:
 // INLINE DEFINITIONS
 //=============================================================================================================
 
+inline int RunningAverage::count() const
+{
+    return m_iCount;
+}
+
+//=============================================================================================================
+
+inline bool RunningAverage::isEmpty() const
+{
+    return m_iCount == 0;
+}
+
+//=============================================================================================================
+
 inline bool RtAveWorker::controlValuesChanged()
 {
     bool result = false;
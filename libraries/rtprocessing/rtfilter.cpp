@@ -56,18 +56,6 @@ using namespace FIFFLIB;
 
 #include <QDebug>
 
-//=============================================================================================================
-// DEFINE GLOBAL METHODS
-//=============================================================================================================
-
-void doFilterPerChannelRTMSA(QPair<QList<FilterData>,QPair<int,RowVectorXd> > &channelDataTime)
-{
-    for(int i = 0; i < channelDataTime.first.size(); ++i) {
-        //channelDataTime.second.second = channelDataTime.first.at(i).applyConvFilter(channelDataTime.second.second, true, FilterData::ZeroPad);
-        channelDataTime.second.second = channelDataTime.first.at(i).applyFFTFilter(channelDataTime.second.second, true, FilterData::ZeroPad); //FFT Convolution for rt is not suitable. FFT make the signal filtering non causal.
-    }
-}
-
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
@@ -89,56 +77,120 @@ MatrixXd RtFilter::filterDataBlock(const MatrixXd& matDataIn,
                                    const RowVectorXi &vecPicks,
                                    const QList<FilterData>& lFilterData)
 {
-    //Initialise the overlay matrix
-    if(m_matOverlap.cols() != iOrder || m_matOverlap.rows() < matDataIn.rows()) {
-        m_matOverlap.resize(matDataIn.rows(), iOrder);
-        m_matOverlap.setZero();
-    }
-
-    if(m_matDelay.cols() != iOrder/2 || m_matOverlap.rows() < matDataIn.rows()) {
-        m_matDelay.resize(matDataIn.rows(), iOrder/2);
-        m_matDelay.setZero();
-    }
-
-    //Resize output matrix to match input matrix
-    MatrixXd matDataOut = matDataIn;
+    return doFilterDataBlock<double>(matDataIn, iOrder, vecPicks, lFilterData, m_overlapSaveFilter, m_sosFilter, m_matDelay);
+}
 
-    //Generate QList structure which can be handled by the QConcurrent framework
-    QList<QPair<QList<FilterData>,QPair<int,RowVectorXd> > > timeData;
+//=============================================================================================================
 
-    //Only select channels specified in vecPicks
-    for(qint32 i = 0; i < vecPicks.cols(); ++i) {
-        timeData.append(QPair<QList<FilterData>,QPair<int,RowVectorXd> >(lFilterData,QPair<int,RowVectorXd>(vecPicks[i],matDataIn.row(vecPicks[i]))));
-    }
+MatrixXf RtFilter::filterDataBlock(const MatrixXf& matDataIn,
+                                   int iOrder,
+                                   const RowVectorXi &vecPicks,
+                                   const QList<FilterData>& lFilterData)
+{
+    return doFilterDataBlock<float>(matDataIn, iOrder, vecPicks, lFilterData, m_overlapSaveFilterFloat, m_sosFilterFloat, m_matDelayFloat);
+}
 
-    //Do the concurrent filtering
-    if(!timeData.isEmpty()) {
-        QFuture<void> future = QtConcurrent::map(timeData,
-                                             doFilterPerChannelRTMSA);
+//=============================================================================================================
 
-        future.waitForFinished();
+MatrixXd RtFilter::filterData(const MatrixXd& matDataIn,
+                              FilterData::FilterType type,
+                              double dCenterfreq,
+                              double bandwidth,
+                              double dTransition,
+                              double dSFreq,
+                              const RowVectorXi& vecPicks,
+                              int iOrder,
+                              qint32 iFftLength,
+                              FilterData::DesignMethod designMethod)
+{
+    return doFilterData<double>(matDataIn,
+                                type,
+                                dCenterfreq,
+                                bandwidth,
+                                dTransition,
+                                dSFreq,
+                                vecPicks,
+                                iOrder,
+                                iFftLength,
+                                designMethod,
+                                m_overlapSaveFilter,
+                                m_sosFilter,
+                                m_matDelay);
+}
 
-        //Do the overlap add method and store in matDataOut
-        int iFilteredNumberCols = timeData.at(0).second.second.cols();
+//=============================================================================================================
 
-        for(int r = 0; r < timeData.size(); r++) {
-            //Get the currently filtered data. This data has a delay of filterLength/2 in front and back.
-            RowVectorXd tempData = timeData.at(r).second.second;
+MatrixXf RtFilter::filterData(const MatrixXf& matDataIn,
+                              FilterData::FilterType type,
+                              double dCenterfreq,
+                              double bandwidth,
+                              double dTransition,
+                              double dSFreq,
+                              const RowVectorXi& vecPicks,
+                              int iOrder,
+                              qint32 iFftLength,
+                              FilterData::DesignMethod designMethod)
+{
+    return doFilterData<float>(matDataIn,
+                               type,
+                               dCenterfreq,
+                               bandwidth,
+                               dTransition,
+                               dSFreq,
+                               vecPicks,
+                               iOrder,
+                               iFftLength,
+                               designMethod,
+                               m_overlapSaveFilterFloat,
+                               m_sosFilterFloat,
+                               m_matDelayFloat);
+}
 
-            //Perform the actual overlap add by adding the last filterlength data to the newly filtered one
-            tempData.head(iOrder) += m_matOverlap.row(timeData.at(r).second.first);
+//=============================================================================================================
 
-            //Write the newly calulated filtered data to the filter data matrix. Keep in mind that the current block also effect last part of the last block (begin at dataIndex-iFilterDelay).
-            int start = 0;
-            matDataOut.row(timeData.at(r).second.first).segment(start,iFilteredNumberCols-iOrder) = tempData.head(iFilteredNumberCols-iOrder);
+template<typename T>
+Matrix<T,Dynamic,Dynamic> RtFilter::doFilterDataBlock(const Matrix<T,Dynamic,Dynamic>& matDataIn,
+                                                      int iOrder,
+                                                      const RowVectorXi &vecPicks,
+                                                      const QList<FilterData>& lFilterData,
+                                                      OverlapSaveFilter<T>& overlapSaveFilter,
+                                                      SosFilter<T>& sosFilter,
+                                                      Matrix<T,Dynamic,Dynamic>& matDelay)
+{
+    if(matDelay.cols() != iOrder/2 || matDelay.rows() < matDataIn.rows()) {
+        matDelay.resize(matDataIn.rows(), iOrder/2);
+        matDelay.setZero();
+    }
 
-            //Refresh the m_matOverlap with the new calculated filtered data.
-            m_matOverlap.row(timeData.at(r).second.first) = timeData.at(r).second.second.tail(iOrder);
+    //Resize output matrix to match input matrix
+    Matrix<T,Dynamic,Dynamic> matDataOut = matDataIn;
+
+    //Separate the FIR designs from the IIR designs
+    QList<FilterData> lFirFilterData, lIirFilterData;
+    for(int i = 0; i < lFilterData.size(); ++i) {
+        if(lFilterData.at(i).m_matSos.rows() > 0) {
+            lIirFilterData << lFilterData.at(i);
+        } else {
+            lFirFilterData << lFilterData.at(i);
         }
     }
 
+    //The spectra are only recomputed and the channel states only reset if the filter changed
+    overlapSaveFilter.setFilter(lFirFilterData);
+    sosFilter.setFilter(lIirFilterData);
+
+    //Do the overlap save filtering of the picked channels and store in matDataOut
+    overlapSaveFilter.filter(matDataIn,
+                             vecPicks,
+                             matDataOut);
+
+    //Run the IIR filters on the result, sample by sample
+    sosFilter.filter(matDataOut,
+                     vecPicks,
+                     matDataOut);
+
     if(matDataIn.cols() >= iOrder/2) {
-        m_matDelay = matDataIn.block(0, matDataIn.cols()-iOrder/2, matDataIn.rows(), iOrder/2);
+        matDelay = matDataIn.block(0, matDataIn.cols()-iOrder/2, matDataIn.rows(), iOrder/2);
     } else {
             qWarning() << "RtFilter::filterDataBlock - Half of filter length is larger than data size. Not filling m_matDelay for next step.";
     }
@@ -148,16 +200,20 @@ MatrixXd RtFilter::filterDataBlock(const MatrixXd& matDataIn,
 
 //=============================================================================================================
 
-MatrixXd RtFilter::filterData(const MatrixXd& matDataIn,
-                              FilterData::FilterType type,
-                              double dCenterfreq,
-                              double bandwidth,
-                              double dTransition,
-                              double dSFreq,
-                              const RowVectorXi& vecPicks,
-                              int iOrder,
-                              qint32 iFftLength,
-                              FilterData::DesignMethod designMethod)
+template<typename T>
+Matrix<T,Dynamic,Dynamic> RtFilter::doFilterData(const Matrix<T,Dynamic,Dynamic>& matDataIn,
+                                                 FilterData::FilterType type,
+                                                 double dCenterfreq,
+                                                 double bandwidth,
+                                                 double dTransition,
+                                                 double dSFreq,
+                                                 const RowVectorXi& vecPicks,
+                                                 int iOrder,
+                                                 qint32 iFftLength,
+                                                 FilterData::DesignMethod designMethod,
+                                                 OverlapSaveFilter<T>& overlapSaveFilter,
+                                                 SosFilter<T>& sosFilter,
+                                                 Matrix<T,Dynamic,Dynamic>& matDelay)
 {
     // Check for size of data
     if (matDataIn.cols()<iOrder){
@@ -170,8 +226,8 @@ MatrixXd RtFilter::filterData(const MatrixXd& matDataIn,
     dTransition = dTransition/(dSFreq/2.0);
 
     // create output matrix with size of inputmatrix and temporal input matrix with size of pick
-    MatrixXd matDataOut = matDataIn;
-    MatrixXd sliceFiltered;
+    Matrix<T,Dynamic,Dynamic> matDataOut = matDataIn;
+    Matrix<T,Dynamic,Dynamic> sliceFiltered;
     // create filter
     FilterData filter = FilterData("rt_filter",
                                    type,
@@ -198,18 +254,24 @@ MatrixXd RtFilter::filterData(const MatrixXd& matDataIn,
                 //catch the last one that might be shorter then original size
                 iSize = matDataIn.cols() - (iSize * (numSlices -1));
             }
-            sliceFiltered = filterDataBlock(matDataIn.block(0,from,matDataIn.rows(),iSize),
-                                            iOrder,
-                                            vecPicks,
-                                            filterList);
+            sliceFiltered = doFilterDataBlock<T>(matDataIn.block(0,from,matDataIn.rows(),iSize),
+                                                 iOrder,
+                                                 vecPicks,
+                                                 filterList,
+                                                 overlapSaveFilter,
+                                                 sosFilter,
+                                                 matDelay);
             matDataOut.block(0,from,matDataIn.rows(),iSize) = sliceFiltered;
             from += iSize;
         }
     } else {
-        matDataOut = filterDataBlock(matDataIn,
-                                    iOrder,
-                                    vecPicks,
-                                    filterList);
+        matDataOut = doFilterDataBlock<T>(matDataIn,
+                                          iOrder,
+                                          vecPicks,
+                                          filterList,
+                                          overlapSaveFilter,
+                                          sosFilter,
+                                          matDelay);
     }
     return matDataOut;
 }
@@ -41,6 +41,8 @@
 //=============================================================================================================
 
 #include "rtprocessing_global.h"
+#include "overlapsavefilter.h"
+#include "sosfilter.h"
 
 #include <utils/filterTools/filterdata.h>
 #include <fiff/fiff_info.h>
@@ -98,7 +100,8 @@ public:
 
     //=========================================================================================================
     /**
-     * Calculates the filtered version of the raw input data
+     * Calculates the filtered version of the raw input data. Consecutive calls are treated as one continuous
+     * stream, see OverlapSaveFilter.
      *
      * @param [in] matDataIn The data which is to be filtered
      * @param [in] iOrder The maximum filterlength, sames as filter order(FIR)
@@ -112,6 +115,23 @@ public:
                                                const Eigen::RowVectorXi& vecPicks,
                                                const QList<UTILSLIB::FilterData> &lFilterData);
 
+    //=========================================================================================================
+    /**
+     * Calculates the filtered version of the raw input data in single precision. The overlap and delay state is
+     * kept separately from the double precision version.
+     *
+     * @param [in] matDataIn The data which is to be filtered
+     * @param [in] iOrder The maximum filterlength, sames as filter order(FIR)
+     * @param [in] vecPicks The used channel as index in RowVector
+     * @param [in] lFilterData The FilterData generated by filterobject from utilslib
+     *
+     * @return The filtered data in form of a matrix.
+     */
+    Eigen::MatrixXf filterDataBlock(const Eigen::MatrixXf& matDataIn,
+                                    int iOrder,
+                                    const Eigen::RowVectorXi& vecPicks,
+                                    const QList<UTILSLIB::FilterData> &lFilterData);
+
     /**
      * Calculates the filtered version of the raw input data AND creates filter
      *
@@ -125,7 +145,8 @@ public:
      * @param [in] vecPicks - used channel as index in QVector
      * @param [in] iOrder represents the order of the filter, the higher the higher is the stopband attenuation
      * @param [in] iFftLength length of the fft (multiple integer of 2^x) - Default = 4096
-     * @param [in] designMethod specifies the design method to use. Choose between Cosind and Tschebyscheff; Defaul = Cosine
+     * @param [in] designMethod specifies the design method to use. Choose between Cosind and Tschebyscheff; Defaul = Cosine. Butterworth
+     *                          gives a causal IIR filter of order iOrder with a few samples of latency, choose a low order (2-8) then.
      *
      * @return The filtered data in form of a matrix.
      */
@@ -141,11 +162,80 @@ public:
                                qint32 iFftLength = 4096,
                                UTILSLIB::FilterData::DesignMethod designMethod = UTILSLIB::FilterData::Cosine);
 
+    //=========================================================================================================
+    /**
+     * Calculates the filtered version of the raw input data in single precision AND creates filter. See the
+     * double precision version for a description of the parameters.
+     *
+     * @return The filtered data in form of a matrix.
+     */
+    Eigen::MatrixXf filterData(const Eigen::MatrixXf& matDataIn,
+                               UTILSLIB::FilterData::FilterType type,
+                               double dCenterfreq,
+                               double dBandwidth,
+                               double dTransition,
+                               double dSFreq,
+                               const Eigen::RowVectorXi &vecPicks = Eigen::RowVectorXi(),
+                               int iOrder = 1024,
+                               qint32 iFftLength = 4096,
+                               UTILSLIB::FilterData::DesignMethod designMethod = UTILSLIB::FilterData::Cosine);
+
 protected:
-    Eigen::MatrixXd                 m_matOverlap;                   /**< Last overlap block */
+    OverlapSaveFilter<double>       m_overlapSaveFilter;            /**< Filter spectra and channel states */
+    SosFilter<double>               m_sosFilter;                    /**< IIR sections and channel states */
     Eigen::MatrixXd                 m_matDelay;                     /**< Last delay block */
+    OverlapSaveFilter<float>        m_overlapSaveFilterFloat;       /**< Filter spectra and channel states of the single precision path */
+    SosFilter<float>                m_sosFilterFloat;               /**< IIR sections and channel states of the single precision path */
+    Eigen::MatrixXf                 m_matDelayFloat;                /**< Last delay block of the single precision path */
 
 private:
+    //=========================================================================================================
+    /**
+     * Implements filterDataBlock for the given precision.
+     *
+     * @param [in] matDataIn The data which is to be filtered
+     * @param [in] iOrder The maximum filterlength, sames as filter order(FIR)
+     * @param [in] vecPicks The used channel as index in RowVector
+     * @param [in] lFilterData The FilterData generated by filterobject from utilslib
+     * @param [in, out] overlapSaveFilter The FIR filter engine holding the channel states
+     * @param [in, out] sosFilter The IIR filter engine holding the channel states
+     * @param [in, out] matDelay The delay block of the last call
+     *
+     * @return The filtered data in form of a matrix.
+     */
+    template<typename T>
+    Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic> doFilterDataBlock(const Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic>& matDataIn,
+                                                                     int iOrder,
+                                                                     const Eigen::RowVectorXi& vecPicks,
+                                                                     const QList<UTILSLIB::FilterData> &lFilterData,
+                                                                     OverlapSaveFilter<T>& overlapSaveFilter,
+                                                                     SosFilter<T>& sosFilter,
+                                                                     Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic>& matDelay);
+
+    //=========================================================================================================
+    /**
+     * Implements filterData for the given precision, see filterData for the parameters.
+     *
+     * @param [in, out] overlapSaveFilter The FIR filter engine holding the channel states
+     * @param [in, out] sosFilter The IIR filter engine holding the channel states
+     * @param [in, out] matDelay The delay block of the last call
+     *
+     * @return The filtered data in form of a matrix.
+     */
+    template<typename T>
+    Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic> doFilterData(const Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic>& matDataIn,
+                                                                UTILSLIB::FilterData::FilterType type,
+                                                                double dCenterfreq,
+                                                                double dBandwidth,
+                                                                double dTransition,
+                                                                double dSFreq,
+                                                                const Eigen::RowVectorXi &vecPicks,
+                                                                int iOrder,
+                                                                qint32 iFftLength,
+                                                                UTILSLIB::FilterData::DesignMethod designMethod,
+                                                                OverlapSaveFilter<T>& overlapSaveFilter,
+                                                                SosFilter<T>& sosFilter,
+                                                                Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic>& matDelay);
 };
 
 //=============================================================================================================
@@ -79,14 +79,14 @@ void RtHpiWorker::doWork(const Eigen::MatrixXd& matData,
     fitResult.devHeadTrans.from = 1;
     fitResult.devHeadTrans.to = 4;
 
-    HPIFit::fitHPI(matData,
-                   matProjectors,
-                   fitResult.devHeadTrans,
-                   vFreqs,
-                   fitResult.errorDistances,
-                   fitResult.GoF,
-                   fitResult.fittedCoils,
-                   pFiffInfo);
+    m_hpiFit.fit(matData,
+                 matProjectors,
+                 fitResult.devHeadTrans,
+                 vFreqs,
+                 fitResult.errorDistances,
+                 fitResult.GoF,
+                 fitResult.fittedCoils,
+                 pFiffInfo);
 
     emit resultReady(fitResult);
 }
@@ -46,6 +46,8 @@
 #include <fiff/fiff_dig_point.h>
 #include <fiff/fiff_coord_trans.h>
 
+#include <inverse/hpiFit/hpifit.h>
+
 //=============================================================================================================
 // EIGEN INCLUDES
 //=============================================================================================================
@@ -102,7 +104,8 @@ class RTPROCESINGSHARED_EXPORT RtHpiWorker : public QObject
 public:
     //=========================================================================================================
     /**
-     * Perform one single HPI fit.
+     * Perform one single HPI fit. The fitting context is kept between calls, so sensor and reference signal
+     * setup is only redone when the measurement info, the projectors or the coil frequencies change.
      *
      * @param[in] matData            Data to estimate the HPI positions from
      * @param[in] matProjectors      The projectors to apply. Bad channels are still included.
@@ -116,6 +119,9 @@ public:
 
 signals:
     void resultReady(const RTPROCESSINGLIB::FittingResult &fitResult);
+
+private:
+    INVERSELIB::HPIFit      m_hpiFit;       /**< The persistent HPI fitting context. */
 };
 
 //=============================================================================================================
@@ -91,6 +91,8 @@ HEADERS +=  \
     rtnoise.h \
     rthpis.h \
     rtfilter.h \
+    overlapsavefilter.h \
+    sosfilter.h \
     rtconnectivity.h
 
 INCLUDEPATH += $${EIGEN_INCLUDE_DIR}
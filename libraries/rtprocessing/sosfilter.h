@@ -0,0 +1,240 @@
+//=============================================================================================================
+/**
+ * @file     sosfilter.h
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief     SosFilter class declaration.
+ *
+ */
+
+#ifndef SOSFILTER_H
+#define SOSFILTER_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/filterTools/filterdata.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QList>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// DEFINE NAMESPACE RTPROCESSINGLIB
+//=============================================================================================================
+
+namespace RTPROCESSINGLIB
+{
+
+//=============================================================================================================
+/**
+ * Streaming IIR filter bank which applies cascaded second order sections (see FilterData::m_matSos) in
+ * transposed direct form II. The filter is causal and sample by sample, hence the latency is the group delay
+ * of the filter only. The picked channels are processed together: every sample is one vector operation over
+ * all channels, the two state values per section and channel are kept between the calls.
+ *
+ * @brief Streaming second order sections filter.
+ */
+template<typename T>
+class SosFilter
+{
+public:
+    typedef Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>    MatrixT;    /**< Data matrix type. */
+    typedef Eigen::Array<T, Eigen::Dynamic, 1>                  ArrayT;     /**< Multi channel sample type. */
+
+    //=========================================================================================================
+    /**
+     * Constructs a SosFilter without sections. filter() does not touch the data until setFilter was called.
+     */
+    SosFilter();
+
+    //=========================================================================================================
+    /**
+     * Sets the filters to apply. The sections of all filters are cascaded. The state is only reset if the
+     * sections differ from the current ones.
+     *
+     * @param [in] lFilterData   The IIR filters to apply. Filters without sections are ignored.
+     *
+     * @return true if the filter changed, false otherwise.
+     */
+    bool setFilter(const QList<UTILSLIB::FilterData>& lFilterData);
+
+    //=========================================================================================================
+    /**
+     * Resets the channel states, i.e. the next block is filtered as if it was preceded by zeros.
+     */
+    void reset();
+
+    //=========================================================================================================
+    /**
+     * Filters the picked rows of a block and writes them to the same rows of the output. The block is assumed to
+     * directly follow the block of the previous call. A change of the picks resets the state. matDataIn and
+     * matDataOut may be the same matrix.
+     *
+     * @param [in] matDataIn     The data block (channels x samples).
+     * @param [in] vecPicks      The rows to filter.
+     * @param [out] matDataOut   The output, must have the size of matDataIn. Only the picked rows are written.
+     */
+    void filter(const MatrixT& matDataIn,
+                const Eigen::RowVectorXi& vecPicks,
+                MatrixT& matDataOut);
+
+    //=========================================================================================================
+    /**
+     * Returns the number of cascaded second order sections.
+     *
+     * @return the number of sections.
+     */
+    inline int numSections() const;
+
+private:
+    Eigen::MatrixXd         m_matSos;       /**< The cascaded sections [b0 b1 b2 a0 a1 a2], normalized to a0 = 1. */
+    MatrixT                 m_matState;     /**< The states, two columns per section (picks x 2*sections). */
+    MatrixT                 m_matWork;      /**< The picked channels of the current block (picks x samples). */
+    ArrayT                  m_arrY;         /**< The output of a section for one sample. */
+    Eigen::RowVectorXi      m_vecPicks;     /**< The picks the state belongs to. */
+};
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+template<typename T>
+SosFilter<T>::SosFilter()
+{
+}
+
+//=============================================================================================================
+
+template<typename T>
+bool SosFilter<T>::setFilter(const QList<UTILSLIB::FilterData>& lFilterData)
+{
+    int iNumSections = 0;
+    for(int i = 0; i < lFilterData.size(); ++i) {
+        iNumSections += lFilterData.at(i).m_matSos.rows();
+    }
+
+    Eigen::MatrixXd matSos(iNumSections, 6);
+    int iSection = 0;
+    for(int i = 0; i < lFilterData.size(); ++i) {
+        const Eigen::MatrixXd& matFilterSos = lFilterData.at(i).m_matSos;
+        for(int s = 0; s < matFilterSos.rows(); ++s, ++iSection) {
+            matSos.row(iSection) = matFilterSos.row(s) / matFilterSos(s,3);
+        }
+    }
+
+    if(matSos.rows() == m_matSos.rows() && matSos.cols() == m_matSos.cols() && matSos == m_matSos) {
+        return false;
+    }
+
+    m_matSos = matSos;
+    reset();
+
+    return true;
+}
+
+//=============================================================================================================
+
+template<typename T>
+void SosFilter<T>::reset()
+{
+    m_matState.resize(0,0);
+}
+
+//=============================================================================================================
+
+template<typename T>
+void SosFilter<T>::filter(const MatrixT& matDataIn,
+                          const Eigen::RowVectorXi& vecPicks,
+                          MatrixT& matDataOut)
+{
+    const int iNumSamples = matDataIn.cols();
+    const int iNumPicks = vecPicks.cols();
+
+    if(m_matSos.rows() == 0 || iNumSamples == 0 || iNumPicks == 0) {
+        return;
+    }
+
+    if(vecPicks.cols() != m_vecPicks.cols() || vecPicks != m_vecPicks) {
+        m_vecPicks = vecPicks;
+        reset();
+    }
+
+    if(m_matState.rows() != iNumPicks || m_matState.cols() != 2 * m_matSos.rows()) {
+        m_matState = MatrixT::Zero(iNumPicks, 2 * m_matSos.rows());
+    }
+
+    // Gather the picked channels, so that every sample is one contiguous column
+    m_matWork.resize(iNumPicks, iNumSamples);
+    for(int c = 0; c < iNumPicks; ++c) {
+        m_matWork.row(c) = matDataIn.row(vecPicks[c]);
+    }
+
+    // Run the sections one after the other over the whole block, all channels at once
+    for(int s = 0; s < m_matSos.rows(); ++s) {
+        const T b0 = T(m_matSos(s,0)), b1 = T(m_matSos(s,1)), b2 = T(m_matSos(s,2));
+        const T a1 = T(m_matSos(s,4)), a2 = T(m_matSos(s,5));
+
+        ArrayT arrW1 = m_matState.col(2*s).array();
+        ArrayT arrW2 = m_matState.col(2*s+1).array();
+
+        for(int n = 0; n < iNumSamples; ++n) {
+            m_arrY = b0 * m_matWork.col(n).array() + arrW1;
+            arrW1 = b1 * m_matWork.col(n).array() - a1 * m_arrY + arrW2;
+            arrW2 = b2 * m_matWork.col(n).array() - a2 * m_arrY;
+            m_matWork.col(n) = m_arrY.matrix();
+        }
+
+        m_matState.col(2*s) = arrW1.matrix();
+        m_matState.col(2*s+1) = arrW2.matrix();
+    }
+
+    for(int c = 0; c < iNumPicks; ++c) {
+        matDataOut.row(vecPicks[c]) = m_matWork.row(c);
+    }
+}
+
+//=============================================================================================================
+
+template<typename T>
+inline int SosFilter<T>::numSections() const
+{
+    return m_matSos.rows();
+}
+} // NAMESPACE RTPROCESSINGLIB
+
+#endif // SOSFILTER_H
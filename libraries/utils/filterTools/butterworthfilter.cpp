@@ -0,0 +1,313 @@
+//=============================================================================================================
+/**
+ * @file     butterworthfilter.cpp
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the ButterworthFilter class.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "butterworthfilter.h"
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+#include <complex>
+#include <algorithm>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QVector>
+#include <QDebug>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace UTILSLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace {
+
+typedef std::complex<double> Complex;
+
+/**
+ * Roots of a second order section. A section with a single real root has bHasSecond = false.
+ */
+struct SectionRoots {
+    Complex first;
+    Complex second;
+    bool bHasSecond;
+};
+
+//=============================================================================================================
+
+Complex productOf(const QVector<Complex>& roots, Complex offset)
+{
+    Complex prod(1.0, 0.0);
+    for(int i = 0; i < roots.size(); ++i) {
+        prod *= offset - roots.at(i);
+    }
+    return prod;
+}
+
+//=============================================================================================================
+
+QVector<SectionRoots> groupRoots(const QVector<Complex>& roots)
+{
+    const double dTol = 1e-10;
+
+    QVector<SectionRoots> groups;
+    QVector<double> vecReal;
+
+    // Complex roots come in conjugate pairs, keep the one with positive imaginary part
+    for(int i = 0; i < roots.size(); ++i) {
+        if(std::abs(roots.at(i).imag()) <= dTol) {
+            vecReal.append(roots.at(i).real());
+        } else if(roots.at(i).imag() > 0) {
+            SectionRoots group = {roots.at(i), std::conj(roots.at(i)), true};
+            groups.append(group);
+        }
+    }
+
+    // Real roots are combined smallest with largest, e.g. a zero at -1 with one at +1
+    std::sort(vecReal.begin(), vecReal.end());
+    for(int i = 0, j = vecReal.size() - 1; i <= j; ++i, --j) {
+        SectionRoots group = {Complex(vecReal.at(i), 0.0), Complex(vecReal.at(j), 0.0), i != j};
+        groups.append(group);
+    }
+
+    return groups;
+}
+
+//=============================================================================================================
+
+void sectionPolynomial(const SectionRoots& group, double* pCoeffs)
+{
+    if(group.bHasSecond) {
+        pCoeffs[0] = 1.0;
+        pCoeffs[1] = -(group.first + group.second).real();
+        pCoeffs[2] = (group.first * group.second).real();
+    } else {
+        pCoeffs[0] = 1.0;
+        pCoeffs[1] = -group.first.real();
+        pCoeffs[2] = 0.0;
+    }
+}
+
+} // namespace
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+ButterworthFilter::ButterworthFilter()
+: m_iFilterOrder(0)
+{
+}
+
+//=============================================================================================================
+
+ButterworthFilter::ButterworthFilter(int order,
+                                     double centerfreq,
+                                     double bandwidth,
+                                     TPassType type)
+: m_iFilterOrder(order)
+{
+    if(m_iFilterOrder < 1) {
+        qWarning() << "[ButterworthFilter::ButterworthFilter] Order must be at least 1. Setting order to 1.";
+        m_iFilterOrder = 1;
+    }
+
+    const double fs = 2.0;
+    const double dMinFreq = 1e-6;
+    const double dMaxFreq = 1.0 - 1e-6;
+
+    // Analog lowpass prototype with unit cutoff, no zeros
+    QVector<Complex> zeros, poles;
+    double gain = 1.0;
+
+    for(int m = -m_iFilterOrder + 1; m < m_iFilterOrder; m += 2) {
+        poles.append(-std::exp(Complex(0.0, M_PI * m / (2.0 * m_iFilterOrder))));
+    }
+
+    // Transform the prototype to the prewarped analog filter
+    double dLow = qBound(dMinFreq, centerfreq - bandwidth/2.0, dMaxFreq);
+    double dHigh = qBound(dMinFreq, centerfreq + bandwidth/2.0, dMaxFreq);
+    double dWarped = 2.0 * fs * std::tan(M_PI * qBound(dMinFreq, centerfreq, dMaxFreq) / fs);
+    double dWarpedLow = 2.0 * fs * std::tan(M_PI * dLow / fs);
+    double dWarpedHigh = 2.0 * fs * std::tan(M_PI * dHigh / fs);
+    double dWo = std::sqrt(dWarpedLow * dWarpedHigh);
+    double dBw = dWarpedHigh - dWarpedLow;
+
+    int iDegree = poles.size() - zeros.size();
+
+    switch(type) {
+        case LPF: {
+            for(int i = 0; i < zeros.size(); ++i) {
+                zeros[i] *= dWarped;
+            }
+            for(int i = 0; i < poles.size(); ++i) {
+                poles[i] *= dWarped;
+            }
+            gain *= std::pow(dWarped, iDegree);
+            break;
+        }
+
+        case HPF: {
+            gain *= (productOf(zeros, Complex(0.0, 0.0)) / productOf(poles, Complex(0.0, 0.0))).real();
+            for(int i = 0; i < zeros.size(); ++i) {
+                zeros[i] = dWarped / zeros[i];
+            }
+            for(int i = 0; i < poles.size(); ++i) {
+                poles[i] = dWarped / poles[i];
+            }
+            zeros.insert(zeros.size(), iDegree, Complex(0.0, 0.0));
+            break;
+        }
+
+        case BPF: {
+            QVector<Complex> zerosBp, polesBp;
+            for(int i = 0; i < zeros.size(); ++i) {
+                Complex z = zeros[i] * dBw / 2.0;
+                zerosBp << z + std::sqrt(z*z - dWo*dWo) << z - std::sqrt(z*z - dWo*dWo);
+            }
+            for(int i = 0; i < poles.size(); ++i) {
+                Complex p = poles[i] * dBw / 2.0;
+                polesBp << p + std::sqrt(p*p - dWo*dWo) << p - std::sqrt(p*p - dWo*dWo);
+            }
+            zerosBp.insert(zerosBp.size(), iDegree, Complex(0.0, 0.0));
+            zeros = zerosBp;
+            poles = polesBp;
+            gain *= std::pow(dBw, iDegree);
+            break;
+        }
+
+        case NOTCH: {
+            gain *= (productOf(zeros, Complex(0.0, 0.0)) / productOf(poles, Complex(0.0, 0.0))).real();
+            QVector<Complex> zerosBs, polesBs;
+            for(int i = 0; i < zeros.size(); ++i) {
+                Complex z = (dBw / 2.0) / zeros[i];
+                zerosBs << z + std::sqrt(z*z - dWo*dWo) << z - std::sqrt(z*z - dWo*dWo);
+            }
+            for(int i = 0; i < poles.size(); ++i) {
+                Complex p = (dBw / 2.0) / poles[i];
+                polesBs << p + std::sqrt(p*p - dWo*dWo) << p - std::sqrt(p*p - dWo*dWo);
+            }
+            zerosBs.insert(zerosBs.size(), iDegree, Complex(0.0, dWo));
+            zerosBs.insert(zerosBs.size(), iDegree, Complex(0.0, -dWo));
+            zeros = zerosBs;
+            poles = polesBs;
+            break;
+        }
+    }
+
+    // Bilinear transform, zeros at infinity are mapped to nyquist
+    const double fs2 = 2.0 * fs;
+    iDegree = poles.size() - zeros.size();
+    gain *= (productOf(zeros, Complex(fs2, 0.0)) / productOf(poles, Complex(fs2, 0.0))).real();
+
+    for(int i = 0; i < zeros.size(); ++i) {
+        zeros[i] = (fs2 + zeros[i]) / (fs2 - zeros[i]);
+    }
+    for(int i = 0; i < poles.size(); ++i) {
+        poles[i] = (fs2 + poles[i]) / (fs2 - poles[i]);
+    }
+    zeros.insert(zeros.size(), iDegree, Complex(-1.0, 0.0));
+
+    // Combine the roots to second order sections. The poles farthest from the unit circle come first and each
+    // gets the nearest zeros, which keeps the intermediate gains moderate.
+    QVector<SectionRoots> poleGroups = groupRoots(poles);
+    QVector<SectionRoots> zeroGroups = groupRoots(zeros);
+
+    std::sort(poleGroups.begin(), poleGroups.end(), [](const SectionRoots& a, const SectionRoots& b) {
+        return std::abs(1.0 - std::abs(a.first)) > std::abs(1.0 - std::abs(b.first));
+    });
+
+    m_matSos = MatrixXd::Zero(poleGroups.size(), 6);
+
+    for(int s = 0; s < poleGroups.size(); ++s) {
+        double vecCoeffs[3];
+        sectionPolynomial(poleGroups.at(s), vecCoeffs);
+        m_matSos(s,3) = vecCoeffs[0];
+        m_matSos(s,4) = vecCoeffs[1];
+        m_matSos(s,5) = vecCoeffs[2];
+
+        if(zeroGroups.isEmpty()) {
+            m_matSos(s,0) = 1.0;
+            continue;
+        }
+
+        int iNearest = 0;
+        for(int i = 1; i < zeroGroups.size(); ++i) {
+            if(std::abs(zeroGroups.at(i).first - poleGroups.at(s).first) < std::abs(zeroGroups.at(iNearest).first - poleGroups.at(s).first)) {
+                iNearest = i;
+            }
+        }
+
+        sectionPolynomial(zeroGroups.at(iNearest), vecCoeffs);
+        m_matSos(s,0) = vecCoeffs[0];
+        m_matSos(s,1) = vecCoeffs[1];
+        m_matSos(s,2) = vecCoeffs[2];
+        zeroGroups.remove(iNearest);
+    }
+
+    if(m_matSos.rows() > 0) {
+        m_matSos.row(0).head(3) *= gain;
+    }
+}
+
+//=============================================================================================================
+
+RowVectorXcd ButterworthFilter::frequencyResponse(const MatrixXd& matSos,
+                                                  int fftLength)
+{
+    RowVectorXcd vecResponse = RowVectorXcd::Ones(fftLength/2 + 1);
+
+    for(int k = 0; k < vecResponse.cols(); ++k) {
+        Complex z1 = std::exp(Complex(0.0, -2.0 * M_PI * k / fftLength));
+        Complex z2 = z1 * z1;
+
+        for(int s = 0; s < matSos.rows(); ++s) {
+            vecResponse[k] *= (matSos(s,0) + matSos(s,1) * z1 + matSos(s,2) * z2)
+                              / (matSos(s,3) + matSos(s,4) * z1 + matSos(s,5) * z2);
+        }
+    }
+
+    return vecResponse;
+}
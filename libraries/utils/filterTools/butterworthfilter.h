@@ -0,0 +1,107 @@
+//=============================================================================================================
+/**
+ * @file     butterworthfilter.h
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Declaration of the ButterworthFilter class.
+ *
+ */
+
+#ifndef BUTTERWORTHFILTER_H
+#define BUTTERWORTHFILTER_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "../utils_global.h"
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// DEFINE NAMESPACE UTILSLIB
+//=============================================================================================================
+
+namespace UTILSLIB
+{
+
+//=============================================================================================================
+/**
+ * Designs a digital Butterworth IIR filter as a cascade of second order sections (biquads). The analog
+ * prototype is transformed to the requested type and mapped with the prewarped bilinear transform. Keeping
+ * the sections separate instead of expanding the transfer function keeps the filter stable for higher orders.
+ *
+ * @brief Creates a Butterworth filter as second order sections.
+ */
+class UTILSSHARED_EXPORT ButterworthFilter
+{
+public:
+    enum TPassType {LPF, HPF, BPF, NOTCH };
+
+    //=========================================================================================================
+    /**
+     * Constructs an empty ButterworthFilter object.
+     */
+    ButterworthFilter();
+
+    //=========================================================================================================
+    /**
+     * Constructs a ButterworthFilter object.
+     *
+     * @param order          order of the analog lowpass prototype. Band pass and notch filters have twice the order.
+     * @param centerfreq     cutoff frequency if LPF, HPF. Center of the pass-/stopband if BPF, NOTCH - normed to sFreq/2 (nyquist)
+     * @param bandwidth      ignored if LPF, HPF. Bandwidth of the pass-/stopband if BPF, NOTCH - normed to sFreq/2 (nyquist)
+     * @param type           filter type (lowpass, highpass, etc.)
+     */
+    ButterworthFilter(int order,
+                      double centerfreq,
+                      double bandwidth,
+                      TPassType type);
+
+    //=========================================================================================================
+    /**
+     * Evaluates the frequency response of second order sections at the frequencies of a half spectrum FFT.
+     *
+     * @param matSos         the second order sections, one row [b0 b1 b2 a0 a1 a2] per section
+     * @param fftLength      length of the fft
+     *
+     * @return the complex response for the fftLength/2+1 frequencies from 0 to nyquist
+     */
+    static Eigen::RowVectorXcd frequencyResponse(const Eigen::MatrixXd& matSos,
+                                                 int fftLength);
+
+    Eigen::MatrixXd     m_matSos;           /**< The second order sections, one row [b0 b1 b2 a0 a1 a2] per section, a0 = 1. */
+    int                 m_iFilterOrder;     /**< The order of the analog lowpass prototype. */
+};
+} // NAMESPACE UTILSLIB
+
+#endif // BUTTERWORTHFILTER_H
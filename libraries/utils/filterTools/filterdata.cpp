@@ -44,6 +44,7 @@
 
 #include "parksmcclellan.h"
 #include "cosinefilter.h"
+#include "butterworthfilter.h"
 
 #include <iostream>
 
@@ -109,8 +110,10 @@ FilterData::FilterData(QString unique_name,
 , m_dBandwidth(bandwidth)
 , m_sFreq(sFreq)
 {
-    if(order < 9) {
+    //The order of the FIR designs is their number of taps, the Butterworth order is the number of poles
+    if((m_designMethod == Cosine || m_designMethod == Tschebyscheff) && m_iFilterOrder < 9) {
        qWarning() << "[FilterData::FilterData] Less than 9 taps were provided. Setting number of taps to 9.";
+       m_iFilterOrder = 9;
     }
 
     designFilter();
@@ -120,6 +123,8 @@ FilterData::FilterData(QString unique_name,
 
 void FilterData::designFilter()
 {
+    m_matSos.resize(0,0);
+
     switch(m_designMethod) {
         case Tschebyscheff: {
             ParksMcClellan filter(m_iFilterOrder,
@@ -183,6 +188,39 @@ void FilterData::designFilter()
 
             break;
         }
+
+        case Butterworth: {
+            ButterworthFilter filterbw(m_iFilterOrder,
+                                       m_dCenterFreq,
+                                       m_dBandwidth,
+                                       (ButterworthFilter::TPassType)m_Type);
+            m_matSos = filterbw.m_matSos;
+
+            //The impulse response is infinite, keep the part which fits into the fft for plotting and the FIR based methods
+            RowVectorXd t_impulse = RowVectorXd::Zero(m_iFFTlength);
+            t_impulse[0] = 1.0;
+
+            for(int s = 0; s < m_matSos.rows(); ++s) {
+                double w1 = 0.0, w2 = 0.0;
+                for(int i = 0; i < t_impulse.cols(); ++i) {
+                    double x = t_impulse[i];
+                    double y = m_matSos(s,0) * x + w1;
+                    w1 = m_matSos(s,1) * x - m_matSos(s,4) * y + w2;
+                    w2 = m_matSos(s,2) * x - m_matSos(s,5) * y;
+                    t_impulse[i] = y;
+                }
+            }
+
+            m_dCoeffA = t_impulse;
+
+            //Use the exact frequency response instead of the transform of the truncated impulse response
+            m_dFFTCoeffA = ButterworthFilter::frequencyResponse(m_matSos, m_iFFTlength);
+
+            break;
+        }
+
+        default:
+            break;
     }
 
     switch(m_Type) {
@@ -267,6 +305,26 @@ RowVectorXd FilterData::applyConvFilter(const RowVectorXd& data, bool keepOverhe
 //=============================================================================================================
 
 RowVectorXd FilterData::applyFFTFilter(const RowVectorXd& data, bool keepOverhead, CompensateEdgeEffects compensateEdgeEffects) const
+{
+    return applyFFTFilter<double>(data, m_dFFTCoeffA, keepOverhead, compensateEdgeEffects);
+}
+
+//=============================================================================================================
+
+RowVectorXf FilterData::applyFFTFilter(const RowVectorXf& data, bool keepOverhead, CompensateEdgeEffects compensateEdgeEffects) const
+{
+    Matrix<std::complex<float>,1,Dynamic> t_fftCoeffA = m_dFFTCoeffA.cast<std::complex<float> >();
+
+    return applyFFTFilter<float>(data, t_fftCoeffA, keepOverhead, compensateEdgeEffects);
+}
+
+//=============================================================================================================
+
+template<typename T>
+Matrix<T,1,Dynamic> FilterData::applyFFTFilter(const Matrix<T,1,Dynamic>& data,
+                                               const Matrix<std::complex<T>,1,Dynamic>& fftCoeffA,
+                                               bool keepOverhead,
+                                               CompensateEdgeEffects compensateEdgeEffects) const
 {
     #ifdef EIGEN_FFTW_DEFAULT
         fftw_make_planner_thread_safe();
@@ -283,7 +341,7 @@ RowVectorXd FilterData::applyFFTFilter(const RowVectorXd& data, bool keepOverhea
     }
 
     //Do zero padding or mirroring depending on user input
-    RowVectorXd t_dataZeroPad = RowVectorXd::Zero(m_iFFTlength);
+    Matrix<T,1,Dynamic> t_dataZeroPad = Matrix<T,1,Dynamic>::Zero(m_iFFTlength);
 
     switch(compensateEdgeEffects) {
         case MirrorData:
@@ -302,18 +360,18 @@ RowVectorXd FilterData::applyFFTFilter(const RowVectorXd& data, bool keepOverhea
     }
 
     //generate fft object
-    Eigen::FFT<double> fft;
+    Eigen::FFT<T> fft;
     fft.SetFlag(fft.HalfSpectrum);
 
     //fft-transform data sequence
-    RowVectorXcd t_freqData;
+    Matrix<std::complex<T>,1,Dynamic> t_freqData;
     fft.fwd(t_freqData,t_dataZeroPad);
 
     //perform frequency-domain filtering
-    RowVectorXcd t_filteredFreq = m_dFFTCoeffA.array()*t_freqData.array();
+    Matrix<std::complex<T>,1,Dynamic> t_filteredFreq = fftCoeffA.array()*t_freqData.array();
 
     //inverse-FFT
-    RowVectorXd t_filteredTime;
+    Matrix<T,1,Dynamic> t_filteredTime;
     fft.inv(t_filteredTime,t_filteredFreq);
 
     //Return filtered data
@@ -338,6 +396,9 @@ QString FilterData::getStringForDesignMethod(const FilterData::DesignMethod &des
     if(designMethod == FilterData::Tschebyscheff)
         designMethodString = "Tschebyscheff";
 
+    if(designMethod == FilterData::Butterworth)
+        designMethodString = "Butterworth";
+
     return designMethodString;
 }
 
@@ -377,6 +438,9 @@ FilterData::DesignMethod FilterData::getDesignMethodForString(const QString &des
     if(designMethodString == "Cosine")
         designMethod = FilterData::Cosine;
 
+    if(designMethodString == "Butterworth")
+        designMethod = FilterData::Butterworth;
+
     return designMethod;
 }
 
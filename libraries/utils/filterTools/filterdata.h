@@ -83,7 +83,8 @@ public:
     enum DesignMethod {
         Tschebyscheff,
         Cosine,
-        External
+        External,
+        Butterworth
     } m_designMethod;
 
     enum FilterType {
@@ -115,7 +116,8 @@ public:
      * @param [in] parkswidth determines the width of the filter slopes (steepness) - normed to sFreq/2 (nyquist)
      * @param [in] sFreq sampling frequency
      * @param [in] fftlength length of the fft (multiple integer of 2^x)
-     * @param [in] designMethod specifies the design method to use. Choose between Cosind and Tschebyscheff
+     * @param [in] designMethod specifies the design method to use. Choose between Cosind and Tschebyscheff for FIR filters
+     *                          or Butterworth for a causal IIR filter, whose order is then given by order.
      **/
 
     FilterData(QString unique_name,
@@ -164,6 +166,21 @@ public:
                                       CompensateEdgeEffects compensateEdgeEffects = MirrorData)
                                       const;
 
+    /**
+     * Single precision version of applyFFTFilter. The transforms are computed in single precision, which halves the
+     * memory bandwidth and doubles the SIMD width of the FFT.
+     *
+     * @param [in] data holds the data to be filtered
+     * @param [in] keepOverhead whether the result should still include the overhead information in front and back of the data
+     * @param [in] compensateEdgeEffects defines how the edge effects should be handlted. Choose between ZeroPad and Mirroring
+     *
+     * @return the filtered data in form of a RowVectorXf
+     */
+    Eigen::RowVectorXf applyFFTFilter(const Eigen::RowVectorXf& data,
+                                      bool keepOverhead = false,
+                                      CompensateEdgeEffects compensateEdgeEffects = MirrorData)
+                                      const;
+
     /**
      * @brief getStringForDesignMethod returns the current design method as a string
      */
@@ -184,6 +201,24 @@ public:
      */
     static FilterData::FilterType getFilterTypeForString(const QString &filerTypeString);
 
+protected:
+    /**
+     * Applies the filter in frequency domain with the given precision, see applyFFTFilter.
+     *
+     * @param [in] data holds the data to be filtered
+     * @param [in] fftCoeffA the FFT-transformed forward filter coefficients in the precision of the data
+     * @param [in] keepOverhead whether the result should still include the overhead information in front and back of the data
+     * @param [in] compensateEdgeEffects defines how the edge effects should be handlted. Choose between ZeroPad and Mirroring
+     *
+     * @return the filtered data
+     */
+    template<typename T>
+    Eigen::Matrix<T,1,Eigen::Dynamic> applyFFTFilter(const Eigen::Matrix<T,1,Eigen::Dynamic>& data,
+                                                     const Eigen::Matrix<std::complex<T>,1,Eigen::Dynamic>& fftCoeffA,
+                                                     bool keepOverhead,
+                                                     CompensateEdgeEffects compensateEdgeEffects) const;
+
+public:
     double          m_sFreq;                /**< the sampling frequency. */
     double          m_dCenterFreq;          /**< contains center freq of the filter. */
     double          m_dBandwidth;           /**< contains bandwidth of the filter. */
@@ -201,6 +236,8 @@ public:
 
     Eigen::RowVectorXcd    m_dFFTCoeffA;    /**< the FFT-transformed forward filter coefficient set, required for frequency-domain filtering, zero-padded to m_iFFTlength. */
     Eigen::RowVectorXcd    m_dFFTCoeffB;    /**< the FFT-transformed backward filter coefficient set, required for frequency-domain filtering, zero-padded to m_iFFTlength. */
+
+    Eigen::MatrixXd        m_matSos;        /**< the second order sections [b0 b1 b2 a0 a1 a2] of IIR designs, empty for FIR filters. m_dCoeffA then holds the impulse response over m_iFFTlength samples. */
 };
 
 //=============================================================================================================
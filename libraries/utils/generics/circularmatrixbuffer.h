@@ -44,6 +44,8 @@
 #include "buffer.h"
 
 #include <typeinfo>
+#include <cstring>
+#include <climits>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -56,7 +58,10 @@
 //=============================================================================================================
 
 #include <QPair>
-#include <QSemaphore>
+#include <QAtomicInt>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QElapsedTimer>
 #include <QSharedPointer>
 #include <stdio.h>
 
@@ -69,7 +74,9 @@ namespace IOBUFFER
 
 //=============================================================================================================
 /**
- * Circular Matrix buffer provides a template for thread safe circular matrix buffers.
+ * Circular Matrix buffer provides a template for thread safe circular matrix buffers. The buffer is a single
+ * producer/single consumer ring of whole matrix slots: a matrix is copied with one memcpy, the slot hand over is lock
+ * free and the mutex is only touched when a thread actually has to wait for a free or a filled slot.
  *
  * @brief The circular matrix buffer
  */
@@ -101,7 +108,7 @@ public:
 
     //=========================================================================================================
     /**
-     * Adds a whole matrix at the end buffer.
+     * Adds a whole matrix at the end buffer. Blocks until a slot is free.
      *
      * @param [in] pMatrix pointer to a Matrix which should be apend to the end.
      */
@@ -109,12 +116,90 @@ public:
 
     //=========================================================================================================
     /**
-     * Returns the first matrix (first in first out).
+     * Adds a whole matrix at the end buffer. Waits at most iTimeoutMs for a free slot.
+     *
+     * @param [in] pMatrix       pointer to a Matrix which should be apend to the end.
+     * @param [in] iTimeoutMs    The maximal waiting time in milliseconds, -1 waits forever, 0 does not wait.
+     *
+     * @return true if the matrix was added, false otherwise.
+     */
+    inline bool push(const Eigen::Matrix<_Tp, Eigen::Dynamic, Eigen::Dynamic>* pMatrix,
+                     int iTimeoutMs);
+
+    //=========================================================================================================
+    /**
+     * Adds a whole matrix at the end buffer if a slot is free. Never blocks.
+     *
+     * @param [in] pMatrix pointer to a Matrix which should be apend to the end.
+     *
+     * @return true if the matrix was added, false if the buffer is full.
+     */
+    inline bool tryPush(const Eigen::Matrix<_Tp, Eigen::Dynamic, Eigen::Dynamic>* pMatrix);
+
+    //=========================================================================================================
+    /**
+     * Returns the first matrix (first in first out). Blocks until a matrix is available.
      *
      * @return the first matrix
      */
     inline Eigen::Matrix<_Tp, Eigen::Dynamic, Eigen::Dynamic> pop();
 
+    //=========================================================================================================
+    /**
+     * Copies the first matrix (first in first out) to matrix. Waits at most iTimeoutMs for a matrix.
+     *
+     * @param [out] matrix       The popped matrix.
+     * @param [in] iTimeoutMs    The maximal waiting time in milliseconds, -1 waits forever, 0 does not wait.
+     *
+     * @return true if a matrix was popped, false otherwise.
+     */
+    inline bool pop(Eigen::Matrix<_Tp, Eigen::Dynamic, Eigen::Dynamic>& matrix,
+                    int iTimeoutMs);
+
+    //=========================================================================================================
+    /**
+     * Copies the first matrix (first in first out) to matrix if one is available. Never blocks.
+     *
+     * @param [out] matrix       The popped matrix.
+     *
+     * @return true if a matrix was popped, false if the buffer is empty.
+     */
+    inline bool tryPop(Eigen::Matrix<_Tp, Eigen::Dynamic, Eigen::Dynamic>& matrix);
+
+    //=========================================================================================================
+    /**
+     * Zero copy write: returns the next free slot (rows x cols, column major) which the producer fills in place,
+     * followed by commitWrite(). Waits at most iTimeoutMs for a free slot.
+     *
+     * @param [in] iTimeoutMs    The maximal waiting time in milliseconds, -1 waits forever, 0 does not wait.
+     *
+     * @return the slot, NULL if no slot became free or the buffer is paused.
+     */
+    inline _Tp* beginWrite(int iTimeoutMs = -1);
+
+    //=========================================================================================================
+    /**
+     * Hands the slot returned by beginWrite() over to the consumer.
+     */
+    inline void commitWrite();
+
+    //=========================================================================================================
+    /**
+     * Zero copy read: returns the first filled slot (rows x cols, column major) which the consumer reads in place,
+     * followed by commitRead(). Waits at most iTimeoutMs for a filled slot.
+     *
+     * @param [in] iTimeoutMs    The maximal waiting time in milliseconds, -1 waits forever, 0 does not wait.
+     *
+     * @return the slot, NULL if no slot was filled or the buffer is paused.
+     */
+    inline const _Tp* beginRead(int iTimeoutMs = -1);
+
+    //=========================================================================================================
+    /**
+     * Hands the slot returned by beginRead() back to the producer.
+     */
+    inline void commitRead();
+
     //=========================================================================================================
     /**
      * Clears the buffer.
@@ -162,22 +247,54 @@ public:
 private:
     //=========================================================================================================
     /**
-     * Returns the current circular index to the corresponding given index.
+     * Returns the number of filled slots for the given read and write positions.
+     */
+    inline int usedSlots(int iWritePos, int iReadPos) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the slot memory of a read or write position. Positions run in [0, 2*size) so that a full and an empty
+     * buffer can be told apart without a modulo.
+     */
+    inline _Tp* slot(int iPos) const;
+
+    //=========================================================================================================
+    /**
+     * Advances a read or write position.
+     */
+    inline int nextPos(int iPos) const;
+
+    //=========================================================================================================
+    /**
+     * Waits until the producer may write (bFree = true) or the consumer may read (bFree = false).
+     *
+     * @param [in] bFree         Whether to wait for a free slot or a filled slot.
+     * @param [in] iTimeoutMs    The maximal waiting time in milliseconds, -1 waits forever, 0 does not wait.
      *
-     * @param [in] index which should be mapped.
-     * @return the mapped index.
+     * @return true if the slot is available, false on timeout or release.
      */
-    inline unsigned int mapIndex(int& index);
+    inline bool waitForSlot(bool bFree,
+                            int iTimeoutMs);
+
+    //=========================================================================================================
+    /**
+     * Wakes threads blocked in waitForSlot(), only takes the mutex if somebody waits.
+     */
+    inline void wakeWaiting();
 
     unsigned int    m_uiMaxNumMatrices;         /**< Holds the maximal number of matrices.*/
     unsigned int    m_uiRows;                   /**< Holds the number rows.*/
     unsigned int    m_uiCols;                   /**< Holds the number cols.*/
-    unsigned int    m_uiMaxNumElements;         /**< Holds the maximal number of buffer elements.*/
+    unsigned int    m_uiMatrixSize;             /**< Holds the number of elements of one matrix slot.*/
     _Tp*            m_pBuffer;                  /**< Holds the circular buffer.*/
-    int             m_iCurrentReadIndex;        /**< Holds the current read index.*/
-    int             m_iCurrentWriteIndex;       /**< Holds the current write index.*/
-    QSemaphore*     m_pFreeElements;            /**< Holds a semaphore which acquires free elements for thread safe writing. A semaphore is a generalization of a mutex.*/
-    QSemaphore*     m_pUsedElements;            /**< Holds a semaphore which acquires written semaphore for thread safe reading.*/
+    QAtomicInt      m_iReadPos;                 /**< Holds the current read position, only advanced by the consumer.*/
+    QAtomicInt      m_iWritePos;                /**< Holds the current write position, only advanced by the producer.*/
+    QAtomicInt      m_iNumWaiting;              /**< Holds the number of threads blocked in waitForSlot().*/
+    QAtomicInt      m_iReleasePop;              /**< Holds whether a blocked pop was released by releaseFromPop().*/
+    QAtomicInt      m_iReleasePush;             /**< Holds whether a blocked push was released by releaseFromPush().*/
+    QMutex          m_mutex;                    /**< Holds the mutex for the wait conditions.*/
+    QWaitCondition  m_slotFreed;                /**< Signaled when the consumer released a slot.*/
+    QWaitCondition  m_slotFilled;               /**< Signaled when the producer filled a slot.*/
     bool            m_bPause;
 };
 
@@ -188,15 +305,16 @@ private:
 template<typename _Tp>
 CircularMatrixBuffer<_Tp>::CircularMatrixBuffer(unsigned int uiMaxNumMatrices, unsigned int uiRows, unsigned int uiCols)
 : Buffer(typeid(_Tp).name())
-, m_uiMaxNumMatrices(uiMaxNumMatrices)
+, m_uiMaxNumMatrices(uiMaxNumMatrices > 0 ? uiMaxNumMatrices : 1)
 , m_uiRows(uiRows)
 , m_uiCols(uiCols)
-, m_uiMaxNumElements(m_uiMaxNumMatrices*m_uiRows*m_uiCols)
-, m_pBuffer(new _Tp[m_uiMaxNumElements])
-, m_iCurrentReadIndex(-1)
-, m_iCurrentWriteIndex(-1)
-, m_pFreeElements(new QSemaphore(m_uiMaxNumElements))
-, m_pUsedElements(new QSemaphore(0))
+, m_uiMatrixSize(m_uiRows*m_uiCols)
+, m_pBuffer(new _Tp[m_uiMaxNumMatrices*m_uiMatrixSize])
+, m_iReadPos(0)
+, m_iWritePos(0)
+, m_iNumWaiting(0)
+, m_iReleasePop(0)
+, m_iReleasePush(0)
 , m_bPause(false)
 {
 }
@@ -206,8 +324,6 @@ CircularMatrixBuffer<_Tp>::CircularMatrixBuffer(unsigned int uiMaxNumMatrices, u
 template<typename _Tp>
 CircularMatrixBuffer<_Tp>::~CircularMatrixBuffer()
 {
-    delete m_pFreeElements;
-    delete m_pUsedElements;
     delete [] m_pBuffer;
 }
 
@@ -216,21 +332,41 @@ CircularMatrixBuffer<_Tp>::~CircularMatrixBuffer()
 template<typename _Tp>
 inline void CircularMatrixBuffer<_Tp>::push(const Eigen::Matrix<_Tp, Eigen::Dynamic, Eigen::Dynamic>* pMatrix)
 {
-    if(!m_bPause)
-    {
-        unsigned int t_size = pMatrix->size();
-        if(t_size == m_uiRows*m_uiCols)
-        {
-            m_pFreeElements->acquire(t_size);
-            for(unsigned int i = 0; i < t_size; ++i)
-                m_pBuffer[mapIndex(m_iCurrentWriteIndex)] = pMatrix->data()[i];
-            m_pUsedElements->release(t_size);
-        }
+    push(pMatrix, -1);
+}
 
-        else {
-            printf("Error: Matrix not appended to CircularMatrixBuffer - wrong dimensions\n");
-        }
+//=============================================================================================================
+
+template<typename _Tp>
+inline bool CircularMatrixBuffer<_Tp>::push(const Eigen::Matrix<_Tp, Eigen::Dynamic, Eigen::Dynamic>* pMatrix,
+                                            int iTimeoutMs)
+{
+    if(m_bPause) {
+        return false;
+    }
+
+    if((unsigned int)pMatrix->size() != m_uiMatrixSize) {
+        printf("Error: Matrix not appended to CircularMatrixBuffer - wrong dimensions\n");
+        return false;
+    }
+
+    _Tp* pSlot = beginWrite(iTimeoutMs);
+    if(!pSlot) {
+        return false;
     }
+
+    std::memcpy(pSlot, pMatrix->data(), m_uiMatrixSize*sizeof(_Tp));
+    commitWrite();
+
+    return true;
+}
+
+//=============================================================================================================
+
+template<typename _Tp>
+inline bool CircularMatrixBuffer<_Tp>::tryPush(const Eigen::Matrix<_Tp, Eigen::Dynamic, Eigen::Dynamic>* pMatrix)
+{
+    return push(pMatrix, 0);
 }
 
 //=============================================================================================================
@@ -240,15 +376,9 @@ inline Eigen::Matrix<_Tp, Eigen::Dynamic, Eigen::Dynamic> CircularMatrixBuffer<_
 {
     Eigen::Matrix<_Tp, Eigen::Dynamic, Eigen::Dynamic> matrix(m_uiRows, m_uiCols);
 
-    if(!m_bPause)
-    {
-        m_pUsedElements->acquire(m_uiRows*m_uiCols);
-        for(quint32 i = 0; i < m_uiRows*m_uiCols; ++i)
-            matrix.data()[i] = m_pBuffer[mapIndex(m_iCurrentReadIndex)];
-        m_pFreeElements->release(m_uiRows*m_uiCols);
-    }
-    else
+    if(!pop(matrix, -1)) {
         matrix.setZero();
+    }
 
     return matrix;
 }
@@ -256,25 +386,164 @@ inline Eigen::Matrix<_Tp, Eigen::Dynamic, Eigen::Dynamic> CircularMatrixBuffer<_
 //=============================================================================================================
 
 template<typename _Tp>
-inline unsigned int CircularMatrixBuffer<_Tp>::mapIndex(int& index)
+inline bool CircularMatrixBuffer<_Tp>::pop(Eigen::Matrix<_Tp, Eigen::Dynamic, Eigen::Dynamic>& matrix,
+                                           int iTimeoutMs)
 {
-    int AuxIndex;
-    AuxIndex = ++index;
-    return index = AuxIndex % m_uiMaxNumElements;
+    const _Tp* pSlot = beginRead(iTimeoutMs);
+    if(!pSlot) {
+        return false;
+    }
+
+    matrix.resize(m_uiRows, m_uiCols);
+    std::memcpy(matrix.data(), pSlot, m_uiMatrixSize*sizeof(_Tp));
+    commitRead();
+
+    return true;
 }
 
 //=============================================================================================================
 
 template<typename _Tp>
-void CircularMatrixBuffer<_Tp>::clear()
+inline bool CircularMatrixBuffer<_Tp>::tryPop(Eigen::Matrix<_Tp, Eigen::Dynamic, Eigen::Dynamic>& matrix)
+{
+    return pop(matrix, 0);
+}
+
+//=============================================================================================================
+
+template<typename _Tp>
+inline _Tp* CircularMatrixBuffer<_Tp>::beginWrite(int iTimeoutMs)
+{
+    if(m_bPause || !waitForSlot(true, iTimeoutMs)) {
+        return NULL;
+    }
+
+    return slot(m_iWritePos.loadAcquire());
+}
+
+//=============================================================================================================
+
+template<typename _Tp>
+inline void CircularMatrixBuffer<_Tp>::commitWrite()
+{
+    //Ordered store: publishes the slot content and orders the store before reading the number of waiting threads
+    m_iWritePos.fetchAndStoreOrdered(nextPos(m_iWritePos.loadAcquire()));
+    wakeWaiting();
+}
+
+//=============================================================================================================
+
+template<typename _Tp>
+inline const _Tp* CircularMatrixBuffer<_Tp>::beginRead(int iTimeoutMs)
 {
-    delete m_pFreeElements;
-    m_pFreeElements = new QSemaphore(m_uiMaxNumElements);
-    delete m_pUsedElements;
-    m_pUsedElements = new QSemaphore(0);
+    if(m_bPause || !waitForSlot(false, iTimeoutMs)) {
+        return NULL;
+    }
 
-    m_iCurrentReadIndex = -1;
-    m_iCurrentWriteIndex = -1;
+    return slot(m_iReadPos.loadAcquire());
+}
+
+//=============================================================================================================
+
+template<typename _Tp>
+inline void CircularMatrixBuffer<_Tp>::commitRead()
+{
+    m_iReadPos.fetchAndStoreOrdered(nextPos(m_iReadPos.loadAcquire()));
+    wakeWaiting();
+}
+
+//=============================================================================================================
+
+template<typename _Tp>
+inline int CircularMatrixBuffer<_Tp>::usedSlots(int iWritePos, int iReadPos) const
+{
+    int iUsed = iWritePos - iReadPos;
+    return iUsed < 0 ? iUsed + 2*(int)m_uiMaxNumMatrices : iUsed;
+}
+
+//=============================================================================================================
+
+template<typename _Tp>
+inline _Tp* CircularMatrixBuffer<_Tp>::slot(int iPos) const
+{
+    return m_pBuffer + (iPos < (int)m_uiMaxNumMatrices ? iPos : iPos - (int)m_uiMaxNumMatrices) * m_uiMatrixSize;
+}
+
+//=============================================================================================================
+
+template<typename _Tp>
+inline int CircularMatrixBuffer<_Tp>::nextPos(int iPos) const
+{
+    return ++iPos == 2*(int)m_uiMaxNumMatrices ? 0 : iPos;
+}
+
+//=============================================================================================================
+
+template<typename _Tp>
+inline bool CircularMatrixBuffer<_Tp>::waitForSlot(bool bFree, int iTimeoutMs)
+{
+    QAtomicInt& iRelease = bFree ? m_iReleasePush : m_iReleasePop;
+    QWaitCondition& waitCondition = bFree ? m_slotFreed : m_slotFilled;
+
+    QElapsedTimer timer;
+    if(iTimeoutMs > 0) {
+        timer.start();
+    }
+
+    while(true) {
+        //Lock free fast path
+        int iUsed = usedSlots(m_iWritePos.loadAcquire(), m_iReadPos.loadAcquire());
+        if(bFree ? iUsed < (int)m_uiMaxNumMatrices : iUsed > 0) {
+            return true;
+        }
+
+        if(iRelease.fetchAndStoreOrdered(0) != 0 || iTimeoutMs == 0) {
+            return false;
+        }
+
+        unsigned long ulWaitMs = ULONG_MAX;
+        if(iTimeoutMs > 0) {
+            qint64 iRemaining = iTimeoutMs - timer.elapsed();
+            if(iRemaining <= 0) {
+                return false;
+            }
+            ulWaitMs = (unsigned long)iRemaining;
+        }
+
+        //Slow path: register as waiting before the final check, so the other side's wakeWaiting() cannot be missed
+        m_mutex.lock();
+        m_iNumWaiting.fetchAndAddOrdered(1);
+        iUsed = usedSlots(m_iWritePos.loadAcquire(), m_iReadPos.loadAcquire());
+        if((bFree ? iUsed >= (int)m_uiMaxNumMatrices : iUsed == 0) && iRelease.loadAcquire() == 0) {
+            waitCondition.wait(&m_mutex, ulWaitMs);
+        }
+        m_iNumWaiting.fetchAndAddOrdered(-1);
+        m_mutex.unlock();
+    }
+}
+
+//=============================================================================================================
+
+template<typename _Tp>
+inline void CircularMatrixBuffer<_Tp>::wakeWaiting()
+{
+    if(m_iNumWaiting.loadAcquire() > 0) {
+        m_mutex.lock();
+        m_slotFreed.wakeAll();
+        m_slotFilled.wakeAll();
+        m_mutex.unlock();
+    }
+}
+
+//=============================================================================================================
+
+template<typename _Tp>
+void CircularMatrixBuffer<_Tp>::clear()
+{
+    m_iReadPos.storeRelease(0);
+    m_iWritePos.storeRelease(0);
+    m_iReleasePop.storeRelease(0);
+    m_iReleasePush.storeRelease(0);
 }
 
 //=============================================================================================================
@@ -314,15 +583,13 @@ inline void CircularMatrixBuffer<_Tp>::pause(bool bPause)
 template<typename _Tp>
 inline bool CircularMatrixBuffer<_Tp>::releaseFromPop()
 {
-   if((uint)m_pUsedElements->available() < m_uiRows*m_uiCols)
+    if(usedSlots(m_iWritePos.loadAcquire(), m_iReadPos.loadAcquire()) == 0)
     {
-        //The last matrix which is to be popped from the buffer is supposed to be a zero matrix
-        unsigned int t_size = m_uiRows*m_uiCols;
-        for(unsigned int i = 0; i < t_size; ++i)
-            m_pBuffer[mapIndex(m_iCurrentWriteIndex)] = 0;
-
-        //Release (create) values from m_pUsedElements so that the pop function can leave the acquire statement in the pop function
-        m_pUsedElements->release(m_uiRows*m_uiCols);
+        //The blocked pop returns a zero matrix
+        m_mutex.lock();
+        m_iReleasePop.storeRelease(1);
+        m_slotFilled.wakeAll();
+        m_mutex.unlock();
 
         return true;
     }
@@ -335,15 +602,13 @@ inline bool CircularMatrixBuffer<_Tp>::releaseFromPop()
 template<typename _Tp>
 inline bool CircularMatrixBuffer<_Tp>::releaseFromPush()
 {
-    if((uint)m_pFreeElements->available() < m_uiRows*m_uiCols)
+    if(usedSlots(m_iWritePos.loadAcquire(), m_iReadPos.loadAcquire()) == (int)m_uiMaxNumMatrices)
     {
-        //The last matrix which is to be pushed to the buffer is supposed to be a zero matrix
-        unsigned int t_size = m_uiRows*m_uiCols;
-        for(unsigned int i = 0; i < t_size; ++i)
-            m_pBuffer[mapIndex(m_iCurrentWriteIndex)] = 0;
-
-        //Release (create) values from m_pFreeElements so that the push function can leave the acquire statement in the push function
-        m_pFreeElements->release(m_uiRows*m_uiCols);
+        //The blocked push returns without appending its matrix
+        m_mutex.lock();
+        m_iReleasePush.storeRelease(1);
+        m_slotFreed.wakeAll();
+        m_mutex.unlock();
 
         return true;
     }
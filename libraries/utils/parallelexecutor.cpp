@@ -0,0 +1,184 @@
+//=============================================================================================================
+/**
+ * @file     parallelexecutor.cpp
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    ParallelExecutor class definition.
+ *
+ */
+
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "parallelexecutor.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QAtomicInt>
+#include <QList>
+#include <QThread>
+#include <QtConcurrent>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace UTILSLIB;
+
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace {
+
+QAtomicInt s_iMaxThreads(0);            /**< The cap set by ParallelExecutor::setMaxThreads, 0 if none. */
+thread_local bool t_bInRegion = false;  /**< Whether the owning thread executes a parallel region. */
+
+/**
+ * Marks the calling thread as being inside a parallel region for its lifetime.
+ */
+class RegionGuard
+{
+public:
+    RegionGuard()
+    : m_bWasInRegion(t_bInRegion)
+    {
+        t_bInRegion = true;
+    }
+
+    ~RegionGuard()
+    {
+        t_bInRegion = m_bWasInRegion;
+    }
+
+private:
+    bool m_bWasInRegion;
+};
+
+} // anonymous namespace
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+void ParallelExecutor::setMaxThreads(int iMaxThreads)
+{
+    s_iMaxThreads.storeRelease(qMax(0, iMaxThreads));
+}
+
+//=============================================================================================================
+
+int ParallelExecutor::maxThreads()
+{
+    int iMaxThreads = QThread::idealThreadCount();
+
+    bool bOk = false;
+    int iEnvThreads = qEnvironmentVariableIntValue("MNECPP_MAX_THREADS", &bOk);
+    if(bOk && iEnvThreads > 0) {
+        iMaxThreads = qMin(iMaxThreads, iEnvThreads);
+    }
+
+    int iApiThreads = s_iMaxThreads.loadAcquire();
+    if(iApiThreads > 0) {
+        iMaxThreads = qMin(iMaxThreads, iApiThreads);
+    }
+
+    return qMax(1, iMaxThreads);
+}
+
+//=============================================================================================================
+
+int ParallelExecutor::threadCount(int iRequested)
+{
+    if(t_bInRegion) {
+        return 1;
+    }
+
+    int iMaxThreads = maxThreads();
+
+    return iRequested > 0 ? qMin(iRequested, iMaxThreads) : iMaxThreads;
+}
+
+//=============================================================================================================
+
+bool ParallelExecutor::isInParallelRegion()
+{
+    return t_bInRegion;
+}
+
+//=============================================================================================================
+
+void ParallelExecutor::run(const std::function<void(int, int)>& func,
+                           int iNumThreads)
+{
+    int iThreads = threadCount(iNumThreads);
+
+    if(iThreads <= 1) {
+        RegionGuard guard;
+        func(0, 1);
+        return;
+    }
+
+    QList<int> lThreads;
+    for(int i = 0; i < iThreads; ++i) {
+        lThreads.append(i);
+    }
+
+    std::function<void(int&)> runThread = [&](int& iThread) {
+        RegionGuard guard;
+        func(iThread, iThreads);
+    };
+
+    QtConcurrent::blockingMap(lThreads, runThread);
+}
+
+//=============================================================================================================
+
+void ParallelExecutor::parallelFor(int iCount,
+                                   const std::function<void(int)>& func,
+                                   int iNumThreads)
+{
+    if(iCount <= 0) {
+        return;
+    }
+
+    std::function<void(int, int)> runRange = [&](int iThread, int iThreads) {
+        int iBegin = static_cast<int>(static_cast<qint64>(iCount) * iThread / iThreads);
+        int iEnd = static_cast<int>(static_cast<qint64>(iCount) * (iThread + 1) / iThreads);
+
+        for(int i = iBegin; i < iEnd; ++i) {
+            func(i);
+        }
+    };
+
+    run(runRange, qMin(iCount, threadCount(iNumThreads)));
+}
@@ -0,0 +1,130 @@
+//=============================================================================================================
+/**
+ * @file     parallelexecutor.h
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    ParallelExecutor class declaration.
+ *
+ */
+
+
+#ifndef PARALLELEXECUTOR_H
+#define PARALLELEXECUTOR_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "utils_global.h"
+
+#include <functional>
+
+//=============================================================================================================
+// DEFINE NAMESPACE UTILSLIB
+//=============================================================================================================
+
+namespace UTILSLIB
+{
+
+//=============================================================================================================
+/**
+ * Runs the data parallel parts of the processing libraries on the global Qt thread pool. The number of threads
+ * used by one parallel region is capped by the number of processors, by the MNECPP_MAX_THREADS environment
+ * variable and by setMaxThreads(). Leaving some processors to the acquisition and display threads keeps a
+ * real-time pipeline responsive while e.g. dipole or HPI fits run in the background.
+ *
+ * Regions started from inside another region run serially on the calling thread, so nested parallel code
+ * never multiplies the number of threads.
+ *
+ * @brief Capped, nesting-aware parallel execution.
+ */
+class UTILSSHARED_EXPORT ParallelExecutor
+{
+public:
+    //=========================================================================================================
+    /**
+     * Caps the number of threads per parallel region for the whole process.
+     *
+     * @param[in] iMaxThreads    The maximal number of threads, 0 removes the cap set by this function.
+     */
+    static void setMaxThreads(int iMaxThreads);
+
+    //=========================================================================================================
+    /**
+     * Returns the maximal number of threads per parallel region, which is the smallest of the number of
+     * processors, the MNECPP_MAX_THREADS environment variable and the value set by setMaxThreads().
+     *
+     * @return The maximal number of threads, at least 1.
+     */
+    static int maxThreads();
+
+    //=========================================================================================================
+    /**
+     * Returns the number of threads a parallel region started from the calling thread would use.
+     *
+     * @param[in] iRequested     The requested number of threads, 0 requests maxThreads().
+     *
+     * @return The number of threads, 1 when called from inside a parallel region.
+     */
+    static int threadCount(int iRequested = 0);
+
+    //=========================================================================================================
+    /**
+     * Returns whether the calling thread currently executes a parallel region.
+     *
+     * @return True if inside a parallel region.
+     */
+    static bool isInParallelRegion();
+
+    //=========================================================================================================
+    /**
+     * Runs func once per thread and blocks until all threads are done. This is meant for work which keeps
+     * per-thread scratch data and distributes its items itself.
+     *
+     * @param[in] func           The function, called with the thread index and the number of threads.
+     * @param[in] iNumThreads    The requested number of threads, 0 requests maxThreads().
+     */
+    static void run(const std::function<void(int iThread, int iNumThreads)>& func,
+                    int iNumThreads = 0);
+
+    //=========================================================================================================
+    /**
+     * Calls func for all indices in [0, iCount) and blocks until all calls are done. Each thread handles one
+     * contiguous range of indices.
+     *
+     * @param[in] iCount         The number of indices.
+     * @param[in] func           The function, called with the index.
+     * @param[in] iNumThreads    The requested number of threads, 0 requests maxThreads().
+     */
+    static void parallelFor(int iCount,
+                            const std::function<void(int iIdx)>& func,
+                            int iNumThreads = 0);
+};
+} // NAMESPACE UTILSLIB
+
+#endif // PARALLELEXECUTOR_H
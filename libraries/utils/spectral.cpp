@@ -41,6 +41,7 @@
 //=============================================================================================================
 
 #include "spectral.h"
+#include "parallelexecutor.h"
 #include "math.h"
 
 //=============================================================================================================
@@ -54,8 +55,18 @@
 //=============================================================================================================
 
 #include <QtMath>
-#include <QtConcurrent>
 #include <QVector>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+//=============================================================================================================
+// STL INCLUDES
+//=============================================================================================================
+
+#include <cmath>
+#include <limits>
+#include <functional>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -64,6 +75,178 @@
 using namespace UTILSLIB;
 using namespace Eigen;
 
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace {
+
+QMutex s_taperCacheMutex;
+QHash<QString, QPair<MatrixXd, VectorXd> > s_taperCache;
+
+const int TAPER_CACHE_SIZE = 64;
+
+/**
+ * Returns the cached tapers for sKey, computing and storing them with computeTapers if they are not cached yet.
+ */
+QPair<MatrixXd, VectorXd> cachedTapers(const QString& sKey,
+                                       const std::function<QPair<MatrixXd, VectorXd>()>& computeTapers)
+{
+    {
+        QMutexLocker locker(&s_taperCacheMutex);
+
+        if(s_taperCache.contains(sKey)) {
+            return s_taperCache.value(sKey);
+        }
+    }
+
+    QPair<MatrixXd, VectorXd> pairTapers = computeTapers();
+
+    QMutexLocker locker(&s_taperCacheMutex);
+
+    if(s_taperCache.size() >= TAPER_CACHE_SIZE) {
+        s_taperCache.clear();
+    }
+
+    s_taperCache.insert(sKey, pairTapers);
+
+    return pairTapers;
+}
+
+//=============================================================================================================
+
+/**
+ * Solves (T - dShift * I) x = b for the symmetric tridiagonal matrix T with the given diagonal and off diagonal,
+ * using Gaussian elimination with partial pivoting. The solution overwrites vecB.
+ */
+void solveShiftedTridiagonal(const VectorXd& vecDiag,
+                             const VectorXd& vecOffDiag,
+                             double dShift,
+                             VectorXd& vecB)
+{
+    int n = vecDiag.size();
+
+    VectorXd d = vecDiag.array() - dShift;
+    VectorXd dl = vecOffDiag;
+    VectorXd du = vecOffDiag;
+    VectorXd du2 = VectorXd::Zero(qMax(n - 2, 0));
+    VectorXi ipiv = VectorXi::LinSpaced(qMax(n - 1, 0), 0, qMax(n - 2, 0));
+
+    double dFact, dTemp;
+
+    // Factorization
+    for(int i = 0; i < n - 1; ++i) {
+        if(std::fabs(d(i)) >= std::fabs(dl(i))) {
+            if(d(i) != 0.0) {
+                dFact = dl(i) / d(i);
+                dl(i) = dFact;
+                d(i + 1) -= dFact * du(i);
+            }
+        } else {
+            dFact = d(i) / dl(i);
+            d(i) = dl(i);
+            dl(i) = dFact;
+            dTemp = du(i);
+            du(i) = d(i + 1);
+            d(i + 1) = dTemp - dFact * d(i + 1);
+
+            if(i < n - 2) {
+                du2(i) = du(i + 1);
+                du(i + 1) = -dFact * du(i + 1);
+            }
+
+            ipiv(i) = i + 1;
+        }
+    }
+
+    // Guard against exactly singular pivots, which occur when the shift is an exact eigenvalue
+    double dEps = std::numeric_limits<double>::epsilon() * qMax(vecDiag.cwiseAbs().maxCoeff(), 1.0);
+
+    for(int i = 0; i < n; ++i) {
+        if(std::fabs(d(i)) < dEps) {
+            d(i) = d(i) < 0.0 ? -dEps : dEps;
+        }
+    }
+
+    // Forward substitution with the row interchanges
+    for(int i = 0; i < n - 1; ++i) {
+        if(ipiv(i) == i) {
+            vecB(i + 1) -= dl(i) * vecB(i);
+        } else {
+            dTemp = vecB(i);
+            vecB(i) = vecB(i + 1);
+            vecB(i + 1) = dTemp - dl(i) * vecB(i);
+        }
+    }
+
+    // Back substitution
+    vecB(n - 1) /= d(n - 1);
+
+    if(n > 1) {
+        vecB(n - 2) = (vecB(n - 2) - du(n - 2) * vecB(n - 1)) / d(n - 2);
+    }
+
+    for(int i = n - 3; i >= 0; --i) {
+        vecB(i) = (vecB(i) - du(i) * vecB(i + 1) - du2(i) * vecB(i + 2)) / d(i);
+    }
+}
+
+/**
+ * Returns the eigenvalue with the given ascending index of the symmetric tridiagonal matrix with the given diagonal
+ * and off diagonal. The eigenvalue is found by bisection on the Sturm sequence count.
+ */
+double tridiagonalEigenvalue(const VectorXd& vecDiag,
+                             const VectorXd& vecOffDiag,
+                             int iIndex)
+{
+    int n = vecDiag.size();
+
+    // Gershgorin bounds
+    double dLower = vecDiag(0), dUpper = vecDiag(0);
+
+    for(int i = 0; i < n; ++i) {
+        double dRadius = (i > 0 ? std::fabs(vecOffDiag(i - 1)) : 0.0) + (i < n - 1 ? std::fabs(vecOffDiag(i)) : 0.0);
+        dLower = qMin(dLower, vecDiag(i) - dRadius);
+        dUpper = qMax(dUpper, vecDiag(i) + dRadius);
+    }
+
+    double dTiny = std::numeric_limits<double>::min();
+
+    for(int iIter = 0; iIter < 200; ++iIter) {
+        double dMid = 0.5 * (dLower + dUpper);
+
+        if(dMid <= dLower || dMid >= dUpper) {
+            break;
+        }
+
+        // Number of eigenvalues below dMid
+        int iCount = 0;
+        double dQ = 1.0;
+
+        for(int i = 0; i < n; ++i) {
+            dQ = vecDiag(i) - dMid - (i > 0 ? vecOffDiag(i - 1) * vecOffDiag(i - 1) / dQ : 0.0);
+
+            if(dQ == 0.0) {
+                dQ = -dTiny;
+            }
+
+            if(dQ < 0.0) {
+                ++iCount;
+            }
+        }
+
+        if(iCount > iIndex) {
+            dUpper = dMid;
+        } else {
+            dLower = dMid;
+        }
+    }
+
+    return 0.5 * (dLower + dUpper);
+}
+
+}
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
@@ -105,61 +288,46 @@ QVector<MatrixXcd> Spectral::computeTaperedSpectraMatrix(const MatrixXd &matData
         fftw_make_planner_thread_safe();
     #endif
 
-    QVector<MatrixXcd> finalResult;
+    QVector<MatrixXcd> finalResult(matData.rows());
+
+    //Check inputs
+    if (matData.cols() != matTaper.cols() || iNfft < matData.cols()) {
+        return finalResult;
+    }
 
-    if(!bUseMultithread) {
-        // Sequential
-//        QElapsedTimer timer;
-//        int iTime = 0;
-//        int iTimeAll = 0;
-//        timer.start();
+    int iNFreqs = int(floor(iNfft / 2.0)) + 1;
+    MatrixXcd* pResult = finalResult.data();
 
+    std::function<void(int, int)> computeRows = [&](int iThread, int iNumThreads) {
+        int iBegin = int(qint64(matData.rows()) * iThread / iNumThreads);
+        int iEnd = int(qint64(matData.rows()) * (iThread + 1) / iNumThreads);
+
+        // One FFT object per thread, so that the plan is reused for all rows and tapers of this block
         FFT<double> fft;
         fft.SetFlag(fft.HalfSpectrum);
 
-        RowVectorXd vecInputFFT, rowData;
+        RowVectorXd vecInputFFT;
         RowVectorXcd vecTmpFreq;
 
-        MatrixXcd matTapSpectrum(matTaper.rows(), int(floor(iNfft / 2.0)) + 1);
-        int j;
-        for (int i = 0; i < matData.rows(); ++i) {
-            rowData = matData.row(i);
+        for (int i = iBegin; i < iEnd; ++i) {
+            MatrixXcd matTapSpectrum(matTaper.rows(), iNFreqs);
 
             //FFT for freq domain returning the half spectrum
-            for (j = 0; j < matTaper.rows(); j++) {
-                vecInputFFT = rowData.cwiseProduct(matTaper.row(j));
+            for (int j = 0; j < matTaper.rows(); ++j) {
+                vecInputFFT = matData.row(i).cwiseProduct(matTaper.row(j));
                 fft.fwd(vecTmpFreq, vecInputFFT, iNfft);
                 matTapSpectrum.row(j) = vecTmpFreq;
             }
 
-            finalResult.append(matTapSpectrum);
-
-//            iTime = timer.elapsed();
-//            qDebug() << QThread::currentThreadId() << "Spectral::computeTaperedSpectraMatrix - Row-wise computation:" << iTime;
-//            iTimeAll += iTime;
-//            timer.restart();
+            pResult[i] = matTapSpectrum;
         }
+    };
 
-//        qDebug() << QThread::currentThreadId() << "Spectral::computeTaperedSpectraMatrix - Complete computation:" << iTimeAll;
+    if(bUseMultithread) {
+        ParallelExecutor::run(computeRows,
+                              qMin(int(matData.rows()), ParallelExecutor::threadCount()));
     } else {
-        // Parallel
-        QList<TaperedSpectraInputData> lData;
-        TaperedSpectraInputData dataTemp;
-        dataTemp.matTaper = matTaper;
-        dataTemp.iNfft = iNfft;
-
-        for (int i = 0; i < matData.rows(); ++i) {
-            dataTemp.vecData = matData.row(i);
-
-            lData.append(dataTemp);
-        }
-
-        QFuture<QVector<MatrixXcd> > result = QtConcurrent::mappedReduced(lData,
-                                                                          compute,
-                                                                          reduce,
-                                                                          QtConcurrent::OrderedReduce);
-        result.waitForFinished();
-        finalResult = result.result();
+        computeRows(0, 1);
     }
 
     return finalResult;
@@ -282,18 +450,56 @@ VectorXd Spectral::calculateFFTFreqs(int iNfft, double dSampFreq)
 
 QPair<MatrixXd, VectorXd> Spectral::generateTapers(int iSignalLength, const QString &sWindowType)
 {
-    QPair<MatrixXd, VectorXd> pairOut;
-    if (sWindowType == "hanning") {
-        pairOut.first = hanningWindow(iSignalLength);
-        pairOut.second = VectorXd::Ones(1);
-    } else if (sWindowType == "ones") {
-        pairOut.first = MatrixXd::Ones(1, iSignalLength) / double(iSignalLength);
-        pairOut.second = VectorXd::Ones(1);
-    } else {
-        pairOut.first = hanningWindow(iSignalLength);
-        pairOut.second = VectorXd::Ones(1);
+    if (sWindowType == "dpss") {
+        return generateDpssTapers(iSignalLength);
+    }
+
+    return cachedTapers(QString("%1_%2").arg(sWindowType).arg(iSignalLength), [&]() {
+        QPair<MatrixXd, VectorXd> pairOut;
+        if (sWindowType == "hanning") {
+            pairOut.first = hanningWindow(iSignalLength);
+            pairOut.second = VectorXd::Ones(1);
+        } else if (sWindowType == "ones") {
+            pairOut.first = MatrixXd::Ones(1, iSignalLength) / double(iSignalLength);
+            pairOut.second = VectorXd::Ones(1);
+        } else {
+            pairOut.first = hanningWindow(iSignalLength);
+            pairOut.second = VectorXd::Ones(1);
+        }
+        return pairOut;
+    });
+}
+
+//=============================================================================================================
+
+QPair<MatrixXd, VectorXd> Spectral::generateDpssTapers(int iSignalLength,
+                                                       double dHalfBandwidth,
+                                                       int iNumTapers)
+{
+    if(iNumTapers < 1) {
+        iNumTapers = qMax(1, int(floor(2.0 * dHalfBandwidth - 1.0)));
+    }
+
+    if(iSignalLength < 1 || dHalfBandwidth <= 0.0) {
+        return QPair<MatrixXd, VectorXd>(MatrixXd(), VectorXd());
     }
-    return pairOut;
+
+    iNumTapers = qMin(iNumTapers, iSignalLength);
+
+    return cachedTapers(QString("dpss_%1_%2_%3").arg(iSignalLength).arg(dHalfBandwidth, 0, 'g', 17).arg(iNumTapers), [&]() {
+        return dpssWindows(iSignalLength,
+                           dHalfBandwidth,
+                           iNumTapers);
+    });
+}
+
+//=============================================================================================================
+
+int Spectral::taperCacheSize()
+{
+    QMutexLocker locker(&s_taperCacheMutex);
+
+    return s_taperCache.size();
 }
 
 //=============================================================================================================
@@ -310,3 +516,83 @@ MatrixXd Spectral::hanningWindow(int iSignalLength)
 
     return matHann;
 }
+
+//=============================================================================================================
+
+QPair<MatrixXd, VectorXd> Spectral::dpssWindows(int iSignalLength,
+                                                double dHalfBandwidth,
+                                                int iNumTapers)
+{
+    int n = iSignalLength;
+    double dW = dHalfBandwidth / double(n);
+
+    // Symmetric tridiagonal matrix which commutes with the time and band limiting operator (Slepian, 1978)
+    VectorXd vecDiag(n), vecOffDiag(qMax(n - 1, 0));
+
+    for(int i = 0; i < n; ++i) {
+        vecDiag(i) = std::pow((n - 1 - 2.0 * i) / 2.0, 2) * std::cos(2.0 * M_PI * dW);
+    }
+
+    for(int i = 1; i < n; ++i) {
+        vecOffDiag(i - 1) = double(i) * (n - i) / 2.0;
+    }
+
+    // The tapers are the eigenvectors of the largest eigenvalues, which are obtained by inverse iteration
+    MatrixXd matTapers(iNumTapers, n);
+    VectorXd vecTaper;
+
+    for(int k = 0; k < iNumTapers; ++k) {
+        double dEigenvalue = tridiagonalEigenvalue(vecDiag, vecOffDiag, n - 1 - k);
+
+        vecTaper = VectorXd::Ones(n) / std::sqrt(double(n));
+
+        // Break the symmetry of the start vector so that antisymmetric tapers are reached as well
+        vecTaper += VectorXd::LinSpaced(n, 0.0, 1.0) / std::sqrt(double(n));
+
+        for(int iIter = 0; iIter < 3; ++iIter) {
+            solveShiftedTridiagonal(vecDiag, vecOffDiag, dEigenvalue, vecTaper);
+            vecTaper.normalize();
+        }
+
+        // Symmetric tapers get a positive mean, antisymmetric tapers start with a positive lobe
+        double dSign = (k % 2 == 0) ? vecTaper.sum() : vecTaper.dot(VectorXd::LinSpaced(n, n - 1.0, 1.0 - n));
+
+        if(dSign < 0.0) {
+            vecTaper = -vecTaper;
+        }
+
+        matTapers.row(k) = vecTaper.transpose();
+    }
+
+    // Concentration ratios from the autocorrelation of each taper, used as taper weights
+    int iNfft = 1;
+    while(iNfft < 2 * n) {
+        iNfft *= 2;
+    }
+
+    FFT<double> fft;
+    VectorXd vecSinc(n);
+    vecSinc(0) = 2.0 * dW;
+
+    for(int i = 1; i < n; ++i) {
+        vecSinc(i) = 2.0 * std::sin(2.0 * M_PI * dW * i) / (M_PI * i);
+    }
+
+    VectorXd vecWeights(iNumTapers);
+    VectorXd vecPadded, vecAutoCorr;
+    VectorXcd vecFreq;
+
+    for(int k = 0; k < iNumTapers; ++k) {
+        vecPadded = VectorXd::Zero(iNfft);
+        vecPadded.head(n) = matTapers.row(k).transpose();
+
+        fft.fwd(vecFreq, vecPadded);
+        vecFreq = vecFreq.cwiseAbs2().cast<std::complex<double> >();
+        fft.inv(vecAutoCorr, vecFreq);
+
+        double dRatio = vecAutoCorr.head(n).dot(vecSinc);
+        vecWeights(k) = std::sqrt(qBound(0.0, dRatio, 1.0));
+    }
+
+    return QPair<MatrixXd, VectorXd>(matTapers, vecWeights);
+}
@@ -104,7 +104,8 @@ public:
 
     //=========================================================================================================
     /**
-     * Calculates the full tapered spectra of a given input matrix data. This function calculates each row in parallel.
+     * Calculates the full tapered spectra of a given input matrix data. The rows are split into one contiguous block
+     * per thread and each thread runs the FFTs of all taper and row combinations of its block with one FFT object.
      *
      * @param[in] matData         input matrix data (time domain), for which the spectrum is computed.
      * @param[in] matTaper        tapers used to compute the spectra.
@@ -187,9 +188,11 @@ public:
 
     //=========================================================================================================
     /**
-     * Calculates a hanning window of given length
+     * Generates the tapers of a given window type and length. Supported types are "hanning", "ones" and "dpss".
+     * The "dpss" type returns the multitaper bank of generateDpssTapers with its default parameters. The tapers are
+     * computed once per type and length and taken from a cache afterwards.
      *
-     * @param[in] iSignalLength    length of the hanning window
+     * @param[in] iSignalLength    length of the tapers
      * @param[in] sWindowType      type of the window function used to compute tapered spectra
      *
      * @return Qpair of tapers and taper weights
@@ -197,6 +200,30 @@ public:
     static QPair<Eigen::MatrixXd, Eigen::VectorXd> generateTapers(int iSignalLength,
                                                                   const QString &sWindowType = "hanning");
 
+    //=========================================================================================================
+    /**
+     * Generates discrete prolate spheroidal sequences (DPSS, Slepian tapers) for multitaper spectral estimation.
+     * The taper weights are the square roots of the spectral concentration ratios. The taper bank is computed once
+     * per length, half bandwidth and number of tapers and taken from a cache afterwards.
+     *
+     * @param[in] iSignalLength    length of the tapers
+     * @param[in] dHalfBandwidth   time half bandwidth product NW. Default is 4.
+     * @param[in] iNumTapers       number of tapers. Default (-1) uses 2 * NW - 1.
+     *
+     * @return Qpair of tapers (one taper per row) and taper weights
+     */
+    static QPair<Eigen::MatrixXd, Eigen::VectorXd> generateDpssTapers(int iSignalLength,
+                                                                      double dHalfBandwidth = 4.0,
+                                                                      int iNumTapers = -1);
+
+    //=========================================================================================================
+    /**
+     * Returns the number of taper banks held in the cache of generateTapers and generateDpssTapers.
+     *
+     * @return the number of cached taper banks
+     */
+    static int taperCacheSize();
+
 private:
     //=========================================================================================================
     /**
@@ -207,6 +234,21 @@ private:
      * @return hanning window
      */
     static Eigen::MatrixXd hanningWindow(int iSignalLength);
+
+    //=========================================================================================================
+    /**
+     * Computes the DPSS tapers and their concentration ratios. The tapers are the eigenvectors of the tridiagonal
+     * matrix which commutes with the time and band limiting operator, found by bisection and inverse iteration.
+     *
+     * @param[in] iSignalLength     length of the tapers
+     * @param[in] dHalfBandwidth    time half bandwidth product NW
+     * @param[in] iNumTapers        number of tapers
+     *
+     * @return Qpair of tapers and taper weights
+     */
+    static QPair<Eigen::MatrixXd, Eigen::VectorXd> dpssWindows(int iSignalLength,
+                                                               double dHalfBandwidth,
+                                                               int iNumTapers);
 };
 
 //=============================================================================================================
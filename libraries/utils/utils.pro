@@ -67,6 +67,7 @@ SOURCES += \
     layoutmaker.cpp \
     selectionio.cpp \
     filterTools/cosinefilter.cpp \
+    filterTools/butterworthfilter.cpp \
     filterTools/parksmcclellan.cpp \
     filterTools/filterdata.cpp \
     filterTools/filterio.cpp \
@@ -75,6 +76,7 @@ SOURCES += \
     warp.cpp \
     filterTools/sphara.cpp \
     sphere.cpp \
+    parallelexecutor.cpp \
     generics/buffer.cpp \
     generics/circularbuffer.cpp \
     generics/circularmatrixbuffer.cpp \
@@ -92,6 +94,7 @@ HEADERS += \
     selectionio.h \
     layoutmaker.h \
     filterTools/cosinefilter.h \
+    filterTools/butterworthfilter.h \
     filterTools/parksmcclellan.h \
     filterTools/filterdata.h \
     filterTools/filterio.h \
@@ -100,6 +103,7 @@ HEADERS += \
     warp.h \
     filterTools/sphara.h \
     sphere.h \
+    parallelexecutor.h \
     simplex_algorithm.h \
     generics/buffer.h \
     generics/circularbuffer.h \
@@ -0,0 +1,412 @@
+//=============================================================================================================
+/**
+ * @file     test_connectivity_network.cpp
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test for the edge storage of the connectivity network.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+
+#include <connectivity/network/network.h>
+#include <connectivity/network/networkedge.h>
+#include <connectivity/network/networknode.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Dense>
+
+//=============================================================================================================
+// STL INCLUDES
+//=============================================================================================================
+
+#include <cmath>
+#include <limits>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace CONNECTIVITYLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestConnectivityNetwork
+ *
+ * @brief The TestConnectivityNetwork class compares the network with results computed from per edge objects.
+ *
+ */
+class TestConnectivityNetwork: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestConnectivityNetwork();
+
+private slots:
+    void initTestCase();
+    void init();
+    void compareFullConnectivityMatrix();
+    void compareThresholdedEdges();
+    void compareDegrees();
+    void compareFrequencyRange();
+    void compareAppendNode();
+    void cleanupTestCase();
+
+private:
+    //=========================================================================================================
+    /**
+     * Computes the connectivity matrix from the reference edges like the former edge list based network did.
+     *
+     * @param[in] dThreshold             Only edges with an absolute weight of at least this threshold are used.
+     * @param[in] bGetMirroredVersion    Whether to mirror the weights to the lower triangle.
+     *
+     * @return The reference connectivity matrix.
+     */
+    MatrixXd referenceConnectivityMatrix(double dThreshold,
+                                         bool bGetMirroredVersion) const;
+
+    //=========================================================================================================
+    /**
+     * Counts the reference edges which start or end at each node.
+     *
+     * @param[in] dThreshold    Only edges with an absolute weight of at least this threshold are counted.
+     *
+     * @return The reference degree of each node.
+     */
+    VectorXi referenceDegrees(double dThreshold) const;
+
+    //=========================================================================================================
+    /**
+     * Compares the thresholded edges of a network with the reference edges.
+     *
+     * @param[in] network       The network to compare.
+     * @param[in] dThreshold    The threshold the network was set to.
+     */
+    void compareEdges(const Network& network,
+                      double dThreshold) const;
+
+    double                      m_dEpsilon;
+    int                         m_iNumberNodes;
+    int                         m_iNumberBins;
+    Network                     m_network;
+    QList<NetworkEdge::SPtr>    m_lEdges;       /**< Reference edges, appended in the same order as to the network.*/
+};
+
+//=============================================================================================================
+
+TestConnectivityNetwork::TestConnectivityNetwork()
+: m_dEpsilon(1e-12)
+, m_iNumberNodes(6)
+, m_iNumberBins(8)
+, m_network("PLI")
+{
+}
+
+//=============================================================================================================
+
+void TestConnectivityNetwork::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    for(int i = 0; i < m_iNumberNodes; ++i) {
+        RowVectorXf vecVert(3);
+        vecVert << i, 2.0f * i, 3.0f * i;
+        m_network.append(NetworkNode::SPtr(new NetworkNode(i, vecVert)));
+    }
+
+    // Half of a spectrum from 0 to 50 Hz with one bin every 6.25 Hz
+    m_network.setSamplingFrequency(100.0f);
+    m_network.setFFTSize(m_iNumberBins);
+    m_network.setUsedFreqBins(m_iNumberBins);
+
+    // Mostly undirected edges with a few gaps and one directed edge (4,1) without its counterpart. Every other
+    // edge is appended as edge object, the others through their weights only.
+    for(int i = 0; i < m_iNumberNodes; ++i) {
+        for(int j = 0; j < m_iNumberNodes; ++j) {
+            if(!((i < j && (i + j) % 4 != 1) || (i == 4 && j == 1))) {
+                continue;
+            }
+
+            MatrixXd matWeight(m_iNumberBins, 1);
+
+            for(int k = 0; k < m_iNumberBins; ++k) {
+                matWeight(k,0) = 0.5 + 0.4 * std::sin(1.3 * k + 0.7 * i + 1.1 * j);
+            }
+
+            if(m_lEdges.size() % 2 == 0) {
+                m_network.append(NetworkEdge::SPtr(new NetworkEdge(i, j, matWeight)));
+            } else {
+                m_network.append(i, j, matWeight.col(0).transpose());
+            }
+
+            m_lEdges << NetworkEdge::SPtr(new NetworkEdge(i, j, matWeight));
+        }
+    }
+
+    // Self-connections are ignored
+    m_network.append(2, 2, RowVectorXd::Ones(m_iNumberBins));
+
+    QVERIFY(!m_network.isEmpty());
+}
+
+//=============================================================================================================
+
+void TestConnectivityNetwork::init()
+{
+    // The reference edges average over all bins unless a test sets a frequency range
+    for(int i = 0; i < m_lEdges.size(); ++i) {
+        m_lEdges.at(i)->setFrequencyBins(QPair<int,int>(-1,-1));
+    }
+}
+
+//=============================================================================================================
+
+void TestConnectivityNetwork::compareFullConnectivityMatrix()
+{
+    QVERIFY(m_network.getFullConnectivityMatrix().isApprox(referenceConnectivityMatrix(0.0, true), m_dEpsilon));
+    QVERIFY(m_network.getFullConnectivityMatrix(false).isApprox(referenceConnectivityMatrix(0.0, false), m_dEpsilon));
+
+    QList<NetworkEdge::SPtr> lEdges = m_network.getFullEdges();
+    QVERIFY(lEdges.size() == m_lEdges.size());
+
+    for(int i = 0; i < lEdges.size(); ++i) {
+        QVERIFY(lEdges.at(i)->getStartNodeID() == m_lEdges.at(i)->getStartNodeID());
+        QVERIFY(lEdges.at(i)->getEndNodeID() == m_lEdges.at(i)->getEndNodeID());
+        QVERIFY(std::fabs(lEdges.at(i)->getWeight() - m_lEdges.at(i)->getWeight()) < m_dEpsilon);
+        QVERIFY(lEdges.at(i)->getMatrixWeight() == m_lEdges.at(i)->getMatrixWeight());
+    }
+}
+
+//=============================================================================================================
+
+void TestConnectivityNetwork::compareThresholdedEdges()
+{
+    // Copies of a network are thresholded independently
+    Network network = m_network;
+    network.setThreshold(0.5);
+
+    compareEdges(network, 0.5);
+    compareEdges(m_network, 0.0);
+
+    QVERIFY(network.getThresholdedConnectivityMatrix().isApprox(referenceConnectivityMatrix(0.5, true), m_dEpsilon));
+    QVERIFY(network.getThresholdedConnectivityMatrix(false).isApprox(referenceConnectivityMatrix(0.5, false), m_dEpsilon));
+    QVERIFY(MatrixXd(network.getThresholdedSparseConnectivityMatrix()).isApprox(referenceConnectivityMatrix(0.5, false), m_dEpsilon));
+}
+
+//=============================================================================================================
+
+void TestConnectivityNetwork::compareDegrees()
+{
+    Network network = m_network;
+    network.setThreshold(0.5);
+
+    VectorXi vecFullDegrees = referenceDegrees(0.0);
+    VectorXi vecThresholdedDegrees = referenceDegrees(0.5);
+
+    QVERIFY(network.getFullDegrees() == vecFullDegrees);
+    QVERIFY(network.getThresholdedDegrees() == vecThresholdedDegrees);
+    QVERIFY(network.getFullDistribution() == vecFullDegrees.sum());
+    QVERIFY(network.getThresholdedDistribution() == vecThresholdedDegrees.sum());
+    QVERIFY(network.getMinMaxFullDegrees().first == vecFullDegrees.minCoeff());
+    QVERIFY(network.getMinMaxFullDegrees().second == vecFullDegrees.maxCoeff());
+
+    QList<NetworkNode::SPtr> lNodes = network.getNodes();
+    QVERIFY(lNodes.size() == m_iNumberNodes);
+
+    for(int i = 0; i < lNodes.size(); ++i) {
+        QVERIFY(lNodes.at(i)->getFullDegree() == vecFullDegrees(i));
+        QVERIFY(lNodes.at(i)->getThresholdedDegree() == vecThresholdedDegrees(i));
+        QVERIFY(lNodes.at(i)->getVert()(2) == 3.0f * i);
+    }
+}
+
+//=============================================================================================================
+
+void TestConnectivityNetwork::compareFrequencyRange()
+{
+    Network network = m_network;
+
+    // 10 to 30 Hz covers the bins 1 to 4
+    network.setFrequencyRange(10.0f, 30.0f);
+    network.setThreshold(0.5);
+
+    for(int i = 0; i < m_lEdges.size(); ++i) {
+        m_lEdges.at(i)->setFrequencyBins(QPair<int,int>(1,4));
+    }
+
+    QVERIFY(network.getFullConnectivityMatrix().isApprox(referenceConnectivityMatrix(0.0, true), m_dEpsilon));
+    compareEdges(network, 0.5);
+    QVERIFY(network.getThresholdedDegrees() == referenceDegrees(0.5));
+
+    double dMin = std::numeric_limits<double>::max();
+    double dMax = 0.0;
+
+    for(int i = 0; i < m_lEdges.size(); ++i) {
+        dMin = qMin(dMin, std::fabs(m_lEdges.at(i)->getWeight()));
+        dMax = qMax(dMax, std::fabs(m_lEdges.at(i)->getWeight()));
+    }
+
+    QVERIFY(std::fabs(network.getMinMaxFullWeights().first - dMin) < m_dEpsilon);
+    QVERIFY(std::fabs(network.getMinMaxFullWeights().second - dMax) < m_dEpsilon);
+
+    // The original network keeps averaging over all bins
+    for(int i = 0; i < m_lEdges.size(); ++i) {
+        m_lEdges.at(i)->setFrequencyBins(QPair<int,int>(-1,-1));
+    }
+
+    QVERIFY(m_network.getFullConnectivityMatrix().isApprox(referenceConnectivityMatrix(0.0, true), m_dEpsilon));
+}
+
+//=============================================================================================================
+
+void TestConnectivityNetwork::compareAppendNode()
+{
+    Network network = m_network;
+
+    RowVectorXf vecVert = RowVectorXf::Ones(3);
+    network.append(NetworkNode::SPtr(new NetworkNode(m_iNumberNodes, vecVert)));
+
+    // The edges keep their weights and the new node is not connected
+    MatrixXd matDist = network.getFullConnectivityMatrix(false);
+    QVERIFY(matDist.rows() == m_iNumberNodes + 1 && matDist.cols() == m_iNumberNodes + 1);
+    QVERIFY(matDist.topLeftCorner(m_iNumberNodes, m_iNumberNodes).isApprox(referenceConnectivityMatrix(0.0, false), m_dEpsilon));
+    QVERIFY(matDist.row(m_iNumberNodes).isZero() && matDist.col(m_iNumberNodes).isZero());
+    QVERIFY(network.getFullDegrees()(m_iNumberNodes) == 0);
+
+    for(int i = 0; i < m_lEdges.size(); ++i) {
+        QVERIFY(network.getEdgeWeights(m_lEdges.at(i)->getStartNodeID(), m_lEdges.at(i)->getEndNodeID()) == m_lEdges.at(i)->getMatrixWeight().col(0));
+    }
+
+    // Averaging over the grown weight block and connecting the new node
+    network.setFrequencyRange(10.0f, 30.0f);
+    network.append(m_iNumberNodes, 0, RowVectorXd::Constant(m_iNumberBins, 0.25));
+
+    for(int i = 0; i < m_lEdges.size(); ++i) {
+        m_lEdges.at(i)->setFrequencyBins(QPair<int,int>(1,4));
+    }
+
+    matDist = network.getFullConnectivityMatrix(false);
+    QVERIFY(matDist.allFinite());
+    QVERIFY(matDist.topLeftCorner(m_iNumberNodes, m_iNumberNodes).isApprox(referenceConnectivityMatrix(0.0, false), m_dEpsilon));
+    QVERIFY(std::fabs(matDist(m_iNumberNodes,0) - 0.25) < m_dEpsilon);
+    QVERIFY(network.getFullDegrees()(m_iNumberNodes) == 1);
+}
+
+//=============================================================================================================
+
+void TestConnectivityNetwork::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+MatrixXd TestConnectivityNetwork::referenceConnectivityMatrix(double dThreshold,
+                                                              bool bGetMirroredVersion) const
+{
+    MatrixXd matDist = MatrixXd::Zero(m_iNumberNodes, m_iNumberNodes);
+
+    for(int i = 0; i < m_lEdges.size(); ++i) {
+        if(std::fabs(m_lEdges.at(i)->getWeight()) < dThreshold) {
+            continue;
+        }
+
+        int row = m_lEdges.at(i)->getStartNodeID();
+        int col = m_lEdges.at(i)->getEndNodeID();
+
+        matDist(row,col) = m_lEdges.at(i)->getWeight();
+
+        if(bGetMirroredVersion) {
+            matDist(col,row) = m_lEdges.at(i)->getWeight();
+        }
+    }
+
+    return matDist;
+}
+
+//=============================================================================================================
+
+VectorXi TestConnectivityNetwork::referenceDegrees(double dThreshold) const
+{
+    VectorXi vecDegrees = VectorXi::Zero(m_iNumberNodes);
+
+    for(int i = 0; i < m_lEdges.size(); ++i) {
+        if(std::fabs(m_lEdges.at(i)->getWeight()) >= dThreshold) {
+            vecDegrees(m_lEdges.at(i)->getStartNodeID())++;
+            vecDegrees(m_lEdges.at(i)->getEndNodeID())++;
+        }
+    }
+
+    return vecDegrees;
+}
+
+//=============================================================================================================
+
+void TestConnectivityNetwork::compareEdges(const Network& network,
+                                           double dThreshold) const
+{
+    QList<NetworkEdge::SPtr> lEdges = network.getThresholdedEdges();
+    int iEdge = 0;
+
+    for(int i = 0; i < m_lEdges.size(); ++i) {
+        if(std::fabs(m_lEdges.at(i)->getWeight()) < dThreshold) {
+            continue;
+        }
+
+        QVERIFY(iEdge < lEdges.size());
+        QVERIFY(lEdges.at(iEdge)->isActive());
+        QVERIFY(lEdges.at(iEdge)->getStartNodeID() == m_lEdges.at(i)->getStartNodeID());
+        QVERIFY(lEdges.at(iEdge)->getEndNodeID() == m_lEdges.at(i)->getEndNodeID());
+        QVERIFY(std::fabs(lEdges.at(iEdge)->getWeight() - m_lEdges.at(i)->getWeight()) < m_dEpsilon);
+        QVERIFY(lEdges.at(iEdge)->getMatrixWeight() == m_lEdges.at(i)->getMatrixWeight());
+        ++iEdge;
+    }
+
+    QVERIFY(iEdge == lEdges.size());
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestConnectivityNetwork)
+#include "test_connectivity_network.moc"
@@ -39,18 +39,25 @@
 
 #include <inverse/dipoleFit/dipole_fit_settings.h>
 #include <inverse/dipoleFit/dipole_fit.h>
+#include <inverse/dipoleFit/dipole_fit_data.h>
+#include <inverse/dipoleFit/dipole_forward.h>
+#include <inverse/dipoleFit/guess_data.h>
+
+#include <fwd/fwd_coil_set.h>
 
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
 
 #include <QtTest>
+#include <QTemporaryDir>
 
 //=============================================================================================================
 // USED NAMESPACES
 //=============================================================================================================
 
 using namespace INVERSELIB;
+using namespace Eigen;
 
 //=============================================================================================================
 /**
@@ -70,12 +77,22 @@ private slots:
     void initTestCase();
     void dipoleFitSimple();
     void dipoleFitAdvanced();
+    void dipoleFitThreaded();
+    void guessSearchBatched();
+    void guessFieldsCache();
+    void guessFieldsCacheKey();
     void cleanupTestCase();
 
 private:
+    void setupAdvancedSettings(DipoleFitSettings& settings);
+    DipoleFitData* setupGuessFitData(DipoleFitSettings& settings);
     void compareFit();
 
     double epsilon;
+    double threadEpsilon;
+    double guessEpsilon;
+    float guessGrid;
+    float guessLimit;
 
     ECDSet m_ECDSet;
     ECDSet m_refECDSet;
@@ -85,6 +102,10 @@ private:
 
 TestDipoleFit::TestDipoleFit()
 : epsilon(0.000001)
+, threadEpsilon(1e-10)
+, guessEpsilon(1e-4)
+, guessGrid(0.02f)
+, guessLimit(0.2f)
 {
 }
 
@@ -169,7 +190,6 @@ void TestDipoleFit::dipoleFitSimple()
 void TestDipoleFit::dipoleFitAdvanced()
 {
     QString refFileName(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/Result/ref_dip-5120-bem-result.dat");
-    QFile testFile;
 
     //*********************************************************************************************************
     // Dipole Fit Settings
@@ -182,37 +202,7 @@ void TestDipoleFit::dipoleFitAdvanced()
     //--mri ./mne-cpp-test-data/MEG/sample/all-trans.fif --meg --tmin 150 --tmax 250 --tstep 10 --dip ./mne-cpp-test-data/Result/dip-5120-bem_fit.dat
     //--mindist 0 --guessrad 100
     DipoleFitSettings settings;
-
-    testFile.setFileName(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis-ave.fif"); QVERIFY( testFile.exists() );
-    settings.measname = testFile.fileName();
-
-    settings.is_raw = false;
-    settings.setno = 1;
-    settings.include_meg = true;
-    settings.include_eeg = false;
-    settings.tmin = 0.15f;
-    settings.tmax = 0.25f;
-    settings.tstep = 0.01f;
-
-    testFile.setFileName(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/subjects/sample/bem/sample-5120-bem.fif"); QVERIFY( testFile.exists() );
-    settings.bemname = testFile.fileName();
-
-    settings.bmin = 1000000.0f;
-    settings.bmax = 1000000.0f;
-
-    settings.dipname = QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/Result/dip-5120-bem_fit.dat";
-
-    settings.guess_mindist = 0.0f;
-    settings.guess_rad = 0.1f;
-
-    testFile.setFileName(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/all-trans.fif"); QVERIFY( testFile.exists() );
-    settings.mriname = testFile.fileName();
-
-    testFile.setFileName(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis-cov.fif"); QVERIFY( testFile.exists() );
-    settings.noisename = testFile.fileName();
-
-    testFile.setFileName(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis-ave.fif"); QVERIFY( testFile.exists() );
-    settings.projnames.append(testFile.fileName());
+    setupAdvancedSettings(settings);
 
     settings.checkIntegrity();
 
@@ -258,6 +248,234 @@ void TestDipoleFit::dipoleFitAdvanced()
 
 //=============================================================================================================
 
+void TestDipoleFit::dipoleFitThreaded()
+{
+    //*********************************************************************************************************
+    // Dipole Fit Settings
+    //*********************************************************************************************************
+
+    printf(">>>>>>>>>>>>>>>>>>>>>>>>> Dipole Fit Settings >>>>>>>>>>>>>>>>>>>>>>>>>\n");
+
+    //Same as dipoleFitAdvanced, the time points are fitted serially and on four threads
+    DipoleFitSettings settings;
+    setupAdvancedSettings(settings);
+    settings.checkIntegrity();
+
+    printf("<<<<<<<<<<<<<<<<<<<<<<<<< Dipole Fit Settings Finished <<<<<<<<<<<<<<<<<<<<<<<<<\n");
+
+    //*********************************************************************************************************
+    // Compute Dipole Fits
+    //*********************************************************************************************************
+
+    printf(">>>>>>>>>>>>>>>>>>>>>>>>> Compute Dipole Fits >>>>>>>>>>>>>>>>>>>>>>>>>\n");
+
+    settings.nthread = 1;
+    DipoleFit dipFitSerial(&settings);
+    m_refECDSet = dipFitSerial.calculateFit();
+
+    settings.nthread = 4;
+    DipoleFit dipFitThreaded(&settings);
+    m_ECDSet = dipFitThreaded.calculateFit();
+
+    printf("<<<<<<<<<<<<<<<<<<<<<<<<< Compute Dipole Fits Finished <<<<<<<<<<<<<<<<<<<<<<<<<\n");
+
+    //*********************************************************************************************************
+    // Compare Fits
+    //*********************************************************************************************************
+
+    QVERIFY( m_refECDSet.size() > 1 );
+    QVERIFY( m_refECDSet.size() == m_ECDSet.size() );
+
+    for (int i = 0; i < m_refECDSet.size(); ++i)
+    {
+        QVERIFY( m_ECDSet[i].valid == m_refECDSet[i].valid );
+        QVERIFY( m_ECDSet[i].time == m_refECDSet[i].time );
+        QVERIFY( (m_ECDSet[i].rd - m_refECDSet[i].rd).norm() <= threadEpsilon * m_refECDSet[i].rd.norm() );
+        QVERIFY( (m_ECDSet[i].Q - m_refECDSet[i].Q).norm() <= threadEpsilon * m_refECDSet[i].Q.norm() );
+        QVERIFY( std::fabs(m_ECDSet[i].good - m_refECDSet[i].good) <= threadEpsilon * std::fabs(m_refECDSet[i].good) );
+    }
+}
+
+//=============================================================================================================
+
+void TestDipoleFit::guessSearchBatched()
+{
+    DipoleFitSettings settings;
+    QScopedPointer<DipoleFitData> fitData(setupGuessFitData(settings));
+    QVERIFY( fitData );
+
+    // A coarse grid keeps the number of guesses small
+    GuessData guess(QString(), QString(), settings.guess_mindist, settings.guess_exclude, guessGrid, fitData.data());
+    QVERIFY( guess.nguess > 0 );
+    QVERIFY( guess.nch == fitData->nmeg + fitData->neeg );
+
+    // Random whitened data, the first time point is the field of a known guess
+    MatrixXf B = MatrixXf::Random(guess.nch, 150);
+    B.col(0) = guess.guess_uu.col(3*(guess.nguess/2));
+
+    VectorXi best;
+    VectorXf good;
+    QVERIFY( guess.find_best_guesses(B, guessLimit, best, good) );
+    QVERIFY( best.size() == B.cols() && good.size() == B.cols() );
+    QVERIFY( best[0] == guess.nguess/2 );
+
+    // Reference: the former search, one forward solution and one dot product per guess and time point
+    VectorXi bestRef = VectorXi::Constant(B.cols(), -1);
+    VectorXd goodRef = VectorXd::Zero(B.cols());
+    DipoleForward* fwd = NULL;
+
+    for (int k = 0; k < guess.nguess; ++k)
+    {
+        fwd = DipoleFitData::dipole_forward_one(fitData.data(), fitData->sphere_funcs, guess.rr[k], fwd);
+        QVERIFY( fwd && fwd->nch == guess.nch );
+
+        int ncomp = fwd->sing[2]/fwd->sing[0] > guessLimit ? 3 : 2;
+        for (int t = 0; t < B.cols(); ++t)
+        {
+            double B2 = B.col(t).cast<double>().squaredNorm();
+            double Bm2 = 0.0;
+            for (int c = 0; c < ncomp; ++c)
+            {
+                double one = Map<VectorXf>(fwd->uu[c], fwd->nch).cast<double>().dot(B.col(t).cast<double>());
+                Bm2 += one*one;
+            }
+            double thisGood = 1.0 - (B2 - Bm2)/B2;
+            if (thisGood > goodRef[t])
+            {
+                bestRef[t] = k;
+                goodRef[t] = thisGood;
+            }
+        }
+    }
+    delete fwd;
+
+    for (int t = 0; t < B.cols(); ++t)
+    {
+        QVERIFY( best[t] == bestRef[t] );
+        QVERIFY( std::fabs(good[t] - goodRef[t]) <= guessEpsilon * goodRef[t] );
+    }
+}
+
+//=============================================================================================================
+
+void TestDipoleFit::guessFieldsCache()
+{
+    DipoleFitSettings settings;
+    QScopedPointer<DipoleFitData> fitData(setupGuessFitData(settings));
+    QVERIFY( fitData );
+
+    QTemporaryDir cacheDir;
+    QVERIFY( cacheDir.isValid() );
+
+    // The first setup computes the fields and writes them to the cache
+    GuessData guessWritten(QString(), QString(), settings.guess_mindist, settings.guess_exclude, guessGrid, fitData.data(), cacheDir.path());
+    QVERIFY( guessWritten.nguess > 0 );
+    QVERIFY( QDir(cacheDir.path()).entryList(QStringList() << "guess-*.dat", QDir::Files).size() == 1 );
+
+    // The second one reads them back
+    GuessData guessRead(QString(), QString(), settings.guess_mindist, settings.guess_exclude, guessGrid, fitData.data(), cacheDir.path());
+    QVERIFY( QDir(cacheDir.path()).entryList(QStringList() << "guess-*.dat", QDir::Files).size() == 1 );
+
+    QVERIFY( guessRead.nguess == guessWritten.nguess );
+    QVERIFY( guessRead.nch == guessWritten.nch );
+    QVERIFY( guessRead.guess_uu.rows() == guessWritten.guess_uu.rows() && guessRead.guess_uu.cols() == guessWritten.guess_uu.cols() );
+    QVERIFY( guessRead.guess_uu == guessWritten.guess_uu );
+    QVERIFY( guessRead.guess_sing_ratio == guessWritten.guess_sing_ratio );
+}
+
+//=============================================================================================================
+
+void TestDipoleFit::guessFieldsCacheKey()
+{
+    DipoleFitSettings settings;
+    QScopedPointer<DipoleFitData> fitData(setupGuessFitData(settings));
+    QVERIFY( fitData );
+    QVERIFY( fitData->meg_coils && fitData->meg_coils->ncoil > 0 );
+
+    QTemporaryDir cacheDir;
+    QVERIFY( cacheDir.isValid() );
+
+    GuessData guess(QString(), QString(), settings.guess_mindist, settings.guess_exclude, guessGrid, fitData.data(), cacheDir.path());
+    QVERIFY( QDir(cacheDir.path()).entryList(QStringList() << "guess-*.dat", QDir::Files).size() == 1 );
+
+    // Move one integration point of a head frame MEG coil, e.g. after a new head position. The cached fields no
+    // longer apply and are stored under a new key.
+    fitData->meg_coils->coils[0]->rmag[0][2] += 0.001f;
+
+    GuessData guessMoved(QString(), QString(), settings.guess_mindist, settings.guess_exclude, guessGrid, fitData.data(), cacheDir.path());
+    QVERIFY( QDir(cacheDir.path()).entryList(QStringList() << "guess-*.dat", QDir::Files).size() == 2 );
+    QVERIFY( guessMoved.guess_uu != guess.guess_uu );
+}
+
+//=============================================================================================================
+
+void TestDipoleFit::setupAdvancedSettings(DipoleFitSettings& settings)
+{
+    QFile testFile;
+
+    testFile.setFileName(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis-ave.fif"); QVERIFY( testFile.exists() );
+    settings.measname = testFile.fileName();
+
+    settings.is_raw = false;
+    settings.setno = 1;
+    settings.include_meg = true;
+    settings.include_eeg = false;
+    settings.tmin = 0.15f;
+    settings.tmax = 0.25f;
+    settings.tstep = 0.01f;
+
+    testFile.setFileName(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/subjects/sample/bem/sample-5120-bem.fif"); QVERIFY( testFile.exists() );
+    settings.bemname = testFile.fileName();
+
+    settings.bmin = 1000000.0f;
+    settings.bmax = 1000000.0f;
+
+    settings.dipname = QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/Result/dip-5120-bem_fit.dat";
+
+    settings.guess_mindist = 0.0f;
+    settings.guess_rad = 0.1f;
+
+    testFile.setFileName(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/all-trans.fif"); QVERIFY( testFile.exists() );
+    settings.mriname = testFile.fileName();
+
+    testFile.setFileName(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis-cov.fif"); QVERIFY( testFile.exists() );
+    settings.noisename = testFile.fileName();
+
+    testFile.setFileName(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis-ave.fif"); QVERIFY( testFile.exists() );
+    settings.projnames.append(testFile.fileName());
+}
+
+//=============================================================================================================
+
+DipoleFitData* TestDipoleFit::setupGuessFitData(DipoleFitSettings& settings)
+{
+    // MEG of the sample data with the sphere model and the ad hoc noise covariance
+    settings.measname = QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis-ave.fif";
+    settings.include_meg = true;
+    settings.include_eeg = false;
+
+    return DipoleFitData::setup_dipole_fit_data(settings.mriname,
+                                                settings.measname,
+                                                settings.bemname,
+                                                &settings.r0,
+                                                NULL,
+                                                settings.accurate,
+                                                settings.badname,
+                                                settings.noisename,
+                                                settings.grad_std,
+                                                settings.mag_std,
+                                                settings.eeg_std,
+                                                settings.mag_reg,
+                                                settings.grad_reg,
+                                                settings.eeg_reg,
+                                                settings.diagnoise,
+                                                settings.projnames,
+                                                settings.include_meg,
+                                                settings.include_eeg);
+}
+
+//=============================================================================================================
+
 void TestDipoleFit::compareFit()
 {
     //*********************************************************************************************************
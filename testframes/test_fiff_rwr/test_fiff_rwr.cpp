@@ -76,6 +76,8 @@ private slots:
     void compareData();
     void compareTimes();
     void compareInfo();
+    void compareSegmentReader();
+    void compareParallelSegmentReader();
     void cleanupTestCase();
 
 private:
@@ -309,6 +311,121 @@ void TestFiffRWR::compareInfo()
 
 //=============================================================================================================
 
+void TestFiffRWR::compareSegmentReader()
+{
+    QFile t_fileIn(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis_trunc_raw.fif");
+    FiffRawData raw(t_fileIn);
+    FiffRawSegmentReader reader(raw);
+
+    RowVectorXi vPicks = raw.info.pick_types(true, false, false);
+
+    MatrixXd mDataRef, mTimesRef, mData, mTimes;
+
+    // Overlapping segments which start and end in the middle of the raw buffers. MEG data is in the order of
+    // 1e-12 T, so the data is compared relative to its norm.
+    fiff_int_t iLength = ceil(0.3 * raw.info.sfreq);
+    fiff_int_t iStep = iLength / 2;
+
+    for(fiff_int_t first = raw.first_samp + 7; first + iLength < raw.first_samp + 5 * raw.info.sfreq; first += iStep) {
+        QVERIFY(raw.read_raw_segment(mDataRef, mTimesRef, first, first + iLength));
+        QVERIFY(reader.read_raw_segment(mData, mTimes, first, first + iLength));
+        QVERIFY(mData.rows() == mDataRef.rows() && mData.cols() == mDataRef.cols());
+        QVERIFY((mDataRef - mData).norm() <= 1e-10 * mDataRef.norm());
+        QVERIFY((mTimesRef - mTimes).cwiseAbs().maxCoeff() < dEpsilon);
+
+        QVERIFY(raw.read_raw_segment(mDataRef, mTimesRef, first, first + iLength, vPicks));
+        QVERIFY(reader.read_raw_segment(mData, mTimes, first, first + iLength, vPicks));
+        QVERIFY(mData.rows() == mDataRef.rows() && mData.cols() == mDataRef.cols());
+        QVERIFY((mDataRef - mData).norm() <= 1e-10 * mDataRef.norm());
+    }
+
+    // Overlapping reads must be served from the cache
+    QVERIFY(reader.cacheHits() > 0);
+
+    // Decoding from the memory mapped file must give the same result
+    QVERIFY(raw.file->map());
+    FiffRawSegmentReader readerMapped(raw);
+    fiff_int_t to = raw.first_samp + (fiff_int_t)(5 * raw.info.sfreq);
+    QVERIFY(raw.read_raw_segment(mDataRef, mTimesRef, raw.first_samp, to, vPicks));
+    QVERIFY(readerMapped.read_raw_segment(mData, mTimes, raw.first_samp, to, vPicks));
+    QVERIFY(mData.rows() == mDataRef.rows() && mData.cols() == mDataRef.cols());
+    QVERIFY((mDataRef - mData).norm() <= 1e-10 * mDataRef.norm());
+    raw.file->unmap();
+
+    // The single precision path must match up to float precision
+    MatrixXf mDataFloat;
+    QVERIFY(reader.read_raw_segment(mDataFloat, mTimes, raw.first_samp, to, vPicks));
+    QVERIFY(mDataFloat.rows() == mDataRef.rows() && mDataFloat.cols() == mDataRef.cols());
+    QVERIFY((mDataRef - mDataFloat.cast<double>()).norm() / mDataRef.norm() < 1e-5);
+
+    QVERIFY(reader.findBuffer(raw.first_samp) == 0);
+    QVERIFY(reader.findBuffer(raw.last_samp + 1) == -1);
+}
+
+//=============================================================================================================
+
+void TestFiffRWR::compareParallelSegmentReader()
+{
+    QFile t_fileIn(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis_trunc_raw.fif");
+    FiffRawData raw(t_fileIn);
+    FiffRawSegmentReader reader(raw);
+
+    RowVectorXi vPicks = raw.info.pick_types(true, true, false);
+
+    MatrixXd mDataRef, mTimesRef, mData, mTimes;
+
+    // Segments which start and end in the middle of a raw buffer and span several buffers. The parallel reader runs
+    // the same decoding per buffer as the serial one, so their results have to be bit-identical.
+    fiff_int_t first = raw.first_samp + 7;
+    fiff_int_t to = raw.first_samp + (fiff_int_t)(3.3 * raw.info.sfreq);
+    QVERIFY(reader.findBuffer(to) > reader.findBuffer(first) + 1);
+
+    QList<int> lNumThreads = QList<int>() << 1 << 2 << 4;
+
+    for(int iNumThreads : lNumThreads) {
+        QVERIFY(reader.read_raw_segment(mDataRef, mTimesRef, first, to));
+        QVERIFY(reader.read_raw_segment_parallel(mData, mTimes, first, to, defaultRowVectorXi, iNumThreads));
+        QVERIFY(mData.rows() == mDataRef.rows() && mData.cols() == mDataRef.cols());
+        QVERIFY(mData == mDataRef);
+        QVERIFY(mTimes == mTimesRef);
+
+        QVERIFY(reader.read_raw_segment(mDataRef, mTimesRef, first, to, vPicks));
+        QVERIFY(reader.read_raw_segment_parallel(mData, mTimes, first, to, vPicks, iNumThreads));
+        QVERIFY(mData.rows() == vPicks.cols() && mData.cols() == mDataRef.cols());
+        QVERIFY(mData == mDataRef);
+    }
+
+    // The serial reader itself is checked against FiffRawData in compareSegmentReader, check the parallel one as well
+    QVERIFY(raw.read_raw_segment(mDataRef, mTimesRef, first, to, vPicks));
+    QVERIFY(mData.rows() == mDataRef.rows() && mData.cols() == mDataRef.cols());
+    QVERIFY((mDataRef - mData).norm() <= 1e-10 * mDataRef.norm());
+
+    // A segment within a single raw buffer
+    QVERIFY(reader.read_raw_segment(mDataRef, mTimesRef, first, first + 10, vPicks));
+    QVERIFY(reader.read_raw_segment_parallel(mData, mTimes, first, first + 10, vPicks, 2));
+    QVERIFY(mData.rows() == mDataRef.rows() && mData.cols() == mDataRef.cols());
+    QVERIFY(mData == mDataRef);
+
+    // Decoding from the memory mapped file must give the same result
+    QVERIFY(reader.read_raw_segment(mDataRef, mTimesRef, first, to, vPicks));
+    QVERIFY(raw.file->map());
+    FiffRawSegmentReader readerMapped(raw);
+    QVERIFY(readerMapped.read_raw_segment_parallel(mData, mTimes, first, to, vPicks, 4));
+    QVERIFY(mData.rows() == mDataRef.rows() && mData.cols() == mDataRef.cols());
+    QVERIFY(mData == mDataRef);
+    raw.file->unmap();
+
+    // The single precision path must match the serial one exactly and the double precision one up to float precision
+    MatrixXf mDataFloat, mDataFloatRef;
+    QVERIFY(reader.read_raw_segment(mDataFloatRef, mTimes, first, to, vPicks));
+    QVERIFY(reader.read_raw_segment_parallel(mDataFloat, mTimes, first, to, vPicks, 4));
+    QVERIFY(mDataFloat.rows() == mDataRef.rows() && mDataFloat.cols() == mDataRef.cols());
+    QVERIFY(mDataFloat == mDataFloatRef);
+    QVERIFY((mDataRef - mDataFloat.cast<double>()).norm() / mDataRef.norm() < 1e-5);
+}
+
+//=============================================================================================================
+
 void TestFiffRWR::cleanupTestCase()
 {
 }
@@ -84,12 +84,64 @@ private slots:
     void initTestCase();
     void compareData();
     void compareTimes();
+    void compareIirStreaming();
+    void compareFirStreaming();
     void cleanupTestCase();
 
 private:
+    //=========================================================================================================
+    /**
+     * Filters the picked rows by direct time domain convolution with the filter taps, starting from zeros.
+     *
+     * @param[in] mData     The data to filter (channels x samples).
+     * @param[in] vPicks    The rows to filter.
+     * @param[in] vTaps     The filter taps.
+     *
+     * @return The data with the picked rows filtered (channels x samples).
+     */
+    MatrixXd convolve(const MatrixXd& mData,
+                      const RowVectorXi& vPicks,
+                      const RowVectorXd& vTaps) const;
+
+    //=========================================================================================================
+    /**
+     * Filters the picked rows by evaluating the difference equation of every second order section in direct form,
+     * starting from zeros.
+     *
+     * @param[in] mData     The data to filter (channels x samples).
+     * @param[in] vPicks    The rows to filter.
+     * @param[in] mSos      The second order sections [b0 b1 b2 a0 a1 a2].
+     *
+     * @return The data with the picked rows filtered (channels x samples).
+     */
+    MatrixXd differenceEquation(const MatrixXd& mData,
+                                const RowVectorXi& vPicks,
+                                const MatrixXd& mSos) const;
+
+    //=========================================================================================================
+    /**
+     * Compares the picked rows of a filter output with a reference. The tolerance scales with the norm of each input
+     * row, so that channels with large values, e.g. the stim channel, do not hide errors on the MEG channels.
+     *
+     * @param[in] mFiltered     The filter output (channels x samples).
+     * @param[in] mReference    The reference (channels x samples).
+     * @param[in] mData         The filter input (channels x samples).
+     * @param[in] vPicks        The compared rows.
+     * @param[in] dTolerance    The tolerance relative to the input row norm.
+     *
+     * @return Whether all picked rows match.
+     */
+    bool compareRows(const MatrixXd& mFiltered,
+                     const MatrixXd& mReference,
+                     const MatrixXd& mData,
+                     const RowVectorXi& vPicks,
+                     double dTolerance) const;
+
     double dEpsilon;
     int iOrder;
 
+    RowVectorXi vMegPicks;
+
     MatrixXd mFirstInData;
     MatrixXd mFirstInTimes;
     MatrixXd mFirstFiltered;
@@ -139,6 +191,7 @@ void TestFiltering::initTestCase()
 
     // Only filter MEG channels
     RowVectorXi vPicks = rawFirstInRaw.info.pick_types(true, true, false);
+    vMegPicks = rawFirstInRaw.info.pick_types(true, false, false);
     RowVectorXd vCals;
     FiffStream::SPtr outfid = FiffStream::start_writing_raw(t_fileOut, rawFirstInRaw.info, vCals);
 
@@ -224,10 +277,150 @@ void TestFiltering::compareTimes()
     QVERIFY( mTimesDiff.sum() < dEpsilon );
 }
 
+//=============================================================================================================
+
+void TestFiltering::compareIirStreaming()
+{
+    // The IIR design must have the Butterworth response at the cutoff frequency
+    FilterData filter("iir_lpf", FilterData::LPF, 4, 0.2, 0.0, 0.0, 1000.0, 1000, FilterData::Butterworth);
+    QVERIFY(filter.m_matSos.rows() == 2);
+    QVERIFY(std::abs(std::abs(filter.m_dFFTCoeffA(0)) - 1.0) < dEpsilon);
+    QVERIFY(std::abs(std::abs(filter.m_dFFTCoeffA(100)) - 1.0/std::sqrt(2.0)) < dEpsilon);
+
+    QList<FilterData> lFilter;
+    lFilter << filter;
+    MatrixXd mData = mFirstInData.leftCols(1000);
+
+    RtFilter rtFilterAll, rtFilterBlocks;
+    MatrixXd mAll = rtFilterAll.filterDataBlock(mData, 4, vMegPicks, lFilter);
+
+    // The cascaded sections must match the difference equations evaluated one after the other
+    QVERIFY(compareRows(mAll, differenceEquation(mData, vMegPicks, filter.m_matSos), mData, vMegPicks, 1e-10));
+
+    // Filtering block by block must give the same result as filtering all samples at once
+    MatrixXd mBlocks(mData.rows(), mData.cols());
+    for(int from = 0; from < mData.cols(); from += 100) {
+        mBlocks.middleCols(from, 100) = rtFilterBlocks.filterDataBlock(MatrixXd(mData.middleCols(from, 100)), 4, vMegPicks, lFilter);
+    }
+
+    QVERIFY(compareRows(mBlocks, mAll, mData, vMegPicks, 1e-10));
+}
+
+//=============================================================================================================
+
+void TestFiltering::compareFirStreaming()
+{
+    double dSFreq = 600.0;
+    FilterData filter("fir_bpf", FilterData::BPF, 256, 10.0/(dSFreq/2.0), 10.0/(dSFreq/2.0), 1.0/(dSFreq/2.0), dSFreq, 512, FilterData::Cosine);
+    QList<FilterData> lFilter;
+    lFilter << filter;
+
+    MatrixXd mData = mFirstInData.leftCols(4000);
+
+    RtFilter rtFilterAll, rtFilterBlocks;
+    MatrixXd mAll = rtFilterAll.filterDataBlock(mData, 256, vMegPicks, lFilter);
+
+    // Overlap-save filtering must match the direct convolution with the taps
+    QVERIFY(compareRows(mAll, convolve(mData, vMegPicks, filter.m_dCoeffA), mData, vMegPicks, 1e-10));
+
+    // Filtering odd sized blocks must give the same result as filtering all samples at once
+    QList<int> lBlockSizes;
+    lBlockSizes << 1 << 17 << 255 << 331 << 1021 << 7;
+
+    MatrixXd mBlocks(mData.rows(), mData.cols());
+    int from = 0;
+    for(int i = 0; from < mData.cols(); ++i) {
+        int iSize = qMin(lBlockSizes.at(i % lBlockSizes.size()), int(mData.cols()) - from);
+        mBlocks.middleCols(from, iSize) = rtFilterBlocks.filterDataBlock(MatrixXd(mData.middleCols(from, iSize)), 256, vMegPicks, lFilter);
+        from += iSize;
+    }
+
+    QVERIFY(compareRows(mBlocks, mAll, mData, vMegPicks, 1e-10));
+}
+
+//=============================================================================================================
+
 void TestFiltering::cleanupTestCase()
 {
 }
 
+//=============================================================================================================
+
+MatrixXd TestFiltering::convolve(const MatrixXd& mData,
+                                 const RowVectorXi& vPicks,
+                                 const RowVectorXd& vTaps) const
+{
+    MatrixXd mFiltered = mData;
+
+    for(int r = 0; r < vPicks.cols(); ++r) {
+        for(int n = 0; n < mData.cols(); ++n) {
+            double dY = 0.0;
+
+            for(int k = 0; k < vTaps.cols() && k <= n; ++k) {
+                dY += vTaps(k) * mData(vPicks(r), n - k);
+            }
+
+            mFiltered(vPicks(r), n) = dY;
+        }
+    }
+
+    return mFiltered;
+}
+
+//=============================================================================================================
+
+MatrixXd TestFiltering::differenceEquation(const MatrixXd& mData,
+                                           const RowVectorXi& vPicks,
+                                           const MatrixXd& mSos) const
+{
+    MatrixXd mFiltered = mData;
+
+    // a0 y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]
+    for(int s = 0; s < mSos.rows(); ++s) {
+        MatrixXd mIn = mFiltered;
+
+        for(int n = 0; n < mData.cols(); ++n) {
+            for(int r = 0; r < vPicks.cols(); ++r) {
+                int c = vPicks(r);
+                double dY = mSos(s,0) * mIn(c,n);
+
+                if(n >= 1) {
+                    dY += mSos(s,1) * mIn(c,n-1) - mSos(s,4) * mFiltered(c,n-1);
+                }
+
+                if(n >= 2) {
+                    dY += mSos(s,2) * mIn(c,n-2) - mSos(s,5) * mFiltered(c,n-2);
+                }
+
+                mFiltered(c,n) = dY / mSos(s,3);
+            }
+        }
+    }
+
+    return mFiltered;
+}
+
+//=============================================================================================================
+
+bool TestFiltering::compareRows(const MatrixXd& mFiltered,
+                                const MatrixXd& mReference,
+                                const MatrixXd& mData,
+                                const RowVectorXi& vPicks,
+                                double dTolerance) const
+{
+    if(vPicks.cols() == 0 || mReference.rows() != mFiltered.rows() || mReference.cols() != mFiltered.cols()) {
+        return false;
+    }
+
+    for(int r = 0; r < vPicks.cols(); ++r) {
+        if((mFiltered.row(vPicks(r)) - mReference.row(vPicks(r))).norm() > dTolerance * mData.row(vPicks(r)).norm()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 //=============================================================================================================
 // MAIN
 //=============================================================================================================
@@ -40,6 +40,7 @@
 
 #include <iostream>
 #include <vector>
+#include <numeric>
 #include <math.h>
 
 #include <fiff/fiff.h>
@@ -98,6 +99,7 @@ private slots:
     void compareMove();
     void compareDetect();
     void compareTime();
+    void compareWarmStart();
     void cleanupTestCase();
 
 private:
@@ -106,6 +108,7 @@ private:
     double dErrorTime = 0.00000001;
     double dErrorAngle = 0.1;
     double dErrorDetect = 0;
+    double dErrorGoF = 0.01;
     MatrixXd mRefPos;
     MatrixXd mHpiPos;
     MatrixXd mRefResult;
@@ -317,6 +320,54 @@ void TestHpiFit::compareTime()
 
 //=============================================================================================================
 
+void TestHpiFit::compareWarmStart()
+{
+    QFile t_fileIn(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/test_hpiFit_raw.fif");
+    FiffRawData raw(t_fileIn);
+    QSharedPointer<FiffInfo> pFiffInfo = QSharedPointer<FIFFLIB::FiffInfo>(new FiffInfo(raw.info));
+    Eigen::MatrixXd mProjectors = Eigen::MatrixXd::Identity(pFiffInfo->chs.size(), pFiffInfo->chs.size());
+
+    fiff_int_t from = raw.first_samp + mRefPos(0,0)*pFiffInfo->sfreq;
+    fiff_int_t to = from + ceil(0.2f*pFiffInfo->sfreq);
+    MatrixXd mData, mTimes;
+    QVERIFY(raw.read_raw_segment(mData, mTimes, from, to));
+
+    // Fit the block with a new fitting context, which starts from the digitized coil positions
+    HPIFit hpiFit;
+
+    FiffCoordTrans transCold = pFiffInfo->dev_head_t;
+    QVector<double> vErrorCold;
+    VectorXd vGoFCold;
+    FiffDigPointSet fittedPointSetCold;
+    hpiFit.fit(mData, mProjectors, transCold, vFreqs, vErrorCold, vGoFCold, fittedPointSetCold, pFiffInfo);
+
+    // The first fit is good enough for the second one to start from its coil positions
+    QVERIFY(vErrorCold.size() == vFreqs.size());
+    QVERIFY(std::accumulate(vErrorCold.begin(), vErrorCold.end(), 0.0) / vErrorCold.size() <= 0.003);
+
+    // Fit the same block again through the same context
+    FiffCoordTrans transWarm = pFiffInfo->dev_head_t;
+    QVector<double> vErrorWarm;
+    VectorXd vGoFWarm;
+    FiffDigPointSet fittedPointSetWarm;
+    hpiFit.fit(mData, mProjectors, transWarm, vFreqs, vErrorWarm, vGoFWarm, fittedPointSetWarm, pFiffInfo);
+
+    qDebug() << "WarmStart translation: [m]" << transCold.translationTo(transWarm.trans);
+    qDebug() << "WarmStart angle: [degree]" << transCold.angleTo(transWarm.trans);
+
+    QVERIFY(transCold.translationTo(transWarm.trans) < dErrorTrans);
+    QVERIFY(transCold.angleTo(transWarm.trans) < dErrorAngle);
+
+    QVERIFY(vErrorWarm.size() == vErrorCold.size());
+    QVERIFY(vGoFWarm.size() == vGoFCold.size());
+    for(int i = 0; i < vErrorCold.size(); ++i) {
+        QVERIFY(std::abs(vErrorWarm[i] - vErrorCold[i]) < dErrorTrans);
+        QVERIFY(std::abs(vGoFWarm(i) - vGoFCold(i)) < dErrorGoF);
+    }
+}
+
+//=============================================================================================================
+
 void TestHpiFit::cleanupTestCase()
 {
 }
@@ -0,0 +1,300 @@
+//=============================================================================================================
+/**
+ * @file     test_mne_epoch_data_list.cpp
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test for the single pass epoch reader.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+
+#include <fiff/fiff.h>
+
+#include <mne/mne_epoch_data_list.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Dense>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace MNELIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestMneEpochDataList
+ *
+ * @brief The TestMneEpochDataList class compares the single pass epoch reader with reading every epoch by
+ *        FiffRawData::read_raw_segment.
+ *
+ */
+class TestMneEpochDataList: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestMneEpochDataList();
+
+private slots:
+    void initTestCase();
+    void compareReadEpochs();
+    void compareStreamEpochs();
+    void compareStreamEpochsGap();
+    void cleanupTestCase();
+
+private:
+    //=========================================================================================================
+    /**
+     * Reads the epoch of an event with read_raw_segment, the way readEpochs did before reading in a single pass.
+     */
+    bool readReferenceEpoch(int iEventRow,
+                            MatrixXd& matEpoch);
+
+    double          m_dEpsilon;
+    float           m_fTMin;
+    float           m_fTMax;
+    qint32          m_iEvent;
+
+    QFile           m_fileRaw;
+    FiffRawData     m_raw;
+    MatrixXi        m_matEvents;
+    RowVectorXi     m_vecPicks;
+    QMap<QString,double> m_mapReject;
+};
+
+//=============================================================================================================
+
+TestMneEpochDataList::TestMneEpochDataList()
+: m_dEpsilon(1e-20)
+, m_fTMin(-0.2f)
+, m_fTMax(0.5f)
+, m_iEvent(1)
+{
+}
+
+//=============================================================================================================
+
+void TestMneEpochDataList::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    m_fileRaw.setFileName(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis_trunc_raw.fif");
+    m_raw = FiffRawData(m_fileRaw);
+
+    m_vecPicks = m_raw.info.pick_types(true, true, true);
+
+    // Events every 0.25s, alternating between two kinds. The epochs overlap and do not align with the raw buffers.
+    int iStep = (int)(0.25 * m_raw.info.sfreq);
+    int iFirst = m_raw.first_samp + (int)(0.3 * m_raw.info.sfreq) + 3;
+    int iLast = m_raw.last_samp - (int)(0.6 * m_raw.info.sfreq);
+    int iNumEvents = (iLast - iFirst) / iStep;
+
+    m_matEvents = MatrixXi::Zero(iNumEvents, 3);
+    for(int i = 0; i < iNumEvents; ++i) {
+        m_matEvents(i,0) = iFirst + i * iStep;
+        m_matEvents(i,2) = (i % 2 == 0) ? 1 : 2;
+    }
+
+    m_mapReject.insert("eog", 300e-06);
+
+    QVERIFY(m_matEvents.rows() > 10);
+}
+
+//=============================================================================================================
+
+void TestMneEpochDataList::compareReadEpochs()
+{
+    MNEEpochDataList data = MNEEpochDataList::readEpochs(m_raw,
+                                                         m_matEvents,
+                                                         m_fTMin,
+                                                         m_fTMax,
+                                                         m_iEvent,
+                                                         m_mapReject,
+                                                         QStringList(),
+                                                         m_vecPicks);
+
+    MatrixXd matEpoch;
+    int iEpoch = 0;
+
+    for(int i = 0; i < m_matEvents.rows(); ++i) {
+        if(m_matEvents(i,2) != m_iEvent) {
+            continue;
+        }
+
+        QVERIFY(iEpoch < data.size());
+        QVERIFY(readReferenceEpoch(i, matEpoch));
+
+        const MNEEpochData::SPtr& pEpoch = data.at(iEpoch++);
+        QVERIFY(pEpoch->epoch.rows() == matEpoch.rows() && pEpoch->epoch.cols() == matEpoch.cols());
+        QVERIFY((pEpoch->epoch - matEpoch).cwiseAbs().maxCoeff() < m_dEpsilon);
+        QVERIFY(pEpoch->bReject == MNEEpochDataList::checkForArtifact(matEpoch, m_raw.info, m_mapReject));
+        QVERIFY(pEpoch->event == m_iEvent);
+    }
+
+    QVERIFY(iEpoch == data.size());
+}
+
+//=============================================================================================================
+
+void TestMneEpochDataList::compareStreamEpochs()
+{
+    QList<int> lEventRows;
+    QList<QWeakPointer<MNEEpochData> > lEpochs;
+    bool bEqual = true;
+
+    qint32 iNumEpochs = MNEEpochDataList::streamEpochs(m_raw,
+                                                       m_matEvents,
+                                                       m_fTMin,
+                                                       m_fTMax,
+                                                       m_iEvent,
+                                                       m_mapReject,
+                                                       [&](qint32 iEventRow, const MNEEpochData::SPtr& pEpoch) {
+                                                           MatrixXd matEpoch;
+                                                           if(!readReferenceEpoch(iEventRow, matEpoch)
+                                                              || pEpoch->epoch.cols() != matEpoch.cols()
+                                                              || (pEpoch->epoch - matEpoch).cwiseAbs().maxCoeff() >= m_dEpsilon) {
+                                                               bEqual = false;
+                                                           }
+                                                           lEpochs.append(pEpoch.toWeakRef());
+                                                           lEventRows.append(iEventRow);
+                                                       },
+                                                       QStringList(),
+                                                       m_vecPicks);
+
+    QVERIFY(bEqual);
+    QVERIFY(iNumEpochs == lEventRows.size());
+    QVERIFY(iNumEpochs == (m_matEvents.col(2).array() == m_iEvent).count());
+
+    // The reader does not keep the epochs once they were handed out
+    for(int i = 0; i < lEpochs.size(); ++i) {
+        QVERIFY(lEpochs.at(i).isNull());
+    }
+
+    // The epochs are handed out in the order of their first sample
+    for(int i = 1; i < lEventRows.size(); ++i) {
+        QVERIFY(m_matEvents(lEventRows.at(i),0) > m_matEvents(lEventRows.at(i-1),0));
+    }
+}
+
+//=============================================================================================================
+
+void TestMneEpochDataList::compareStreamEpochsGap()
+{
+    // Remove a raw buffer in the middle of the data, so that there is a gap between the remaining buffers
+    FiffRawData raw = m_raw;
+    QVERIFY(raw.rawdir.size() > 4);
+    int iGap = raw.rawdir.size() / 2;
+    FiffRawDir gapDir = raw.rawdir.takeAt(iGap);
+    const FiffRawDir& nextDir = raw.rawdir.at(iGap);
+    int iLength = gapDir.nsamp / 4;
+
+    // The first epoch lies within the gap, the second one starts in the gap and ends in the next buffer
+    MatrixXi matEvents = MatrixXi::Zero(3, 3);
+    matEvents(0,0) = gapDir.first + iLength;
+    matEvents(1,0) = gapDir.last - iLength / 2;
+    matEvents(2,0) = nextDir.first + iLength;
+    matEvents.col(2).setConstant(m_iEvent);
+
+    float fTMax = iLength / m_raw.info.sfreq;
+    QVector<MNEEpochData::SPtr> vecEpochs(matEvents.rows());
+
+    qint32 iNumEpochs = MNEEpochDataList::streamEpochs(raw,
+                                                       matEvents,
+                                                       0.0f,
+                                                       fTMax,
+                                                       m_iEvent,
+                                                       QMap<QString,double>(),
+                                                       [&](qint32 iEventRow, const MNEEpochData::SPtr& pEpoch) {
+                                                           vecEpochs[iEventRow] = pEpoch;
+                                                       },
+                                                       QStringList(),
+                                                       m_vecPicks);
+
+    // All epochs are handed out, the ones overlapping with the gap are marked for rejection
+    QVERIFY(iNumEpochs == matEvents.rows());
+
+    MatrixXd matEpoch, matTimes;
+
+    for(int i = 0; i < matEvents.rows(); ++i) {
+        QVERIFY(vecEpochs.at(i));
+        QVERIFY(vecEpochs.at(i)->bReject == (i < 2));
+
+        fiff_int_t from = matEvents(i,0);
+        fiff_int_t to = matEvents(i,0) + floor(fTMax * m_raw.info.sfreq + 0.5);
+        QVERIFY(m_raw.read_raw_segment(matEpoch, matTimes, from, to, m_vecPicks));
+        QVERIFY(vecEpochs.at(i)->epoch.rows() == matEpoch.rows() && vecEpochs.at(i)->epoch.cols() == matEpoch.cols());
+
+        // The samples outside of the gap are read, the ones inside are left at zero
+        int iInGap = qMax(0, qMin(to, gapDir.last) - from + 1);
+        QVERIFY(vecEpochs.at(i)->epoch.leftCols(iInGap).isZero(0.0));
+        QVERIFY(((vecEpochs.at(i)->epoch.rightCols(matEpoch.cols() - iInGap) - matEpoch.rightCols(matEpoch.cols() - iInGap)).array().abs() < m_dEpsilon).all());
+    }
+}
+
+//=============================================================================================================
+
+void TestMneEpochDataList::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+bool TestMneEpochDataList::readReferenceEpoch(int iEventRow,
+                                              MatrixXd& matEpoch)
+{
+    MatrixXd matTimes;
+    fiff_int_t event_samp = m_matEvents(iEventRow,0);
+    fiff_int_t from = event_samp + m_fTMin*m_raw.info.sfreq;
+    fiff_int_t to = event_samp + floor(m_fTMax*m_raw.info.sfreq + 0.5);
+
+    return m_raw.read_raw_segment(matEpoch, matTimes, from, to, m_vecPicks);
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestMneEpochDataList)
+#include "test_mne_epoch_data_list.moc"
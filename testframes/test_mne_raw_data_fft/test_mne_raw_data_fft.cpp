@@ -0,0 +1,230 @@
+//=============================================================================================================
+/**
+ * @file     test_mne_raw_data_fft.cpp
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test for the real FFT used by the raw data filter.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+
+#include <mne/c/mne_raw_data.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Dense>
+
+//=============================================================================================================
+// STL INCLUDES
+//=============================================================================================================
+
+#include <cmath>
+#include <cstdlib>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace MNELIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestMneRawDataFft
+ *
+ * @brief The TestMneRawDataFft class compares MneRawData::mne_fft_ana with a direct DFT and checks that
+ *        MneRawData::mne_fft_syn inverts it.
+ *
+ */
+class TestMneRawDataFft: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestMneRawDataFft();
+
+private slots:
+    void initTestCase();
+    void compareDirectDft();
+    void compareRoundTrip();
+    void compareCachedTables();
+    void cleanupTestCase();
+
+private:
+    //=========================================================================================================
+    /**
+     * Returns the spectrum of data computed by a direct DFT in double precision, in the FFTPACK rfftf storage
+     * order.
+     */
+    static VectorXd directDft(const VectorXf& data);
+
+    double          m_dEpsilon;
+    QList<int>      m_lLengths;
+};
+
+//=============================================================================================================
+
+TestMneRawDataFft::TestMneRawDataFft()
+: m_dEpsilon(1e-5)
+{
+}
+
+//=============================================================================================================
+
+void TestMneRawDataFft::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    std::srand(42);
+
+    // Odd, even, powers of two, which use the radix-2 path, and their neighbours, which use the direct transform
+    m_lLengths << 2 << 3 << 4 << 5 << 6 << 7 << 8 << 9 << 15 << 16 << 17 << 63 << 64 << 65 << 100 << 127 << 128
+               << 255 << 256 << 1000 << 1024 << 1025 << 4096;
+}
+
+//=============================================================================================================
+
+void TestMneRawDataFft::compareDirectDft()
+{
+    for(int np : m_lLengths) {
+        VectorXf data = VectorXf::Random(np);
+        VectorXd reference = directDft(data);
+
+        MneRawData::mne_fft_ana(data.data(), np, NULL);
+
+        double dScale = reference.cwiseAbs().maxCoeff();
+        QVERIFY2((data.cast<double>() - reference).cwiseAbs().maxCoeff() < m_dEpsilon * dScale * std::log2(double(np) + 1.0),
+                 qPrintable(QString("Length %1").arg(np)));
+    }
+}
+
+//=============================================================================================================
+
+void TestMneRawDataFft::compareRoundTrip()
+{
+    for(int np : m_lLengths) {
+        VectorXf data = VectorXf::Random(np);
+        VectorXf orig = data;
+
+        MneRawData::mne_fft_ana(data.data(), np, NULL);
+        MneRawData::mne_fft_syn(data.data(), np, NULL);
+
+        QVERIFY2((data - orig).cwiseAbs().maxCoeff() < m_dEpsilon * std::log2(double(np) + 1.0),
+                 qPrintable(QString("Length %1").arg(np)));
+    }
+}
+
+//=============================================================================================================
+
+void TestMneRawDataFft::compareCachedTables()
+{
+    float* precalc = NULL;
+
+    // The cached tables are reused for the same length and replaced when the length changes, alternating the
+    // lengths also switches between the radix-2 and the direct transform
+    for(int i = 0; i < 3; ++i) {
+        for(int np : m_lLengths) {
+            VectorXf data = VectorXf::Random(np);
+            VectorXf orig = data;
+            VectorXf uncached = data;
+
+            MneRawData::mne_fft_ana(data.data(), np, &precalc);
+            MneRawData::mne_fft_ana(uncached.data(), np, NULL);
+            QVERIFY(precalc != NULL && int(precalc[0]) == np);
+            QVERIFY(data == uncached);
+
+            MneRawData::mne_fft_syn(data.data(), np, &precalc);
+            QVERIFY((data - orig).cwiseAbs().maxCoeff() < m_dEpsilon * std::log2(double(np) + 1.0));
+
+            // A second transform of the same length keeps the tables
+            float* precalcPrev = precalc;
+            MneRawData::mne_fft_ana(data.data(), np, &precalc);
+            MneRawData::mne_fft_syn(data.data(), np, &precalc);
+            QVERIFY(precalc == precalcPrev);
+            QVERIFY((data - orig).cwiseAbs().maxCoeff() < m_dEpsilon * std::log2(double(np) + 1.0));
+        }
+    }
+
+    std::free(precalc);
+}
+
+//=============================================================================================================
+
+void TestMneRawDataFft::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+VectorXd TestMneRawDataFft::directDft(const VectorXf& data)
+{
+    int np = data.size();
+    VectorXd spectrum(np);
+
+    for(int k = 0; 2*k <= np; ++k) {
+        double re = 0.0;
+        double im = 0.0;
+
+        for(int j = 0; j < np; ++j) {
+            double phi = 2.0 * M_PI * double((qint64(j) * k) % np) / np;
+            re += data[j] * std::cos(phi);
+            im -= data[j] * std::sin(phi);
+        }
+
+        if(k == 0) {
+            spectrum[0] = re;
+        } else if(2*k == np) {
+            spectrum[np-1] = re;
+        } else {
+            spectrum[2*k-1] = re;
+            spectrum[2*k] = im;
+        }
+    }
+
+    return spectrum;
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestMneRawDataFft)
+#include "test_mne_raw_data_fft.moc"
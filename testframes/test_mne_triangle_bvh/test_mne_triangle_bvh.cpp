@@ -0,0 +1,465 @@
+//=============================================================================================================
+/**
+ * @file     test_mne_triangle_bvh.cpp
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test for the triangle bounding volume hierarchy.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+
+#include <mne/mne_bem.h>
+#include <mne/mne_bem_surface.h>
+#include <mne/mne_triangle_bvh.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Dense>
+#include <Eigen/Geometry>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace MNELIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestMneTriangleBVH
+ *
+ * @brief The TestMneTriangleBVH class compares the nearest triangle and ray queries of MNETriangleBVH with an
+ *        exhaustive search over all triangles.
+ *
+ */
+class TestMneTriangleBVH: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestMneTriangleBVH();
+
+private slots:
+    void initTestCase();
+    void compareEmpty();
+    void compareNearestBem();
+    void compareNearestSoup();
+    void compareRayBem();
+    void compareRaySoup();
+    void cleanupTestCase();
+
+private:
+    //=========================================================================================================
+    /**
+     * Returns whether nearestTriangle and nearestTriangles agree with the exhaustive search for all points.
+     */
+    bool compareNearest(const MatrixX3f& matVertices,
+                        const MatrixX3i& matTris,
+                        const MatrixX3f& matPoints,
+                        float fTolerance) const;
+
+    //=========================================================================================================
+    /**
+     * Returns whether intersectRay agrees with the exhaustive search for all rays. A ray which grazes an edge
+     * may or may not hit, so the result is checked against the first hit with slightly shrunk and with slightly
+     * grown triangles.
+     */
+    bool compareRays(const MatrixX3f& matVertices,
+                     const MatrixX3i& matTris,
+                     const MatrixX3f& matOrigins,
+                     const MatrixX3f& matDirections,
+                     float fTolerance) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the distance between a point and a triangle.
+     */
+    static float pointTriangleDist(const Vector3f& r,
+                                   const Vector3f& r1,
+                                   const Vector3f& r2,
+                                   const Vector3f& r3);
+
+    //=========================================================================================================
+    /**
+     * Returns the ray parameter at which the ray hits the triangle, infinity if it misses. Barycentric
+     * coordinates down to -fMargin count as inside.
+     */
+    static float rayTriangleHit(const Vector3f& origin,
+                                const Vector3f& direction,
+                                const Vector3f& r1,
+                                const Vector3f& r2,
+                                const Vector3f& r3,
+                                float fMargin);
+
+    MatrixX3f   m_matBemVertices;
+    MatrixX3i   m_matBemTris;
+    MatrixX3f   m_matSoupVertices;
+    MatrixX3i   m_matSoupTris;
+};
+
+//=============================================================================================================
+
+TestMneTriangleBVH::TestMneTriangleBVH()
+{
+}
+
+//=============================================================================================================
+
+void TestMneTriangleBVH::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    std::srand(42);
+
+    // A closed surface
+    QFile fileBem(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/subjects/sample/bem/sample-5120-bem.fif");
+    MNEBem bem(fileBem);
+    QVERIFY(bem.size() > 0);
+
+    m_matBemVertices = bem[0].rr;
+    m_matBemTris = bem[0].tris;
+    QVERIFY(m_matBemTris.rows() == 5120);
+
+    // Randomly placed, overlapping and differently sized triangles in the unit cube
+    int iNumSoupTris = 2000;
+    m_matSoupVertices.resize(3 * iNumSoupTris, 3);
+    m_matSoupTris.resize(iNumSoupTris, 3);
+
+    for(int i = 0; i < iNumSoupTris; ++i) {
+        RowVector3f vecCenter = RowVector3f::Random();
+        float fSize = 0.01f + 0.2f * (RowVector3f::Random()[0] + 1.0f);
+
+        for(int j = 0; j < 3; ++j) {
+            m_matSoupVertices.row(3*i+j) = vecCenter + fSize * RowVector3f::Random();
+            m_matSoupTris(i,j) = 3*i+j;
+        }
+    }
+}
+
+//=============================================================================================================
+
+void TestMneTriangleBVH::compareEmpty()
+{
+    MNETriangleBVH bvh;
+    QVERIFY(bvh.isEmpty());
+
+    Vector3f rClosest;
+    float dist, t;
+    QVERIFY(bvh.nearestTriangle(Vector3f::Zero(), rClosest, dist) == -1);
+    QVERIFY(bvh.intersectRay(Vector3f::Zero(), Vector3f::UnitX(), t) == -1);
+
+    MNETriangleBVH bvhNoTris(m_matBemVertices, MatrixX3i(0,3));
+    QVERIFY(bvhNoTris.isEmpty());
+}
+
+//=============================================================================================================
+
+void TestMneTriangleBVH::compareNearestBem()
+{
+    // Points inside, close to and far outside of the surface. More than 128 points run the parallel path.
+    Vector3f vecCenter = m_matBemVertices.colwise().mean().transpose();
+    float fRadius = (m_matBemVertices.rowwise() - vecCenter.transpose()).rowwise().norm().maxCoeff();
+
+    MatrixX3f matPoints(600, 3);
+    for(int i = 0; i < matPoints.rows(); ++i) {
+        float fScale = (i < 300) ? 1.0f : 3.0f;
+        matPoints.row(i) = vecCenter.transpose() + fScale * fRadius * RowVector3f::Random();
+    }
+
+    for(int i = 0; i < 100; ++i) {
+        matPoints.row(i) = m_matBemVertices.row(std::rand() % m_matBemVertices.rows()) + 0.001f * RowVector3f::Random();
+    }
+
+    QVERIFY(compareNearest(m_matBemVertices, m_matBemTris, matPoints, 1e-6f));
+}
+
+//=============================================================================================================
+
+void TestMneTriangleBVH::compareNearestSoup()
+{
+    MatrixX3f matPoints = 1.5f * MatrixX3f::Random(500, 3);
+
+    QVERIFY(compareNearest(m_matSoupVertices, m_matSoupTris, matPoints, 1e-5f));
+}
+
+//=============================================================================================================
+
+void TestMneTriangleBVH::compareRayBem()
+{
+    // Every ray from the inside hits the closed surface
+    Vector3f vecCenter = m_matBemVertices.colwise().mean().transpose();
+
+    MatrixX3f matOrigins(500, 3);
+    MatrixX3f matDirections = MatrixX3f::Random(500, 3);
+
+    for(int i = 0; i < matOrigins.rows(); ++i) {
+        matOrigins.row(i) = vecCenter.transpose() + 0.01f * RowVector3f::Random();
+    }
+
+    MNETriangleBVH bvh(m_matBemVertices, m_matBemTris);
+    float t;
+    for(int i = 0; i < matOrigins.rows(); ++i) {
+        QVERIFY(bvh.intersectRay(matOrigins.row(i).transpose(), matDirections.row(i).transpose(), t) >= 0);
+    }
+
+    QVERIFY(compareRays(m_matBemVertices, m_matBemTris, matOrigins, matDirections, 1e-5f));
+
+    // Rays pointing away from the surface miss it
+    Vector3f vecFar = vecCenter + Vector3f(1.0f, 0.0f, 0.0f);
+    QVERIFY(bvh.intersectRay(vecFar, Vector3f::UnitX(), t) == -1);
+
+    // Hits beyond tMax are ignored
+    Vector3f vecDir = Vector3f::UnitZ();
+    QVERIFY(bvh.intersectRay(vecCenter, vecDir, t) >= 0);
+    QVERIFY(bvh.intersectRay(vecCenter, vecDir, t, 0.5f * t) == -1);
+}
+
+//=============================================================================================================
+
+void TestMneTriangleBVH::compareRaySoup()
+{
+    MatrixX3f matOrigins = 2.0f * MatrixX3f::Random(500, 3);
+    MatrixX3f matDirections = MatrixX3f::Random(500, 3);
+
+    // Some rays along the coordinate axes, which exercise the slab test with zero direction components
+    for(int i = 0; i < 30; ++i) {
+        matDirections.row(i) = RowVector3f::Zero();
+        matDirections(i, i % 3) = (i % 2 == 0) ? 1.0f : -1.0f;
+    }
+
+    QVERIFY(compareRays(m_matSoupVertices, m_matSoupTris, matOrigins, matDirections, 1e-4f));
+}
+
+//=============================================================================================================
+
+void TestMneTriangleBVH::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+bool TestMneTriangleBVH::compareNearest(const MatrixX3f& matVertices,
+                                        const MatrixX3i& matTris,
+                                        const MatrixX3f& matPoints,
+                                        float fTolerance) const
+{
+    MNETriangleBVH bvh(matVertices, matTris);
+
+    if(bvh.ntri() != matTris.rows()) {
+        return false;
+    }
+
+    VectorXi vecNearest;
+    MatrixX3f matClosest;
+    VectorXf vecDist;
+    bvh.nearestTriangles(matPoints, vecNearest, matClosest, vecDist);
+
+    for(int k = 0; k < matPoints.rows(); ++k) {
+        Vector3f r = matPoints.row(k).transpose();
+
+        float fBestDist = std::numeric_limits<float>::max();
+        for(int i = 0; i < matTris.rows(); ++i) {
+            fBestDist = qMin(fBestDist, pointTriangleDist(r,
+                                                          matVertices.row(matTris(i,0)).transpose(),
+                                                          matVertices.row(matTris(i,1)).transpose(),
+                                                          matVertices.row(matTris(i,2)).transpose()));
+        }
+
+        Vector3f rClosest;
+        float dist;
+        int tri = bvh.nearestTriangle(r, rClosest, dist);
+
+        if(tri < 0 || std::fabs(dist - fBestDist) > fTolerance) {
+            qWarning() << "TestMneTriangleBVH::compareNearest - Point" << k << "distance" << dist << "exhaustive" << fBestDist;
+            return false;
+        }
+
+        // The returned point lies on the returned triangle at the returned distance
+        float fTriDist = pointTriangleDist(r,
+                                           matVertices.row(matTris(tri,0)).transpose(),
+                                           matVertices.row(matTris(tri,1)).transpose(),
+                                           matVertices.row(matTris(tri,2)).transpose());
+        if(std::fabs(fTriDist - dist) > fTolerance || std::fabs((rClosest - r).norm() - dist) > fTolerance) {
+            return false;
+        }
+
+        // The batch query returns the same as the single one
+        if(vecNearest[k] != tri || vecDist[k] != dist || matClosest.row(k) != rClosest.transpose()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//=============================================================================================================
+
+bool TestMneTriangleBVH::compareRays(const MatrixX3f& matVertices,
+                                     const MatrixX3i& matTris,
+                                     const MatrixX3f& matOrigins,
+                                     const MatrixX3f& matDirections,
+                                     float fTolerance) const
+{
+    MNETriangleBVH bvh(matVertices, matTris);
+
+    const float fInf = std::numeric_limits<float>::infinity();
+    int iNumHits = 0;
+
+    for(int k = 0; k < matOrigins.rows(); ++k) {
+        Vector3f origin = matOrigins.row(k).transpose();
+        Vector3f direction = matDirections.row(k).transpose();
+
+        float fFirstShrunk = fInf;
+        float fFirstGrown = fInf;
+        for(int i = 0; i < matTris.rows(); ++i) {
+            Vector3f r1 = matVertices.row(matTris(i,0)).transpose();
+            Vector3f r2 = matVertices.row(matTris(i,1)).transpose();
+            Vector3f r3 = matVertices.row(matTris(i,2)).transpose();
+
+            fFirstShrunk = qMin(fFirstShrunk, rayTriangleHit(origin, direction, r1, r2, r3, -1e-4f));
+            fFirstGrown = qMin(fFirstGrown, rayTriangleHit(origin, direction, r1, r2, r3, 1e-4f));
+        }
+
+        float t = fInf;
+        int tri = bvh.intersectRay(origin, direction, t);
+
+        if(tri < 0) {
+            if(fFirstShrunk != fInf) {
+                qWarning() << "TestMneTriangleBVH::compareRays - Ray" << k << "missed, exhaustive hit at" << fFirstShrunk;
+                return false;
+            }
+            continue;
+        }
+
+        ++iNumHits;
+
+        if(t < fFirstGrown - fTolerance || (fFirstShrunk != fInf && t > fFirstShrunk + fTolerance)) {
+            qWarning() << "TestMneTriangleBVH::compareRays - Ray" << k << "hit at" << t << "exhaustive between" << fFirstGrown << fFirstShrunk;
+            return false;
+        }
+
+        // The hit lies on the returned triangle
+        if(rayTriangleHit(origin,
+                          direction,
+                          matVertices.row(matTris(tri,0)).transpose(),
+                          matVertices.row(matTris(tri,1)).transpose(),
+                          matVertices.row(matTris(tri,2)).transpose(),
+                          1e-4f) == fInf) {
+            return false;
+        }
+    }
+
+    return iNumHits > 0;
+}
+
+//=============================================================================================================
+
+float TestMneTriangleBVH::pointTriangleDist(const Vector3f& r,
+                                            const Vector3f& r1,
+                                            const Vector3f& r2,
+                                            const Vector3f& r3)
+{
+    // The projection onto the plane if it falls inside, otherwise the closest point on one of the edges
+    Vector3f vecNormal = (r2 - r1).cross(r3 - r1);
+
+    if(vecNormal.squaredNorm() > 0.0f) {
+        vecNormal.normalize();
+        Vector3f rProj = r - vecNormal.dot(r - r1) * vecNormal;
+
+        if((r2 - r1).cross(rProj - r1).dot(vecNormal) >= 0.0f
+           && (r3 - r2).cross(rProj - r2).dot(vecNormal) >= 0.0f
+           && (r1 - r3).cross(rProj - r3).dot(vecNormal) >= 0.0f) {
+            return (r - rProj).norm();
+        }
+    }
+
+    auto segmentDist = [&r](const Vector3f& a, const Vector3f& b) {
+        if((b - a).squaredNorm() == 0.0f) {
+            return (r - a).norm();
+        }
+        float s = qBound(0.0f, (r - a).dot(b - a) / (b - a).squaredNorm(), 1.0f);
+        return (r - (a + s * (b - a))).norm();
+    };
+
+    return qMin(segmentDist(r1, r2), qMin(segmentDist(r2, r3), segmentDist(r3, r1)));
+}
+
+//=============================================================================================================
+
+float TestMneTriangleBVH::rayTriangleHit(const Vector3f& origin,
+                                         const Vector3f& direction,
+                                         const Vector3f& r1,
+                                         const Vector3f& r2,
+                                         const Vector3f& r3,
+                                         float fMargin)
+{
+    // Intersect with the plane and express the hit in barycentric coordinates
+    Vector3f vecNormal = (r2 - r1).cross(r3 - r1);
+    float fDenom = vecNormal.dot(direction);
+
+    if(std::fabs(fDenom) < 1e-12f) {
+        return std::numeric_limits<float>::infinity();
+    }
+
+    float t = vecNormal.dot(r1 - origin) / fDenom;
+    if(t < 0.0f) {
+        return std::numeric_limits<float>::infinity();
+    }
+
+    Vector3f rHit = origin + t * direction;
+    float fArea = vecNormal.squaredNorm();
+    float b1 = (r3 - r2).cross(rHit - r2).dot(vecNormal) / fArea;
+    float b2 = (r1 - r3).cross(rHit - r3).dot(vecNormal) / fArea;
+    float b3 = 1.0f - b1 - b2;
+
+    if(b1 < -fMargin || b2 < -fMargin || b3 < -fMargin) {
+        return std::numeric_limits<float>::infinity();
+    }
+
+    return t;
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestMneTriangleBVH)
+#include "test_mne_triangle_bvh.moc"
@@ -0,0 +1,358 @@
+//=============================================================================================================
+/**
+ * @file     test_rtprocessing_running_average.cpp
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test for the running average of the real-time averaging.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+
+#include <rtprocessing/rtave.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Dense>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace RTPROCESSINGLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestRtProcessingRunningAverage
+ *
+ * @brief The TestRtProcessingRunningAverage class compares the running average with the average, variance and SNR
+ *        computed directly from the most recent epochs.
+ *
+ */
+class TestRtProcessingRunningAverage: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestRtProcessingRunningAverage();
+
+private slots:
+    void initTestCase();
+    void compareEviction();
+    void compareResum();
+    void compareSetMaxEpochs();
+    void compareVariance();
+    void compareShapeChange();
+    void cleanupTestCase();
+
+private:
+    //=========================================================================================================
+    /**
+     * Appends a new random epoch to the running average and to the list of all appended epochs.
+     */
+    void appendEpoch(RunningAverage& average,
+                     double dOffset = 0.0);
+
+    //=========================================================================================================
+    /**
+     * Returns whether the running average matches the average of the last iNumEpochs appended epochs.
+     */
+    bool compareMean(const RunningAverage& average,
+                     int iNumEpochs) const;
+
+    //=========================================================================================================
+    /**
+     * Returns whether the variance and SNR of the running average match the ones of the last iNumEpochs appended
+     * epochs.
+     */
+    bool compareStatistics(const RunningAverage& average,
+                           int iNumEpochs) const;
+
+    double              m_dEpsilon;
+    int                 m_iNumChannels;
+    int                 m_iNumSamples;
+    QList<MatrixXd>     m_lEpochs;
+};
+
+//=============================================================================================================
+
+TestRtProcessingRunningAverage::TestRtProcessingRunningAverage()
+: m_dEpsilon(1e-10)
+, m_iNumChannels(4)
+, m_iNumSamples(25)
+{
+}
+
+//=============================================================================================================
+
+void TestRtProcessingRunningAverage::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    std::srand(42);
+}
+
+//=============================================================================================================
+
+void TestRtProcessingRunningAverage::compareEviction()
+{
+    m_lEpochs.clear();
+
+    RunningAverage average(5);
+    QVERIFY(average.isEmpty());
+    QVERIFY(average.mean().size() == 0);
+
+    // Below the capacity all epochs are averaged
+    for(int i = 1; i <= 5; ++i) {
+        appendEpoch(average);
+        QVERIFY(average.count() == i);
+        QVERIFY(compareMean(average, i));
+    }
+
+    // At the capacity the oldest epoch is evicted by every new one
+    for(int i = 0; i < 12; ++i) {
+        appendEpoch(average);
+        QVERIFY(average.count() == 5);
+        QVERIFY(compareMean(average, 5));
+    }
+}
+
+//=============================================================================================================
+
+void TestRtProcessingRunningAverage::compareResum()
+{
+    m_lEpochs.clear();
+
+    // Large epochs followed by small ones. Without the periodic re-summation the rounding error of subtracting the
+    // large epochs would remain in the sum of the small ones.
+    RunningAverage average(3, true);
+
+    for(int i = 0; i < 3; ++i) {
+        appendEpoch(average, 1e8);
+    }
+
+    for(int i = 0; i < 1000; ++i) {
+        appendEpoch(average);
+        QVERIFY(average.count() == 3);
+    }
+
+    // Subtracting the large epochs alone would leave an error of about 1e-8 in the mean and of about 1 in the sum of
+    // squares
+    QVERIFY(compareMean(average, 3));
+    QVERIFY(compareStatistics(average, 3));
+}
+
+//=============================================================================================================
+
+void TestRtProcessingRunningAverage::compareSetMaxEpochs()
+{
+    m_lEpochs.clear();
+
+    RunningAverage average(6);
+
+    // Setting the capacity of an empty average keeps it empty
+    average.setMaxEpochs(7);
+    QVERIFY(average.isEmpty());
+    average.setMaxEpochs(6);
+
+    // Wrap the ring so that the oldest epoch is not in the first slot
+    for(int i = 0; i < 9; ++i) {
+        appendEpoch(average);
+    }
+    QVERIFY(compareMean(average, 6));
+
+    // Shrinking keeps the most recent epochs
+    average.setMaxEpochs(4);
+    QVERIFY(average.count() == 4);
+    QVERIFY(compareMean(average, 4));
+
+    for(int i = 0; i < 3; ++i) {
+        appendEpoch(average);
+        QVERIFY(average.count() == 4);
+        QVERIFY(compareMean(average, 4));
+    }
+
+    // Growing keeps all stored epochs and fills the new slots first
+    average.setMaxEpochs(8);
+    QVERIFY(average.count() == 4);
+    QVERIFY(compareMean(average, 4));
+
+    for(int i = 5; i <= 8; ++i) {
+        appendEpoch(average);
+        QVERIFY(average.count() == i);
+        QVERIFY(compareMean(average, i));
+    }
+
+    for(int i = 0; i < 5; ++i) {
+        appendEpoch(average);
+        QVERIFY(average.count() == 8);
+        QVERIFY(compareMean(average, 8));
+    }
+
+    // A capacity below one is clamped
+    average.setMaxEpochs(0);
+    QVERIFY(average.count() == 1);
+    QVERIFY(compareMean(average, 1));
+}
+
+//=============================================================================================================
+
+void TestRtProcessingRunningAverage::compareVariance()
+{
+    m_lEpochs.clear();
+
+    RunningAverage average(7, true);
+
+    // Less than two epochs have no variance
+    appendEpoch(average);
+    QVERIFY(average.variance().isZero());
+
+    for(int i = 2; i <= 7; ++i) {
+        appendEpoch(average);
+        QVERIFY(compareStatistics(average, i));
+    }
+
+    for(int i = 0; i < 10; ++i) {
+        appendEpoch(average);
+        QVERIFY(compareStatistics(average, 7));
+    }
+
+    // The variance follows the number of averages
+    average.setMaxEpochs(5);
+    QVERIFY(compareStatistics(average, 5));
+
+    // Disabling the variance returns zeros, enabling it again recomputes it from the stored epochs
+    average.setComputeVariance(false);
+    QVERIFY(average.variance().isZero());
+
+    appendEpoch(average);
+    average.setComputeVariance(true);
+    QVERIFY(compareStatistics(average, 5));
+}
+
+//=============================================================================================================
+
+void TestRtProcessingRunningAverage::compareShapeChange()
+{
+    m_lEpochs.clear();
+
+    RunningAverage average(4);
+
+    for(int i = 0; i < 6; ++i) {
+        appendEpoch(average);
+    }
+
+    // An epoch of a different shape restarts the average
+    m_iNumSamples += 5;
+    m_lEpochs.clear();
+
+    appendEpoch(average);
+    QVERIFY(average.count() == 1);
+    QVERIFY(average.mean().cols() == m_iNumSamples);
+    QVERIFY(compareMean(average, 1));
+
+    appendEpoch(average);
+    QVERIFY(compareMean(average, 2));
+
+    m_iNumSamples -= 5;
+}
+
+//=============================================================================================================
+
+void TestRtProcessingRunningAverage::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+void TestRtProcessingRunningAverage::appendEpoch(RunningAverage& average,
+                                                 double dOffset)
+{
+    m_lEpochs.append(MatrixXd::Random(m_iNumChannels, m_iNumSamples).array() + dOffset);
+    average.append(m_lEpochs.last());
+}
+
+//=============================================================================================================
+
+bool TestRtProcessingRunningAverage::compareMean(const RunningAverage& average,
+                                                 int iNumEpochs) const
+{
+    MatrixXd matMean = MatrixXd::Zero(m_iNumChannels, m_iNumSamples);
+    for(int i = m_lEpochs.size() - iNumEpochs; i < m_lEpochs.size(); ++i) {
+        matMean += m_lEpochs.at(i);
+    }
+    matMean /= iNumEpochs;
+
+    MatrixXd matAverage = average.mean();
+
+    return matAverage.rows() == matMean.rows()
+           && matAverage.cols() == matMean.cols()
+           && (matAverage - matMean).cwiseAbs().maxCoeff() < m_dEpsilon;
+}
+
+//=============================================================================================================
+
+bool TestRtProcessingRunningAverage::compareStatistics(const RunningAverage& average,
+                                                       int iNumEpochs) const
+{
+    if(average.count() != iNumEpochs || !compareMean(average, iNumEpochs)) {
+        return false;
+    }
+
+    MatrixXd matMean = average.mean();
+    MatrixXd matVariance = MatrixXd::Zero(m_iNumChannels, m_iNumSamples);
+    for(int i = m_lEpochs.size() - iNumEpochs; i < m_lEpochs.size(); ++i) {
+        matVariance += (m_lEpochs.at(i) - matMean).cwiseAbs2();
+    }
+    matVariance /= (iNumEpochs - 1);
+
+    MatrixXd matSnr = (matMean.array().abs() / (matVariance.array() / iNumEpochs).sqrt()).matrix();
+
+    return (average.variance() - matVariance).cwiseAbs().maxCoeff() < m_dEpsilon
+           && ((average.snr() - matSnr).array().abs() / matSnr.array()).maxCoeff() < 1e-6;
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestRtProcessingRunningAverage)
+#include "test_rtprocessing_running_average.moc"
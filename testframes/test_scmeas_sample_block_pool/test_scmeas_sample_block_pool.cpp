@@ -0,0 +1,222 @@
+//=============================================================================================================
+/**
+ * @file     test_scmeas_sample_block_pool.cpp
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test for the recycling of sample blocks by the sample block pool.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+
+#include <scMeas/sampleblockpool.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace SCMEASLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestScMeasSampleBlockPool
+ *
+ * @brief The TestScMeasSampleBlockPool class checks which blocks the pool hands out again and which it frees.
+ *
+ */
+class TestScMeasSampleBlockPool: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestScMeasSampleBlockPool();
+
+private slots:
+    void initTestCase();
+    void compareRecycling();
+    void compareShapeChange();
+    void compareMaxFreeBlocks();
+    void compareOutlivePool();
+    void cleanupTestCase();
+
+private:
+    int     m_iRows;
+    int     m_iCols;
+};
+
+//=============================================================================================================
+
+TestScMeasSampleBlockPool::TestScMeasSampleBlockPool()
+: m_iRows(3)
+, m_iCols(5)
+{
+}
+
+//=============================================================================================================
+
+void TestScMeasSampleBlockPool::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+}
+
+//=============================================================================================================
+
+void TestScMeasSampleBlockPool::compareRecycling()
+{
+    SampleBlockPool::SPtr pPool(new SampleBlockPool(4));
+
+    SampleBlockPool::Block pBlock = pPool->acquire(m_iRows, m_iCols);
+    QVERIFY(pBlock->rows() == m_iRows && pBlock->cols() == m_iCols);
+    QVERIFY(pPool->freeBlocks() == 0);
+
+    // A released block returns to the pool and is handed out by the next acquire
+    const double* pData = pBlock->data();
+    pBlock.clear();
+    QVERIFY(pPool->freeBlocks() == 1);
+
+    pBlock = pPool->acquire(m_iRows, m_iCols);
+    QVERIFY(pBlock->data() == pData);
+    QVERIFY(pBlock->rows() == m_iRows && pBlock->cols() == m_iCols);
+    QVERIFY(pPool->freeBlocks() == 0);
+
+    // The block is only recycled once the last reference is gone
+    SampleBlockPool::ConstBlock pConstBlock = pBlock;
+    pBlock.clear();
+    QVERIFY(pPool->freeBlocks() == 0);
+
+    pConstBlock.clear();
+    QVERIFY(pPool->freeBlocks() == 1);
+}
+
+//=============================================================================================================
+
+void TestScMeasSampleBlockPool::compareShapeChange()
+{
+    SampleBlockPool::SPtr pPool(new SampleBlockPool(4));
+
+    SampleBlockPool::Block pOldBlock = pPool->acquire(m_iRows, m_iCols);
+    pPool->acquire(m_iRows, m_iCols).clear();
+    QVERIFY(pPool->freeBlocks() == 1);
+
+    // A new shape discards the unused blocks of the old one and allocates a fresh block
+    SampleBlockPool::Block pBlock = pPool->acquire(m_iRows + 1, m_iCols);
+    QVERIFY(pBlock->rows() == m_iRows + 1 && pBlock->cols() == m_iCols);
+    QVERIFY(pPool->freeBlocks() == 0);
+
+    // Blocks of the old shape are freed on release instead of being recycled
+    pOldBlock.clear();
+    QVERIFY(pPool->freeBlocks() == 0);
+
+    // Blocks of the new shape are recycled
+    const double* pData = pBlock->data();
+    pBlock.clear();
+    QVERIFY(pPool->freeBlocks() == 1);
+
+    pBlock = pPool->acquire(m_iRows + 1, m_iCols);
+    QVERIFY(pBlock->data() == pData);
+    pBlock.clear();
+
+    // Going back to the old shape starts over with a fresh block
+    pBlock = pPool->acquire(m_iRows, m_iCols);
+    QVERIFY(pBlock->rows() == m_iRows && pBlock->cols() == m_iCols);
+    QVERIFY(pPool->freeBlocks() == 0);
+}
+
+//=============================================================================================================
+
+void TestScMeasSampleBlockPool::compareMaxFreeBlocks()
+{
+    SampleBlockPool::SPtr pPool(new SampleBlockPool(2));
+
+    QList<SampleBlockPool::Block> lBlocks;
+    for(int i = 0; i < 5; ++i) {
+        lBlocks.append(pPool->acquire(m_iRows, m_iCols));
+    }
+
+    // Only as many released blocks as the cap allows are kept, the others are freed
+    lBlocks.clear();
+    QVERIFY(pPool->freeBlocks() == 2);
+
+    for(int i = 0; i < 5; ++i) {
+        lBlocks.append(pPool->acquire(m_iRows, m_iCols));
+        QVERIFY(pPool->freeBlocks() == qMax(0, 1 - i));
+    }
+}
+
+//=============================================================================================================
+
+void TestScMeasSampleBlockPool::compareOutlivePool()
+{
+    SampleBlockPool::SPtr pPool(new SampleBlockPool(4));
+    QWeakPointer<SampleBlockPool> wpPool = pPool;
+
+    SampleBlockPool::Block pBlock = pPool->acquire(m_iRows, m_iCols);
+    pPool->acquire(m_iRows, m_iCols).clear();
+    QVERIFY(pPool->freeBlocks() == 1);
+
+    // The pool goes away while a block is still in use, the block stays valid
+    pPool.clear();
+    QVERIFY(wpPool.isNull());
+
+    pBlock->setConstant(2.0);
+    QVERIFY(pBlock->sum() == 2.0 * m_iRows * m_iCols);
+
+    // Releasing the block frees it without a pool to return to
+    pBlock.clear();
+    QVERIFY(pBlock.isNull());
+}
+
+//=============================================================================================================
+
+void TestScMeasSampleBlockPool::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestScMeasSampleBlockPool)
+#include "test_scmeas_sample_block_pool.moc"
@@ -0,0 +1,350 @@
+//=============================================================================================================
+/**
+ * @file     test_scshared_connector_edge.cpp
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test for the queue policies of the plug-in connector edge.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+
+#include <scShared/Management/pluginconnectoredge.h>
+#include <scShared/Management/plugininputconnector.h>
+
+#include <scMeas/measurement.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+#include <QtConcurrent>
+#include <QElapsedTimer>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace SCSHAREDLIB;
+using namespace SCMEASLIB;
+
+//=============================================================================================================
+/**
+ * Measurement holding a single number, which supports snapshots like the real-time measurements do.
+ */
+class TestMeasurement : public Measurement
+{
+public:
+    explicit TestMeasurement(int iValue = 0)
+    : m_iValue(iValue)
+    {
+    }
+
+    void setValue(int iValue)
+    {
+        m_iValue = iValue;
+    }
+
+    int getValue() const
+    {
+        return m_iValue;
+    }
+
+    virtual QSharedPointer<Measurement> snapshot() const
+    {
+        return QSharedPointer<Measurement>(new TestMeasurement(m_iValue));
+    }
+
+private:
+    int m_iValue;
+};
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestScSharedConnectorEdge
+ *
+ * @brief The TestScSharedConnectorEdge class pushes measurements through an edge with each queue policy and checks
+ * the delivered snapshots and the drop counters.
+ *
+ */
+class TestScSharedConnectorEdge: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestScSharedConnectorEdge();
+
+private slots:
+    void initTestCase();
+    void init();
+    void compareBlocking();
+    void compareDropOldest();
+    void compareCoalesce();
+    void compareBackpressureTimeout();
+    void compareBackpressureWait();
+    void compareRelease();
+    void cleanup();
+    void cleanupTestCase();
+
+private:
+    void pushValues(PluginConnectorEdge& edge,
+                    int iFirst,
+                    int iLast);
+
+    QSharedPointer<PluginInputConnector>    m_pInputConnector;
+    QList<int>                              m_lReceived;
+    int                                     m_iTimeoutMs;
+};
+
+//=============================================================================================================
+
+TestScSharedConnectorEdge::TestScSharedConnectorEdge()
+: m_iTimeoutMs(50)
+{
+}
+
+//=============================================================================================================
+
+void TestScSharedConnectorEdge::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+}
+
+//=============================================================================================================
+
+void TestScSharedConnectorEdge::init()
+{
+    // The input connector lives in the test thread, deliveries are processed by its event loop
+    m_lReceived.clear();
+    m_pInputConnector = QSharedPointer<PluginInputConnector>(new PluginInputConnector(Q_NULLPTR, "input", "Test input"));
+
+    connect(m_pInputConnector.data(), &PluginInputConnector::notify, [this](Measurement::SPtr pMeasurement) {
+        m_lReceived.append(pMeasurement.staticCast<TestMeasurement>()->getValue());
+    });
+}
+
+//=============================================================================================================
+
+void TestScSharedConnectorEdge::compareBlocking()
+{
+    PluginConnectorEdge edge(m_pInputConnector.data(), Blocking, 4);
+
+    // The measurement itself is handed over right away
+    pushValues(edge, 0, 9);
+
+    QVERIFY(m_lReceived.size() == 10);
+    for(int i = 0; i < m_lReceived.size(); ++i) {
+        QVERIFY(m_lReceived.at(i) == i);
+    }
+
+    EdgeStatistics statistics = edge.getStatistics();
+    QVERIFY(statistics.iDropped == 0);
+    QVERIFY(statistics.iQueueDepth == 0);
+}
+
+//=============================================================================================================
+
+void TestScSharedConnectorEdge::compareDropOldest()
+{
+    PluginConnectorEdge edge(m_pInputConnector.data(), DropOldest, 4);
+
+    // Nothing is delivered before the receiver's event loop runs, a full queue discards its oldest snapshot
+    pushValues(edge, 0, 9);
+
+    QVERIFY(m_lReceived.isEmpty());
+
+    EdgeStatistics statistics = edge.getStatistics();
+    QVERIFY(statistics.iDropped == 6);
+    QVERIFY(statistics.iQueueDepth == 4);
+    QVERIFY(statistics.iMaxQueueDepth == 4);
+    QVERIFY(statistics.iDelivered == 0);
+
+    QCoreApplication::processEvents();
+
+    // The snapshots hold the values at the time of the push, not the last value of the measurement
+    QVERIFY(m_lReceived == QList<int>() << 6 << 7 << 8 << 9);
+
+    statistics = edge.getStatistics();
+    QVERIFY(statistics.iDropped == 6);
+    QVERIFY(statistics.iQueueDepth == 0);
+    QVERIFY(statistics.iDelivered == 4);
+
+    // Shrinking the queue drops the oldest queued snapshots as well
+    pushValues(edge, 10, 13);
+    edge.setPolicy(DropOldest, 1);
+    QCoreApplication::processEvents();
+
+    QVERIFY(m_lReceived.mid(4) == QList<int>() << 13);
+    QVERIFY(edge.getStatistics().iDropped == 9);
+}
+
+//=============================================================================================================
+
+void TestScSharedConnectorEdge::compareCoalesce()
+{
+    PluginConnectorEdge edge(m_pInputConnector.data(), Coalesce, 4);
+
+    // Only the latest snapshot is kept
+    pushValues(edge, 0, 9);
+
+    EdgeStatistics statistics = edge.getStatistics();
+    QVERIFY(statistics.iDropped == 9);
+    QVERIFY(statistics.iQueueDepth == 1);
+    QVERIFY(statistics.iMaxQueueDepth == 1);
+
+    QCoreApplication::processEvents();
+
+    QVERIFY(m_lReceived == QList<int>() << 9);
+
+    statistics = edge.getStatistics();
+    QVERIFY(statistics.iDropped == 9);
+    QVERIFY(statistics.iDelivered == 1);
+}
+
+//=============================================================================================================
+
+void TestScSharedConnectorEdge::compareBackpressureTimeout()
+{
+    PluginConnectorEdge edge(m_pInputConnector.data(), Backpressure, 2);
+    edge.setPolicy(Backpressure, 2, m_iTimeoutMs);
+
+    // The queue is full and the receiver does not deliver, the sender waits for the timeout and drops the oldest
+    pushValues(edge, 0, 1);
+
+    QElapsedTimer timer;
+    timer.start();
+    pushValues(edge, 2, 2);
+    QVERIFY(timer.elapsed() >= m_iTimeoutMs - 1);
+
+    EdgeStatistics statistics = edge.getStatistics();
+    QVERIFY(statistics.iDropped == 1);
+    QVERIFY(statistics.iQueueDepth == 2);
+
+    QCoreApplication::processEvents();
+
+    QVERIFY(m_lReceived == QList<int>() << 1 << 2);
+    QVERIFY(edge.getStatistics().iDelivered == 2);
+}
+
+//=============================================================================================================
+
+void TestScSharedConnectorEdge::compareBackpressureWait()
+{
+    PluginConnectorEdge edge(m_pInputConnector.data(), Backpressure, 2);
+    edge.setPolicy(Backpressure, 2, 100 * m_iTimeoutMs);
+
+    pushValues(edge, 0, 1);
+
+    // A sender thread waits for free space until the receiver delivered, nothing is dropped
+    QFuture<void> sender = QtConcurrent::run([&]() {
+        pushValues(edge, 2, 5);
+    });
+
+    while(!sender.isFinished()) {
+        QCoreApplication::processEvents();
+    }
+    QCoreApplication::processEvents();
+
+    QVERIFY(m_lReceived == QList<int>() << 0 << 1 << 2 << 3 << 4 << 5);
+
+    EdgeStatistics statistics = edge.getStatistics();
+    QVERIFY(statistics.iDropped == 0);
+    QVERIFY(statistics.iDelivered == 6);
+    QVERIFY(statistics.iMaxQueueDepth <= 2);
+}
+
+//=============================================================================================================
+
+void TestScSharedConnectorEdge::compareRelease()
+{
+    PluginConnectorEdge edge(m_pInputConnector.data(), Backpressure, 2);
+    edge.setPolicy(Backpressure, 2, 100 * m_iTimeoutMs);
+
+    pushValues(edge, 0, 1);
+
+    // A sender waiting for free space is woken up by release() and its measurement is not queued
+    QFuture<void> sender = QtConcurrent::run([&]() {
+        pushValues(edge, 2, 2);
+    });
+
+    QThread::msleep(m_iTimeoutMs);
+
+    QElapsedTimer timer;
+    timer.start();
+    edge.release();
+    sender.waitForFinished();
+    QVERIFY(timer.elapsed() < 100 * m_iTimeoutMs);
+
+    // A released edge ignores all further measurements
+    pushValues(edge, 3, 5);
+    QCoreApplication::processEvents();
+
+    QVERIFY(m_lReceived.isEmpty());
+    QVERIFY(edge.getStatistics().iQueueDepth == 0);
+    QVERIFY(edge.getStatistics().iDelivered == 0);
+}
+
+//=============================================================================================================
+
+void TestScSharedConnectorEdge::cleanup()
+{
+    m_pInputConnector.clear();
+}
+
+//=============================================================================================================
+
+void TestScSharedConnectorEdge::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+void TestScSharedConnectorEdge::pushValues(PluginConnectorEdge& edge,
+                                           int iFirst,
+                                           int iLast)
+{
+    // The sender reuses one measurement, like the plug-ins do
+    QSharedPointer<TestMeasurement> pMeasurement(new TestMeasurement());
+
+    for(int i = iFirst; i <= iLast; ++i) {
+        pMeasurement->setValue(i);
+        edge.push(pMeasurement);
+    }
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestScSharedConnectorEdge)
+#include "test_scshared_connector_edge.moc"
@@ -51,6 +51,7 @@
 #include <connectivity/metrics/debiasedsquaredweightedphaselagindex.h>
 #include <connectivity/metrics/crosscorrelation.h>
 #include <connectivity/connectivitysettings.h>
+#include <connectivity/connectivity.h>
 #include <connectivity/network/network.h>
 
 //=============================================================================================================
@@ -97,6 +98,7 @@ private slots:
     void spectralConnectivityCoherence();
     void spectralConnectivityImagCoherence();
     void spectralConnectivityXCOR();
+    void spectralConnectivityFused();
     void cleanupTestCase();
 
 private:
@@ -348,6 +350,51 @@ void TestSpectralConnectivity::spectralConnectivityXCOR()
 
 //=============================================================================================================
 
+void TestSpectralConnectivity::spectralConnectivityFused()
+{
+    //*********************************************************************************************************
+    // Compute Connectivity In One Fused Pass
+    //*********************************************************************************************************
+
+    QStringList lMethods = QStringList() << "WPLI" << "USPLI" << "PLI" << "COH" << "IMAGCOH" << "PLV" << "DSWPLI";
+    m_connectivitySettings.setConnectivityMethods(lMethods);
+
+    QList<Network> lFused = Connectivity::calculate(m_connectivitySettings, true);
+
+    //*********************************************************************************************************
+    // Compute Each Metric On Its Own As Reference, In The Order Connectivity::calculate Returns Them
+    //*********************************************************************************************************
+
+    QList<Network> lSingle;
+    lSingle << WeightedPhaseLagIndex::calculate(m_connectivitySettings)
+            << UnbiasedSquaredPhaseLagIndex::calculate(m_connectivitySettings)
+            << PhaseLagIndex::calculate(m_connectivitySettings)
+            << Coherence::calculate(m_connectivitySettings)
+            << ImagCoherence::calculate(m_connectivitySettings)
+            << PhaseLockingValue::calculate(m_connectivitySettings)
+            << DebiasedSquaredWeightedPhaseLagIndex::calculate(m_connectivitySettings);
+
+    //*********************************************************************************************************
+    // Compare Connectivity
+    //*********************************************************************************************************
+
+    QVERIFY(lFused.size() == lSingle.size());
+
+    for(int i = 0; i < lSingle.size(); ++i) {
+        QVERIFY(lFused.at(i).getConnectivityMethod() == lSingle.at(i).getConnectivityMethod());
+        QVERIFY(lFused.at(i).getNodes().size() == lSingle.at(i).getNodes().size());
+        QVERIFY(lFused.at(i).getUsedFreqBins() == lSingle.at(i).getUsedFreqBins());
+
+        MatrixXd matFused = lFused.at(i).getFullConnectivityMatrix();
+        MatrixXd matSingle = lSingle.at(i).getFullConnectivityMatrix();
+
+        QVERIFY(matFused.rows() == matSingle.rows() && matFused.cols() == matSingle.cols());
+        QVERIFY2((matFused - matSingle).cwiseAbs().maxCoeff() < dEpsilon, qPrintable(lSingle.at(i).getConnectivityMethod()));
+    }
+}
+
+//=============================================================================================================
+
 QList<MatrixXd> TestSpectralConnectivity::readConnectivityData()
 {
     MatrixXd inputTrials;
@@ -0,0 +1,392 @@
+//=============================================================================================================
+/**
+ * @file     test_utils_circular_matrix_buffer.cpp
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test for the single producer/single consumer ring of the circular matrix buffer.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+#include <utils/generics/circularmatrixbuffer.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+#include <QtConcurrent>
+#include <QElapsedTimer>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace IOBUFFER;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestUtilsCircularMatrixBuffer
+ *
+ * @brief The TestUtilsCircularMatrixBuffer class tests the order, the non blocking and timed calls, the release of
+ * blocked threads and the zero copy slots of the circular matrix buffer.
+ *
+ */
+class TestUtilsCircularMatrixBuffer: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestUtilsCircularMatrixBuffer();
+
+private slots:
+    void initTestCase();
+    void compareFifoOrder();
+    void compareZeroCopyFifoOrder();
+    void compareFullAndEmpty();
+    void compareTimeouts();
+    void compareReleaseFromPop();
+    void compareReleaseFromPush();
+    void compareZeroCopy();
+    void cleanupTestCase();
+
+private:
+    MatrixXd numberedMatrix(int iNumber) const;
+
+    int     m_iRows;
+    int     m_iCols;
+    int     m_iSlots;
+    int     m_iNumMatrices;
+    int     m_iTimeoutMs;
+};
+
+//=============================================================================================================
+
+TestUtilsCircularMatrixBuffer::TestUtilsCircularMatrixBuffer()
+: m_iRows(3)
+, m_iCols(5)
+, m_iSlots(4)
+, m_iNumMatrices(10000)
+, m_iTimeoutMs(50)
+{
+}
+
+//=============================================================================================================
+
+void TestUtilsCircularMatrixBuffer::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+}
+
+//=============================================================================================================
+
+void TestUtilsCircularMatrixBuffer::compareFifoOrder()
+{
+    // A producer thread pushes numbered matrices through a small ring, the consumer has to see all of them in order
+    CircularMatrixBuffer<double> buffer(m_iSlots, m_iRows, m_iCols);
+
+    QFuture<void> producer = QtConcurrent::run([&]() {
+        for(int i = 0; i < m_iNumMatrices; ++i) {
+            MatrixXd matData = numberedMatrix(i);
+            buffer.push(&matData);
+        }
+    });
+
+    bool bInOrder = true;
+    for(int i = 0; i < m_iNumMatrices; ++i) {
+        if(buffer.pop() != numberedMatrix(i)) {
+            bInOrder = false;
+        }
+    }
+
+    producer.waitForFinished();
+
+    QVERIFY(bInOrder);
+
+    MatrixXd matData;
+    QVERIFY(!buffer.tryPop(matData));
+}
+
+//=============================================================================================================
+
+void TestUtilsCircularMatrixBuffer::compareZeroCopyFifoOrder()
+{
+    // The same with the producer and the consumer working on the slots in place
+    CircularMatrixBuffer<double> buffer(m_iSlots, m_iRows, m_iCols);
+
+    QFuture<void> producer = QtConcurrent::run([&]() {
+        for(int i = 0; i < m_iNumMatrices; ++i) {
+            double* pSlot = buffer.beginWrite();
+            Map<MatrixXd>(pSlot, m_iRows, m_iCols) = numberedMatrix(i);
+            buffer.commitWrite();
+        }
+    });
+
+    bool bInOrder = true;
+    for(int i = 0; i < m_iNumMatrices; ++i) {
+        const double* pSlot = buffer.beginRead();
+        if(Map<const MatrixXd>(pSlot, m_iRows, m_iCols) != numberedMatrix(i)) {
+            bInOrder = false;
+        }
+        buffer.commitRead();
+    }
+
+    producer.waitForFinished();
+
+    QVERIFY(bInOrder);
+}
+
+//=============================================================================================================
+
+void TestUtilsCircularMatrixBuffer::compareFullAndEmpty()
+{
+    CircularMatrixBuffer<double> buffer(m_iSlots, m_iRows, m_iCols);
+    MatrixXd matData;
+
+    // Nothing to pop from an empty ring
+    QVERIFY(!buffer.tryPop(matData));
+
+    // Matrices of the wrong size are not appended
+    MatrixXd matWrongSize = MatrixXd::Ones(m_iRows + 1, m_iCols);
+    QVERIFY(!buffer.tryPush(&matWrongSize));
+
+    // The ring takes exactly one matrix per slot
+    for(int i = 0; i < m_iSlots; ++i) {
+        matData = numberedMatrix(i);
+        QVERIFY(buffer.tryPush(&matData));
+    }
+
+    matData = numberedMatrix(m_iSlots);
+    QVERIFY(!buffer.tryPush(&matData));
+
+    // Popping one matrix frees one slot, the positions wrap around the end of the ring
+    QVERIFY(buffer.tryPop(matData));
+    QVERIFY(matData == numberedMatrix(0));
+
+    matData = numberedMatrix(m_iSlots);
+    QVERIFY(buffer.tryPush(&matData));
+    QVERIFY(!buffer.tryPush(&matData));
+
+    for(int i = 1; i <= m_iSlots; ++i) {
+        QVERIFY(buffer.tryPop(matData));
+        QVERIFY(matData.rows() == m_iRows && matData.cols() == m_iCols);
+        QVERIFY(matData == numberedMatrix(i));
+    }
+
+    QVERIFY(!buffer.tryPop(matData));
+}
+
+//=============================================================================================================
+
+void TestUtilsCircularMatrixBuffer::compareTimeouts()
+{
+    CircularMatrixBuffer<double> buffer(m_iSlots, m_iRows, m_iCols);
+    MatrixXd matData;
+    QElapsedTimer timer;
+
+    // A pop from the empty ring gives up after the timeout
+    timer.start();
+    QVERIFY(!buffer.pop(matData, m_iTimeoutMs));
+    QVERIFY(timer.elapsed() >= m_iTimeoutMs - 1);
+    QVERIFY(!buffer.beginRead(m_iTimeoutMs));
+
+    for(int i = 0; i < m_iSlots; ++i) {
+        matData = numberedMatrix(i);
+        QVERIFY(buffer.push(&matData, m_iTimeoutMs));
+    }
+
+    // A push to the full ring gives up after the timeout
+    matData = numberedMatrix(m_iSlots);
+    timer.start();
+    QVERIFY(!buffer.push(&matData, m_iTimeoutMs));
+    QVERIFY(timer.elapsed() >= m_iTimeoutMs - 1);
+    QVERIFY(!buffer.beginWrite(m_iTimeoutMs));
+
+    // A timed pop returns as soon as a matrix is available
+    QVERIFY(buffer.pop(matData, m_iTimeoutMs));
+    QVERIFY(matData == numberedMatrix(0));
+
+    // A timed push waiting for a free slot succeeds once the consumer pops
+    QFuture<bool> producer = QtConcurrent::run([&]() {
+        MatrixXd matNext = numberedMatrix(m_iSlots);
+        return buffer.push(&matNext, 100 * m_iTimeoutMs) && buffer.push(&matNext, 100 * m_iTimeoutMs);
+    });
+
+    for(int i = 1; i <= m_iSlots; ++i) {
+        QVERIFY(buffer.pop(matData, 100 * m_iTimeoutMs));
+        QVERIFY(matData == numberedMatrix(i));
+    }
+
+    QVERIFY(producer.result());
+    QVERIFY(buffer.tryPop(matData));
+    QVERIFY(matData == numberedMatrix(m_iSlots));
+}
+
+//=============================================================================================================
+
+void TestUtilsCircularMatrixBuffer::compareReleaseFromPop()
+{
+    CircularMatrixBuffer<double> buffer(m_iSlots, m_iRows, m_iCols);
+
+    // A consumer blocked on the empty ring without a timeout is woken up by releaseFromPop()
+    QFuture<bool> consumer = QtConcurrent::run([&]() {
+        MatrixXd matData;
+        return buffer.pop(matData, -1);
+    });
+
+    QThread::msleep(m_iTimeoutMs);
+
+    QVERIFY(buffer.releaseFromPop());
+    QVERIFY(!consumer.result());
+
+    // The blocking pop() hands out a zero matrix when released
+    QFuture<MatrixXd> consumerZero = QtConcurrent::run([&]() {
+        return buffer.pop();
+    });
+
+    QThread::msleep(m_iTimeoutMs);
+
+    QVERIFY(buffer.releaseFromPop());
+    QVERIFY(consumerZero.result() == MatrixXd::Zero(m_iRows, m_iCols));
+
+    // There is nothing to release as long as matrices are available
+    MatrixXd matData = numberedMatrix(0);
+    QVERIFY(buffer.tryPush(&matData));
+    QVERIFY(!buffer.releaseFromPop());
+    QVERIFY(buffer.tryPop(matData));
+    QVERIFY(matData == numberedMatrix(0));
+}
+
+//=============================================================================================================
+
+void TestUtilsCircularMatrixBuffer::compareReleaseFromPush()
+{
+    CircularMatrixBuffer<double> buffer(m_iSlots, m_iRows, m_iCols);
+    MatrixXd matData;
+
+    // There is nothing to release as long as a slot is free
+    QVERIFY(!buffer.releaseFromPush());
+
+    for(int i = 0; i < m_iSlots; ++i) {
+        matData = numberedMatrix(i);
+        QVERIFY(buffer.tryPush(&matData));
+    }
+
+    // A producer blocked on the full ring without a timeout is woken up by releaseFromPush() and drops its matrix
+    QFuture<bool> producer = QtConcurrent::run([&]() {
+        MatrixXd matNext = numberedMatrix(m_iSlots);
+        return buffer.push(&matNext, -1);
+    });
+
+    QThread::msleep(m_iTimeoutMs);
+
+    QVERIFY(buffer.releaseFromPush());
+    QVERIFY(!producer.result());
+
+    for(int i = 0; i < m_iSlots; ++i) {
+        QVERIFY(buffer.tryPop(matData));
+        QVERIFY(matData == numberedMatrix(i));
+    }
+
+    QVERIFY(!buffer.tryPop(matData));
+}
+
+//=============================================================================================================
+
+void TestUtilsCircularMatrixBuffer::compareZeroCopy()
+{
+    CircularMatrixBuffer<double> buffer(m_iSlots, m_iRows, m_iCols);
+
+    // Nothing to read from an empty ring
+    QVERIFY(!buffer.beginRead(0));
+
+    // The slots are filled in place and read back by a regular pop
+    for(int i = 0; i < m_iSlots; ++i) {
+        double* pSlot = buffer.beginWrite(0);
+        QVERIFY(pSlot);
+        Map<MatrixXd>(pSlot, m_iRows, m_iCols) = numberedMatrix(i);
+        buffer.commitWrite();
+    }
+
+    QVERIFY(!buffer.beginWrite(0));
+
+    MatrixXd matData;
+    QVERIFY(buffer.tryPop(matData));
+    QVERIFY(matData == numberedMatrix(0));
+
+    // Regularly pushed matrices are read in place, the slot stays valid until it is committed
+    matData = numberedMatrix(m_iSlots);
+    QVERIFY(buffer.tryPush(&matData));
+
+    for(int i = 1; i <= m_iSlots; ++i) {
+        const double* pSlot = buffer.beginRead(0);
+        QVERIFY(pSlot);
+        QVERIFY(Map<const MatrixXd>(pSlot, m_iRows, m_iCols) == numberedMatrix(i));
+        QVERIFY(buffer.beginRead(0) == pSlot);
+        buffer.commitRead();
+    }
+
+    QVERIFY(!buffer.beginRead(0));
+}
+
+//=============================================================================================================
+
+void TestUtilsCircularMatrixBuffer::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+MatrixXd TestUtilsCircularMatrixBuffer::numberedMatrix(int iNumber) const
+{
+    MatrixXd matData(m_iRows, m_iCols);
+
+    for(int i = 0; i < matData.size(); ++i) {
+        matData(i) = iNumber * matData.size() + i;
+    }
+
+    return matData;
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestUtilsCircularMatrixBuffer)
+#include "test_utils_circular_matrix_buffer.moc"
@@ -0,0 +1,446 @@
+//=============================================================================================================
+/**
+ * @file     test_utils_parallel_executor.cpp
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test for the capped, nesting-aware parallel executor.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+#include <utils/parallelexecutor.h>
+
+#include <mne/mne_forwardsolution.h>
+
+#include <inverse/rapMusic/rapmusic.h>
+#include <inverse/rapMusic/pwlrapmusic.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+#include <QAtomicInt>
+#include <QMutex>
+#include <QSet>
+#include <QThread>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace UTILSLIB;
+using namespace MNELIB;
+using namespace INVERSELIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestUtilsParallelExecutor
+ *
+ * @brief The TestUtilsParallelExecutor class tests the index coverage, the thread caps and the serial nesting of
+ * the parallel executor, and that RAP MUSIC finds the same dipoles with and without threads.
+ *
+ */
+class TestUtilsParallelExecutor: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestUtilsParallelExecutor();
+
+private slots:
+    void initTestCase();
+    void compareCoverage();
+    void compareCoverageSmallRange();
+    void compareMaxThreads();
+    void compareEnvMaxThreads();
+    void compareNestedSerial();
+    void compareRapMusic();
+    void comparePwlRapMusic();
+    void cleanup();
+    void cleanupTestCase();
+
+private:
+    QVector<int> visitCounts(int iCount, int iNumThreads) const;
+    int maxConcurrency(int iCount) const;
+    MNEForwardSolution syntheticForward() const;
+    MatrixXd syntheticMeasurement(const MNEForwardSolution& fwd) const;
+    QList<DipolePair<double> > fitDipolePairs(RapMusic& rapMusic,
+                                              const MatrixXd& matMeasurement) const;
+    void compareDipolePairs(const QList<DipolePair<double> >& serialDipoles,
+                            const QList<DipolePair<double> >& parallelDipoles) const;
+
+    int     m_iCount;
+    int     m_iCap;
+    int     m_iNumChannels;
+    int     m_iNumGridPoints;
+    int     m_iNumSamples;
+};
+
+//=============================================================================================================
+
+TestUtilsParallelExecutor::TestUtilsParallelExecutor()
+: m_iCount(10007)
+, m_iCap(2)
+, m_iNumChannels(60)
+, m_iNumGridPoints(80)
+, m_iNumSamples(200)
+{
+}
+
+//=============================================================================================================
+
+void TestUtilsParallelExecutor::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+}
+
+//=============================================================================================================
+
+void TestUtilsParallelExecutor::compareCoverage()
+{
+    // Every index of [0, iCount) has to be visited exactly once, whatever the number of threads
+    QVector<int> vecThreads = QVector<int>() << 0 << 1 << 3 << ParallelExecutor::maxThreads();
+
+    for(int iNumThreads : vecThreads) {
+        QVector<int> vecCounts = visitCounts(m_iCount, iNumThreads);
+
+        QCOMPARE(vecCounts.size(), m_iCount);
+        QCOMPARE(vecCounts.count(1), m_iCount);
+    }
+
+    // An empty range must not call the function at all
+    QCOMPARE(visitCounts(0, 0).size(), 0);
+
+    QAtomicInt iCalls(0);
+    ParallelExecutor::parallelFor(0, [&](int) { iCalls.ref(); });
+    ParallelExecutor::parallelFor(-5, [&](int) { iCalls.ref(); });
+    QCOMPARE(iCalls.loadAcquire(), 0);
+}
+
+//=============================================================================================================
+
+void TestUtilsParallelExecutor::compareCoverageSmallRange()
+{
+    // Ranges with fewer indices than threads must neither skip nor repeat an index
+    int iNumThreads = qMax(4, ParallelExecutor::maxThreads());
+
+    for(int iCount = 1; iCount < iNumThreads; ++iCount) {
+        QVector<int> vecCounts = visitCounts(iCount, iNumThreads);
+
+        QCOMPARE(vecCounts.count(1), iCount);
+    }
+}
+
+//=============================================================================================================
+
+void TestUtilsParallelExecutor::compareMaxThreads()
+{
+    int iCap = qMin(m_iCap, qMax(1, QThread::idealThreadCount()));
+
+    ParallelExecutor::setMaxThreads(m_iCap);
+
+    QCOMPARE(ParallelExecutor::maxThreads(), iCap);
+    QCOMPARE(ParallelExecutor::threadCount(), iCap);
+    QCOMPARE(ParallelExecutor::threadCount(64), iCap);
+    QCOMPARE(ParallelExecutor::threadCount(1), 1);
+
+    // run has to start exactly one call per granted thread
+    QAtomicInt iCalls(0);
+    QAtomicInt iReportedThreads(0);
+    ParallelExecutor::run([&](int, int iNumThreads) {
+        iCalls.ref();
+        iReportedThreads.storeRelease(iNumThreads);
+    }, 64);
+
+    QCOMPARE(iCalls.loadAcquire(), iCap);
+    QCOMPARE(iReportedThreads.loadAcquire(), iCap);
+    QVERIFY(maxConcurrency(m_iCount) <= iCap);
+
+    // 0 removes the cap again
+    ParallelExecutor::setMaxThreads(0);
+
+    QCOMPARE(ParallelExecutor::maxThreads(), qMax(1, QThread::idealThreadCount()));
+}
+
+//=============================================================================================================
+
+void TestUtilsParallelExecutor::compareEnvMaxThreads()
+{
+    int iCap = qMin(m_iCap, qMax(1, QThread::idealThreadCount()));
+
+    qputenv("MNECPP_MAX_THREADS", QByteArray::number(m_iCap));
+
+    QCOMPARE(ParallelExecutor::maxThreads(), iCap);
+    QCOMPARE(ParallelExecutor::threadCount(64), iCap);
+    QVERIFY(maxConcurrency(m_iCount) <= iCap);
+
+    // The smaller of the environment and the API cap wins
+    ParallelExecutor::setMaxThreads(1);
+
+    QCOMPARE(ParallelExecutor::maxThreads(), 1);
+
+    ParallelExecutor::setMaxThreads(m_iCap + 1);
+
+    QCOMPARE(ParallelExecutor::maxThreads(), iCap);
+
+    // Invalid values are ignored
+    qputenv("MNECPP_MAX_THREADS", "none");
+    ParallelExecutor::setMaxThreads(0);
+
+    QCOMPARE(ParallelExecutor::maxThreads(), qMax(1, QThread::idealThreadCount()));
+}
+
+//=============================================================================================================
+
+void TestUtilsParallelExecutor::compareNestedSerial()
+{
+    QVERIFY(!ParallelExecutor::isInParallelRegion());
+
+    // A region started inside another region has to stay on the calling thread
+    QAtomicInt iInRegion(0);
+    QAtomicInt iNestedThreadCount(0);
+    QAtomicInt iForeignThreads(0);
+    QAtomicInt iNestedCalls(0);
+
+    int iNumThreads = qMax(2, ParallelExecutor::maxThreads());
+    int iNestedCount = 100;
+
+    ParallelExecutor::run([&](int, int) {
+        if(ParallelExecutor::isInParallelRegion()) {
+            iInRegion.ref();
+        }
+
+        if(ParallelExecutor::threadCount() != 1) {
+            iNestedThreadCount.ref();
+        }
+
+        QThread* pOuterThread = QThread::currentThread();
+
+        ParallelExecutor::parallelFor(iNestedCount, [&](int) {
+            iNestedCalls.ref();
+
+            if(QThread::currentThread() != pOuterThread) {
+                iForeignThreads.ref();
+            }
+        });
+
+        ParallelExecutor::run([&](int, int iNestedThreads) {
+            if(iNestedThreads != 1 || QThread::currentThread() != pOuterThread) {
+                iForeignThreads.ref();
+            }
+        });
+
+        // The nested region must not clear the flag of the outer one
+        if(!ParallelExecutor::isInParallelRegion()) {
+            iNestedThreadCount.ref();
+        }
+    }, iNumThreads);
+
+    int iOuterThreads = ParallelExecutor::threadCount(iNumThreads);
+
+    QCOMPARE(iInRegion.loadAcquire(), iOuterThreads);
+    QCOMPARE(iNestedThreadCount.loadAcquire(), 0);
+    QCOMPARE(iForeignThreads.loadAcquire(), 0);
+    QCOMPARE(iNestedCalls.loadAcquire(), iOuterThreads * iNestedCount);
+    QVERIFY(!ParallelExecutor::isInParallelRegion());
+}
+
+//=============================================================================================================
+
+void TestUtilsParallelExecutor::compareRapMusic()
+{
+    MNEForwardSolution fwd = syntheticForward();
+    MatrixXd matMeasurement = syntheticMeasurement(fwd);
+
+    // The thread count is taken on construction, so both instances are created under their cap
+    ParallelExecutor::setMaxThreads(1);
+    RapMusic serialRapMusic(fwd, false, 2);
+    QList<DipolePair<double> > serialDipoles = fitDipolePairs(serialRapMusic, matMeasurement);
+
+    ParallelExecutor::setMaxThreads(0);
+    RapMusic parallelRapMusic(fwd, false, 2);
+    QList<DipolePair<double> > parallelDipoles = fitDipolePairs(parallelRapMusic, matMeasurement);
+
+    QVERIFY(!serialDipoles.isEmpty());
+    compareDipolePairs(serialDipoles, parallelDipoles);
+}
+
+//=============================================================================================================
+
+void TestUtilsParallelExecutor::comparePwlRapMusic()
+{
+    MNEForwardSolution fwd = syntheticForward();
+    MatrixXd matMeasurement = syntheticMeasurement(fwd);
+
+    ParallelExecutor::setMaxThreads(1);
+    PwlRapMusic serialRapMusic(fwd, false, 2);
+    QList<DipolePair<double> > serialDipoles = fitDipolePairs(serialRapMusic, matMeasurement);
+
+    ParallelExecutor::setMaxThreads(0);
+    PwlRapMusic parallelRapMusic(fwd, false, 2);
+    QList<DipolePair<double> > parallelDipoles = fitDipolePairs(parallelRapMusic, matMeasurement);
+
+    QVERIFY(!serialDipoles.isEmpty());
+    compareDipolePairs(serialDipoles, parallelDipoles);
+}
+
+//=============================================================================================================
+
+void TestUtilsParallelExecutor::cleanup()
+{
+    // Do not let a failed test leak its cap into the next one
+    qunsetenv("MNECPP_MAX_THREADS");
+    ParallelExecutor::setMaxThreads(0);
+}
+
+//=============================================================================================================
+
+void TestUtilsParallelExecutor::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+QVector<int> TestUtilsParallelExecutor::visitCounts(int iCount,
+                                                    int iNumThreads) const
+{
+    QVector<QAtomicInt> vecCounts(qMax(0, iCount));
+    QAtomicInt* pCounts = vecCounts.data();
+
+    ParallelExecutor::parallelFor(iCount, [&](int iIdx) {
+        pCounts[iIdx].ref();
+    }, iNumThreads);
+
+    QVector<int> vecResult;
+    for(const QAtomicInt& iVisits : vecCounts) {
+        vecResult.append(iVisits.loadAcquire());
+    }
+
+    return vecResult;
+}
+
+//=============================================================================================================
+
+int TestUtilsParallelExecutor::maxConcurrency(int iCount) const
+{
+    QAtomicInt iRunning(0);
+    QAtomicInt iMaxRunning(0);
+
+    ParallelExecutor::parallelFor(iCount, [&](int) {
+        int iNow = iRunning.fetchAndAddOrdered(1) + 1;
+
+        int iMax = iMaxRunning.loadAcquire();
+        while(iNow > iMax && !iMaxRunning.testAndSetOrdered(iMax, iNow)) {
+            iMax = iMaxRunning.loadAcquire();
+        }
+
+        iRunning.deref();
+    }, 64);
+
+    return iMaxRunning.loadAcquire();
+}
+
+//=============================================================================================================
+
+MNEForwardSolution TestUtilsParallelExecutor::syntheticForward() const
+{
+    // A fixed pseudo random gain matrix with three free orientation columns per grid point
+    std::srand(42);
+
+    MNEForwardSolution fwd;
+    fwd.sol->data = MatrixXd::Random(m_iNumChannels, 3 * m_iNumGridPoints);
+    fwd.sol->nrow = m_iNumChannels;
+    fwd.sol->ncol = 3 * m_iNumGridPoints;
+
+    return fwd;
+}
+
+//=============================================================================================================
+
+MatrixXd TestUtilsParallelExecutor::syntheticMeasurement(const MNEForwardSolution& fwd) const
+{
+    // Three sources with distinct time courses, so the signal subspace has rank three
+    RowVectorXd vecTime = RowVectorXd::LinSpaced(m_iNumSamples, 0.0, 1.0);
+
+    MatrixXd matMeasurement = fwd.sol->data.col(3 * 10) * (2.0 * M_PI * 5.0 * vecTime).array().sin().matrix()
+                              + fwd.sol->data.col(3 * 47 + 1) * (2.0 * M_PI * 11.0 * vecTime).array().sin().matrix()
+                              + fwd.sol->data.col(3 * 63 + 2) * (2.0 * M_PI * 3.0 * vecTime).array().cos().matrix();
+
+    return matMeasurement;
+}
+
+//=============================================================================================================
+
+QList<DipolePair<double> > TestUtilsParallelExecutor::fitDipolePairs(RapMusic& rapMusic,
+                                                                     const MatrixXd& matMeasurement) const
+{
+    QList<DipolePair<double> > dipoles;
+    rapMusic.calculateInverse(matMeasurement, dipoles);
+
+    return dipoles;
+}
+
+//=============================================================================================================
+
+void TestUtilsParallelExecutor::compareDipolePairs(const QList<DipolePair<double> >& serialDipoles,
+                                                   const QList<DipolePair<double> >& parallelDipoles) const
+{
+    // Every correlation is computed by exactly one thread, so the results have to be identical
+    QCOMPARE(parallelDipoles.size(), serialDipoles.size());
+
+    for(int i = 0; i < serialDipoles.size(); ++i) {
+        QCOMPARE(parallelDipoles[i].m_iIdx1, serialDipoles[i].m_iIdx1);
+        QCOMPARE(parallelDipoles[i].m_iIdx2, serialDipoles[i].m_iIdx2);
+        QCOMPARE(parallelDipoles[i].m_vCorrelation, serialDipoles[i].m_vCorrelation);
+        QCOMPARE(parallelDipoles[i].m_Dipole1.phi_x(), serialDipoles[i].m_Dipole1.phi_x());
+        QCOMPARE(parallelDipoles[i].m_Dipole1.phi_y(), serialDipoles[i].m_Dipole1.phi_y());
+        QCOMPARE(parallelDipoles[i].m_Dipole1.phi_z(), serialDipoles[i].m_Dipole1.phi_z());
+        QCOMPARE(parallelDipoles[i].m_Dipole2.phi_x(), serialDipoles[i].m_Dipole2.phi_x());
+        QCOMPARE(parallelDipoles[i].m_Dipole2.phi_y(), serialDipoles[i].m_Dipole2.phi_y());
+        QCOMPARE(parallelDipoles[i].m_Dipole2.phi_z(), serialDipoles[i].m_Dipole2.phi_z());
+    }
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestUtilsParallelExecutor)
+#include "test_utils_parallel_executor.moc"
@@ -0,0 +1,202 @@
+//=============================================================================================================
+/**
+ * @file     test_utils_spectral.cpp
+ * @author   MNE-CPP authors
+ * @version  dev
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, MNE-CPP authors. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test for the DPSS tapers of the spectral utilities.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+#include <utils/spectral.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Dense>
+
+//=============================================================================================================
+// STL INCLUDES
+//=============================================================================================================
+
+#include <cmath>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace UTILSLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestUtilsSpectral
+ *
+ * @brief The TestUtilsSpectral class compares the DPSS tapers with a dense eigendecomposition of the sinc kernel.
+ *
+ */
+class TestUtilsSpectral: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestUtilsSpectral();
+
+private slots:
+    void initTestCase();
+    void compareDpssOrthonormality();
+    void compareDpssConcentration();
+    void compareDpssCache();
+    void cleanupTestCase();
+
+private:
+    double          m_dEpsilon;
+};
+
+//=============================================================================================================
+
+TestUtilsSpectral::TestUtilsSpectral()
+: m_dEpsilon(1e-8)
+{
+}
+
+//=============================================================================================================
+
+void TestUtilsSpectral::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+}
+
+//=============================================================================================================
+
+void TestUtilsSpectral::compareDpssOrthonormality()
+{
+    QList<int> lLengths = QList<int>() << 16 << 101 << 256 << 1000;
+
+    for(int n : lLengths) {
+        QPair<MatrixXd, VectorXd> tapers = Spectral::generateDpssTapers(n, 4.0, 7);
+
+        QVERIFY(tapers.first.rows() == 7 && tapers.first.cols() == n);
+        QVERIFY(tapers.second.size() == 7);
+        QVERIFY((tapers.first * tapers.first.transpose() - MatrixXd::Identity(7, 7)).cwiseAbs().maxCoeff() < m_dEpsilon);
+    }
+
+    // The default number of tapers is 2 * NW - 1
+    QVERIFY(Spectral::generateDpssTapers(128, 3.0).first.rows() == 5);
+}
+
+//=============================================================================================================
+
+void TestUtilsSpectral::compareDpssConcentration()
+{
+    QList<int> lLengths = QList<int>() << 16 << 33 << 64 << 101;
+    QList<double> lHalfBandwidths = QList<double>() << 2.0 << 2.5 << 4.0;
+
+    for(int n : lLengths) {
+        for(double dNW : lHalfBandwidths) {
+            int iNumTapers = int(floor(2.0 * dNW - 1.0));
+            QPair<MatrixXd, VectorXd> tapers = Spectral::generateDpssTapers(n, dNW, iNumTapers);
+
+            // The time and band limiting operator sin(2 pi W (m - n)) / (pi (m - n)) with 2W on the diagonal
+            double dW = dNW / n;
+            MatrixXd matKernel(n, n);
+
+            for(int i = 0; i < n; ++i) {
+                for(int j = 0; j < n; ++j) {
+                    matKernel(i,j) = (i == j) ? 2.0 * dW : std::sin(2.0 * M_PI * dW * (i - j)) / (M_PI * (i - j));
+                }
+            }
+
+            SelfAdjointEigenSolver<MatrixXd> eigenSolver(matKernel);
+
+            for(int k = 0; k < iNumTapers; ++k) {
+                // Eigen sorts the eigenvalues in increasing order
+                double dEigenvalue = eigenSolver.eigenvalues()(n - 1 - k);
+                VectorXd vecEigenvector = eigenSolver.eigenvectors().col(n - 1 - k);
+                VectorXd vecTaper = tapers.first.row(k).transpose();
+
+                // The weights are the square roots of the concentration ratios
+                QVERIFY2(std::fabs(tapers.second(k) * tapers.second(k) - dEigenvalue) < m_dEpsilon,
+                         qPrintable(QString("N %1 NW %2 taper %3").arg(n).arg(dNW).arg(k)));
+
+                // The tapers are the eigenvectors up to their sign
+                QVERIFY(qMin((vecTaper - vecEigenvector).norm(), (vecTaper + vecEigenvector).norm()) < 1e-6);
+            }
+        }
+    }
+}
+
+//=============================================================================================================
+
+void TestUtilsSpectral::compareDpssCache()
+{
+    int iCacheSize = Spectral::taperCacheSize();
+
+    QPair<MatrixXd, VectorXd> tapers = Spectral::generateDpssTapers(517, 3.5, 6);
+    QVERIFY(Spectral::taperCacheSize() == iCacheSize + 1);
+
+    // The same (N, NW, K) is taken from the cache
+    QPair<MatrixXd, VectorXd> tapersCached = Spectral::generateDpssTapers(517, 3.5, 6);
+    QVERIFY(Spectral::taperCacheSize() == iCacheSize + 1);
+    QVERIFY(tapersCached.first == tapers.first);
+    QVERIFY(tapersCached.second == tapers.second);
+
+    // A different number of tapers, half bandwidth or length is computed and cached on its own
+    QVERIFY(Spectral::generateDpssTapers(517, 3.5, 5).first.rows() == 5);
+    QVERIFY(Spectral::taperCacheSize() == iCacheSize + 2);
+
+    Spectral::generateDpssTapers(517, 3.0, 6);
+    QVERIFY(Spectral::taperCacheSize() == iCacheSize + 3);
+
+    Spectral::generateDpssTapers(518, 3.5, 6);
+    QVERIFY(Spectral::taperCacheSize() == iCacheSize + 4);
+}
+
+//=============================================================================================================
+
+void TestUtilsSpectral::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestUtilsSpectral)
+#include "test_utils_spectral.moc"
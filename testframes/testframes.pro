@@ -52,6 +52,14 @@ SUBDIRS += \
     test_filtering \
     test_hpiFit \
     test_mne_forward_solution \
+    test_mne_epoch_data_list \
+    test_utils_circular_matrix_buffer \
+    test_utils_parallel_executor \
+    test_mne_triangle_bvh \
+    test_mne_raw_data_fft \
+    test_rtprocessing_running_average \
+    test_utils_spectral \
+    test_connectivity_network \
     test_fiff_cov \
     test_fiff_digitizer \
     test_mne_msh_display_surface_set \
@@ -63,5 +71,12 @@ SUBDIRS += \
             test_geometryinfo \
             test_spectral_connectivity \
             test_mne_anonymize
+
+        # The MNE Scan libraries are built with the applications
+        !contains(MNECPP_CONFIG, noApplications) {
+            SUBDIRS += \
+                test_scshared_connector_edge \
+                test_scmeas_sample_block_pool
+        }
     }
 }